@@ -0,0 +1,357 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "databaseinterface.h"
+#include "datatypes.h"
+
+#include <QObject>
+#include <QString>
+#include <QUrl>
+#include <QTime>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QTemporaryFile>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+#include <QDebug>
+
+#include <QTest>
+#include <QSignalSpy>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+using namespace Qt::Literals::StringLiterals;
+
+class DatabaseInterfaceBenchmark: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DatabaseInterfaceBenchmark(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static constexpr int DefaultTracksCount = 50000;
+
+    static constexpr int TracksPerAlbum = 12;
+
+    static constexpr int AlbumsPerArtist = 4;
+
+    static constexpr int SearchBudgetMs = 20;
+
+    static constexpr int SearchFirstBatchSize = 20;
+
+    QTemporaryFile mLibraryDatabaseFile;
+
+    std::unique_ptr<DatabaseInterface> mLibraryDatabase;
+
+    static int tracksCount()
+    {
+        auto isValid = false;
+        const auto count = qEnvironmentVariableIntValue("ELISA_BENCHMARK_TRACKS_COUNT", &isValid);
+
+        return (isValid && count > 0) ? count : DefaultTracksCount;
+    }
+
+    /**
+     * Library where names repeat like in a real collection: albums of a dozen tracks,
+     * a few albums per artist and a small set of genres, composers and lyricists
+     */
+    static DataTypes::ListTrackDataType generateTracks(int count)
+    {
+        auto result = DataTypes::ListTrackDataType{};
+        result.reserve(count);
+
+        for (int i = 0; i < count; ++i) {
+            const auto albumIndex = i / TracksPerAlbum;
+            const auto artistIndex = albumIndex / AlbumsPerArtist;
+            const auto artist = u"artist%1"_s.arg(artistIndex);
+
+            result.push_back({true, QString::number(i), u"0"_s, u"track%1"_s.arg(i),
+                              artist, u"album%1"_s.arg(albumIndex), artist,
+                              i % TracksPerAlbum + 1, 1, QTime::fromMSecsSinceStartOfDay(180000 + i % 60000),
+                              QUrl::fromLocalFile(u"/music/%1/album%2/track%3.ogg"_s.arg(artist).arg(albumIndex).arg(i)),
+                              QDateTime::fromMSecsSinceEpoch(i), {}, 0, true,
+                              u"genre%1"_s.arg(artistIndex % 30), u"composer%1"_s.arg(artistIndex % 200),
+                              u"lyricist%1"_s.arg(artistIndex % 200), false});
+        }
+
+        return result;
+    }
+
+    /**
+     * Library shared by the benchmarks only reading the database
+     */
+    DatabaseInterface &libraryDatabase()
+    {
+        if (!mLibraryDatabase) {
+            mLibraryDatabaseFile.open();
+
+            mLibraryDatabase = std::make_unique<DatabaseInterface>();
+            mLibraryDatabase->init(u"libraryBenchmarkDb"_s, mLibraryDatabaseFile.fileName());
+            mLibraryDatabase->insertTracksList(generateTracks(tracksCount()), {});
+        }
+
+        return *mLibraryDatabase;
+    }
+
+    static void printInsertionRate(const char *step, qsizetype tracksCount, qint64 durationNs)
+    {
+        qInfo() << step << tracksCount << "tracks in" << durationNs / 1000000 << "ms:"
+                << (durationNs > 0 ? 1e9 * static_cast<double>(tracksCount) / static_cast<double>(durationNs) : 0.) << "tracks/s";
+    }
+
+private Q_SLOTS:
+
+    void insertNewTracks()
+    {
+        const auto newTracks = generateTracks(tracksCount());
+
+        QTemporaryFile databaseFile;
+        databaseFile.open();
+
+        DatabaseInterface musicDb;
+        musicDb.init(u"benchmarkDb"_s, databaseFile.fileName());
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto insertionDuration = qint64{0};
+
+        QBENCHMARK_ONCE {
+            QElapsedTimer insertionTimer;
+            insertionTimer.start();
+
+            musicDb.insertTracksList(newTracks, {});
+
+            insertionDuration = insertionTimer.nsecsElapsed();
+        }
+
+        printInsertionRate("inserted", newTracks.size(), insertionDuration);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+        QCOMPARE(musicDb.allTracksData().size(), newTracks.size());
+    }
+
+    void insertKnownTracks()
+    {
+        const auto knownTracks = generateTracks(tracksCount());
+
+        QTemporaryFile databaseFile;
+        databaseFile.open();
+
+        DatabaseInterface musicDb;
+        musicDb.init(u"benchmarkDb"_s, databaseFile.fileName());
+        musicDb.insertTracksList(knownTracks, {});
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto insertionDuration = qint64{0};
+
+        // a full rescan of an unchanged collection
+        QBENCHMARK_ONCE {
+            QElapsedTimer insertionTimer;
+            insertionTimer.start();
+
+            musicDb.insertTracksList(knownTracks, {});
+
+            insertionDuration = insertionTimer.nsecsElapsed();
+        }
+
+        printInsertionRate("inserted again", knownTracks.size(), insertionDuration);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+        QCOMPARE(musicDb.allTracksData().size(), knownTracks.size());
+    }
+
+    void searchLibrary_data()
+    {
+        QTest::addColumn<QString>("searchText");
+        QTest::addColumn<bool>("isSelective");
+
+        QTest::newRow("one track") << u"track12345"_s << true;
+        QTest::newRow("one artist") << u"artist123"_s << true;
+        QTest::newRow("artist and album") << u"artist123 album493"_s << true;
+        QTest::newRow("uppercase prefix") << u"ALBUM493"_s << true;
+        QTest::newRow("many artists") << u"artist1"_s << false;
+        QTest::newRow("every track") << u"tr"_s << false;
+    }
+
+    void searchLibrary()
+    {
+        QFETCH(QString, searchText);
+        QFETCH(bool, isSelective);
+
+        auto &musicDb = libraryDatabase();
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto results = musicDb.librarySearch(searchText, SearchFirstBatchSize);
+
+        QVERIFY(!results.isEmpty());
+
+        QElapsedTimer searchTimer;
+        searchTimer.start();
+
+        results = musicDb.librarySearch(searchText, SearchFirstBatchSize);
+
+        const auto searchDuration = searchTimer.elapsed();
+
+        qInfo() << "searched" << searchText << "in" << tracksCount() << "tracks in" << searchDuration << "ms";
+
+        // a prefix matching the whole library is reported but cannot be ranked in the budget
+        if (isSelective) {
+            QVERIFY2(searchDuration < SearchBudgetMs, qPrintable(u"%1 ms"_s.arg(searchDuration)));
+        }
+
+        QBENCHMARK {
+            results = musicDb.librarySearch(searchText, SearchFirstBatchSize);
+        }
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void allAlbumsData()
+    {
+        auto &musicDb = libraryDatabase();
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        // the aggregation over all tracks that the albums list did before reading the summaries
+        auto aggregatedAlbumsDuration = qint64{0};
+        {
+            auto connection = QSqlDatabase::addDatabase(u"QSQLITE"_s, u"aggregatedAlbumsBenchmark"_s);
+            connection.setDatabaseName(mLibraryDatabaseFile.fileName());
+            QVERIFY(connection.open());
+
+            QSqlQuery aggregatedAlbumsQuery(connection);
+
+            QElapsedTimer aggregationTimer;
+            aggregationTimer.start();
+
+            QVERIFY(aggregatedAlbumsQuery.exec(u"SELECT "
+                                               "album.`ID`, "
+                                               "GROUP_CONCAT(tracks.`Year`, ', '), "
+                                               "COUNT(DISTINCT tracks.`ArtistName`), "
+                                               "GROUP_CONCAT(tracks.`ArtistName`, ', '), "
+                                               "MAX(tracks.`Rating`), "
+                                               "GROUP_CONCAT(genres.`Name`, ', '), "
+                                               "COUNT(DISTINCT tracks.`DiscNumber`) <= 1 "
+                                               "FROM "
+                                               "`Albums` album, "
+                                               "`Tracks` tracks LEFT JOIN "
+                                               "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                               "WHERE "
+                                               "tracks.`AlbumTitle` = album.`Title` AND "
+                                               "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
+                                               "(tracks.`AlbumArtistName` IS NULL AND album.`ArtistName` IS NULL)) AND "
+                                               "tracks.`AlbumPath` = album.`AlbumPath` "
+                                               "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` "
+                                               "ORDER BY album.`Title` COLLATE NOCASE"_s));
+            while (aggregatedAlbumsQuery.next()) {
+            }
+
+            aggregatedAlbumsDuration = aggregationTimer.nsecsElapsed();
+        }
+        QSqlDatabase::removeDatabase(u"aggregatedAlbumsBenchmark"_s);
+
+        auto allAlbums = musicDb.allAlbumsData();
+
+        QElapsedTimer albumsTimer;
+        albumsTimer.start();
+
+        allAlbums = musicDb.allAlbumsData();
+
+        const auto albumsDuration = albumsTimer.nsecsElapsed();
+
+        qInfo() << "listed" << allAlbums.size() << "albums in" << albumsDuration / 1000000 << "ms, aggregating them took"
+                << aggregatedAlbumsDuration / 1000000 << "ms";
+
+        QCOMPARE(allAlbums.size(), (tracksCount() + TracksPerAlbum - 1) / TracksPerAlbum);
+        QVERIFY2(albumsDuration < aggregatedAlbumsDuration,
+                 qPrintable(u"%1 ms against %2 ms"_s.arg(albumsDuration / 1000000).arg(aggregatedAlbumsDuration / 1000000)));
+
+        QBENCHMARK {
+            allAlbums = musicDb.allAlbumsData();
+        }
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void allArtistsData()
+    {
+        auto &musicDb = libraryDatabase();
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto allArtists = musicDb.allArtistsData();
+
+        QCOMPARE(allArtists.size(), (tracksCount() + TracksPerAlbum * AlbumsPerArtist - 1) / (TracksPerAlbum * AlbumsPerArtist));
+
+        QBENCHMARK {
+            allArtists = musicDb.allArtistsData();
+        }
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    /**
+     * Time from the opening of an existing library to the first albums, with the statements
+     * prepared on first use and with all of them prepared during the startup
+     */
+    void startupToFirstData()
+    {
+        const auto expectedAlbumsCount = libraryDatabase().allAlbumsData().size();
+
+        auto connectionIndex = 0;
+        auto albumsCount = qsizetype{0};
+
+        const auto openLibrary = [this, &connectionIndex, &albumsCount](bool prepareAllStatements) {
+            auto timer = QElapsedTimer{};
+            timer.start();
+
+            DatabaseInterface musicDb;
+            musicDb.init(u"startupBenchmarkDb%1"_s.arg(connectionIndex++), mLibraryDatabaseFile.fileName());
+
+            if (prepareAllStatements) {
+                musicDb.prepareAllStatements();
+            }
+
+            albumsCount = musicDb.allAlbumsData().size();
+
+            return timer.nsecsElapsed();
+        };
+
+        constexpr auto runsCount = 5;
+
+        auto lazyDurationNs = std::numeric_limits<qint64>::max();
+        auto eagerDurationNs = std::numeric_limits<qint64>::max();
+
+        for (int i = 0; i < runsCount; ++i) {
+            lazyDurationNs = std::min(lazyDurationNs, openLibrary(false));
+            eagerDurationNs = std::min(eagerDurationNs, openLibrary(true));
+        }
+
+        QCOMPARE(albumsCount, expectedAlbumsCount);
+
+        qInfo() << "first albums after" << lazyDurationNs / 1000 << "us with the statements prepared on first use,"
+                << eagerDurationNs / 1000 << "us with all of them prepared at startup";
+
+        QBENCHMARK {
+            openLibrary(false);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(DatabaseInterfaceBenchmark)
+
+
+#include "databaseinterfacebenchmark.moc"
@@ -7,6 +7,8 @@
 #include "databasetestdata.h"
 
 #include "databaseinterface.h"
+#include "databasestatistics.h"
+#include "librarysnapshot.h"
 #include "datatypes.h"
 
 #include "config-upnp-qt.h"
@@ -15,8 +17,11 @@
 #include <QUrl>
 #include <QString>
 #include <QHash>
+#include <QSet>
 #include <QList>
 #include <QThread>
+#include <QSemaphore>
+#include <QScopeGuard>
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
@@ -24,6 +29,7 @@
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QTemporaryFile>
+#include <QJsonArray>
 
 #include <QDebug>
 
@@ -31,6 +37,7 @@
 #include <QSignalSpy>
 
 #include <algorithm>
+#include <atomic>
 
 using namespace Qt::Literals::StringLiterals;
 
@@ -2180,6 +2187,95 @@ private Q_SLOTS:
         QCOMPARE(removedTrackId, qulonglong(0));
     }
 
+    void removeTracksFromSeveralAlbums()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(u"testDb"_s);
+
+        QSignalSpy musicDbArtistRemovedSpy(&musicDb, &DatabaseInterface::artistRemoved);
+        QSignalSpy musicDbAlbumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
+        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy musicDbAlbumModifiedSpy(&musicDb, &DatabaseInterface::albumModified);
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        auto artistsIds = QSet<qulonglong>{};
+        for (const auto &oneArtist : musicDb.allArtistsData()) {
+            artistsIds.insert(oneArtist.databaseId());
+        }
+
+        auto albumsIds = QSet<qulonglong>{};
+        for (const auto &oneAlbum : musicDb.allAlbumsData()) {
+            albumsIds.insert(oneAlbum.databaseId());
+        }
+
+        // all tracks of album1 and album4, one track of album2 and an unknown file
+        const auto removedFiles = QList<QUrl>{
+            QUrl::fromLocalFile(u"/$1"_s), QUrl::fromLocalFile(u"/$2"_s), QUrl::fromLocalFile(u"/$3"_s),
+            QUrl::fromLocalFile(u"/$4"_s), QUrl::fromLocalFile(u"/$4Bis"_s),
+            QUrl::fromLocalFile(u"/$14"_s), QUrl::fromLocalFile(u"/$15"_s), QUrl::fromLocalFile(u"/$16"_s),
+            QUrl::fromLocalFile(u"/$17"_s), QUrl::fromLocalFile(u"/$18"_s),
+            QUrl::fromLocalFile(u"/$5"_s),
+            QUrl::fromLocalFile(u"/unknownFile"_s),
+        };
+
+        auto removedTracksIds = QSet<qulonglong>{};
+        for (const auto &oneFile : removedFiles) {
+            const auto trackId = musicDb.trackIdFromFileName(oneFile);
+            if (trackId != 0) {
+                removedTracksIds.insert(trackId);
+            }
+        }
+
+        QCOMPARE(removedTracksIds.size(), 11);
+
+        const auto album1Id = musicDb.albumIdFromTitleAndArtist(u"album1"_s, u"Various Artists"_s, u"/"_s);
+        const auto album2Id = musicDb.albumIdFromTitleAndArtist(u"album2"_s, u"artist1"_s, u"/"_s);
+        const auto album4Id = musicDb.albumIdFromTitleAndArtist(u"album4"_s, u"artist2"_s, u"/"_s);
+
+        musicDb.removeTracksList(removedFiles);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+
+        auto notifiedTracksIds = QSet<qulonglong>{};
+        for (const auto &oneSignal : std::as_const(musicDbTrackRemovedSpy)) {
+            notifiedTracksIds.insert(oneSignal.at(0).toULongLong());
+        }
+        QCOMPARE(musicDbTrackRemovedSpy.count(), removedTracksIds.size());
+        QCOMPARE(notifiedTracksIds, removedTracksIds);
+
+        auto notifiedAlbumsIds = QSet<qulonglong>{};
+        for (const auto &oneSignal : std::as_const(musicDbAlbumRemovedSpy)) {
+            notifiedAlbumsIds.insert(oneSignal.at(0).toULongLong());
+        }
+        QCOMPARE(notifiedAlbumsIds, (QSet<qulonglong>{album1Id, album4Id}));
+
+        auto remainingAlbumsIds = QSet<qulonglong>{};
+        for (const auto &oneAlbum : musicDb.allAlbumsData()) {
+            remainingAlbumsIds.insert(oneAlbum.databaseId());
+        }
+        QCOMPARE(remainingAlbumsIds, albumsIds - notifiedAlbumsIds);
+
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumModifiedSpy.at(0).at(1).toULongLong(), album2Id);
+
+        auto notifiedArtistsIds = QSet<qulonglong>{};
+        for (const auto &oneSignal : std::as_const(musicDbArtistRemovedSpy)) {
+            notifiedArtistsIds.insert(oneSignal.at(0).toULongLong());
+        }
+        QVERIFY(!notifiedArtistsIds.isEmpty());
+
+        auto remainingArtistsIds = QSet<qulonglong>{};
+        for (const auto &oneArtist : musicDb.allArtistsData()) {
+            remainingArtistsIds.insert(oneArtist.databaseId());
+        }
+        QCOMPARE(remainingArtistsIds, artistsIds - notifiedArtistsIds);
+
+        QVERIFY(musicDb.tracksDataFromAuthor(u"artist3"_s).isEmpty());
+        QCOMPARE(musicDb.albumData(album2Id).size(), 5);
+    }
+
     void removeOneTrackAndModifyIt()
     {
         QTemporaryFile databaseFile;
@@ -5754,6 +5850,847 @@ private Q_SLOTS:
 
         databaseFile.remove();
     }
+
+    void readWhileImportingTracks()
+    {
+        constexpr int batchesCount = 20;
+        constexpr int tracksPerAlbum = 10;
+        constexpr int batchSize = 10 * tracksPerAlbum;
+
+        QTemporaryFile databaseFile;
+        databaseFile.open();
+
+        QThread writerThread;
+        DatabaseInterface writerDb;
+
+        QSignalSpy writerDbInitDoneSpy(&writerDb, &DatabaseInterface::requestsInitDone);
+
+        auto insertedBatchesCount = std::atomic<int>{0};
+        connect(&writerDb, &DatabaseInterface::finishInsertingTracksList,
+                &writerDb, [&insertedBatchesCount]() { ++insertedBatchesCount; }, Qt::DirectConnection);
+
+        writerDb.moveToThread(&writerThread);
+        writerThread.start();
+
+        QMetaObject::invokeMethod(&writerDb, "init", Qt::QueuedConnection,
+                                  Q_ARG(QString, u"testDb"_s), Q_ARG(QString, databaseFile.fileName()));
+
+        QVERIFY(writerDbInitDoneSpy.wait());
+
+        DatabaseInterface readerDb;
+        readerDb.initReadOnly(u"testDbReader"_s, databaseFile.fileName());
+
+        QCOMPARE(readerDb.journalMode(), u"wal"_s);
+        QCOMPARE(readerDb.allTracksData().size(), 0);
+
+        // the writer waits for one read before each batch: the reads and the commits are interleaved
+        QSemaphore allowedBatches;
+
+        auto stopWriter = qScopeGuard([&]() {
+            allowedBatches.release(batchesCount);
+            writerThread.quit();
+            writerThread.wait();
+        });
+
+        for (int batchIndex = 0; batchIndex < batchesCount; ++batchIndex) {
+            auto newTracks = DataTypes::ListTrackDataType{};
+
+            for (int trackIndex = 0; trackIndex < batchSize; ++trackIndex) {
+                const auto trackNumber = batchIndex * batchSize + trackIndex;
+
+                auto newTrack = mNewTracks[0];
+                newTrack[DataTypes::TitleRole] = u"track%1"_s.arg(trackNumber);
+                newTrack[DataTypes::AlbumRole] = u"album%1"_s.arg(trackNumber / tracksPerAlbum);
+                newTrack[DataTypes::AlbumArtistRole] = u"artist%1"_s.arg(trackNumber / tracksPerAlbum);
+                newTrack[DataTypes::ArtistRole] = u"artist%1"_s.arg(trackNumber / tracksPerAlbum);
+                newTrack[DataTypes::TrackNumberRole] = trackIndex % tracksPerAlbum + 1;
+                newTrack[DataTypes::ResourceRole] = QUrl::fromLocalFile(u"/import/track%1.ogg"_s.arg(trackNumber));
+                newTrack[DataTypes::ImageUrlRole] = QUrl{};
+
+                newTracks.push_back(newTrack);
+            }
+
+            QMetaObject::invokeMethod(&writerDb, [&writerDb, &allowedBatches, newTracks]() {
+                allowedBatches.acquire();
+                writerDb.insertTracksList(newTracks, {});
+            }, Qt::QueuedConnection);
+        }
+
+        auto readsDuringImportCount = 0;
+        auto previousTracksCount = qsizetype{0};
+
+        for (int batchIndex = 0; batchIndex < batchesCount; ++batchIndex) {
+            const auto allAlbums = readerDb.allAlbumsData();
+            const auto allTracks = readerDb.allTracksData();
+
+            // the last batch is only inserted once this read is done
+            if (insertedBatchesCount < batchesCount) {
+                ++readsDuringImportCount;
+            }
+
+            // each batch is committed at once: a reader never sees part of a batch
+            QCOMPARE(allTracks.size() % batchSize, 0);
+            QVERIFY(allTracks.size() >= previousTracksCount);
+            QVERIFY(allTracks.size() <= batchIndex * batchSize);
+            QVERIFY(allTracks.size() >= allAlbums.size() * tracksPerAlbum);
+
+            previousTracksCount = allTracks.size();
+
+            allowedBatches.release();
+        }
+
+        QTRY_COMPARE_WITH_TIMEOUT(insertedBatchesCount.load(), batchesCount, 60000);
+
+        QCOMPARE(readsDuringImportCount, batchesCount);
+
+        QCOMPARE(readerDb.allTracksData().size(), batchesCount * batchSize);
+        QCOMPARE(readerDb.allAlbumsData().size(), batchesCount * batchSize / tracksPerAlbum);
+    }
+
+    void tracksInsertedByAnotherWriter()
+    {
+        QTemporaryFile databaseFile;
+        databaseFile.open();
+
+        DatabaseInterface musicDb;
+        musicDb.init(u"testDb"_s, databaseFile.fileName());
+
+        // stands for elisaImport running in another process
+        DatabaseInterface importDb;
+        importDb.init(u"testDbImport"_s, databaseFile.fileName());
+
+        QSignalSpy musicDbArtistsAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
+        QSignalSpy musicDbAlbumsAddedSpy(&musicDb, &DatabaseInterface::albumsAdded);
+        QSignalSpy musicDbTracksAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.checkExternalChanges();
+
+        QCOMPARE(musicDbTracksAddedSpy.count(), 0);
+
+        importDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDb.checkExternalChanges();
+
+        QCOMPARE(musicDbArtistsAddedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumsAddedSpy.count(), 1);
+        QCOMPARE(musicDbTracksAddedSpy.count(), 1);
+        QCOMPARE(musicDbArtistsAddedSpy.at(0).at(0).value<DataTypes::ListArtistDataType>().size(), importDb.allArtistsData().size());
+        QCOMPARE(musicDbAlbumsAddedSpy.at(0).at(0).value<DataTypes::ListAlbumDataType>().size(), importDb.allAlbumsData().size());
+        QCOMPARE(musicDbTracksAddedSpy.at(0).at(0).value<DataTypes::ListTrackDataType>().size(), importDb.allTracksData().size());
+
+        musicDb.checkExternalChanges();
+
+        QCOMPARE(musicDbTracksAddedSpy.count(), 1);
+
+        // the identifiers allocated by the other writer are not reused
+        const auto importedTracksCount = importDb.allTracksData().size();
+
+        auto newTrack = mNewTracks[0];
+        newTrack[DataTypes::TitleRole] = u"track from Elisa"_s;
+        newTrack[DataTypes::ResourceRole] = QUrl::fromLocalFile(u"/trackFromElisa.ogg"_s);
+
+        musicDb.insertTracksList({newTrack}, mNewCovers);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+        QCOMPARE(musicDbTracksAddedSpy.count(), 2);
+        QCOMPARE(musicDb.allTracksData().size(), importedTracksCount + 1);
+
+        newTrack[DataTypes::TitleRole] = u"track from import"_s;
+        newTrack[DataTypes::ResourceRole] = QUrl::fromLocalFile(u"/trackFromImport.ogg"_s);
+
+        musicDb.setExternalChangesPollInterval(10);
+
+        importDb.insertTracksList({newTrack}, mNewCovers);
+
+        QVERIFY(musicDbTracksAddedSpy.wait());
+        QCOMPARE(musicDbTracksAddedSpy.count(), 3);
+        QCOMPARE(musicDbTracksAddedSpy.at(2).at(0).value<DataTypes::ListTrackDataType>().size(), 1);
+        QCOMPARE(musicDbTracksAddedSpy.at(2).at(0).value<DataTypes::ListTrackDataType>().at(0).title(), u"track from import"_s);
+        QCOMPARE(musicDb.allTracksData().size(), importedTracksCount + 2);
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void notifiedDataMatchesSingleQueries()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(u"testDb"_s);
+
+        QSignalSpy musicDbArtistsAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
+        QSignalSpy musicDbAlbumsAddedSpy(&musicDb, &DatabaseInterface::albumsAdded);
+        QSignalSpy musicDbTracksAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+        QCOMPARE(musicDbArtistsAddedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumsAddedSpy.count(), 1);
+        QCOMPARE(musicDbTracksAddedSpy.count(), 1);
+
+        const auto newArtists = musicDbArtistsAddedSpy.at(0).at(0).value<DataTypes::ListArtistDataType>();
+        QCOMPARE(newArtists.size(), musicDb.allArtistsData().size());
+        for (const auto &oneArtist : newArtists) {
+            QCOMPARE(oneArtist, musicDb.artistDataFromDatabaseId(oneArtist.databaseId()));
+        }
+
+        const auto newAlbums = musicDbAlbumsAddedSpy.at(0).at(0).value<DataTypes::ListAlbumDataType>();
+        QCOMPARE(newAlbums.size(), musicDb.allAlbumsData().size());
+        for (const auto &oneAlbum : newAlbums) {
+            QCOMPARE(oneAlbum, musicDb.albumDataFromDatabaseId(oneAlbum.databaseId()));
+        }
+
+        const auto newTracks = musicDbTracksAddedSpy.at(0).at(0).value<DataTypes::ListTrackDataType>();
+        QCOMPARE(newTracks.size(), mNewTracks.size());
+        for (const auto &oneTrack : newTracks) {
+            QCOMPARE(oneTrack, musicDb.trackDataFromDatabaseId(oneTrack.databaseId()));
+        }
+
+        auto modifiedTracks = DataTypes::ListTrackDataType{};
+        for (const auto &oneTrack : std::as_const(mNewTracks)) {
+            auto modifiedTrack = oneTrack;
+            modifiedTrack[DataTypes::CommentRole] = u"modified comment"_s;
+            modifiedTracks.push_back(modifiedTrack);
+        }
+
+        musicDb.insertTracksList(modifiedTracks, mNewCovers);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+        QCOMPARE(musicDbTracksAddedSpy.count(), 1);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), mNewTracks.size());
+        for (const auto &oneSignal : std::as_const(musicDbTrackModifiedSpy)) {
+            const auto modifiedTrack = oneSignal.at(0).value<DataTypes::TrackDataType>();
+
+            QCOMPARE(modifiedTrack.comment(), u"modified comment"_s);
+            QCOMPARE(modifiedTrack, musicDb.trackDataFromDatabaseId(modifiedTrack.databaseId()));
+        }
+    }
+
+    void librarySearchFollowsChanges()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(u"testDb"_s);
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto firstTrack = DataTypes::TrackDataType {true, u"$1"_s, u"0"_s, u"Éléphant blanc"_s,
+                u"Zoé"_s, u"Mémo"_s, u"Zoé"_s,
+                1, 1, QTime::fromMSecsSinceStartOfDay(1), {QUrl::fromLocalFile(u"/$1"_s)}, QDateTime::fromMSecsSinceEpoch(1),
+                {}, 1, true, u"Électro"_s, u"composer1"_s, u"lyricist1"_s, false};
+        auto secondTrack = DataTypes::TrackDataType {true, u"$2"_s, u"0"_s, u"Elephant gun"_s,
+                u"Beirut"_s, u"Lon Gisland"_s, u"Beirut"_s,
+                1, 1, QTime::fromMSecsSinceStartOfDay(2), {QUrl::fromLocalFile(u"/$2"_s)}, QDateTime::fromMSecsSinceEpoch(2),
+                {}, 1, true, u"genre1"_s, u"composer1"_s, u"lyricist1"_s, false};
+
+        musicDb.insertTracksList({firstTrack, secondTrack}, mNewCovers);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+
+        QCOMPARE(musicDb.librarySearch(u"elep"_s, 10).size(), 2);
+
+        const auto artistResults = musicDb.librarySearch(u"ZOE"_s, 10);
+        QCOMPARE(artistResults.size(), 3);
+        QCOMPARE(artistResults.at(0).elementType(), ElisaUtils::Artist);
+        QCOMPARE(artistResults.at(0)[DataTypes::TitleRole].toString(), u"Zoé"_s);
+        QCOMPARE(artistResults.at(0).databaseId(), musicDb.artistIdFromName(u"Zoé"_s));
+
+        const auto trackResults = musicDb.librarySearch(u"elep zoe"_s, 10);
+        QCOMPARE(trackResults.size(), 1);
+        QCOMPARE(trackResults.at(0).elementType(), ElisaUtils::Track);
+        QCOMPARE(trackResults.at(0).databaseId(), musicDb.trackIdFromFileName(QUrl::fromLocalFile(u"/$1"_s)));
+        QCOMPARE(trackResults.at(0)[DataTypes::AlbumRole].toString(), u"Mémo"_s);
+
+        QCOMPARE(musicDb.librarySearch(u"elep"_s, 1, 1).size(), 1);
+        QCOMPARE(musicDb.librarySearch(u"\" -"_s, 10).size(), 0);
+
+        auto modifiedTrack = secondTrack;
+        modifiedTrack[DataTypes::TitleRole] = u"Nantes"_s;
+        musicDb.insertTracksList({modifiedTrack}, mNewCovers);
+
+        QCOMPARE(musicDb.librarySearch(u"nant"_s, 10).size(), 1);
+        QCOMPARE(musicDb.librarySearch(u"elep"_s, 10).size(), 1);
+
+        musicDb.removeTracksList({firstTrack.resourceURI()});
+
+        QCOMPARE(musicDb.librarySearch(u"zoe"_s, 10).size(), 0);
+        QCOMPARE(musicDb.librarySearch(u"elep"_s, 10).size(), 0);
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void tracksDataPageFollowsSortOrder()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(u"testDb"_s);
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+
+        const auto allTracksCount = musicDb.allTracksData().size();
+
+        for (const auto sortRole : {DataTypes::TitleRole, DataTypes::YearRole}) {
+            for (const auto sortOrder : {Qt::AscendingOrder, Qt::DescendingOrder}) {
+                auto pagedTracks = DataTypes::ListTrackDataType{};
+                auto afterSortValue = QVariant{};
+                auto afterDatabaseId = qulonglong{0};
+
+                while (true) {
+                    const auto onePage = musicDb.tracksDataPage(sortRole, sortOrder, afterSortValue, afterDatabaseId, 3);
+                    QVERIFY(onePage.size() <= 3);
+
+                    pagedTracks.append(onePage);
+
+                    if (onePage.size() < 3) {
+                        break;
+                    }
+
+                    afterSortValue = DatabaseInterface::trackSortValue(onePage.constLast(), sortRole);
+                    afterDatabaseId = onePage.constLast().databaseId();
+                }
+
+                QCOMPARE(pagedTracks.size(), allTracksCount);
+
+                auto pagedIds = QSet<qulonglong>{};
+                for (int trackIndex = 0; trackIndex < pagedTracks.size(); ++trackIndex) {
+                    pagedIds.insert(pagedTracks[trackIndex].databaseId());
+
+                    if (trackIndex == 0) {
+                        continue;
+                    }
+
+                    const auto previousValue = DatabaseInterface::trackSortValue(pagedTracks[trackIndex - 1], sortRole);
+                    const auto currentValue = DatabaseInterface::trackSortValue(pagedTracks[trackIndex], sortRole);
+                    const auto comparison = sortRole == DataTypes::YearRole ?
+                                (previousValue.toInt() > currentValue.toInt()) - (previousValue.toInt() < currentValue.toInt()) :
+                                QString::compare(previousValue.toString(), currentValue.toString(), Qt::CaseInsensitive);
+
+                    QVERIFY(sortOrder == Qt::AscendingOrder ? comparison <= 0 : comparison >= 0);
+                }
+
+                QCOMPARE(pagedIds.size(), allTracksCount);
+            }
+        }
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void albumsAndArtistsSummariesFollowChanges()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(u"testDb"_s);
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto firstTrack = DataTypes::TrackDataType {true, u"$1"_s, u"0"_s, u"track1"_s,
+                u"artist1"_s, u"album1"_s, u"artist1"_s,
+                1, 1, QTime::fromMSecsSinceStartOfDay(1), {QUrl::fromLocalFile(u"/album1/$1"_s)}, QDateTime::fromMSecsSinceEpoch(1),
+                {}, 3, true, u"genre1"_s, u"composer1"_s, u"lyricist1"_s, false};
+        auto secondTrack = DataTypes::TrackDataType {true, u"$2"_s, u"0"_s, u"track2"_s,
+                u"artist2"_s, u"album1"_s, u"artist1"_s,
+                2, 2, QTime::fromMSecsSinceStartOfDay(2), {QUrl::fromLocalFile(u"/album1/$2"_s)}, QDateTime::fromMSecsSinceEpoch(2),
+                {}, 5, false, u"genre2"_s, u"composer1"_s, u"lyricist1"_s, false};
+
+        musicDb.insertTracksList({firstTrack, secondTrack}, mNewCovers);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+
+        auto allAlbums = musicDb.allAlbumsData();
+        QCOMPARE(allAlbums.size(), 1);
+        QCOMPARE(allAlbums.at(0)[DataTypes::HighestTrackRating].toInt(), 5);
+        QCOMPARE(allAlbums.at(0)[DataTypes::IsSingleDiscAlbumRole].toBool(), false);
+        QCOMPARE(allAlbums.at(0)[DataTypes::AllArtistsRole].toStringList().size(), 2);
+        QCOMPARE(musicDb.allAlbumsDataByArtist(u"artist2"_s).size(), 1);
+
+        auto modifiedTrack = secondTrack;
+        modifiedTrack[DataTypes::RatingRole] = 1;
+        musicDb.insertTracksList({modifiedTrack}, mNewCovers);
+
+        allAlbums = musicDb.allAlbumsData();
+        QCOMPARE(allAlbums.size(), 1);
+        QCOMPARE(allAlbums.at(0)[DataTypes::HighestTrackRating].toInt(), 3);
+
+        musicDb.removeTracksList({secondTrack.resourceURI()});
+
+        allAlbums = musicDb.allAlbumsData();
+        QCOMPARE(allAlbums.size(), 1);
+        QCOMPARE(allAlbums.at(0)[DataTypes::IsSingleDiscAlbumRole].toBool(), true);
+        QCOMPARE(allAlbums.at(0)[DataTypes::AllArtistsRole].toStringList(), QStringList{u"artist1"_s});
+        QCOMPARE(musicDb.allAlbumsDataByArtist(u"artist2"_s).size(), 0);
+
+        const auto allArtists = musicDb.allArtistsData();
+        QCOMPARE(allArtists.size(), 1);
+        QCOMPARE(allArtists.at(0)[DataTypes::TitleRole].toString(), u"artist1"_s);
+        QCOMPARE(allArtists.at(0)[DataTypes::GenreRole].toStringList(), QStringList{u"genre1"_s});
+
+        musicDb.removeTracksList({firstTrack.resourceURI()});
+
+        QCOMPARE(musicDb.allAlbumsData().size(), 0);
+        QCOMPARE(musicDb.allArtistsData().size(), 0);
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void pendingWritesAreMergedAndReadBack()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(u"testDb"_s);
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+        QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
+        QSignalSpy musicDbFinishInsertingSpy(&musicDb, &DatabaseInterface::finishInsertingTracksList);
+
+        auto firstTrack = DataTypes::TrackDataType {true, u"$1"_s, u"0"_s, u"track1"_s,
+                u"artist1"_s, u"album1"_s, u"artist1"_s,
+                1, 1, QTime::fromMSecsSinceStartOfDay(1), {QUrl::fromLocalFile(u"/album1/$1"_s)}, QDateTime::fromMSecsSinceEpoch(1),
+                {}, 3, true, u"genre1"_s, u"composer1"_s, u"lyricist1"_s, false};
+        auto secondTrack = DataTypes::TrackDataType {true, u"$2"_s, u"0"_s, u"track2"_s,
+                u"artist1"_s, u"album1"_s, u"artist1"_s,
+                2, 1, QTime::fromMSecsSinceStartOfDay(2), {QUrl::fromLocalFile(u"/album1/$2"_s)}, QDateTime::fromMSecsSinceEpoch(2),
+                {}, 5, true, u"genre1"_s, u"composer1"_s, u"lyricist1"_s, false};
+
+        musicDb.insertTracksList({firstTrack, secondTrack}, mNewCovers);
+
+        QCOMPARE(musicDbFinishInsertingSpy.count(), 1);
+
+        musicDb.trackHasStartedPlaying(firstTrack.resourceURI(), QDateTime::fromSecsSinceEpoch(5));
+        musicDb.trackHasStartedPlaying(secondTrack.resourceURI(), QDateTime::fromSecsSinceEpoch(10));
+        musicDb.trackHasStartedPlaying(firstTrack.resourceURI(), QDateTime::fromSecsSinceEpoch(20));
+        musicDb.trackHasFinishedPlaying(firstTrack.resourceURI(), QDateTime::fromSecsSinceEpoch(6));
+        musicDb.trackHasFinishedPlaying(firstTrack.resourceURI(), QDateTime::fromSecsSinceEpoch(21));
+        musicDb.trackHasFinishedPlaying(firstTrack.resourceURI(), QDateTime::fromSecsSinceEpoch(30));
+        musicDb.trackHasFinishedPlaying(secondTrack.resourceURI(), QDateTime::fromSecsSinceEpoch(11));
+
+        auto modifiedTrack = secondTrack;
+        modifiedTrack[DataTypes::RatingRole] = 1;
+        musicDb.saveModifiedTracks({modifiedTrack}, mNewCovers);
+        modifiedTrack[DataTypes::RatingRole] = 4;
+        musicDb.saveModifiedTracks({modifiedTrack}, mNewCovers);
+
+        QCOMPARE(musicDbFinishInsertingSpy.count(), 1);
+
+        const auto recentlyPlayedTracks = musicDb.recentlyPlayedTracksData(2);
+        QCOMPARE(recentlyPlayedTracks.size(), 2);
+        QCOMPARE(recentlyPlayedTracks.at(0).resourceURI(), firstTrack.resourceURI());
+        QCOMPARE(recentlyPlayedTracks.at(1).resourceURI(), secondTrack.resourceURI());
+
+        QCOMPARE(musicDbFinishInsertingSpy.count(), 3);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
+
+        const auto firstTrackData = musicDb.trackDataFromDatabaseId(musicDb.trackIdFromFileName(firstTrack.resourceURI()));
+        QCOMPARE(firstTrackData[DataTypes::PlayCounter].toInt(), 3);
+
+        const auto secondTrackData = musicDb.trackDataFromDatabaseId(musicDb.trackIdFromFileName(secondTrack.resourceURI()));
+        QCOMPARE(secondTrackData[DataTypes::PlayCounter].toInt(), 1);
+        QCOMPARE(secondTrackData[DataTypes::RatingRole].toInt(), 4);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void statementProfilingRecordsExecutionsAndPlans()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(u"testDb"_s);
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        QVERIFY(!musicDb.statementStatistics());
+
+        musicDb.setStatementProfiling(true);
+
+        const auto statistics = musicDb.statementStatistics();
+        QVERIFY(statistics);
+
+        auto firstTrack = DataTypes::TrackDataType {true, u"$1"_s, u"0"_s, u"track1"_s,
+                u"artist1"_s, u"album1"_s, u"artist1"_s,
+                1, 1, QTime::fromMSecsSinceStartOfDay(1), {QUrl::fromLocalFile(u"/album1/$1"_s)}, QDateTime::fromMSecsSinceEpoch(1),
+                {}, 3, true, u"genre1"_s, u"composer1"_s, u"lyricist1"_s, false};
+        auto secondTrack = DataTypes::TrackDataType {true, u"$2"_s, u"0"_s, u"track2"_s,
+                u"artist1"_s, u"album1"_s, u"artist1"_s,
+                2, 1, QTime::fromMSecsSinceStartOfDay(2), {QUrl::fromLocalFile(u"/album1/$2"_s)}, QDateTime::fromMSecsSinceEpoch(2),
+                {}, 5, true, u"genre1"_s, u"composer1"_s, u"lyricist1"_s, false};
+
+        musicDb.insertTracksList({firstTrack, secondTrack}, mNewCovers);
+
+        QCOMPARE(musicDb.allTracksData().size(), 2);
+        QCOMPARE(musicDb.allTracksData().size(), 2);
+
+        const auto insertTrack = statistics->statement(u"InsertTrackQuery"_s);
+        QCOMPARE(insertTrack.mExecutionsCount, 2);
+        QCOMPARE(insertTrack.mRowsCount, 2);
+        QCOMPARE(insertTrack.mInTransactionNs, insertTrack.mTotalNs);
+
+        const auto selectAllTracks = statistics->statement(u"SelectAllTracksQuery"_s);
+        QCOMPARE(selectAllTracks.mExecutionsCount, 2);
+        QCOMPARE(selectAllTracks.mRowsCount, 4);
+        QVERIFY(selectAllTracks.mP50Ns <= selectAllTracks.mMaximumNs);
+        QVERIFY(!selectAllTracks.mQueryPlan.isEmpty());
+
+        QVERIFY(DatabaseStatistics::isFullScan(u"SCAN Tracks"_s));
+        QVERIFY(DatabaseStatistics::isFullScan(u"SCAN TABLE Tracks"_s));
+        QVERIFY(!DatabaseStatistics::isFullScan(u"SCAN tracks USING INDEX TracksTitleSortIndex"_s));
+        QVERIFY(!DatabaseStatistics::isFullScan(u"SEARCH Tracks USING INTEGER PRIMARY KEY (rowid=?)"_s));
+
+        const auto allStatements = statistics->statements();
+        QVERIFY(allStatements.size() > 2);
+        QVERIFY(allStatements.constFirst().mTotalNs >= allStatements.constLast().mTotalNs);
+
+        QVERIFY(statistics->toJson().value(u"statements"_s).toArray().size() == allStatements.size());
+
+        musicDb.setStatementProfiling(false);
+        QVERIFY(!musicDb.statementStatistics());
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void statementsArePreparedOnFirstUseAndInBackground()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(u"testDb"_s);
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto newTrack = DataTypes::TrackDataType {true, u"$1"_s, u"0"_s, u"track1"_s,
+                u"artist1"_s, u"album1"_s, u"artist1"_s,
+                1, 1, QTime::fromMSecsSinceStartOfDay(1), {QUrl::fromLocalFile(u"/album1/$1"_s)}, QDateTime::fromMSecsSinceEpoch(1),
+                {}, 3, true, u"genre1"_s, u"composer1"_s, u"lyricist1"_s, false};
+
+        // statements outside of the warm-up list are prepared before their first bound value
+        musicDb.insertTracksList({newTrack}, mNewCovers);
+
+        const auto trackId = musicDb.trackIdFromFileName(newTrack.resourceURI());
+        QVERIFY(trackId != 0);
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId).title(), u"track1"_s);
+        QCOMPARE(musicDb.allAlbumsData().size(), 1);
+
+        QVERIFY(musicDb.prepareAllStatements());
+
+        QCOMPARE(musicDb.trackIdFromFileName(newTrack.resourceURI()), trackId);
+        QCOMPARE(musicDb.allTracksData().size(), 1);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void maintenanceKeepsTheRemainingData()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(u"testDb"_s);
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto newTracks = DataTypes::ListTrackDataType{};
+        for (int i = 1; i <= 200; ++i) {
+            newTracks.push_back({true, u"$%1"_s.arg(i), u"0"_s, u"track%1"_s.arg(i),
+                                 u"artist%1"_s.arg(i % 10), u"album%1"_s.arg(i % 20), u"artist%1"_s.arg(i % 10),
+                                 i, 1, QTime::fromMSecsSinceStartOfDay(i), {QUrl::fromLocalFile(u"/album%1/$%2"_s.arg(i % 20).arg(i))},
+                                 QDateTime::fromMSecsSinceEpoch(i), {}, 0, true, u"genre1"_s, u"composer1"_s, u"lyricist1"_s, false});
+        }
+
+        musicDb.insertTracksList(newTracks, mNewCovers);
+
+        auto removedTracks = QList<QUrl>{};
+        for (int i = 1; i <= 190; ++i) {
+            removedTracks.push_back(newTracks[i - 1].resourceURI());
+        }
+
+        musicDb.removeTracksList(removedTracks);
+
+        // statistics of the planner, incremental vacuum of the removed tracks and integrity check
+        musicDb.runMaintenance();
+
+        QCOMPARE(musicDb.allTracksData().size(), 10);
+        QCOMPARE(musicDb.allAlbumsData().size(), 10);
+        QCOMPARE(musicDb.trackDataFromDatabaseId(musicDb.trackIdFromFileName(newTracks.constLast().resourceURI())).title(), u"track200"_s);
+
+        musicDb.runMaintenance();
+
+        QCOMPARE(musicDb.allTracksData().size(), 10);
+
+        // the full-text index is left to SQLite
+        QCOMPARE(musicDb.librarySearch(u"track200"_s, 10).size(), 1);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void librarySnapshotGivesTheAlbumsAndArtistsOnce()
+    {
+        QTemporaryFile snapshotFile;
+        QVERIFY(snapshotFile.open());
+        snapshotFile.close();
+
+        DatabaseInterface musicDb;
+        musicDb.init(u"testDb"_s);
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.setLibrarySnapshotFileName(snapshotFile.fileName());
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        // the maintenance ends by writing the snapshot
+        musicDb.runMaintenance();
+
+        const auto allAlbums = musicDb.allAlbumsData();
+        const auto allArtists = musicDb.allArtistsData();
+
+        LibrarySnapshot snapshot;
+        QVERIFY(snapshot.open(snapshotFile.fileName()));
+
+        const auto snapshotAlbums = snapshot.takeAlbums();
+        QCOMPARE(snapshotAlbums.size(), allAlbums.size());
+        for (int i = 0; i < allAlbums.size(); ++i) {
+            QCOMPARE(snapshotAlbums[i].databaseId(), allAlbums[i].databaseId());
+            QCOMPARE(snapshotAlbums[i].title(), allAlbums[i].title());
+            QCOMPARE(snapshotAlbums[i].albumArtURI(), allAlbums[i].albumArtURI());
+        }
+
+        QVERIFY(snapshot.isOpen());
+        QVERIFY(snapshot.takeAlbums().isEmpty());
+
+        const auto snapshotArtists = snapshot.takeArtists();
+        QCOMPARE(snapshotArtists.size(), allArtists.size());
+        QCOMPARE(snapshotArtists.constFirst().name(), allArtists.constFirst().name());
+
+        QVERIFY(!snapshot.isOpen());
+        QVERIFY(snapshot.takeArtists().isEmpty());
+
+        // the values written with another version of the stream cannot be read
+        {
+            QFile versionedFile(snapshotFile.fileName());
+            QVERIFY(versionedFile.open(QIODevice::ReadWrite));
+            QVERIFY(versionedFile.seek(2 * sizeof(quint32)));
+
+            QDataStream versionStream(&versionedFile);
+            versionStream << static_cast<qint32>(QDataStream::Qt_5_15);
+            versionedFile.close();
+
+            LibrarySnapshot versionedSnapshot;
+            QVERIFY(!versionedSnapshot.open(snapshotFile.fileName()));
+            QVERIFY(versionedSnapshot.takeAlbums().isEmpty());
+        }
+
+        QFile truncatedFile(snapshotFile.fileName());
+        QVERIFY(truncatedFile.open(QIODevice::WriteOnly));
+        truncatedFile.write("ELSS");
+        truncatedFile.close();
+
+        LibrarySnapshot truncatedSnapshot;
+        QVERIFY(!truncatedSnapshot.open(snapshotFile.fileName()));
+        QVERIFY(truncatedSnapshot.takeAlbums().isEmpty());
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void reopeningTheDatabaseKeepsItsData()
+    {
+        const auto dbName = u"testDb"_s;
+
+        QTemporaryFile databaseFile;
+        databaseFile.open();
+
+        auto tracksCount = qsizetype{};
+        auto albumsCount = qsizetype{};
+        auto searchResultsCount = qsizetype{};
+
+        {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            musicDb.init(dbName, databaseFile.fileName());
+
+            musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+            tracksCount = musicDb.allTracksData().count();
+            albumsCount = musicDb.allAlbumsData().count();
+            searchResultsCount = musicDb.librarySearch(u"artist2"_s, 1000).count();
+
+            QVERIFY(searchResultsCount > 0);
+            QCOMPARE(musicDbErrorSpy.count(), 0);
+        }
+
+        const auto checkReopenedDatabase = [&]() {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            musicDb.init(dbName, databaseFile.fileName());
+
+            QCOMPARE(musicDbErrorSpy.count(), 0);
+            QCOMPARE(musicDb.allTracksData().count(), tracksCount);
+            QCOMPARE(musicDb.allAlbumsData().count(), albumsCount);
+            QCOMPARE(musicDb.librarySearch(u"artist2"_s, 1000).count(), searchResultsCount);
+        };
+
+        // the latest upgrade is run again on the current version
+        checkReopenedDatabase();
+
+        // the upgrades since the search index must not fail nor duplicate anything when they run again
+        {
+            auto database = QSqlDatabase::addDatabase(u"QSQLITE"_s, dbName);
+            database.setDatabaseName(databaseFile.fileName());
+            QVERIFY(database.open());
+
+            auto versionQuery = QSqlQuery(database);
+            QVERIFY(versionQuery.exec(u"UPDATE `DatabaseVersion` SET `Version` = %1"_s.arg(DatabaseInterface::V18)));
+            versionQuery.finish();
+
+            database.close();
+        }
+        QSqlDatabase::removeDatabase(dbName);
+
+        checkReopenedDatabase();
+    }
+
+    void readersShareTheStatisticsOfTheWriter()
+    {
+        QTemporaryFile databaseFile;
+        databaseFile.open();
+
+        DatabaseInterface writerDb;
+        writerDb.init(u"testDb"_s, databaseFile.fileName());
+        writerDb.setStatementProfiling(true);
+
+        QSignalSpy writerDbErrorSpy(&writerDb, &DatabaseInterface::databaseError);
+
+        writerDb.insertTracksList(mNewTracks, mNewCovers);
+
+        DatabaseInterface readerDb;
+        readerDb.initReadOnly(u"testDbReader"_s, databaseFile.fileName());
+
+        QSignalSpy readerDbErrorSpy(&readerDb, &DatabaseInterface::databaseError);
+
+        const auto statistics = writerDb.statementStatistics();
+        QVERIFY(statistics);
+
+        readerDb.setStatementStatistics(statistics);
+        QCOMPARE(readerDb.statementStatistics(), statistics);
+
+        const auto tracksCount = writerDb.allTracksData().size();
+        QCOMPARE(readerDb.allTracksData().size(), tracksCount);
+
+        // the reads of both connections are in the statistics logged by the writer
+        const auto selectAllTracks = statistics->statement(u"SelectAllTracksQuery"_s);
+        QCOMPARE(selectAllTracks.mExecutionsCount, 2);
+        QCOMPARE(selectAllTracks.mRowsCount, 2 * tracksCount);
+
+        readerDb.setStatementStatistics(nullptr);
+        QVERIFY(!readerDb.statementStatistics());
+
+        QCOMPARE(writerDbErrorSpy.count(), 0);
+        QCOMPARE(readerDbErrorSpy.count(), 0);
+    }
+
+    void allStatementsCompile()
+    {
+        QTemporaryFile databaseFile;
+        databaseFile.open();
+
+        DatabaseInterface writerDb;
+        writerDb.init(u"testDb"_s, databaseFile.fileName());
+
+        QSignalSpy writerDbErrorSpy(&writerDb, &DatabaseInterface::databaseError);
+
+        // an error in the text of a statement is only found when it is compiled
+        QVERIFY(writerDb.prepareAllStatements());
+
+        DatabaseInterface readerDb;
+        readerDb.initReadOnly(u"testDbReader"_s, databaseFile.fileName());
+
+        QSignalSpy readerDbErrorSpy(&readerDb, &DatabaseInterface::databaseError);
+
+        QVERIFY(readerDb.prepareAllStatements());
+
+        QCOMPARE(writerDbErrorSpy.count(), 0);
+        QCOMPARE(readerDbErrorSpy.count(), 0);
+    }
+
+    void writesQueuedBeforeInitAreCommitted()
+    {
+        DatabaseInterface musicDb;
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+        QSignalSpy finishInsertingSpy(&musicDb, &DatabaseInterface::finishInsertingTracksList);
+
+        // the player or a loader thread may queue writes before the database thread has opened it
+        musicDb.saveModifiedTracks(mNewTracks, mNewCovers);
+        musicDb.trackHasStartedPlaying(mNewTracks.constFirst().resourceURI(), QDateTime::currentDateTime());
+        musicDb.removeRadio(1);
+
+        musicDb.init(u"testDb"_s);
+
+        QVERIFY(musicDb.trackIdFromFileName(mNewTracks.constFirst().resourceURI()) != 0);
+        QCOMPARE(finishInsertingSpy.count(), 1);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void clearDataEnablesTheIncrementalVacuum()
+    {
+        QTemporaryFile databaseFile;
+        QVERIFY(databaseFile.open());
+
+        const auto dbName = u"testDb"_s;
+
+        const auto autoVacuumMode = [&](const QString &newMode) {
+            auto result = -1;
+
+            {
+                auto database = QSqlDatabase::addDatabase(u"QSQLITE"_s, dbName);
+                database.setDatabaseName(databaseFile.fileName());
+                if (database.open()) {
+                    auto pragmaQuery = QSqlQuery(database);
+
+                    if (!newMode.isEmpty()) {
+                        pragmaQuery.exec(u"PRAGMA auto_vacuum = %1"_s.arg(newMode));
+                        pragmaQuery.exec(u"VACUUM"_s);
+                    }
+
+                    if (pragmaQuery.exec(u"PRAGMA auto_vacuum"_s) && pragmaQuery.next()) {
+                        result = pragmaQuery.value(0).toInt();
+                    }
+                    pragmaQuery.finish();
+
+                    database.close();
+                }
+            }
+            QSqlDatabase::removeDatabase(dbName);
+
+            return result;
+        };
+
+        {
+            DatabaseInterface musicDb;
+            musicDb.init(dbName, databaseFile.fileName());
+        }
+
+        // like the databases created before the incremental vacuum
+        QCOMPARE(autoVacuumMode(u"NONE"_s), 0);
+
+        {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            musicDb.init(dbName, databaseFile.fileName());
+
+            musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+            const auto tracksCount = musicDb.allTracksData().size();
+            QVERIFY(tracksCount > 0);
+
+            musicDb.clearData();
+
+            QVERIFY(musicDb.allTracksData().isEmpty());
+
+            musicDb.insertTracksList(mNewTracks, mNewCovers);
+            QCOMPARE(musicDb.allTracksData().size(), tracksCount);
+
+            QCOMPARE(musicDbErrorSpy.count(), 0);
+        }
+
+        QCOMPARE(autoVacuumMode({}), 2);
+    }
 };
 
 QTEST_GUILESS_MAIN(DatabaseInterfaceTests)
@@ -0,0 +1,516 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "syntheticlibrarydata.h"
+
+#include "databaseinterface.h"
+#include "datatypes.h"
+
+#include <QObject>
+#include <QString>
+#include <QUrl>
+#include <QDir>
+#include <QFile>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QTemporaryFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+#include <QDebug>
+
+#include <QTest>
+#include <QSignalSpy>
+
+#include <map>
+#include <memory>
+
+using namespace Qt::Literals::StringLiterals;
+
+/**
+ * Scaling of DatabaseInterface with synthetic libraries
+ *
+ * The library sizes are read from ELISA_BENCHMARK_LIBRARY_SIZES, for example "10000,100000,500000",
+ * and default to 10000 tracks. The time of each case is written as JSON to the file named by
+ * ELISA_BENCHMARK_JSON or to databaselibrarybenchmark.json in the current directory.
+ */
+class DatabaseLibraryBenchmark: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DatabaseLibraryBenchmark(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    struct LibraryDatabase {
+        explicit LibraryDatabase(int tracksCount) : mData(tracksCount)
+        {
+        }
+
+        SyntheticLibraryData mData;
+
+        QTemporaryFile mDatabaseFile;
+
+        std::unique_ptr<DatabaseInterface> mDatabase;
+    };
+
+    struct Measurement {
+        qint64 mTotalNs = 0;
+
+        int mIterations = 0;
+
+        void add(qint64 durationNs)
+        {
+            mTotalNs += durationNs;
+            ++mIterations;
+        }
+    };
+
+    static constexpr int LookupsCount = 1000;
+
+    static constexpr int AlbumsLookupsCount = 100;
+
+    static constexpr int PlaysCount = 100;
+
+    std::map<int, std::unique_ptr<LibraryDatabase>> mLibraries;
+
+    QJsonArray mResults;
+
+    static QList<int> librarySizes()
+    {
+        auto result = QList<int>{};
+
+        const auto allSizes = qEnvironmentVariable("ELISA_BENCHMARK_LIBRARY_SIZES").split(u',', Qt::SkipEmptyParts);
+        for (const auto &oneSize : allSizes) {
+            auto isValid = false;
+            const auto size = oneSize.trimmed().toInt(&isValid);
+
+            if (isValid && size > 0) {
+                result.push_back(size);
+            }
+        }
+
+        if (result.isEmpty()) {
+            result.push_back(10000);
+        }
+
+        return result;
+    }
+
+    static void addSizeRows()
+    {
+        QTest::addColumn<int>("tracksCount");
+
+        const auto allSizes = librarySizes();
+        for (const auto oneSize : allSizes) {
+            QTest::addRow("%d tracks", oneSize) << oneSize;
+        }
+    }
+
+    static void createDatabase(DatabaseInterface &musicDb, QTemporaryFile &databaseFile, const QString &name)
+    {
+        databaseFile.open();
+        musicDb.init(name, databaseFile.fileName());
+    }
+
+    /**
+     * Library shared by the benchmarks that do not change the tracks
+     */
+    LibraryDatabase &library(int tracksCount)
+    {
+        auto &oneLibrary = mLibraries[tracksCount];
+
+        if (!oneLibrary) {
+            oneLibrary = std::make_unique<LibraryDatabase>(tracksCount);
+            oneLibrary->mDatabase = std::make_unique<DatabaseInterface>();
+
+            createDatabase(*oneLibrary->mDatabase, oneLibrary->mDatabaseFile, u"libraryBenchmarkDb%1"_s.arg(tracksCount));
+            oneLibrary->mDatabase->insertTracksList(oneLibrary->mData.tracks(), {});
+        }
+
+        return *oneLibrary;
+    }
+
+    void addResult(const QString &benchmarkName, int tracksCount, const Measurement &measurement,
+                   int operationsCount = 1, const QJsonObject &parameters = {})
+    {
+        const auto iterationMs = measurement.mIterations > 0 ?
+                    static_cast<double>(measurement.mTotalNs) / 1e6 / measurement.mIterations : 0.;
+
+        auto result = QJsonObject{
+            {u"benchmark"_s, benchmarkName},
+            {u"tracks"_s, tracksCount},
+            {u"iterations"_s, measurement.mIterations},
+            {u"msPerIteration"_s, iterationMs},
+            {u"operationsPerIteration"_s, operationsCount},
+            {u"msPerOperation"_s, iterationMs / operationsCount},
+        };
+
+        for (auto itParameter = parameters.begin(); itParameter != parameters.end(); ++itParameter) {
+            result.insert(itParameter.key(), itParameter.value());
+        }
+
+        qInfo() << benchmarkName << tracksCount << "tracks:" << iterationMs << "ms per iteration";
+
+        mResults.push_back(result);
+    }
+
+    static QString sqliteVersion()
+    {
+        auto result = QString{};
+
+        {
+            auto connection = QSqlDatabase::addDatabase(u"QSQLITE"_s, u"sqliteVersionBenchmark"_s);
+            connection.setDatabaseName(u":memory:"_s);
+
+            if (connection.open()) {
+                QSqlQuery versionQuery(connection);
+                if (versionQuery.exec(u"SELECT sqlite_version()"_s) && versionQuery.next()) {
+                    result = versionQuery.value(0).toString();
+                }
+            }
+        }
+        QSqlDatabase::removeDatabase(u"sqliteVersionBenchmark"_s);
+
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void cleanupTestCase()
+    {
+        mLibraries.clear();
+
+        auto fileName = qEnvironmentVariable("ELISA_BENCHMARK_JSON");
+        if (fileName.isEmpty()) {
+            fileName = QDir::current().filePath(u"databaselibrarybenchmark.json"_s);
+        }
+
+        const auto report = QJsonObject{
+            {u"date"_s, QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+            {u"qtVersion"_s, QString::fromLatin1(qVersion())},
+            {u"sqliteVersion"_s, sqliteVersion()},
+            {u"results"_s, mResults},
+        };
+
+        QFile reportFile(fileName);
+        QVERIFY(reportFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        reportFile.write(QJsonDocument(report).toJson(QJsonDocument::Indented));
+
+        qInfo() << "results written to" << fileName;
+    }
+
+    void insertTracksList_data()
+    {
+        QTest::addColumn<int>("tracksCount");
+        QTest::addColumn<int>("batchSize");
+
+        const auto allSizes = librarySizes();
+        for (const auto oneSize : allSizes) {
+            for (const auto oneBatchSize : {50, 500, 5000}) {
+                QTest::addRow("%d tracks by %d", oneSize, oneBatchSize) << oneSize << oneBatchSize;
+            }
+        }
+    }
+
+    void insertTracksList()
+    {
+        QFETCH(int, tracksCount);
+        QFETCH(int, batchSize);
+
+        const auto &allTracks = library(tracksCount).mData.tracks();
+
+        QTemporaryFile databaseFile;
+        DatabaseInterface musicDb;
+        createDatabase(musicDb, databaseFile, u"insertBenchmarkDb"_s);
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto measurement = Measurement{};
+
+        QBENCHMARK_ONCE {
+            QElapsedTimer insertionTimer;
+            insertionTimer.start();
+
+            for (qsizetype batchStart = 0; batchStart < allTracks.size(); batchStart += batchSize) {
+                musicDb.insertTracksList(allTracks.mid(batchStart, batchSize), {});
+            }
+
+            measurement.add(insertionTimer.nsecsElapsed());
+        }
+
+        addResult(u"insertTracksList"_s, tracksCount, measurement, tracksCount, {{u"batchSize"_s, batchSize}});
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+        QCOMPARE(musicDb.allTracksData().size(), allTracks.size());
+    }
+
+    void removeTracksList_data()
+    {
+        addSizeRows();
+    }
+
+    void removeTracksList()
+    {
+        QFETCH(int, tracksCount);
+
+        const auto &allTracks = library(tracksCount).mData.tracks();
+
+        QTemporaryFile databaseFile;
+        DatabaseInterface musicDb;
+        createDatabase(musicDb, databaseFile, u"removeBenchmarkDb"_s);
+        musicDb.insertTracksList(allTracks, {});
+
+        // one track in ten, spread over most albums
+        auto removedFiles = QList<QUrl>{};
+        for (qsizetype i = 0; i < allTracks.size(); i += 10) {
+            removedFiles.push_back(allTracks[i].resourceURI());
+        }
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto measurement = Measurement{};
+
+        QBENCHMARK_ONCE {
+            QElapsedTimer removalTimer;
+            removalTimer.start();
+
+            musicDb.removeTracksList(removedFiles);
+
+            measurement.add(removalTimer.nsecsElapsed());
+        }
+
+        addResult(u"removeTracksList"_s, tracksCount, measurement, static_cast<int>(removedFiles.size()));
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+        QCOMPARE(musicDb.allTracksData().size(), allTracks.size() - removedFiles.size());
+    }
+
+    void allAlbumsData_data()
+    {
+        addSizeRows();
+    }
+
+    void allAlbumsData()
+    {
+        QFETCH(int, tracksCount);
+
+        auto &oneLibrary = library(tracksCount);
+        auto &musicDb = *oneLibrary.mDatabase;
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto allAlbums = musicDb.allAlbumsData();
+        QCOMPARE(allAlbums.size(), oneLibrary.mData.albumsCount());
+
+        auto measurement = Measurement{};
+
+        QBENCHMARK {
+            QElapsedTimer albumsTimer;
+            albumsTimer.start();
+
+            allAlbums = musicDb.allAlbumsData();
+
+            measurement.add(albumsTimer.nsecsElapsed());
+        }
+
+        addResult(u"allAlbumsData"_s, tracksCount, measurement);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void allArtistsData_data()
+    {
+        addSizeRows();
+    }
+
+    void allArtistsData()
+    {
+        QFETCH(int, tracksCount);
+
+        auto &musicDb = *library(tracksCount).mDatabase;
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto allArtists = musicDb.allArtistsData();
+        QVERIFY(!allArtists.isEmpty());
+
+        auto measurement = Measurement{};
+
+        QBENCHMARK {
+            QElapsedTimer artistsTimer;
+            artistsTimer.start();
+
+            allArtists = musicDb.allArtistsData();
+
+            measurement.add(artistsTimer.nsecsElapsed());
+        }
+
+        addResult(u"allArtistsData"_s, tracksCount, measurement);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void allTracksData_data()
+    {
+        addSizeRows();
+    }
+
+    void allTracksData()
+    {
+        QFETCH(int, tracksCount);
+
+        auto &musicDb = *library(tracksCount).mDatabase;
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto allTracks = musicDb.allTracksData();
+        QCOMPARE(allTracks.size(), tracksCount);
+
+        auto measurement = Measurement{};
+
+        QBENCHMARK {
+            QElapsedTimer tracksTimer;
+            tracksTimer.start();
+
+            allTracks = musicDb.allTracksData();
+
+            measurement.add(tracksTimer.nsecsElapsed());
+        }
+
+        addResult(u"allTracksData"_s, tracksCount, measurement);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void albumData_data()
+    {
+        addSizeRows();
+    }
+
+    void albumData()
+    {
+        QFETCH(int, tracksCount);
+
+        auto &musicDb = *library(tracksCount).mDatabase;
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        const auto allAlbums = musicDb.allAlbumsData();
+        QVERIFY(!allAlbums.isEmpty());
+
+        auto albumIds = QList<qulonglong>{};
+        for (int i = 0; i < AlbumsLookupsCount; ++i) {
+            albumIds.push_back(allAlbums[(i * 7919) % allAlbums.size()].databaseId());
+        }
+
+        auto measurement = Measurement{};
+
+        QBENCHMARK {
+            QElapsedTimer albumTimer;
+            albumTimer.start();
+
+            for (const auto oneAlbumId : std::as_const(albumIds)) {
+                const auto albumTracks = musicDb.albumData(oneAlbumId);
+                Q_UNUSED(albumTracks)
+            }
+
+            measurement.add(albumTimer.nsecsElapsed());
+        }
+
+        addResult(u"albumData"_s, tracksCount, measurement, AlbumsLookupsCount);
+
+        QVERIFY(!musicDb.albumData(albumIds.constFirst()).isEmpty());
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void trackIdFromFileName_data()
+    {
+        addSizeRows();
+    }
+
+    void trackIdFromFileName()
+    {
+        QFETCH(int, tracksCount);
+
+        auto &oneLibrary = library(tracksCount);
+        auto &musicDb = *oneLibrary.mDatabase;
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        const auto files = oneLibrary.mData.sampleFiles(LookupsCount);
+
+        auto measurement = Measurement{};
+
+        QBENCHMARK {
+            QElapsedTimer lookupTimer;
+            lookupTimer.start();
+
+            for (const auto &oneFile : files) {
+                const auto trackId = musicDb.trackIdFromFileName(oneFile);
+                Q_UNUSED(trackId)
+            }
+
+            measurement.add(lookupTimer.nsecsElapsed());
+        }
+
+        addResult(u"trackIdFromFileName"_s, tracksCount, measurement, LookupsCount);
+
+        QVERIFY(musicDb.trackIdFromFileName(files.constFirst()) != 0);
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void trackHasFinishedPlaying_data()
+    {
+        addSizeRows();
+    }
+
+    void trackHasFinishedPlaying()
+    {
+        QFETCH(int, tracksCount);
+
+        auto &oneLibrary = library(tracksCount);
+        auto &musicDb = *oneLibrary.mDatabase;
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        const auto files = oneLibrary.mData.sampleFiles(PlaysCount, 11);
+        const auto playDate = QDateTime::fromSecsSinceEpoch(1700000000);
+
+        auto measurement = Measurement{};
+
+        // the plays are queued: a read commits them as one transaction
+        QBENCHMARK {
+            QElapsedTimer playsTimer;
+            playsTimer.start();
+
+            for (const auto &oneFile : files) {
+                musicDb.trackHasFinishedPlaying(oneFile, playDate);
+            }
+            const auto trackId = musicDb.trackIdFromFileName(files.constFirst());
+            Q_UNUSED(trackId)
+
+            measurement.add(playsTimer.nsecsElapsed());
+        }
+
+        addResult(u"trackHasFinishedPlaying"_s, tracksCount, measurement, PlaysCount);
+
+        QVERIFY(!musicDb.frequentlyPlayedTracksData(1).isEmpty());
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(DatabaseLibraryBenchmark)
+
+
+#include "databaselibrarybenchmark.moc"
@@ -19,12 +19,15 @@
 #include <QThread>
 #include <QStandardPaths>
 #include <QAbstractItemModelTester>
+#include <QAtomicInt>
 
 #include <QDebug>
 
 #include <QSignalSpy>
 #include <QTest>
 
+#include <limits>
+
 class DataModelTests: public QObject, public DatabaseTestData
 {
     Q_OBJECT
@@ -1554,6 +1557,208 @@ private Q_SLOTS:
         QCOMPARE(beginInsertRowsSpy.at(1).at(1).toInt(), 2);
         QCOMPARE(beginInsertRowsSpy.at(1).at(2).toInt(), 2);
     }
+
+    void librarySnapshotIsReconciledWithTheDatabase()
+    {
+        DatabaseInterface musicDb;
+        DataModel albumsModel;
+        QAbstractItemModelTester testModel(&albumsModel);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        const auto allAlbums = musicDb.allAlbumsData();
+        QVERIFY(allAlbums.size() > 3);
+
+        // the previous run did not know one album, knew one removed since then and an older title
+        auto snapshotAlbums = allAlbums;
+        snapshotAlbums.removeAt(1);
+        snapshotAlbums.last()[DataTypes::TitleRole] = QStringLiteral("old title");
+
+        auto removedAlbum = DataTypes::AlbumDataType{};
+        removedAlbum[DataTypes::DatabaseIdRole] = std::numeric_limits<qulonglong>::max();
+        removedAlbum[DataTypes::TitleRole] = QStringLiteral("removed album");
+        removedAlbum[DataTypes::ElementTypeRole] = ElisaUtils::Album;
+        snapshotAlbums.push_front(removedAlbum);
+
+        albumsModel.initialize(nullptr, nullptr, ElisaUtils::Album, ElisaUtils::NoFilter, {}, {}, 0, {});
+
+        QSignalSpy beginInsertRowsSpy(&albumsModel, &DataModel::rowsAboutToBeInserted);
+        QSignalSpy beginRemoveRowsSpy(&albumsModel, &DataModel::rowsAboutToBeRemoved);
+        QSignalSpy modelResetSpy(&albumsModel, &DataModel::modelReset);
+        QSignalSpy dataChangedSpy(&albumsModel, &DataModel::dataChanged);
+
+        albumsModel.albumsSnapshotLoaded(snapshotAlbums);
+
+        QCOMPARE(albumsModel.rowCount(), allAlbums.size());
+        QCOMPARE(albumsModel.data(albumsModel.index(0, 0), Qt::DisplayRole).toString(), QStringLiteral("removed album"));
+        QCOMPARE(beginInsertRowsSpy.count(), 1);
+
+        albumsModel.allAlbumsLoaded(allAlbums);
+
+        QCOMPARE(albumsModel.rowCount(), allAlbums.size());
+        for (int i = 0; i < allAlbums.size(); ++i) {
+            QCOMPARE(albumsModel.data(albumsModel.index(i, 0), Qt::DisplayRole).toString(), allAlbums[i].title());
+        }
+
+        QCOMPARE(beginInsertRowsSpy.count(), 2);
+        QCOMPARE(beginInsertRowsSpy.at(1).at(1).toInt(), 1);
+        QCOMPARE(beginInsertRowsSpy.at(1).at(2).toInt(), 1);
+        QCOMPARE(beginRemoveRowsSpy.count(), 1);
+        QCOMPARE(beginRemoveRowsSpy.at(0).at(1).toInt(), 0);
+        QCOMPARE(dataChangedSpy.count(), 1);
+        QCOMPARE(dataChangedSpy.at(0).at(0).value<QModelIndex>().row(), allAlbums.size() - 1);
+        QCOMPARE(modelResetSpy.count(), 0);
+
+        // the snapshot is only reconciled once
+        albumsModel.allAlbumsLoaded({});
+        QCOMPARE(albumsModel.rowCount(), allAlbums.size());
+    }
+
+    void cancelledLoadsAreDropped()
+    {
+        DatabaseInterface musicDb;
+        DataModel albumsModel;
+        DataModel cancelledAlbumsModel;
+        QAbstractItemModelTester testModel(&albumsModel);
+        QAbstractItemModelTester testCancelledModel(&cancelledAlbumsModel);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        // a load already running stops and drops the rows it has read
+        QAtomicInt isCancelled = 1;
+        musicDb.setLoadCancellation(&isCancelled);
+
+        QVERIFY(musicDb.isLoadCancelled());
+        QVERIFY(musicDb.allAlbumsData().isEmpty());
+        QVERIFY(musicDb.allArtistsData().isEmpty());
+        QVERIFY(musicDb.allTracksData().isEmpty());
+
+        musicDb.setLoadCancellation(nullptr);
+
+        const auto allAlbums = musicDb.allAlbumsData();
+        QVERIFY(!allAlbums.isEmpty());
+
+        cancelledAlbumsModel.cancelLoads();
+
+        cancelledAlbumsModel.initialize(nullptr, &musicDb, ElisaUtils::Album, ElisaUtils::NoFilter, {}, {}, 0, {});
+        albumsModel.initialize(nullptr, &musicDb, ElisaUtils::Album, ElisaUtils::NoFilter, {}, {}, 0, {});
+
+        QCOMPARE(cancelledAlbumsModel.rowCount(), 0);
+        QCOMPARE(albumsModel.rowCount(), allAlbums.size());
+
+        // the cancellation of a loader only applies to its own loads
+        QVERIFY(!musicDb.isLoadCancelled());
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void pagedTracksKeepABoundedCache()
+    {
+        DatabaseInterface musicDb;
+        DataModel tracksModel;
+        QAbstractItemModelTester testModel(&tracksModel);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        const auto allTracks = musicDb.tracksDataPage(DataTypes::TitleRole, Qt::AscendingOrder, {}, 0, std::numeric_limits<int>::max());
+        QCOMPARE(allTracks.size(), musicDb.allTracksData().size());
+
+        tracksModel.setTracksPaging(5, 2);
+        tracksModel.initialize(nullptr, &musicDb, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0, {});
+
+        QVERIFY(tracksModel.isPaged());
+
+        while (tracksModel.canFetchMore({})) {
+            tracksModel.fetchMore({});
+        }
+
+        QCOMPARE(tracksModel.rowCount(), allTracks.size());
+
+        // only the last two pages keep their tracks
+        QVERIFY(!tracksModel.data(tracksModel.index(0, 0), DataTypes::DatabaseIdRole).isValid());
+        QCOMPARE(tracksModel.data(tracksModel.index(allTracks.size() - 1, 0), DataTypes::DatabaseIdRole).toULongLong(),
+                 allTracks.last().databaseId());
+
+        tracksModel.useTracksRows(0, 0);
+
+        QTRY_COMPARE(tracksModel.data(tracksModel.index(0, 0), DataTypes::DatabaseIdRole).toULongLong(),
+                     allTracks.first().databaseId());
+        QCOMPARE(tracksModel.rowCount(), allTracks.size());
+
+        auto allPagedTracks = DataModel::ListTrackDataType{};
+        connect(&tracksModel, &DataModel::allPagedTracksLoaded,
+                this, [&allPagedTracks](const DataModel::ListTrackDataType &tracks) {allPagedTracks = tracks;});
+
+        tracksModel.loadAllPagedTracks();
+
+        QCOMPARE(allPagedTracks.size(), allTracks.size());
+        QCOMPARE(allPagedTracks.first().databaseId(), allTracks.first().databaseId());
+
+        // a filtering view sees all the rows
+        tracksModel.setKeepAllTracksPages(true);
+
+        for (int row = 0; row < allTracks.size(); ++row) {
+            QCOMPARE(tracksModel.data(tracksModel.index(row, 0), DataTypes::DatabaseIdRole).toULongLong(),
+                     allTracks.at(row).databaseId());
+        }
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void pagedTracksFollowTheOrderOfTheDatabase()
+    {
+        DatabaseInterface musicDb;
+        DataModel tracksModel;
+        QAbstractItemModelTester testModel(&tracksModel);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        tracksModel.setTracksPaging(5, 2);
+        tracksModel.initialize(nullptr, &musicDb, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0, {});
+        tracksModel.setKeepAllTracksPages(true);
+
+        while (tracksModel.canFetchMore({})) {
+            tracksModel.fetchMore({});
+        }
+
+        // COLLATE NOCASE only folds ASCII letters: the upper case accented letter comes first
+        const auto newTitles = QStringList{QStringLiteral("\u00E9a"), QStringLiteral("\u00C9b"), QStringLiteral("Track0"), QStringLiteral("track99")};
+
+        for (int i = 0; i < newTitles.size(); ++i) {
+            const auto newTrack = DataTypes::TrackDataType{true, QStringLiteral("$%1").arg(100 + i), QStringLiteral("0"), newTitles.at(i),
+                    QStringLiteral("artist2"), QStringLiteral("album1"), QStringLiteral("Various Artists"), 1, 1,
+                    QTime::fromMSecsSinceStartOfDay(100 + i), {QUrl::fromLocalFile(QStringLiteral("/$%1").arg(100 + i))},
+                    QDateTime::fromMSecsSinceEpoch(100 + i),
+                    QUrl::fromLocalFile(QStringLiteral("album1")), 5, true,
+            {}, QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+
+            musicDb.insertTracksList({newTrack}, mNewCovers);
+        }
+
+        const auto allTracks = musicDb.tracksDataPage(DataTypes::TitleRole, Qt::AscendingOrder, {}, 0, std::numeric_limits<int>::max());
+        QCOMPARE(tracksModel.rowCount(), allTracks.size());
+
+        for (int row = 0; row < allTracks.size(); ++row) {
+            QCOMPARE(tracksModel.data(tracksModel.index(row, 0), DataTypes::DatabaseIdRole).toULongLong(),
+                     allTracks.at(row).databaseId());
+        }
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
 };
 
 QTEST_GUILESS_MAIN(DataModelTests)
@@ -0,0 +1,222 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "abstractfile/directorytree.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+
+#include <QTest>
+
+#include <algorithm>
+
+class DirectoryTreeTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DirectoryTreeTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static QStringList entryPaths(const DirectoryTree &tree, const QString &directoryPath)
+    {
+        QStringList result;
+
+        const auto allEntries = tree.entries(directoryPath);
+        for (const auto &oneEntry : allEntries) {
+            result.push_back(oneEntry.path);
+        }
+
+        std::sort(result.begin(), result.end());
+
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void addEntries()
+    {
+        DirectoryTree tree;
+        tree.setRootPaths({QStringLiteral("/music")});
+
+        QVERIFY(!tree.isDiscoveredDirectory(QStringLiteral("/music/artist")));
+
+        tree.addEntry(QStringLiteral("/music/artist/track1.ogg"), true, {});
+        tree.addEntry(QStringLiteral("/music/artist/track2.ogg"), true, {});
+        tree.addEntry(QStringLiteral("/music/artist/album"), false, {});
+
+        QVERIFY(tree.isDiscoveredDirectory(QStringLiteral("/music/artist")));
+        QVERIFY(tree.isDiscoveredDirectory(QStringLiteral("/music/artist/")));
+        QVERIFY(!tree.isDiscoveredDirectory(QStringLiteral("/music/artist/album")));
+        QVERIFY(!tree.isDiscoveredDirectory(QStringLiteral("/music/other")));
+
+        QCOMPARE(entryPaths(tree, QStringLiteral("/music/artist")),
+                 (QStringList{QStringLiteral("/music/artist/album"),
+                              QStringLiteral("/music/artist/track1.ogg"),
+                              QStringLiteral("/music/artist/track2.ogg")}));
+
+        const auto allEntries = tree.entries(QStringLiteral("/music/artist"));
+        const auto itAlbum = std::find_if(allEntries.cbegin(), allEntries.cend(),
+                                          [](const auto &oneEntry) {return oneEntry.path == QStringLiteral("/music/artist/album");});
+        QVERIFY(itAlbum != allEntries.cend());
+        QVERIFY(!itAlbum->isFile);
+
+        tree.markDiscoveredDirectory(QStringLiteral("/music/artist/album"));
+        QVERIFY(tree.isDiscoveredDirectory(QStringLiteral("/music/artist/album")));
+        QVERIFY(tree.entries(QStringLiteral("/music/artist/album")).isEmpty());
+    }
+
+    void insideRootPaths()
+    {
+        DirectoryTree tree;
+        tree.setRootPaths({QStringLiteral("/home/user/Music"), QStringLiteral("/media/music/")});
+
+        QVERIFY(tree.isInsideRootPaths(QStringLiteral("/home/user/Music/track.ogg")));
+        QVERIFY(tree.isInsideRootPaths(QStringLiteral("/home/user/Music/artist/album/track.ogg")));
+        QVERIFY(tree.isInsideRootPaths(QStringLiteral("/media/music/track.ogg")));
+        QVERIFY(!tree.isInsideRootPaths(QStringLiteral("/home/user/Music")));
+        QVERIFY(!tree.isInsideRootPaths(QStringLiteral("/home/user/MusicOld/track.ogg")));
+        QVERIFY(!tree.isInsideRootPaths(QStringLiteral("/home/user/track.ogg")));
+        QVERIFY(!tree.isInsideRootPaths(QStringLiteral("/unknown/track.ogg")));
+
+        tree.setRootPaths({QStringLiteral("/media/music")});
+
+        QVERIFY(!tree.isInsideRootPaths(QStringLiteral("/home/user/Music/track.ogg")));
+        QVERIFY(tree.isInsideRootPaths(QStringLiteral("/media/music/track.ogg")));
+    }
+
+    void fileSystemRoot()
+    {
+        DirectoryTree tree;
+        tree.setRootPaths({QStringLiteral("/")});
+
+        QVERIFY(tree.isInsideRootPaths(QStringLiteral("/track.ogg")));
+        QVERIFY(tree.isInsideRootPaths(QStringLiteral("/music/track.ogg")));
+
+        tree.addEntry(QStringLiteral("/track.ogg"), true, {});
+        tree.addEntry(QStringLiteral("/music"), false, {});
+
+        QCOMPARE(entryPaths(tree, QStringLiteral("/")),
+                 (QStringList{QStringLiteral("/music"), QStringLiteral("/track.ogg")}));
+    }
+
+    void outdatedEntries()
+    {
+        const auto referenceTime = QDateTime::fromMSecsSinceEpoch(1700000000000);
+
+        DirectoryTree tree;
+        tree.addEntry(QStringLiteral("/music/track.ogg"), true, referenceTime);
+
+        QVERIFY(!tree.isEntryOutdated(QStringLiteral("/music/track.ogg"), referenceTime));
+        QVERIFY(!tree.isEntryOutdated(QStringLiteral("/music/track.ogg"), referenceTime.addSecs(-10)));
+        QVERIFY(tree.isEntryOutdated(QStringLiteral("/music/track.ogg"), referenceTime.addSecs(10)));
+        QVERIFY(tree.isEntryOutdated(QStringLiteral("/music/unknown.ogg"), referenceTime));
+
+        QVERIFY(tree.containsFile(QStringLiteral("/music/track.ogg")));
+        QVERIFY(!tree.containsFile(QStringLiteral("/music")));
+        QVERIFY(!tree.containsFile(QStringLiteral("/music/unknown.ogg")));
+
+        tree.addEntry(QStringLiteral("/music/track.ogg"), true, referenceTime.addSecs(10));
+
+        QVERIFY(!tree.isEntryOutdated(QStringLiteral("/music/track.ogg"), referenceTime.addSecs(10)));
+    }
+
+    void removeDirectoryContent()
+    {
+        DirectoryTree tree;
+        tree.addEntry(QStringLiteral("/music/artist"), false, {});
+        tree.addEntry(QStringLiteral("/music/artist/track1.ogg"), true, {});
+        tree.addEntry(QStringLiteral("/music/artist/album"), false, {});
+        tree.addEntry(QStringLiteral("/music/artist/album/track2.ogg"), true, {});
+        tree.addEntry(QStringLiteral("/music/artist/album/track3.ogg"), true, {});
+        tree.addEntry(QStringLiteral("/music/other/track4.ogg"), true, {});
+
+        auto removedFiles = tree.removeDirectoryContent(QStringLiteral("/music/artist"));
+        std::sort(removedFiles.begin(), removedFiles.end());
+
+        QCOMPARE(removedFiles,
+                 (QStringList{QStringLiteral("/music/artist/album/track2.ogg"),
+                              QStringLiteral("/music/artist/album/track3.ogg"),
+                              QStringLiteral("/music/artist/track1.ogg")}));
+
+        QVERIFY(!tree.isDiscoveredDirectory(QStringLiteral("/music/artist")));
+        QVERIFY(!tree.isDiscoveredDirectory(QStringLiteral("/music/artist/album")));
+        QVERIFY(tree.entries(QStringLiteral("/music/artist")).isEmpty());
+        QVERIFY(tree.isDiscoveredDirectory(QStringLiteral("/music/other")));
+        QVERIFY(tree.removeDirectoryContent(QStringLiteral("/music/unknown")).isEmpty());
+    }
+
+    void removeEntryReleasesNodes()
+    {
+        DirectoryTree tree;
+        tree.addEntry(QStringLiteral("/music/track1.ogg"), true, {});
+
+        const auto initialNodesCount = tree.nodesCount();
+
+        tree.addEntry(QStringLiteral("/music/artist/album/track2.ogg"), true, {});
+        tree.addEntry(QStringLiteral("/music/artist/album/track3.ogg"), true, {});
+        QCOMPARE(tree.nodesCount(), initialNodesCount + 4);
+
+        tree.removeEntry(QStringLiteral("/music/artist"));
+        QCOMPARE(tree.nodesCount(), initialNodesCount);
+        QCOMPARE(entryPaths(tree, QStringLiteral("/music")), QStringList{QStringLiteral("/music/track1.ogg")});
+        QVERIFY(tree.isEntryOutdated(QStringLiteral("/music/artist/album/track2.ogg"), {}));
+
+        tree.addEntry(QStringLiteral("/music/artist/track4.ogg"), true, {});
+        QCOMPARE(tree.nodesCount(), initialNodesCount + 2);
+
+        tree.clear();
+        QCOMPARE(tree.nodesCount(), 0);
+        QVERIFY(tree.entries(QStringLiteral("/music")).isEmpty());
+    }
+
+    void removeRootEntry()
+    {
+        DirectoryTree tree;
+        tree.setRootPaths({QStringLiteral("/music/rock"), QStringLiteral("/music/jazz"), QStringLiteral("/other/classical")});
+
+        tree.addEntry(QStringLiteral("/music/rock/track1.ogg"), true, {});
+        tree.addEntry(QStringLiteral("/music/jazz/track2.ogg"), true, {});
+        tree.addEntry(QStringLiteral("/other/classical/track3.ogg"), true, {});
+
+        QVERIFY(tree.isInsideRootPaths(QStringLiteral("/music/rock/track1.ogg")));
+
+        tree.removeEntry(QStringLiteral("/music/rock"));
+
+        QVERIFY(!tree.containsFile(QStringLiteral("/music/rock/track1.ogg")));
+        QVERIFY(!tree.isInsideRootPaths(QStringLiteral("/music/rock/track1.ogg")));
+        QVERIFY(tree.isInsideRootPaths(QStringLiteral("/music/jazz/track2.ogg")));
+
+        // a root removed with its parent is forgotten too
+        tree.removeEntry(QStringLiteral("/other"));
+
+        QVERIFY(!tree.isInsideRootPaths(QStringLiteral("/other/classical/track3.ogg")));
+
+        // the released nodes are reused by paths that are not roots
+        tree.addEntry(QStringLiteral("/music/blues/track4.ogg"), true, {});
+        tree.addEntry(QStringLiteral("/music/rock/track1.ogg"), true, {});
+
+        QVERIFY(!tree.isInsideRootPaths(QStringLiteral("/music/blues/track4.ogg")));
+        QVERIFY(!tree.isInsideRootPaths(QStringLiteral("/music/rock/track1.ogg")));
+
+        tree.setRootPaths({QStringLiteral("/music/rock")});
+
+        QVERIFY(tree.isInsideRootPaths(QStringLiteral("/music/rock/track1.ogg")));
+        QVERIFY(!tree.isInsideRootPaths(QStringLiteral("/music/jazz/track2.ogg")));
+        QVERIFY(!tree.isInsideRootPaths(QStringLiteral("/music/blues/track4.ogg")));
+    }
+};
+
+QTEST_GUILESS_MAIN(DirectoryTreeTest)
+
+
+#include "directorytreetest.moc"
@@ -0,0 +1,209 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "abstractfile/directorywalker.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+
+#include <QTest>
+
+#include <algorithm>
+
+using namespace Qt::Literals::StringLiterals;
+
+class DirectoryWalkerTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DirectoryWalkerTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static bool createFile(const QString &fileName, const QByteArray &content)
+    {
+        QFile newFile(fileName);
+        if (!newFile.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+
+        return newFile.write(content) == content.size();
+    }
+
+    static QList<DirectoryWalker::Entry> sortedEntries(DirectoryWalker &walker, const QString &directoryPath)
+    {
+        auto result = walker.entries(directoryPath);
+
+        std::sort(result.begin(), result.end(), [](const auto &left, const auto &right) {
+            return left.fileName < right.fileName;
+        });
+
+        return result;
+    }
+
+    static int walkTree(DirectoryWalker &walker, const QString &directoryPath)
+    {
+        auto filesCount = 0;
+
+        const auto allEntries = walker.entries(directoryPath);
+        for (const auto &oneEntry : allEntries) {
+            if (oneEntry.isDirectory) {
+                filesCount += walkTree(walker, oneEntry.canonicalPath);
+            } else {
+                ++filesCount;
+            }
+        }
+
+        return filesCount;
+    }
+
+    QTemporaryDir mSyntheticTree;
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        QVERIFY(mSyntheticTree.isValid());
+
+        for (int artistIndex = 0; artistIndex < 20; ++artistIndex) {
+            for (int albumIndex = 0; albumIndex < 10; ++albumIndex) {
+                const auto albumPath = mSyntheticTree.path() + u"/artist%1/album%2"_s.arg(artistIndex).arg(albumIndex);
+                QVERIFY(QDir().mkpath(albumPath));
+
+                for (int trackIndex = 0; trackIndex < 50; ++trackIndex) {
+                    QVERIFY(createFile(albumPath + u"/track%1.ogg"_s.arg(trackIndex), QByteArray(trackIndex, 'a')));
+                }
+            }
+        }
+    }
+
+    void listDirectory()
+    {
+        QTemporaryDir testDirectory;
+        QVERIFY(testDirectory.isValid());
+
+        const auto directoryPath = QFileInfo(testDirectory.path()).canonicalFilePath();
+
+        QVERIFY(createFile(directoryPath + u"/track.ogg"_s, "content"));
+        QVERIFY(createFile(directoryPath + u"/.hidden.ogg"_s, "hidden"));
+        QVERIFY(QDir().mkpath(directoryPath + u"/album"_s));
+        QVERIFY(QDir().mkpath(directoryPath + u"/.hiddenAlbum"_s));
+        QVERIFY(QFile::link(directoryPath + u"/track.ogg"_s, directoryPath + u"/linkedTrack.ogg"_s));
+        QVERIFY(QFile::link(directoryPath + u"/album"_s, directoryPath + u"/linkedAlbum"_s));
+        QVERIFY(QFile::link(directoryPath + u"/missing.ogg"_s, directoryPath + u"/brokenLink.ogg"_s));
+
+        DirectoryWalker walker;
+        const auto allEntries = sortedEntries(walker, directoryPath);
+
+        QCOMPARE(allEntries.size(), 4);
+
+        QCOMPARE(allEntries[0].fileName, u"album"_s);
+        QCOMPARE(allEntries[0].canonicalPath, directoryPath + u"/album"_s);
+        QVERIFY(allEntries[0].isDirectory);
+
+        QCOMPARE(allEntries[1].fileName, u"linkedAlbum"_s);
+        QCOMPARE(allEntries[1].canonicalPath, directoryPath + u"/album"_s);
+        QVERIFY(allEntries[1].isDirectory);
+
+        QCOMPARE(allEntries[2].fileName, u"linkedTrack.ogg"_s);
+        QCOMPARE(allEntries[2].canonicalPath, directoryPath + u"/track.ogg"_s);
+        QCOMPARE(allEntries[2].size, qint64{7});
+        QVERIFY(!allEntries[2].isDirectory);
+
+        QCOMPARE(allEntries[3].fileName, u"track.ogg"_s);
+        QCOMPARE(allEntries[3].canonicalPath, directoryPath + u"/track.ogg"_s);
+        QCOMPARE(allEntries[3].size, qint64{7});
+        QVERIFY(!allEntries[3].isDirectory);
+
+        const QFileInfo trackInfo(directoryPath + u"/track.ogg"_s);
+        QCOMPARE(allEntries[3].modificationTime, trackInfo.lastModified().toMSecsSinceEpoch());
+        QCOMPARE(allEntries[3].changeTime, trackInfo.metadataChangeTime().toMSecsSinceEpoch());
+
+        QVERIFY(walker.entries(directoryPath + u"/missing"_s).isEmpty());
+    }
+
+    void sameEntriesWithQDir()
+    {
+        if (!DirectoryWalker::hasNativeBackend()) {
+            QSKIP("No native backend on this platform");
+        }
+
+        const auto albumPath = mSyntheticTree.path() + u"/artist0/album0"_s;
+
+        DirectoryWalker nativeWalker;
+        DirectoryWalker qtWalker;
+        qtWalker.setNativeBackendEnabled(false);
+
+        QVERIFY(nativeWalker.isNativeBackendEnabled());
+        QVERIFY(!qtWalker.isNativeBackendEnabled());
+
+        const auto nativeEntries = sortedEntries(nativeWalker, albumPath);
+        const auto qtEntries = sortedEntries(qtWalker, albumPath);
+
+        QCOMPARE(nativeEntries.size(), qtEntries.size());
+
+        for (qsizetype i = 0; i < nativeEntries.size(); ++i) {
+            QCOMPARE(nativeEntries[i].fileName, qtEntries[i].fileName);
+            QCOMPARE(nativeEntries[i].canonicalPath, qtEntries[i].canonicalPath);
+            QCOMPARE(nativeEntries[i].size, qtEntries[i].size);
+            QCOMPARE(nativeEntries[i].modificationTime, qtEntries[i].modificationTime);
+            QCOMPARE(nativeEntries[i].changeTime, qtEntries[i].changeTime);
+            QCOMPARE(nativeEntries[i].isDirectory, qtEntries[i].isDirectory);
+        }
+
+        QVERIFY(nativeWalker.systemCallsCount() > 0);
+        QCOMPARE(qtWalker.systemCallsCount(), qint64{0});
+    }
+
+    void benchmarkWalkTree_data()
+    {
+        QTest::addColumn<bool>("useNativeBackend");
+
+        QTest::newRow("QDir") << false;
+        if (DirectoryWalker::hasNativeBackend()) {
+            QTest::newRow("native") << true;
+        }
+    }
+
+    void benchmarkWalkTree()
+    {
+        QFETCH(bool, useNativeBackend);
+
+        DirectoryWalker walker;
+        walker.setNativeBackendEnabled(useNativeBackend);
+
+        auto filesCount = 0;
+        auto walksCount = 0;
+        QElapsedTimer walkTimer;
+        walkTimer.start();
+
+        QBENCHMARK {
+            filesCount = walkTree(walker, mSyntheticTree.path());
+            ++walksCount;
+        }
+
+        QCOMPARE(filesCount, 10000);
+
+        // the system calls issued by QDir are not counted, use strace -c -f to compare them
+        qInfo() << (useNativeBackend ? "native" : "QDir") << "walker:" << walkTimer.elapsed() / walksCount << "ms per walk"
+                << walker.systemCallsCount() / walksCount << "system calls per walk";
+    }
+};
+
+QTEST_GUILESS_MAIN(DirectoryWalkerTest)
+
+
+#include "directorywalkertest.moc"
@@ -75,6 +75,14 @@ private Q_SLOTS:
 
     }
 
+    void testNonAudioFileScan()
+    {
+        FileScanner fileScanner;
+        auto scannedImage = fileScanner.scanOneFile(QUrl::fromLocalFile(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/cover.jpg")));
+        QVERIFY(!scannedImage.isValid());
+        QVERIFY(!fileScanner.shouldScanFile(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/cover.jpg")));
+    }
+
     void testFindCoverInDirectory()
     {
         FileScanner fileScanner;
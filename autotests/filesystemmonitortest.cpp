@@ -0,0 +1,201 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "abstractfile/filesystemmonitor.h"
+
+#include <QObject>
+#include <QString>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QSignalSpy>
+
+#include <QTest>
+
+using namespace Qt::Literals::StringLiterals;
+
+class FileSystemMonitorTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit FileSystemMonitorTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static bool createFile(const QString &fileName, const QByteArray &content)
+    {
+        QFile newFile(fileName);
+        if (!newFile.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+
+        return newFile.write(content) == content.size();
+    }
+
+private Q_SLOTS:
+
+    void directoryChanges_data()
+    {
+        QTest::addColumn<bool>("useNativeBackend");
+
+        QTest::newRow("QFileSystemWatcher") << false;
+        if (FileSystemMonitor::hasNativeBackend()) {
+            QTest::newRow("native") << true;
+        }
+    }
+
+    void directoryChanges()
+    {
+        QFETCH(bool, useNativeBackend);
+
+        QTemporaryDir testDirectory;
+        QVERIFY(testDirectory.isValid());
+
+        const auto directoryPath = QFileInfo(testDirectory.path()).canonicalFilePath();
+
+        FileSystemMonitor monitor;
+        monitor.setNativeBackendEnabled(useNativeBackend);
+        QCOMPARE(monitor.isNativeBackendEnabled(), useNativeBackend);
+
+        QSignalSpy directoryChangedSpy(&monitor, &FileSystemMonitor::directoryChanged);
+
+        QVERIFY(monitor.watchDirectory(directoryPath));
+        QCOMPARE(monitor.watchesCount(), 1);
+
+        QVERIFY(createFile(directoryPath + u"/track.ogg"_s, "content"));
+
+        QVERIFY(directoryChangedSpy.wait());
+        QCOMPARE(directoryChangedSpy.constFirst().at(0).toString(), directoryPath);
+
+        directoryChangedSpy.clear();
+
+        QVERIFY(QFile::remove(directoryPath + u"/track.ogg"_s));
+
+        QVERIFY(directoryChangedSpy.wait());
+        QCOMPARE(directoryChangedSpy.constFirst().at(0).toString(), directoryPath);
+    }
+
+    void fileChanges_data()
+    {
+        directoryChanges_data();
+    }
+
+    void fileChanges()
+    {
+        QFETCH(bool, useNativeBackend);
+
+        QTemporaryDir testDirectory;
+        QVERIFY(testDirectory.isValid());
+
+        const auto directoryPath = QFileInfo(testDirectory.path()).canonicalFilePath();
+        const auto fileName = directoryPath + u"/track.ogg"_s;
+
+        QVERIFY(createFile(fileName, "content"));
+
+        FileSystemMonitor monitor;
+        monitor.setNativeBackendEnabled(useNativeBackend);
+
+        QSignalSpy fileChangedSpy(&monitor, &FileSystemMonitor::fileChanged);
+
+        QVERIFY(monitor.watchDirectory(directoryPath));
+        QVERIFY(monitor.watchFile(fileName));
+
+        // a file costs a watch only without the native backend
+        QCOMPARE(monitor.watchesCount(), useNativeBackend ? 1 : 2);
+
+        QVERIFY(createFile(fileName, "new content"));
+
+        QVERIFY(fileChangedSpy.wait());
+        QCOMPARE(fileChangedSpy.constFirst().at(0).toString(), fileName);
+    }
+
+    void coalesceNativeEvents()
+    {
+        if (!FileSystemMonitor::hasNativeBackend()) {
+            QSKIP("No native backend on this platform");
+        }
+
+        QTemporaryDir testDirectory;
+        QVERIFY(testDirectory.isValid());
+
+        const auto rootPath = QFileInfo(testDirectory.path()).canonicalFilePath();
+        const auto firstAlbumPath = rootPath + u"/album1"_s;
+        const auto secondAlbumPath = rootPath + u"/album2"_s;
+
+        QVERIFY(QDir().mkpath(firstAlbumPath));
+        QVERIFY(QDir().mkpath(secondAlbumPath));
+
+        FileSystemMonitor monitor;
+        QVERIFY(monitor.isNativeBackendEnabled());
+
+        QSignalSpy directoryChangedSpy(&monitor, &FileSystemMonitor::directoryChanged);
+
+        QVERIFY(monitor.watchDirectory(rootPath));
+        QVERIFY(monitor.watchDirectory(firstAlbumPath));
+        QVERIFY(monitor.watchDirectory(secondAlbumPath));
+        QVERIFY(monitor.watchDirectory(secondAlbumPath + u"/"_s));
+
+        QCOMPARE(monitor.watchesCount(), 3);
+
+        for (int trackIndex = 0; trackIndex < 100; ++trackIndex) {
+            QVERIFY(createFile(firstAlbumPath + u"/track%1.ogg"_s.arg(trackIndex), "content"));
+            QVERIFY(createFile(secondAlbumPath + u"/track%1.ogg"_s.arg(trackIndex), "content"));
+        }
+
+        // all the events are pending: they are read at once
+        QVERIFY(directoryChangedSpy.wait());
+
+        QCOMPARE(directoryChangedSpy.count(), 2);
+        QCOMPARE(directoryChangedSpy.at(0).at(0).toString(), firstAlbumPath);
+        QCOMPARE(directoryChangedSpy.at(1).at(0).toString(), secondAlbumPath);
+    }
+
+    void removeWatchedDirectory()
+    {
+        if (!FileSystemMonitor::hasNativeBackend()) {
+            QSKIP("No native backend on this platform");
+        }
+
+        QTemporaryDir testDirectory;
+        QVERIFY(testDirectory.isValid());
+
+        const auto rootPath = QFileInfo(testDirectory.path()).canonicalFilePath();
+        const auto albumPath = rootPath + u"/album"_s;
+
+        QVERIFY(QDir().mkpath(albumPath));
+
+        FileSystemMonitor monitor;
+
+        QSignalSpy directoryChangedSpy(&monitor, &FileSystemMonitor::directoryChanged);
+
+        QVERIFY(monitor.watchDirectory(rootPath));
+        QVERIFY(monitor.watchDirectory(albumPath));
+        QCOMPARE(monitor.watchesCount(), 2);
+
+        QVERIFY(QDir(albumPath).removeRecursively());
+
+        QVERIFY(directoryChangedSpy.wait());
+        QTRY_COMPARE(monitor.watchesCount(), 1);
+
+        QStringList changedDirectories;
+        for (const auto &oneSignal : std::as_const(directoryChangedSpy)) {
+            changedDirectories.push_back(oneSignal.at(0).toString());
+        }
+
+        QVERIFY(changedDirectories.contains(rootPath));
+        QVERIFY(changedDirectories.contains(albumPath));
+    }
+};
+
+QTEST_GUILESS_MAIN(FileSystemMonitorTest)
+
+
+#include "filesystemmonitortest.moc"
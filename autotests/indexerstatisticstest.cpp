@@ -0,0 +1,97 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "abstractfile/indexerstatistics.h"
+
+#include <QObject>
+#include <QString>
+#include <QUrl>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include <QTest>
+
+using namespace Qt::Literals::StringLiterals;
+
+class IndexerStatisticsTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit IndexerStatisticsTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void extractionPercentiles()
+    {
+        IndexerStatistics statistics;
+
+        QCOMPARE(statistics.extractionTimePercentile(50), qint64{0});
+
+        // 1 ms to 100 ms
+        for (int i = 100; i >= 1; --i) {
+            statistics.addExtraction(QUrl::fromLocalFile(u"/music/track%1.ogg"_s.arg(i)), qint64{i} * 1000000, i % 2 == 0);
+        }
+
+        QCOMPARE(statistics.extractedFilesCount(), 100);
+        QCOMPARE(statistics.extractionTimePercentile(50), qint64{50000000});
+        QCOMPARE(statistics.extractionTimePercentile(90), qint64{90000000});
+        QCOMPARE(statistics.extractionTimePercentile(99), qint64{99000000});
+        QCOMPARE(statistics.extractionTimePercentile(100), qint64{100000000});
+        QCOMPARE(statistics.extractionTimePercentile(0), qint64{1000000});
+    }
+
+    void jsonSummary()
+    {
+        IndexerStatistics statistics;
+
+        statistics.start();
+
+        statistics.addExtraction(QUrl::fromLocalFile(u"/music/fast.ogg"_s), 1000000, true);
+        statistics.addExtraction(QUrl::fromLocalFile(u"/music/slow.ogg"_s), 30000000, true);
+        statistics.addExtraction(QUrl::fromLocalFile(u"/music/cover.jpg"_s), 2000000, false);
+
+        statistics.addDatabaseBatch(1, 4000000);
+        statistics.addDatabaseBatch(2, 2000000);
+
+        statistics.addError();
+
+        statistics.stop();
+
+        const auto summary = statistics.toJson(2);
+
+        const auto extraction = summary[u"extraction"_s].toObject();
+        QCOMPARE(extraction[u"files"_s].toInt(), 3);
+        QCOMPARE(extraction[u"validTracks"_s].toInt(), 2);
+        QCOMPARE(extraction[u"totalMs"_s].toDouble(), 33.);
+        QCOMPARE(extraction[u"maxMs"_s].toDouble(), 30.);
+
+        const auto database = summary[u"database"_s].toObject();
+        QCOMPARE(database[u"batchesCount"_s].toInt(), 2);
+        QCOMPARE(database[u"tracks"_s].toInt(), 3);
+        QCOMPARE(database[u"totalMs"_s].toDouble(), 6.);
+        QCOMPARE(database[u"msPerTrack"_s].toDouble(), 2.);
+        QCOMPARE(database[u"batches"_s].toArray().size(), 2);
+        QCOMPARE(database[u"batches"_s].toArray().at(1).toObject()[u"tracks"_s].toInt(), 2);
+
+        const auto slowestFiles = summary[u"slowestFiles"_s].toArray();
+        QCOMPARE(slowestFiles.size(), 2);
+        QCOMPARE(slowestFiles.at(0).toObject()[u"file"_s].toString(), u"/music/slow.ogg"_s);
+        QCOMPARE(slowestFiles.at(1).toObject()[u"file"_s].toString(), u"/music/cover.jpg"_s);
+
+        QCOMPARE(summary[u"errors"_s].toInt(), 1);
+        QVERIFY(summary.contains(u"elapsedMs"_s));
+        QVERIFY(summary.contains(u"filesPerSecond"_s));
+    }
+};
+
+QTEST_GUILESS_MAIN(IndexerStatisticsTest)
+
+
+#include "indexerstatisticstest.moc"
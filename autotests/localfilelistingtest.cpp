@@ -21,6 +21,7 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 
 #include <QSignalSpy>
 #include <QTest>
@@ -177,6 +178,49 @@ private Q_SLOTS:
         QVERIFY(removedTracksListSpy.isEmpty());
     }
 
+    void initialTestWithTracksAndExtractionWorkers_data()
+    {
+        QTest::addColumn<int>("workerCount");
+
+        QTest::newRow("one worker") << 1;
+        QTest::newRow("four workers") << 4;
+    }
+
+    void initialTestWithTracksAndExtractionWorkers()
+    {
+        QFETCH(int, workerCount);
+
+        Elisa::ElisaConfiguration::self()->setDefaults();
+        Elisa::ElisaConfiguration::self()->setExtractionWorkerCount(workerCount);
+
+        LocalFileListing myListing;
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicPath});
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 2);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+
+        auto allNewTracks = QStringList{};
+        for (const auto &oneSignal : std::as_const(tracksListSpy)) {
+            const auto newTracks = oneSignal.at(0).value<DataTypes::ListTrackDataType>();
+            for (const auto &oneTrack : newTracks) {
+                allNewTracks.push_back(oneTrack.resourceURI().toLocalFile());
+            }
+        }
+
+        QCOMPARE(allNewTracks.count(), 5);
+        QCOMPARE(allNewTracks.removeDuplicates(), 0);
+
+        Elisa::ElisaConfiguration::self()->setDefaults();
+    }
+
     void addAndRemoveTracks()
     {
         LocalFileListing myListing;
@@ -690,6 +734,375 @@ private Q_SLOTS:
         QCOMPARE(newCovers.count(), 3);
         QCOMPARE(removedTracks.count(), 1);
     }
+
+    void refreshSkipsUnchangedDirectories()
+    {
+        const QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + u"/music"_s;
+        const QString workingPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH);
+        const QString musicParentPath = workingPath + u"/fingerprints"_s;
+        const QString fingerprintsFileName = workingPath + u"/fingerprints.cache"_s;
+
+        QDir musicParentDirectory(musicParentPath);
+        QVERIFY(musicParentDirectory.removeRecursively());
+        QFile::remove(fingerprintsFileName);
+
+        QVERIFY(musicParentDirectory.mkpath(musicParentPath + u"/artist1"_s));
+        QVERIFY(musicParentDirectory.mkpath(musicParentPath + u"/artist2/album"_s));
+        QVERIFY(QFile::copy(musicOriginPath + u"/test.ogg"_s, musicParentPath + u"/artist1/test.ogg"_s));
+        QVERIFY(QFile::copy(musicOriginPath + u"/test.ogg"_s, musicParentPath + u"/artist2/test.ogg"_s));
+        QVERIFY(QFile::copy(musicOriginPath + u"/test.ogg"_s, musicParentPath + u"/artist2/album/test.ogg"_s));
+
+        auto allIndexedTracks = QHash<QUrl, QDateTime>{};
+
+        {
+            LocalFileListing myListing;
+            myListing.setDirectoryFingerprintsFileName(fingerprintsFileName);
+            myListing.setDirectoryQuietPeriod(0);
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+            myListing.refreshContent();
+
+            const auto allNewTracks = newTrackFiles(tracksListSpy);
+            QCOMPARE(allNewTracks.count(), 3);
+
+            for (const auto &oneTrack : allNewTracks) {
+                allIndexedTracks[QUrl::fromLocalFile(oneTrack)] = QFileInfo(oneTrack).metadataChangeTime();
+            }
+        }
+
+        QVERIFY(QFile::exists(fingerprintsFileName));
+
+        const QString newTrackPath = musicParentPath + u"/artist2/album/test2.ogg"_s;
+        QVERIFY(QFile::copy(musicOriginPath + u"/test.ogg"_s, newTrackPath));
+
+        {
+            LocalFileListing myListing;
+            myListing.setDirectoryFingerprintsFileName(fingerprintsFileName);
+            myListing.setDirectoryQuietPeriod(0);
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+            QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+            myListing.setIndexedTracks(allIndexedTracks);
+
+            QCOMPARE(newTrackFiles(tracksListSpy), QStringList{QFileInfo(newTrackPath).canonicalFilePath()});
+            QCOMPARE(removedTracksListSpy.count(), 0);
+        }
+
+        const auto newTrackInfo = QFileInfo(newTrackPath);
+        allIndexedTracks[QUrl::fromLocalFile(newTrackInfo.canonicalFilePath())] = newTrackInfo.metadataChangeTime();
+
+        {
+            LocalFileListing myListing;
+            myListing.setDirectoryFingerprintsFileName(fingerprintsFileName);
+            myListing.setDirectoryQuietPeriod(0);
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+            myListing.setIndexedTracks(allIndexedTracks);
+
+            QCOMPARE(newTrackFiles(tracksListSpy).count(), 0);
+            QCOMPARE(myListing.listedDirectoriesCount(), 0);
+        }
+
+        // tags rewritten in place do not modify the timestamps of the directory of the file
+        const auto rewrittenTrackPath = QFileInfo(musicParentPath + u"/artist1/test.ogg"_s).canonicalFilePath();
+        QTest::qWait(20);
+        QVERIFY(rewriteInPlace(rewrittenTrackPath));
+
+        {
+            LocalFileListing myListing;
+            myListing.setDirectoryFingerprintsFileName(fingerprintsFileName);
+            myListing.setDirectoryQuietPeriod(0);
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+            myListing.setIndexedTracks(allIndexedTracks);
+
+            QCOMPARE(newTrackFiles(tracksListSpy).count(), 0);
+        }
+
+        {
+            // a full rescan does not use the fingerprints
+            LocalFileListing myListing;
+            myListing.setDirectoryQuietPeriod(0);
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+            myListing.setIndexedTracks(allIndexedTracks);
+
+            QCOMPARE(newTrackFiles(tracksListSpy), QStringList{rewrittenTrackPath});
+        }
+
+        {
+            LocalFileListing myListing;
+            myListing.setDirectoryFingerprintsFileName(fingerprintsFileName);
+            myListing.setDirectoryQuietPeriod(0);
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+
+            // fingerprints of directories whose tracks are not indexed anymore are ignored
+            myListing.setIndexedTracks({});
+
+            QCOMPARE(newTrackFiles(tracksListSpy).count(), 4);
+        }
+    }
+
+    void replayFileSystemEventsStorm_data()
+    {
+        QTest::addColumn<bool>("withDirectoryChanges");
+
+        QTest::newRow("files rewritten in place") << false;
+        QTest::newRow("files rewritten and directory modified") << true;
+    }
+
+    void replayFileSystemEventsStorm()
+    {
+        QFETCH(bool, withDirectoryChanges);
+
+        const QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + u"/music"_s;
+        const QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + u"/eventsStorm"_s;
+        const auto trackNames = QStringList{u"test.ogg"_s, u"test.mp3"_s, u"test.m4a"_s};
+        constexpr int quietPeriod = 300;
+
+        QDir musicDirectory(musicPath);
+        QVERIFY(musicDirectory.removeRecursively());
+        QVERIFY(musicDirectory.mkpath(musicPath));
+
+        for (const auto &oneTrackName : trackNames) {
+            QVERIFY(QFile::copy(musicOriginPath + u"/"_s + oneTrackName, musicPath + u"/"_s + oneTrackName));
+        }
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy modifiedTracksListSpy(&myListing, &LocalFileListing::modifyTracksList);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicPath});
+        myListing.refreshContent();
+
+        QCOMPARE(newTrackFiles(tracksListSpy).count(), 3);
+        tracksListSpy.clear();
+
+        myListing.setFileSystemChangesQuietPeriod(quietPeriod);
+
+        const auto canonicalMusicPath = QFileInfo(musicPath).canonicalFilePath();
+
+        // the change time of the rewritten files must be newer than the one of the scan
+        QTest::qWait(20);
+
+        for (const auto &oneTrackName : trackNames) {
+            QVERIFY(rewriteInPlace(canonicalMusicPath + u"/"_s + oneTrackName));
+        }
+
+        if (withDirectoryChanges) {
+            QVERIFY(musicDirectory.mkpath(musicPath + u"/artwork"_s));
+        }
+
+        const auto extractedFilesCount = myListing.extractedFilesCount();
+
+        // recorded while a tagger saved an album: each file is reported several
+        // times by events less than the quiet period apart
+        for (int round = 0; round < 4; ++round) {
+            for (const auto &oneTrackName : trackNames) {
+                QVERIFY(QMetaObject::invokeMethod(&myListing, "fileChanged", Q_ARG(QString, canonicalMusicPath + u"/"_s + oneTrackName)));
+                QVERIFY(QMetaObject::invokeMethod(&myListing, "fileChanged", Q_ARG(QString, canonicalMusicPath + u"/"_s + oneTrackName)));
+            }
+
+            if (withDirectoryChanges) {
+                QVERIFY(QMetaObject::invokeMethod(&myListing, "directoryChanged", Q_ARG(QString, canonicalMusicPath)));
+            }
+
+            QTest::qWait(quietPeriod / 4);
+        }
+
+        QCOMPARE(myListing.extractedFilesCount(), extractedFilesCount);
+
+        QTRY_COMPARE(myListing.extractedFilesCount(), extractedFilesCount + 3);
+
+        QTest::qWait(3 * quietPeriod);
+
+        QCOMPARE(myListing.extractedFilesCount(), extractedFilesCount + 3);
+
+        if (withDirectoryChanges) {
+            // modified files found while listing their directory are reported as new tracks
+            QCOMPARE(tracksListSpy.count(), 1);
+            QCOMPARE(newTrackFiles(tracksListSpy).count(), 3);
+            QCOMPARE(modifiedTracksListSpy.count(), 0);
+        } else {
+            QCOMPARE(tracksListSpy.count(), 0);
+            QCOMPARE(modifiedTracksListSpy.count(), 1);
+            QCOMPARE(modifiedTracksListSpy.at(0).at(0).value<DataTypes::ListTrackDataType>().count(), 3);
+        }
+    }
+
+    void rescanOnlyChangedDirectory()
+    {
+        const QString trackOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + u"/music/test.ogg"_s;
+        const QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + u"/targetedRescan"_s;
+
+        QDir musicParentDirectory(musicParentPath);
+        QVERIFY(musicParentDirectory.removeRecursively());
+
+        for (int artistIndex = 0; artistIndex < 10; ++artistIndex) {
+            for (int albumIndex = 0; albumIndex < 5; ++albumIndex) {
+                const auto albumPath = musicParentPath + u"/artist%1/album%2"_s.arg(artistIndex).arg(albumIndex);
+                QVERIFY(musicParentDirectory.mkpath(albumPath));
+                QVERIFY(QFile::copy(trackOriginPath, albumPath + u"/track.ogg"_s));
+            }
+        }
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicParentPath});
+        myListing.refreshContent();
+
+        QCOMPARE(newTrackFiles(tracksListSpy).count(), 50);
+        QCOMPARE(myListing.listedDirectoriesCount(), 61);
+
+        tracksListSpy.clear();
+        myListing.setFileSystemChangesQuietPeriod(100);
+
+        const auto artistPath = QFileInfo(musicParentPath + u"/artist0"_s).canonicalFilePath();
+        const auto newAlbumPath = artistPath + u"/newAlbum/disc1"_s;
+
+        QVERIFY(musicParentDirectory.mkpath(newAlbumPath));
+        QVERIFY(QFile::copy(trackOriginPath, newAlbumPath + u"/track1.ogg"_s));
+        QVERIFY(QFile::copy(trackOriginPath, newAlbumPath + u"/track2.ogg"_s));
+
+        auto listedDirectoriesCount = myListing.listedDirectoriesCount();
+
+        QVERIFY(QMetaObject::invokeMethod(&myListing, "directoryChanged", Q_ARG(QString, artistPath)));
+
+        QVERIFY(tracksListSpy.wait());
+        QTest::qWait(300);
+
+        // the changed directory and the two new ones
+        QCOMPARE(myListing.listedDirectoriesCount(), listedDirectoriesCount + 3);
+        QCOMPARE(newTrackFiles(tracksListSpy).count(), 2);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+
+        const auto removedArtistPath = QFileInfo(musicParentPath + u"/artist1"_s).canonicalFilePath();
+
+        QVERIFY(QDir(removedArtistPath + u"/album0"_s).removeRecursively());
+
+        listedDirectoriesCount = myListing.listedDirectoriesCount();
+
+        QVERIFY(QMetaObject::invokeMethod(&myListing, "directoryChanged", Q_ARG(QString, removedArtistPath)));
+
+        QVERIFY(removedTracksListSpy.wait());
+        QTest::qWait(300);
+
+        QCOMPARE(myListing.listedDirectoriesCount(), listedDirectoriesCount + 1);
+        QCOMPARE(removedTracksListSpy.count(), 1);
+        QCOMPARE(removedTracksListSpy.at(0).at(0).value<QList<QUrl>>(),
+                 QList<QUrl>{QUrl::fromLocalFile(removedArtistPath + u"/album0/track.ogg"_s)});
+    }
+
+    void benchmarkRefreshOfSyntheticTree_data()
+    {
+        QTest::addColumn<bool>("unchangedTree");
+
+        QTest::newRow("first scan") << false;
+        QTest::newRow("rescan of unchanged tree") << true;
+    }
+
+    void benchmarkRefreshOfSyntheticTree()
+    {
+        QFETCH(bool, unchangedTree);
+
+        const QString trackOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + u"/music/test.ogg"_s;
+        const QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + u"/syntheticTree"_s;
+
+        QDir musicParentDirectory(musicParentPath);
+
+        if (!musicParentDirectory.exists()) {
+            for (int artistIndex = 0; artistIndex < 20; ++artistIndex) {
+                for (int albumIndex = 0; albumIndex < 10; ++albumIndex) {
+                    const auto albumPath = musicParentPath + u"/artist%1/album%2"_s.arg(artistIndex).arg(albumIndex);
+                    QVERIFY(musicParentDirectory.mkpath(albumPath));
+
+                    for (int trackIndex = 0; trackIndex < 5; ++trackIndex) {
+                        QVERIFY(QFile::copy(trackOriginPath, albumPath + u"/track%1.ogg"_s.arg(trackIndex)));
+                    }
+                }
+            }
+        }
+
+        LocalFileListing myListing;
+        myListing.setDirectoryQuietPeriod(0);
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicParentPath});
+        myListing.refreshContent();
+
+        auto allIndexedTracks = QHash<QUrl, QDateTime>{};
+        const auto allNewTracks = newTrackFiles(tracksListSpy);
+        for (const auto &oneTrack : allNewTracks) {
+            allIndexedTracks[QUrl::fromLocalFile(oneTrack)] = QFileInfo(oneTrack).metadataChangeTime();
+        }
+
+        QCOMPARE(allIndexedTracks.count(), 1000);
+
+        if (unchangedTree) {
+            QBENCHMARK {
+                myListing.setIndexedTracks(allIndexedTracks);
+            }
+        } else {
+            QBENCHMARK {
+                myListing.resetAndRefreshContent();
+            }
+        }
+    }
+
+private:
+
+    static bool rewriteInPlace(const QString &fileName)
+    {
+        QFile modifiedFile(fileName);
+        if (!modifiedFile.open(QIODevice::ReadWrite)) {
+            return false;
+        }
+
+        char firstByte = 0;
+
+        return modifiedFile.getChar(&firstByte) && modifiedFile.seek(0) && modifiedFile.putChar(firstByte);
+    }
+
+    static QStringList newTrackFiles(const QSignalSpy &tracksListSpy)
+    {
+        auto allNewTracks = QStringList{};
+
+        for (const auto &oneSignal : tracksListSpy) {
+            const auto newTracks = oneSignal.at(0).value<DataTypes::ListTrackDataType>();
+            for (const auto &oneTrack : newTracks) {
+                allNewTracks.push_back(oneTrack.resourceURI().toLocalFile());
+            }
+        }
+
+        return allNewTracks;
+    }
 };
 
 QTEST_GUILESS_MAIN(LocalFileListingTests)
@@ -0,0 +1,231 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "nativetagreader.h"
+#include "filescanner.h"
+#include "config-upnp-qt.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <QMimeDatabase>
+
+#include <QTest>
+
+class NativeTagReaderTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit NativeTagReaderTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static QString sampleFile(const QString &subpath)
+    {
+        return QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + subpath;
+    }
+
+    void addSampleFilesColumns()
+    {
+        QTest::addColumn<QString>("fileName");
+
+        QTest::newRow("ogg") << sampleFile(QStringLiteral("/music/test.ogg"));
+        QTest::newRow("ogg with multiple values") << sampleFile(QStringLiteral("/music/testMultiple.ogg"));
+        QTest::newRow("ogg with many tags") << sampleFile(QStringLiteral("/music/testMany.ogg"));
+        QTest::newRow("ogg with cover") << sampleFile(QStringLiteral("/cover_art/artist4/test.ogg"));
+        QTest::newRow("flac with cover") << sampleFile(QStringLiteral("/cover_art/artist4/test.flac"));
+        QTest::newRow("mp3") << sampleFile(QStringLiteral("/music/test.mp3"));
+        QTest::newRow("mp3 with cover") << sampleFile(QStringLiteral("/cover_art/artist4/test.mp3"));
+        QTest::newRow("m4a") << sampleFile(QStringLiteral("/music/test.m4a"));
+        QTest::newRow("playlist sample ogg") << sampleFile(QStringLiteral("/../samplefiles/test2.ogg"));
+    }
+
+    QMimeDatabase mMimeDb;
+
+private Q_SLOTS:
+
+    void readTrack_data()
+    {
+        QTest::addColumn<QString>("fileName");
+        QTest::addColumn<QString>("title");
+        QTest::addColumn<QString>("album");
+        QTest::addColumn<int>("channels");
+        QTest::addColumn<int>("durationMs");
+        QTest::addColumn<bool>("hasEmbeddedCover");
+
+        QTest::newRow("ogg") << sampleFile(QStringLiteral("/music/test.ogg")) << QStringLiteral("Title") << QStringLiteral("Test") << 1 << 1000 << false;
+        QTest::newRow("ogg with cover") << sampleFile(QStringLiteral("/cover_art/artist4/test.ogg")) << QStringLiteral("Title") << QStringLiteral("Album") << 1 << 1000 << true;
+        QTest::newRow("flac with cover") << sampleFile(QStringLiteral("/cover_art/artist4/test.flac")) << QStringLiteral("Title") << QStringLiteral("Album") << 1 << 1006 << true;
+        QTest::newRow("mp3") << sampleFile(QStringLiteral("/music/test.mp3")) << QStringLiteral("Title") << QStringLiteral("Test") << 1 << 1032 << false;
+        QTest::newRow("mp3 with cover") << sampleFile(QStringLiteral("/cover_art/artist4/test.mp3")) << QStringLiteral("Title") << QStringLiteral("Album") << 1 << 1032 << true;
+        QTest::newRow("m4a") << sampleFile(QStringLiteral("/music/test.m4a")) << QStringLiteral("Title") << QStringLiteral("Test") << 2 << 1028 << false;
+        QTest::newRow("playlist sample ogg") << sampleFile(QStringLiteral("/../samplefiles/test2.ogg")) << QStringLiteral("Title2") << QStringLiteral("Test2") << 1 << 1000 << false;
+    }
+
+    void readTrack()
+    {
+        QFETCH(QString, fileName);
+        QFETCH(QString, title);
+        QFETCH(QString, album);
+        QFETCH(int, channels);
+        QFETCH(int, durationMs);
+        QFETCH(bool, hasEmbeddedCover);
+
+        NativeTagReader reader;
+        DataTypes::TrackDataType track;
+        auto trackHasEmbeddedCover = std::optional<bool>{};
+
+        QVERIFY(reader.readTrack(fileName, mMimeDb.mimeTypeForFile(fileName).name(), track, trackHasEmbeddedCover));
+
+        QCOMPARE(track.title(), title);
+        QCOMPARE(track.album(), album);
+        QCOMPARE(track.albumArtist(), QStringLiteral("Album Artist"));
+        QCOMPARE(track.genre(), QStringLiteral("Genre"));
+        QCOMPARE(track.composer(), QStringLiteral("Composer"));
+        QCOMPARE(track.trackNumber(), 1);
+        QCOMPARE(track.discNumber(), 1);
+        QCOMPARE(track.year(), 2015);
+        QCOMPARE(track.channels(), channels);
+        QCOMPARE(track.sampleRate(), 48000);
+        QVERIFY(track.bitRate() > 0);
+        QCOMPARE(track.duration().msecsSinceStartOfDay(), durationMs);
+        QVERIFY(trackHasEmbeddedCover);
+        QCOMPARE(*trackHasEmbeddedCover, hasEmbeddedCover);
+    }
+
+    void readTrackWithMultipleValues()
+    {
+        const auto fileName = sampleFile(QStringLiteral("/music/testMultiple.ogg"));
+
+        NativeTagReader reader;
+        DataTypes::TrackDataType track;
+        auto hasEmbeddedCover = std::optional<bool>{};
+
+        QVERIFY(reader.readTrack(fileName, mMimeDb.mimeTypeForFile(fileName).name(), track, hasEmbeddedCover));
+
+        QVERIFY(track.artist().contains(QStringLiteral("Artist1")));
+        QVERIFY(track.artist().contains(QStringLiteral("Artist2")));
+        QVERIFY(track.genre().contains(QStringLiteral("Genre1")));
+        QVERIFY(track.genre().contains(QStringLiteral("Genre3")));
+        QVERIFY(track.composer().contains(QStringLiteral("Composer3")));
+        QVERIFY(hasEmbeddedCover);
+        QCOMPARE(*hasEmbeddedCover, false);
+    }
+
+    void readTrackWithManyTags()
+    {
+        const auto fileName = sampleFile(QStringLiteral("/music/testMany.ogg"));
+
+        NativeTagReader reader;
+        DataTypes::TrackDataType track;
+        auto hasEmbeddedCover = std::optional<bool>{};
+
+        QVERIFY(reader.readTrack(fileName, mMimeDb.mimeTypeForFile(fileName).name(), track, hasEmbeddedCover));
+
+        QCOMPARE(track.lyricist(), QStringLiteral("Lyricist"));
+        QCOMPARE(track.lyrics(), QStringLiteral("Lyrics"));
+        QCOMPARE(track.comment(), QStringLiteral("Comment"));
+        QCOMPARE(track.rating(), 5);
+        QVERIFY(hasEmbeddedCover);
+        QCOMPARE(*hasEmbeddedCover, true);
+    }
+
+    void unknownFormatIsNotHandled()
+    {
+        const auto fileName = sampleFile(QStringLiteral("/music/cover.jpg"));
+
+        NativeTagReader reader;
+        DataTypes::TrackDataType track;
+        auto hasEmbeddedCover = std::optional<bool>{false};
+
+        QVERIFY(!reader.readTrack(fileName, mMimeDb.mimeTypeForFile(fileName).name(), track, hasEmbeddedCover));
+        QVERIFY(track.isEmpty());
+        QVERIFY(!hasEmbeddedCover);
+
+        QVERIFY(!reader.readTrack(fileName, QStringLiteral("audio/mpeg"), track, hasEmbeddedCover));
+        QVERIFY(track.isEmpty());
+    }
+
+#if KFFileMetaData_FOUND
+    void sameResultAsKFileMetaData_data()
+    {
+        addSampleFilesColumns();
+    }
+
+    void sameResultAsKFileMetaData()
+    {
+        QFETCH(QString, fileName);
+
+        FileScanner nativeScanner;
+        FileScanner genericScanner;
+        genericScanner.setNativeTagReaderEnabled(false);
+
+        const auto nativeTrack = nativeScanner.scanOneFile(QUrl::fromLocalFile(fileName));
+        const auto genericTrack = genericScanner.scanOneFile(QUrl::fromLocalFile(fileName));
+
+        QVERIFY(nativeTrack.isValid());
+        QVERIFY(genericTrack.isValid());
+
+        QCOMPARE(nativeTrack.title(), genericTrack.title());
+        QCOMPARE(nativeTrack.album(), genericTrack.album());
+        QCOMPARE(nativeTrack.albumArtist(), genericTrack.albumArtist());
+        QCOMPARE(nativeTrack.artist(), genericTrack.artist());
+        QCOMPARE(nativeTrack.genre(), genericTrack.genre());
+        QCOMPARE(nativeTrack.composer(), genericTrack.composer());
+        QCOMPARE(nativeTrack.lyricist(), genericTrack.lyricist());
+        QCOMPARE(nativeTrack.comment(), genericTrack.comment());
+        QCOMPARE(nativeTrack.rating(), genericTrack.rating());
+        QCOMPARE(nativeTrack.trackNumber(), genericTrack.trackNumber());
+        QCOMPARE(nativeTrack.discNumber(), genericTrack.discNumber());
+        QCOMPARE(nativeTrack.year(), genericTrack.year());
+        QCOMPARE(nativeTrack.channels(), genericTrack.channels());
+        QCOMPARE(nativeTrack.sampleRate(), genericTrack.sampleRate());
+        QCOMPARE(nativeTrack.hasEmbeddedCover(), genericTrack.hasEmbeddedCover());
+        QVERIFY(qAbs(nativeTrack.duration().msecsTo(genericTrack.duration())) < 1000);
+    }
+#endif
+
+    void benchmarkFileScan_data()
+    {
+        QTest::addColumn<bool>("useNativeTagReader");
+
+        QTest::newRow("native tag reader") << true;
+#if KFFileMetaData_FOUND
+        QTest::newRow("KFileMetaData") << false;
+#endif
+    }
+
+    void benchmarkFileScan()
+    {
+        QFETCH(bool, useNativeTagReader);
+
+        const auto allFiles = QStringList{
+            sampleFile(QStringLiteral("/music/test.ogg")),
+            sampleFile(QStringLiteral("/music/test.mp3")),
+            sampleFile(QStringLiteral("/music/test.m4a")),
+            sampleFile(QStringLiteral("/cover_art/artist4/test.flac")),
+        };
+
+        FileScanner fileScanner;
+        fileScanner.setNativeTagReaderEnabled(useNativeTagReader);
+
+        QBENCHMARK {
+            for (const auto &oneFile : allFiles) {
+                auto scannedTrack = fileScanner.scanOneFile(QUrl::fromLocalFile(oneFile));
+            }
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(NativeTagReaderTest)
+
+
+#include "nativetagreadertest.moc"
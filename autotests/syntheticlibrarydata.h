@@ -0,0 +1,182 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SYNTHETICLIBRARYDATA_H
+#define SYNTHETICLIBRARYDATA_H
+
+#include "datatypes.h"
+
+#include <QUrl>
+#include <QString>
+#include <QDateTime>
+#include <QTime>
+#include <QSet>
+#include <QList>
+#include <QRandomGenerator>
+
+#include <algorithm>
+
+/**
+ * Deterministic music library of a given size with the shape of a real collection
+ *
+ * A few artists have many albums while most have one or two, a few genres cover most of the
+ * tracks, about one album in ten has several discs and one in twenty is a compilation of
+ * various artists. The same seed always gives the same tracks.
+ */
+class SyntheticLibraryData
+{
+public:
+
+    explicit SyntheticLibraryData(int tracksCount, quint32 seed = 2026)
+    {
+        generate(tracksCount, seed);
+    }
+
+    [[nodiscard]] const DataTypes::ListTrackDataType &tracks() const
+    {
+        return mTracks;
+    }
+
+    [[nodiscard]] int albumsCount() const
+    {
+        return mAlbumsCount;
+    }
+
+    [[nodiscard]] int multiDiscAlbumsCount() const
+    {
+        return mMultiDiscAlbumsCount;
+    }
+
+    [[nodiscard]] int artistsCount() const
+    {
+        return static_cast<int>(mArtists.size());
+    }
+
+    /**
+     * Files of @p count tracks picked at random, with the same seed always giving the same files
+     */
+    [[nodiscard]] QList<QUrl> sampleFiles(int count, quint32 seed = 7) const
+    {
+        auto result = QList<QUrl>{};
+        result.reserve(count);
+
+        auto generator = QRandomGenerator{seed};
+        for (int i = 0; i < count && !mTracks.isEmpty(); ++i) {
+            result.push_back(mTracks[generator.bounded(static_cast<int>(mTracks.size()))].resourceURI());
+        }
+
+        return result;
+    }
+
+private:
+
+    static constexpr int GenresCount = 40;
+
+    static constexpr int ComposersCount = 500;
+
+    // the weight of the nth genre is 1/n
+    static QList<double> cumulativeGenreWeights()
+    {
+        auto result = QList<double>{};
+        result.reserve(GenresCount);
+
+        auto total = 0.;
+        for (int i = 1; i <= GenresCount; ++i) {
+            total += 1. / i;
+            result.push_back(total);
+        }
+
+        return result;
+    }
+
+    static QString genre(QRandomGenerator &generator, const QList<double> &cumulativeWeights)
+    {
+        const auto value = generator.generateDouble() * cumulativeWeights.constLast();
+        const auto itGenre = std::lower_bound(cumulativeWeights.cbegin(), cumulativeWeights.cend(), value);
+
+        return QStringLiteral("Genre %1").arg(std::distance(cumulativeWeights.cbegin(), itGenre));
+    }
+
+    void generate(int tracksCount, quint32 seed)
+    {
+        auto generator = QRandomGenerator{seed};
+        const auto genreWeights = cumulativeGenreWeights();
+
+        mTracks.reserve(tracksCount);
+
+        auto artistIndex = 0;
+        auto albumIndex = 0;
+
+        while (mTracks.size() < tracksCount) {
+            const auto artist = QStringLiteral("Artist %1").arg(artistIndex);
+            const auto artistGenre = genre(generator, genreWeights);
+
+            // geometric number of albums: most artists have one or two, a few have a dozen
+            auto albumsCount = 1;
+            while (albumsCount < 25 && generator.bounded(100) < 55) {
+                ++albumsCount;
+            }
+
+            for (int album = 0; album < albumsCount && mTracks.size() < tracksCount; ++album, ++albumIndex) {
+                const auto isCompilation = generator.bounded(100) < 5;
+                const auto albumArtist = isCompilation ? QStringLiteral("Various Artists") : artist;
+                const auto albumTitle = generator.bounded(100) < 3 ? QStringLiteral("Greatest Hits") : QStringLiteral("Album %1").arg(albumIndex);
+                const auto discsCount = generator.bounded(100) < 10 ? 2 + generator.bounded(2) : 1;
+                const auto tracksPerDisc = 8 + generator.bounded(9);
+                const auto year = 1960 + generator.bounded(66);
+                const auto albumGenre = generator.bounded(100) < 80 ? artistGenre : genre(generator, genreWeights);
+
+                auto albumTracksCount = 0;
+
+                for (int disc = 1; disc <= discsCount && mTracks.size() < tracksCount; ++disc) {
+                    for (int trackNumber = 1; trackNumber <= tracksPerDisc && mTracks.size() < tracksCount; ++trackNumber) {
+                        const auto trackIndex = static_cast<int>(mTracks.size());
+                        const auto trackArtist = isCompilation ? QStringLiteral("Artist %1").arg(generator.bounded(artistIndex + 50)) : artist;
+                        const auto title = (disc == 1 && trackNumber == 1 && generator.bounded(100) < 2) ?
+                                    QStringLiteral("Intro") : QStringLiteral("Track %1").arg(trackIndex);
+                        const auto rating = generator.bounded(100) < 70 ? 0 : 2 * (1 + generator.bounded(5));
+                        const auto trackGenre = generator.bounded(100) < 90 ? albumGenre : genre(generator, genreWeights);
+
+                        auto oneTrack = DataTypes::TrackDataType{true, QString::number(trackIndex), QStringLiteral("0"), title,
+                                trackArtist, albumTitle, albumArtist,
+                                trackNumber, disc, QTime::fromMSecsSinceStartOfDay(120000 + generator.bounded(300000)),
+                                QUrl::fromLocalFile(QStringLiteral("/music/%1/%2 %3/%4-%5.flac").arg(albumArtist).arg(albumIndex).arg(albumTitle).arg(disc).arg(trackNumber)),
+                                QDateTime::fromMSecsSinceEpoch(trackIndex), {}, rating, discsCount == 1,
+                                trackGenre, QStringLiteral("Composer %1").arg(artistIndex % ComposersCount),
+                                QStringLiteral("Lyricist %1").arg(artistIndex % ComposersCount), false};
+                        oneTrack[DataTypes::YearRole] = year;
+
+                        mArtists.insert(trackArtist);
+                        mArtists.insert(albumArtist);
+                        mTracks.push_back(oneTrack);
+                        ++albumTracksCount;
+                    }
+                }
+
+                if (albumTracksCount > 0) {
+                    ++mAlbumsCount;
+
+                    if (discsCount > 1) {
+                        ++mMultiDiscAlbumsCount;
+                    }
+                }
+            }
+
+            ++artistIndex;
+        }
+    }
+
+    DataTypes::ListTrackDataType mTracks;
+
+    QSet<QString> mArtists;
+
+    int mAlbumsCount = 0;
+
+    int mMultiDiscAlbumsCount = 0;
+
+};
+
+#endif // SYNTHETICLIBRARYDATA_H
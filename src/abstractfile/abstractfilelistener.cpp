@@ -79,6 +79,11 @@ void AbstractFileListener::setAllRootPaths(const QStringList &allRootPaths)
     d->mFileListing->setAllRootPaths(allRootPaths);
 }
 
+void AbstractFileListener::setDirectoryFingerprintsFileName(const QString &fileName)
+{
+    d->mFileListing->setDirectoryFingerprintsFileName(fileName);
+}
+
 void AbstractFileListener::setFileListing(AbstractFileListing *fileIndexer)
 {
     d->mFileListing = fileIndexer;
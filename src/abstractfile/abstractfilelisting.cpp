@@ -9,6 +9,11 @@
 #include "config-upnp-qt.h"
 
 #include "abstractfile/indexercommon.h"
+#include "abstractfile/directorytree.h"
+#include "abstractfile/directoryfingerprints.h"
+#include "abstractfile/directorywalker.h"
+#include "abstractfile/filesystemmonitor.h"
+#include "abstractfile/indexerstatistics.h"
 
 #include "filescanner.h"
 #include "elisa_settings.h"
@@ -17,55 +22,65 @@
 #include <QFileInfo>
 #include <QFile>
 #include <QDir>
-#include <QFileSystemWatcher>
 #include <QSet>
 #include <QAtomicInt>
+#include <QTimeZone>
+#include <QTimer>
+#include <QElapsedTimer>
 
 
 #include <algorithm>
+#include <memory>
 #include <utility>
 
-static QUrl getParentDirectory(const QUrl &filePath)
+class AbstractFileListingPrivate
 {
-    return QUrl::fromLocalFile(QFileInfo{filePath.toLocalFile()}.absolutePath());
-}
+public:
 
-struct FileSystemPath {
-    QUrl path;
-    bool isFile;
-    QDateTime lastModified;
-};
+    QStringList mAllRootPaths;
 
-inline bool operator==(const FileSystemPath &path1, const FileSystemPath &path2)
-{
-    return path1.path == path2.path && path1.isFile == path2.isFile;
-}
+    FileSystemMonitor *mFileSystemMonitor = nullptr;
 
-inline size_t qHash(const FileSystemPath &fileSystemPath, size_t seed = 0)
-{
-    return qHash(fileSystemPath.path, seed);
-}
+    QTimer *mFileSystemChangesTimer = nullptr;
 
-class AbstractFileListingPrivate
-{
-public:
+    QElapsedTimer mFileSystemChangesBurst;
 
-    QStringList mAllRootPaths;
+    QSet<QString> mChangedDirectories;
 
-    QFileSystemWatcher mFileSystemWatcher;
+    QSet<QString> mChangedFiles;
 
     QHash<QString, QUrl> mAllAlbumCover;
 
-    QHash<QUrl, QSet<FileSystemPath>> mDiscoveredDirectories;
+    DirectoryTree mDiscoveredDirectories;
+
+    DirectoryFingerprints mDirectoryFingerprints;
+
+    QHash<QString, DirectoryFingerprint> mPendingFingerprints;
+
+    DirectoryWalker mDirectoryWalker;
 
     FileScanner mFileScanner;
 
+    std::unique_ptr<FileScanPipeline> mScanPipeline;
+
+    IndexerStatistics *mStatistics = nullptr;
+
     QAtomicInt mStopRequest = 0;
 
     int mImportedTracksCount = 0;
 
     int mNewFilesEmitInterval = 1;
 
+    int mMaximumNewFilesBatchSize = DefaultMaximumNewFilesBatchSize;
+
+    int mExtractedFilesCount = 0;
+
+    int mListedDirectoriesCount = 0;
+
+    int mFileSystemChangesQuietPeriod = DefaultFileSystemChangesQuietPeriodMs;
+
+    int mDirectoryQuietPeriod = DefaultDirectoryQuietPeriodMs;
+
     bool mHandleNewFiles = true;
 
     bool mWaitEndTrackRemoval = false;
@@ -74,14 +89,36 @@ public:
 
     bool mIsActive = false;
 
+    bool mIsProcessingFileSystemChanges = false;
+
+    bool mScanNewSubDirectoriesOnly = false;
+
+    static constexpr int DefaultDirectoryQuietPeriodMs = 2000;
+
+    static constexpr int DefaultFileSystemChangesQuietPeriodMs = 1000;
+
+    static constexpr int DefaultMaximumNewFilesBatchSize = 50;
+
+    // a continuous stream of changes is still handled from time to time
+    static constexpr int MaximumFileSystemChangesDelayFactor = 10;
+
 };
 
 AbstractFileListing::AbstractFileListing(QObject *parent) : QObject(parent), d(std::make_unique<AbstractFileListingPrivate>())
 {
-    connect(&d->mFileSystemWatcher, &QFileSystemWatcher::directoryChanged,
+    // a child follows the listing to its thread
+    d->mFileSystemMonitor = new FileSystemMonitor(this);
+
+    connect(d->mFileSystemMonitor, &FileSystemMonitor::directoryChanged,
             this, &AbstractFileListing::directoryChanged);
-    connect(&d->mFileSystemWatcher, &QFileSystemWatcher::fileChanged,
+    connect(d->mFileSystemMonitor, &FileSystemMonitor::fileChanged,
             this, &AbstractFileListing::fileChanged);
+
+    d->mFileSystemChangesTimer = new QTimer(this);
+    d->mFileSystemChangesTimer->setSingleShot(true);
+
+    connect(d->mFileSystemChangesTimer, &QTimer::timeout,
+            this, &AbstractFileListing::processFileSystemChanges);
 }
 
 AbstractFileListing::~AbstractFileListing()
@@ -126,6 +163,46 @@ void AbstractFileListing::setAllRootPaths(const QStringList &allRootPaths)
     d->mAllRootPaths = allRootPaths;
 }
 
+void AbstractFileListing::setDirectoryFingerprintsFileName(const QString &fileName)
+{
+    d->mDirectoryFingerprints.setFileName(fileName);
+}
+
+void AbstractFileListing::setFileSystemChangesQuietPeriod(int quietPeriodMs)
+{
+    d->mFileSystemChangesQuietPeriod = std::max(0, quietPeriodMs);
+}
+
+int AbstractFileListing::fileSystemChangesQuietPeriod() const
+{
+    return d->mFileSystemChangesQuietPeriod;
+}
+
+void AbstractFileListing::setDirectoryQuietPeriod(int quietPeriodMs)
+{
+    d->mDirectoryQuietPeriod = std::max(0, quietPeriodMs);
+}
+
+void AbstractFileListing::setMaximumNewFilesBatchSize(int batchSize)
+{
+    d->mMaximumNewFilesBatchSize = std::max(1, batchSize);
+}
+
+void AbstractFileListing::setStatistics(IndexerStatistics *statistics)
+{
+    d->mStatistics = statistics;
+}
+
+int AbstractFileListing::extractedFilesCount() const
+{
+    return d->mExtractedFilesCount;
+}
+
+int AbstractFileListing::listedDirectoriesCount() const
+{
+    return d->mListedDirectoriesCount;
+}
+
 void AbstractFileListing::databaseFinishedInsertingTracksList()
 {
 }
@@ -159,42 +236,58 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
         return;
     }
 
-    QDir rootDirectory(path.toLocalFile());
-    rootDirectory.refresh();
+    const auto directoryPath = QDir::cleanPath(path.toLocalFile());
+    const auto directoryInfo = QFileInfo(directoryPath);
 
-    if (rootDirectory.exists()) {
+    if (directoryInfo.isDir()) {
         if (watchForFileSystemChanges & WatchChangedDirectories) {
             watchPath(path.toLocalFile());
         }
     }
 
+    if (skipUnchangedDirectory(newFiles, directoryPath, directoryInfo, watchForFileSystemChanges)) {
+        return;
+    }
+
     auto currentFilesList = QSet<QUrl>();
+    auto currentFingerprint = DirectoryFingerprint(directoryInfo);
 
-    rootDirectory.refresh();
-    const auto entryList = rootDirectory.entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+    const auto entryList = d->mDirectoryWalker.entries(directoryPath);
+    ++d->mListedDirectoriesCount;
     for (const auto &oneEntry : entryList) {
-        auto newFilePath = QUrl::fromLocalFile(oneEntry.canonicalFilePath());
+        currentFilesList.insert(QUrl::fromLocalFile(oneEntry.canonicalPath));
+        currentFingerprint.addEntry(oneEntry);
+    }
 
-        if (oneEntry.isDir() || oneEntry.isFile()) {
-            currentFilesList.insert(newFilePath);
-        }
+    const auto *previousFingerprint = d->mDirectoryFingerprints.fingerprint(directoryPath);
+    if (previousFingerprint && previousFingerprint->hasSameEntries(currentFingerprint) &&
+            previousFingerprint->indexedFilesCount == d->mDiscoveredDirectories.fileEntriesCount(directoryPath)) {
+        qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << directoryPath << "touched but content not modified";
+
+        addPendingFingerprint(directoryPath, currentFingerprint);
+        scanSubDirectories(newFiles, directoryPath, currentFingerprint.subDirectories, watchForFileSystemChanges);
+
+        return;
     }
 
-    auto &currentDirectoryListingFiles = d->mDiscoveredDirectories[path];
+    d->mDiscoveredDirectories.markDiscoveredDirectory(path.toLocalFile());
+    const auto currentDirectoryListingFiles = d->mDiscoveredDirectories.entries(path.toLocalFile());
     auto allRemovedTracks = QList<QUrl>();
 
     for (const auto &removedFilePath : currentDirectoryListingFiles) {
-        if (currentFilesList.contains(removedFilePath.path)) {
+        const auto removedFileUrl = QUrl::fromLocalFile(removedFilePath.path);
+
+        if (currentFilesList.contains(removedFileUrl)) {
             continue;
         }
 
         if (removedFilePath.isFile) {
-            allRemovedTracks.push_back(removedFilePath.path);
+            allRemovedTracks.push_back(removedFileUrl);
         } else {
-            removeFile(removedFilePath.path, allRemovedTracks);
+            removeFile(removedFileUrl, allRemovedTracks);
         }
 
-        currentDirectoryListingFiles.remove(removedFilePath);
+        d->mDiscoveredDirectories.removeEntry(removedFilePath.path);
     }
 
     if (!allRemovedTracks.isEmpty()) {
@@ -205,10 +298,19 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
         return;
     }
 
-    for (const auto &newFilePath : std::as_const(currentFilesList)) {
-        QFileInfo oneEntry(newFilePath.toLocalFile());
+    for (const auto &oneEntry : entryList) {
+        const auto newFilePath = QUrl::fromLocalFile(oneEntry.canonicalPath);
+
+        // several entries can be links to the same file
+        if (!currentFilesList.remove(newFilePath)) {
+            continue;
+        }
+
+        if (oneEntry.isDirectory) {
+            if (skipKnownSubDirectory(oneEntry.canonicalPath)) {
+                continue;
+            }
 
-        if (oneEntry.isDir()) {
             addFileInDirectory(newFilePath, path, WatchChangedDirectories | WatchChangedFiles);
             scanDirectory(newFiles, newFilePath, WatchChangedDirectories | WatchChangedFiles);
 
@@ -218,82 +320,306 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
 
             continue;
         }
-        if (!oneEntry.isFile()) {
+
+        if (!fileModifiedSinceLastScan(newFilePath, QDateTime::fromMSecsSinceEpoch(oneEntry.changeTime, QTimeZone::UTC))) {
+            qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << newFilePath << "file not modified since last scan";
             continue;
         }
 
-        if (!fileModifiedSinceLastScan(newFilePath, path, oneEntry.metadataChangeTime())) {
-            qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << newFilePath << "file not modified since last scan";
+        if (d->mScanPipeline) {
+            while (d->mScanPipeline->isFull() && d->mStopRequest == 0) {
+                if (auto scanResult = d->mScanPipeline->takeNextResult(true)) {
+                    addScanResult(newFiles, *scanResult);
+                }
+            }
+
+            if (d->mStopRequest == 1) {
+                break;
+            }
+
+            d->mScanPipeline->submit(newFilePath, path);
+            collectScannedFiles(newFiles, false);
+
             continue;
         }
 
-        auto newTrack = scanOneFile(newFilePath, oneEntry, WatchChangedDirectories | WatchChangedFiles);
+        auto newTrack = scanOneFile(newFilePath, QFileInfo(oneEntry.canonicalPath), WatchChangedDirectories | WatchChangedFiles);
 
-        if (newTrack.isValid() && d->mStopRequest == 0) {
-            addCover(newTrack);
+        addScannedTrack(newFiles, newFilePath, path, newTrack);
 
-            addFileInDirectory(newTrack.resourceURI(), path, WatchChangedDirectories | WatchChangedFiles);
-            newFiles.push_back(newTrack);
+        if (d->mStopRequest == 1) {
+            break;
+        }
+    }
 
-            ++d->mImportedTracksCount;
+    addPendingFingerprint(directoryPath, currentFingerprint);
+}
 
-            if (newFiles.size() > d->mNewFilesEmitInterval && d->mStopRequest == 0) {
-                d->mNewFilesEmitInterval = std::min(50, 1 + d->mNewFilesEmitInterval * d->mNewFilesEmitInterval);
-                emitNewFiles(newFiles);
-                newFiles.clear();
-            }
-        } else {
-            qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << newFilePath << "is not a valid track";
+bool AbstractFileListing::skipUnchangedDirectory(DataTypes::ListTrackDataType &newFiles, const QString &directoryPath,
+                                                 const QFileInfo &directoryInfo, FileSystemWatchingModes watchForFileSystemChanges)
+{
+    // a full rescan clears the fingerprints to also find the files rewritten in place while Elisa was not running
+    const auto *fingerprint = d->mDirectoryFingerprints.fingerprint(directoryPath);
+    if (!fingerprint || !fingerprint->hasSameTimestamps(directoryInfo)) {
+        return false;
+    }
+
+    // the index may have been modified or cleared since the fingerprint was taken
+    if (fingerprint->indexedFilesCount != d->mDiscoveredDirectories.fileEntriesCount(directoryPath)) {
+        return false;
+    }
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::skipUnchangedDirectory" << directoryPath;
+
+    // the fingerprint is kept for the next refresh
+    addPendingFingerprint(directoryPath, *fingerprint);
+
+    const auto subDirectories = fingerprint->subDirectories;
+    scanSubDirectories(newFiles, directoryPath, subDirectories, watchForFileSystemChanges);
+
+    return true;
+}
+
+void AbstractFileListing::scanSubDirectories(DataTypes::ListTrackDataType &newFiles, const QString &directoryPath,
+                                             const QStringList &subDirectories, FileSystemWatchingModes watchForFileSystemChanges)
+{
+    d->mDiscoveredDirectories.markDiscoveredDirectory(directoryPath);
+
+    // a change deep in the tree does not modify the timestamps of the parent directories
+    for (const auto &oneSubDirectory : subDirectories) {
+        if (skipKnownSubDirectory(oneSubDirectory)) {
+            continue;
         }
 
+        d->mDiscoveredDirectories.addEntry(oneSubDirectory, false, {});
+        scanDirectory(newFiles, QUrl::fromLocalFile(oneSubDirectory), watchForFileSystemChanges);
+
         if (d->mStopRequest == 1) {
             break;
         }
     }
 }
 
-void AbstractFileListing::directoryChanged(const QString &path)
+bool AbstractFileListing::skipKnownSubDirectory(const QString &subDirectoryPath) const
+{
+    // a change of a directory is reported for itself: its known sub-directories did not change
+    return d->mScanNewSubDirectoriesOnly && d->mDiscoveredDirectories.isDiscoveredDirectory(subDirectoryPath);
+}
+
+void AbstractFileListing::addPendingFingerprint(const QString &directoryPath, const DirectoryFingerprint &fingerprint)
 {
-    if (!d->mDiscoveredDirectories.contains(QUrl::fromLocalFile(path))) {
+    if (d->mStopRequest == 1 || !fingerprint.isStable(QDateTime::currentDateTime(), d->mDirectoryQuietPeriod)) {
         return;
     }
 
-    Q_EMIT indexingStarted();
+    d->mPendingFingerprints.insert(directoryPath, fingerprint);
+}
 
-    scanDirectoryTree(path);
+void AbstractFileListing::commitPendingFingerprints()
+{
+    if (d->mStopRequest == 1) {
+        d->mPendingFingerprints.clear();
+        return;
+    }
 
-    Q_EMIT indexingFinished();
+    for (auto itFingerprint = d->mPendingFingerprints.begin(); itFingerprint != d->mPendingFingerprints.end(); ++itFingerprint) {
+        // only known once the extraction of the files of the directory is finished
+        itFingerprint->indexedFilesCount = d->mDiscoveredDirectories.fileEntriesCount(itFingerprint.key());
+        d->mDirectoryFingerprints.setFingerprint(itFingerprint.key(), *itFingerprint);
+    }
+
+    d->mPendingFingerprints.clear();
+}
+
+void AbstractFileListing::addScannedTrack(DataTypes::ListTrackDataType &newFiles, const QUrl &newFilePath, const QUrl &path, const DataTypes::TrackDataType &newTrack)
+{
+    if (newTrack.isValid() && d->mStopRequest == 0) {
+        addCover(newTrack);
+
+        addFileInDirectory(newTrack.resourceURI(), path, WatchChangedDirectories | WatchChangedFiles);
+        newFiles.push_back(newTrack);
+
+        ++d->mImportedTracksCount;
+
+        // the tracks found while handling file system changes are reported at once
+        if (!d->mIsProcessingFileSystemChanges && newFiles.size() > d->mNewFilesEmitInterval && d->mStopRequest == 0) {
+            d->mNewFilesEmitInterval = std::min(d->mMaximumNewFilesBatchSize, 1 + d->mNewFilesEmitInterval * d->mNewFilesEmitInterval);
+            emitNewFiles(newFiles);
+            newFiles.clear();
+        }
+    } else {
+        qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << newFilePath << "is not a valid track";
+    }
+}
+
+void AbstractFileListing::collectScannedFiles(DataTypes::ListTrackDataType &newFiles, bool waitForAllFiles)
+{
+    if (!d->mScanPipeline) {
+        return;
+    }
+
+    if (d->mStopRequest == 1) {
+        d->mScanPipeline->cancelPending();
+    }
+
+    while (auto scanResult = d->mScanPipeline->takeNextResult(waitForAllFiles)) {
+        addScanResult(newFiles, *scanResult);
+    }
+}
+
+void AbstractFileListing::addScanResult(DataTypes::ListTrackDataType &newFiles, const FileScanPipeline::ScanResult &scanResult)
+{
+    ++d->mExtractedFilesCount;
+
+    if (d->mStatistics) {
+        d->mStatistics->addExtraction(scanResult.fileName, scanResult.extractionTimeNs, scanResult.track.isValid());
+    }
+
+    if (scanResult.track.isValid() && d->mStopRequest == 0) {
+        watchFile(scanResult.fileName.toLocalFile());
+    }
+
+    addScannedTrack(newFiles, scanResult.fileName, scanResult.parentDirectory, scanResult.track);
+}
+
+void AbstractFileListing::directoryChanged(const QString &path)
+{
+    if (!d->mDiscoveredDirectories.isDiscoveredDirectory(path)) {
+        return;
+    }
+
+    d->mChangedDirectories.insert(QDir::cleanPath(path));
+    scheduleFileSystemChanges();
 }
 
 void AbstractFileListing::fileChanged(const QString &modifiedFileName)
 {
-    QFileInfo modifiedFileInfo(modifiedFileName);
-    auto modifiedFile = QUrl::fromLocalFile(modifiedFileName);
+    // the native monitor reports all the files of the watched directories: new ones are
+    // handled through the change of their directory
+    if (!d->mDiscoveredDirectories.containsFile(modifiedFileName)) {
+        return;
+    }
+
+    d->mChangedFiles.insert(modifiedFileName);
+    scheduleFileSystemChanges();
+}
+
+void AbstractFileListing::scheduleFileSystemChanges()
+{
+    if (!d->mFileSystemChangesBurst.isValid()) {
+        d->mFileSystemChangesBurst.start();
+    }
+
+    const auto maximumDelay = qint64{d->mFileSystemChangesQuietPeriod} * AbstractFileListingPrivate::MaximumFileSystemChangesDelayFactor;
+    if (d->mFileSystemChangesBurst.elapsed() >= maximumDelay) {
+        if (!d->mFileSystemChangesTimer->isActive()) {
+            d->mFileSystemChangesTimer->start(0);
+        }
+        return;
+    }
+
+    // each new change restarts the quiet period
+    d->mFileSystemChangesTimer->start(d->mFileSystemChangesQuietPeriod);
+}
+
+void AbstractFileListing::processFileSystemChanges()
+{
+    auto changedDirectories = QStringList(d->mChangedDirectories.cbegin(), d->mChangedDirectories.cend());
+    auto changedFiles = QStringList(d->mChangedFiles.cbegin(), d->mChangedFiles.cend());
+
+    d->mChangedDirectories.clear();
+    d->mChangedFiles.clear();
+    d->mFileSystemChangesBurst.invalidate();
+
+    if (d->mStopRequest == 1 || (changedDirectories.isEmpty() && changedFiles.isEmpty())) {
+        return;
+    }
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::processFileSystemChanges" << changedDirectories.size() << "directories"
+                                  << changedFiles.size() << "files";
+
+    Q_EMIT indexingStarted();
+
+    // a parent directory comes before its children: a child removed with its parent is not listed
+    std::sort(changedDirectories.begin(), changedDirectories.end());
+
+    d->mIsProcessingFileSystemChanges = true;
+    d->mScanNewSubDirectoriesOnly = true;
+
+    auto newFiles = DataTypes::ListTrackDataType();
+
+    for (const auto &oneDirectory : std::as_const(changedDirectories)) {
+        // it may have been removed with one of its parents
+        if (!d->mDiscoveredDirectories.isDiscoveredDirectory(oneDirectory)) {
+            continue;
+        }
+
+        scanDirectory(newFiles, QUrl::fromLocalFile(oneDirectory), WatchChangedDirectories | WatchChangedFiles);
+    }
+
+    collectScannedFiles(newFiles, true);
+    commitPendingFingerprints();
+
+    d->mScanNewSubDirectoriesOnly = false;
+    d->mIsProcessingFileSystemChanges = false;
+
+    if (!newFiles.isEmpty() && d->mStopRequest == 0) {
+        emitNewFiles(newFiles);
+    }
 
-    auto modifiedTrack = scanOneFile(modifiedFile, modifiedFileInfo, WatchChangedDirectories | WatchChangedFiles);
+    auto modifiedTracks = DataTypes::ListTrackDataType();
 
-    if (modifiedTrack.isValid()) {
-        Q_EMIT modifyTracksList({modifiedTrack}, d->mAllAlbumCover);
+    std::sort(changedFiles.begin(), changedFiles.end());
+
+    for (const auto &modifiedFileName : std::as_const(changedFiles)) {
+        if (d->mStopRequest == 1) {
+            break;
+        }
+
+        if (!d->mDiscoveredDirectories.containsFile(modifiedFileName)) {
+            continue;
+        }
+
+        const auto modifiedFileInfo = QFileInfo(modifiedFileName);
+        const auto modifiedFile = QUrl::fromLocalFile(modifiedFileName);
+        const auto changeTime = modifiedFileInfo.metadataChangeTime();
+
+        // already extracted during the scan of its directory or not modified since then
+        if (!fileModifiedSinceLastScan(modifiedFile, changeTime)) {
+            continue;
+        }
+
+        auto modifiedTrack = scanOneFile(modifiedFile, modifiedFileInfo, WatchChangedDirectories | WatchChangedFiles);
+
+        if (modifiedTrack.isValid()) {
+            d->mDiscoveredDirectories.addEntry(modifiedFileName, true, changeTime);
+            modifiedTracks.push_back(modifiedTrack);
+        }
+    }
+
+    if (!modifiedTracks.isEmpty() && d->mStopRequest == 0) {
+        Q_EMIT modifyTracksList(modifiedTracks, d->mAllAlbumCover);
     }
+
+    saveDirectoryFingerprints();
+
+    Q_EMIT indexingFinished();
 }
 
 void AbstractFileListing::executeInit(const QHash<QUrl, QDateTime> &allFiles)
 {
     d->mDiscoveredDirectories.clear();
+    d->mDiscoveredDirectories.setRootPaths(d->mAllRootPaths);
 
     QList<QUrl> removedPaths;
 
     for (const auto &pathInfo : allFiles.asKeyValueRange()) {
         const auto &pathToBeIndexed = pathInfo.first;
         const auto &lastModified = pathInfo.second;
-        bool indexThisPath = std::any_of(d->mAllRootPaths.cbegin(), d->mAllRootPaths.cend(),
-                                         [&](const auto &rootPath) {
-            return QUrl::fromLocalFile(rootPath).isParentOf(pathToBeIndexed);
-        });
-
-        if (indexThisPath) {
-            const auto parentPath = getParentDirectory(pathToBeIndexed);
-            d->mDiscoveredDirectories[parentPath].insert({pathToBeIndexed, true, lastModified});
+        const auto localPathToBeIndexed = pathToBeIndexed.toLocalFile();
+
+        if (pathToBeIndexed.isLocalFile() && d->mDiscoveredDirectories.isInsideRootPaths(localPathToBeIndexed)) {
+            d->mDiscoveredDirectories.addEntry(localPathToBeIndexed, true, lastModified);
         } else {
             removedPaths.push_back(pathToBeIndexed);
         }
@@ -311,10 +637,14 @@ void AbstractFileListing::triggerStop()
 void AbstractFileListing::triggerRefreshOfContent()
 {
     d->mImportedTracksCount = 0;
+
+    d->mDirectoryFingerprints.load();
+    d->mDirectoryFingerprints.retainRootPaths(d->mAllRootPaths);
 }
 
 void AbstractFileListing::resetAndRefreshContent()
 {
+    d->mDirectoryFingerprints.clear();
     executeInit({});
     refreshContent();
 }
@@ -330,18 +660,19 @@ DataTypes::TrackDataType AbstractFileListing::scanOneFile(const QUrl &scanFile,
 
     qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::scanOneFile" << scanFile;
 
-    auto localFileName = scanFile.toLocalFile();
-
-    if (!d->mFileScanner.shouldScanFile(localFileName)) {
-        qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::scanOneFile" << "invalid mime type";
-        return newTrack;
-    }
+    QElapsedTimer extractionTimer;
+    extractionTimer.start();
 
     newTrack = d->mFileScanner.scanOneFile(scanFile, scanFileInfo);
+    ++d->mExtractedFilesCount;
+
+    if (d->mStatistics) {
+        d->mStatistics->addExtraction(scanFile, extractionTimer.nsecsElapsed(), newTrack.isValid());
+    }
 
     if (newTrack.isValid() && scanFileInfo.exists()) {
         if (watchForFileSystemChanges & WatchChangedFiles) {
-            watchPath(scanFile.toLocalFile());
+            watchFile(scanFile.toLocalFile());
         }
     }
 
@@ -350,42 +681,61 @@ DataTypes::TrackDataType AbstractFileListing::scanOneFile(const QUrl &scanFile,
 
 void AbstractFileListing::watchPath(const QString &pathName)
 {
-    if (!d->mFileSystemWatcher.addPath(pathName)) {
+    if (!d->mFileSystemMonitor->watchDirectory(pathName)) {
         qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::watchPath" << "fail for" << pathName;
 
-        if (!d->mErrorWatchingFileSystemChanges) {
-            d->mErrorWatchingFileSystemChanges = true;
-            Q_EMIT errorWatchingFileSystemChanges();
-        }
+        signalErrorWatchingFileSystemChanges();
+    }
+}
+
+void AbstractFileListing::watchFile(const QString &fileName)
+{
+    if (!d->mFileSystemMonitor->watchFile(fileName)) {
+        qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::watchFile" << "fail for" << fileName;
+
+        signalErrorWatchingFileSystemChanges();
     }
 }
 
+void AbstractFileListing::signalErrorWatchingFileSystemChanges()
+{
+    if (!d->mErrorWatchingFileSystemChanges) {
+        d->mErrorWatchingFileSystemChanges = true;
+        Q_EMIT errorWatchingFileSystemChanges();
+    }
+}
+
+FileSystemMonitor &AbstractFileListing::fileSystemMonitor()
+{
+    return *d->mFileSystemMonitor;
+}
+
 void AbstractFileListing::addFileInDirectory(const QUrl &newFile, const QUrl &directoryName, FileSystemWatchingModes watchForFileSystemChanges)
 {
-    if (!d->mDiscoveredDirectories.contains(directoryName)) {
+    const auto directoryPath = directoryName.toLocalFile();
+
+    if (!d->mDiscoveredDirectories.isDiscoveredDirectory(directoryPath)) {
         if (watchForFileSystemChanges & WatchChangedDirectories) {
-            watchPath(directoryName.toLocalFile());
+            watchPath(directoryPath);
         }
 
-        QDir currentDirectory(directoryName.toLocalFile());
+        QDir currentDirectory(directoryPath);
         if (currentDirectory.cdUp()) {
             const auto parentDirectoryName = currentDirectory.absolutePath();
-            const auto parentDirectory = QUrl::fromLocalFile(parentDirectoryName);
-            if (!d->mDiscoveredDirectories.contains(parentDirectory)) {
+            if (!d->mDiscoveredDirectories.isDiscoveredDirectory(parentDirectoryName)) {
                 if (watchForFileSystemChanges & WatchChangedDirectories) {
                     watchPath(parentDirectoryName);
                 }
             }
 
-            auto &parentCurrentDirectoryListingFiles = d->mDiscoveredDirectories[parentDirectory];
-
-            parentCurrentDirectoryListingFiles.insert({directoryName, false});
+            d->mDiscoveredDirectories.addEntry(directoryPath, false, {});
         }
     }
-    auto &currentDirectoryListingFiles = d->mDiscoveredDirectories[directoryName];
+
+    d->mDiscoveredDirectories.markDiscoveredDirectory(directoryPath);
 
     QFileInfo newFileInfo(newFile.toLocalFile());
-    currentDirectoryListingFiles.insert({newFile, newFileInfo.isFile(), newFileInfo.metadataChangeTime()});
+    d->mDiscoveredDirectories.addEntry(newFile.toLocalFile(), newFileInfo.isFile(), newFileInfo.metadataChangeTime());
 }
 
 void AbstractFileListing::scanDirectoryTree(const QString &path)
@@ -395,12 +745,35 @@ void AbstractFileListing::scanDirectoryTree(const QString &path)
     qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectoryTree" << path;
 
     scanDirectory(newFiles, QUrl::fromLocalFile(path), WatchChangedDirectories | WatchChangedFiles);
+    collectScannedFiles(newFiles, true);
+    commitPendingFingerprints();
 
     if (!newFiles.isEmpty() && d->mStopRequest == 0) {
         emitNewFiles(newFiles);
     }
 }
 
+void AbstractFileListing::saveDirectoryFingerprints()
+{
+    d->mDirectoryFingerprints.save();
+}
+
+void AbstractFileListing::setExtractionWorkerCount(int workerCount)
+{
+    const auto effectiveWorkerCount = FileScanPipeline::effectiveWorkerCount(workerCount);
+
+    if (effectiveWorkerCount <= 1) {
+        d->mScanPipeline.reset();
+        return;
+    }
+
+    if (d->mScanPipeline && d->mScanPipeline->workerCount() == effectiveWorkerCount) {
+        return;
+    }
+
+    d->mScanPipeline = std::make_unique<FileScanPipeline>(effectiveWorkerCount, d->mStopRequest);
+}
+
 void AbstractFileListing::setHandleNewFiles(bool handleThem)
 {
     d->mHandleNewFiles = handleThem;
@@ -425,28 +798,24 @@ void AbstractFileListing::addCover(const DataTypes::TrackDataType &newTrack)
 
 void AbstractFileListing::removeDirectory(const QUrl &removedDirectory, QList<QUrl> &allRemovedFiles)
 {
-    const auto itRemovedDirectory = d->mDiscoveredDirectories.constFind(removedDirectory);
+    const auto removedDirectoryPath = removedDirectory.toLocalFile();
 
-    if (itRemovedDirectory == d->mDiscoveredDirectories.cend()) {
+    if (!d->mDiscoveredDirectories.isDiscoveredDirectory(removedDirectoryPath)) {
         return;
     }
 
-    const auto &currentRemovedDirectory = *itRemovedDirectory;
-    for (const auto &itFile : currentRemovedDirectory) {
-        if (itFile.path.isValid() && !itFile.path.isEmpty()) {
-            removeFile(itFile.path, allRemovedFiles);
-            if (itFile.isFile) {
-                allRemovedFiles.push_back(itFile.path);
-            }
-        }
-    }
+    d->mDirectoryFingerprints.removeSubtree(QDir::cleanPath(removedDirectoryPath));
+    d->mPendingFingerprints.remove(QDir::cleanPath(removedDirectoryPath));
 
-    d->mDiscoveredDirectories.erase(itRemovedDirectory);
+    const auto allFiles = d->mDiscoveredDirectories.removeDirectoryContent(removedDirectoryPath);
+    for (const auto &oneFile : allFiles) {
+        allRemovedFiles.push_back(QUrl::fromLocalFile(oneFile));
+    }
 }
 
 void AbstractFileListing::removeFile(const QUrl &oneRemovedTrack, QList<QUrl> &allRemovedFiles)
 {
-    if (d->mDiscoveredDirectories.contains(oneRemovedTrack)) {
+    if (d->mDiscoveredDirectories.isDiscoveredDirectory(oneRemovedTrack.toLocalFile())) {
         removeDirectory(oneRemovedTrack, allRemovedFiles);
     }
 }
@@ -471,20 +840,9 @@ bool AbstractFileListing::isActive() const
     return d->mIsActive;
 }
 
-bool AbstractFileListing::fileModifiedSinceLastScan(const QUrl &path, const QUrl &parentPath, const QDateTime &lastModified) const
+bool AbstractFileListing::fileModifiedSinceLastScan(const QUrl &path, const QDateTime &lastModified) const
 {
-    const auto parentDir = d->mDiscoveredDirectories.constFind(parentPath);
-    if (parentDir == d->mDiscoveredDirectories.cend()) {
-        return true;
-    }
-
-    const auto itPath = std::find_if(parentDir->cbegin(), parentDir->cend(),
-                                     [&](const auto &onePath) { return onePath.path == path; });
-    if (itPath == parentDir->cend()) {
-        return true;
-    }
-
-    return itPath->lastModified < lastModified;
+    return d->mDiscoveredDirectories.isEntryOutdated(path.toLocalFile(), lastModified);
 }
 
 
@@ -9,6 +9,7 @@
 
 #include "elisaLib_export.h"
 #include "datatypes.h"
+#include "abstractfile/filescanpipeline.h"
 
 #include <QObject>
 #include <QString>
@@ -20,7 +21,10 @@
 
 class AbstractFileListingPrivate;
 class FileScanner;
+class FileSystemMonitor;
+class IndexerStatistics;
 class QFileInfo;
+struct DirectoryFingerprint;
 
 class ELISALIB_EXPORT AbstractFileListing : public QObject
 {
@@ -47,6 +51,23 @@ public:
 
     [[nodiscard]] virtual bool canHandleRootPaths() const;
 
+    [[nodiscard]] int fileSystemChangesQuietPeriod() const;
+
+    /**
+     * Record the extraction time of each file in @p statistics, which must outlive the listing
+     */
+    void setStatistics(IndexerStatistics *statistics);
+
+    /**
+     * Number of files given to the file scanner since the creation of the listing
+     */
+    [[nodiscard]] int extractedFilesCount() const;
+
+    /**
+     * Number of directories whose entries were listed since the creation of the listing
+     */
+    [[nodiscard]] int listedDirectoriesCount() const;
+
 Q_SIGNALS:
 
     void tracksList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers);
@@ -88,6 +109,37 @@ public Q_SLOTS:
 
     void setAllRootPaths(const QStringList &allRootPaths);
 
+    /**
+     * Persist the fingerprints of the scanned directories in @p fileName
+     *
+     * A refresh does not list again the directories whose timestamps did not change, only their
+     * sub-directories are visited. A file whose tags are rewritten in place while Elisa is not
+     * running is then found by the file watcher once it runs or by a full rescan.
+     * Nothing is persisted when no file name is set.
+     */
+    void setDirectoryFingerprintsFileName(const QString &fileName);
+
+    /**
+     * Do not keep the fingerprint of a directory modified during the last @p quietPeriodMs
+     */
+    void setDirectoryQuietPeriod(int quietPeriodMs);
+
+    /**
+     * Wait until no file system change was reported during @p quietPeriodMs before handling them
+     *
+     * All the changes of a burst are handled at once: each changed directory is listed once,
+     * each modified file is extracted once and the new or modified tracks are reported together.
+     * Only the sub-directories that appeared in a changed directory are listed recursively.
+     */
+    void setFileSystemChangesQuietPeriod(int quietPeriodMs);
+
+    /**
+     * Report at most @p batchSize new tracks at once
+     *
+     * The first batches of a scan are smaller to show the first tracks quickly.
+     */
+    void setMaximumNewFilesBatchSize(int batchSize);
+
     void databaseFinishedInsertingTracksList();
 
     void databaseFinishedRemovingTracksList();
@@ -98,6 +150,10 @@ protected Q_SLOTS:
 
     void fileChanged(const QString &modifiedFileName);
 
+private Q_SLOTS:
+
+    void processFileSystemChanges();
+
 protected:
 
     virtual void executeInit(const QHash<QUrl, QDateTime> &allFiles);
@@ -110,12 +166,27 @@ protected:
 
     virtual DataTypes::TrackDataType scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo, FileSystemWatchingModes watchForFileSystemChanges);
 
+    /**
+     * Watch the directory @p pathName for new, removed, renamed or modified entries
+     */
     void watchPath(const QString &pathName);
 
+    void watchFile(const QString &fileName);
+
     void addFileInDirectory(const QUrl &newFile, const QUrl &directoryName, FileSystemWatchingModes watchForFileSystemChanges);
 
     void scanDirectoryTree(const QString &path);
 
+    void saveDirectoryFingerprints();
+
+    /**
+     * Extract metadata of new files on @p workerCount threads during directory scans
+     *
+     * One worker per core when @p workerCount is not strictly positive. A single worker
+     * keeps the extraction on the calling thread.
+     */
+    void setExtractionWorkerCount(int workerCount);
+
     void setHandleNewFiles(bool handleThem);
 
     void emitNewFiles(const DataTypes::ListTrackDataType &tracks);
@@ -128,16 +199,40 @@ protected:
 
     FileScanner& fileScanner();
 
+    FileSystemMonitor& fileSystemMonitor();
+
     [[nodiscard]] bool waitEndTrackRemoval() const;
 
     void setWaitEndTrackRemoval(bool wait);
 
     [[nodiscard]] bool isActive() const;
 
-    [[nodiscard]] bool fileModifiedSinceLastScan(const QUrl &path, const QUrl &parentPath, const QDateTime &lastModified) const;
+    [[nodiscard]] bool fileModifiedSinceLastScan(const QUrl &path, const QDateTime &lastModified) const;
 
 private:
 
+    void addScannedTrack(DataTypes::ListTrackDataType &newFiles, const QUrl &newFilePath, const QUrl &path, const DataTypes::TrackDataType &newTrack);
+
+    void collectScannedFiles(DataTypes::ListTrackDataType &newFiles, bool waitForAllFiles);
+
+    void addScanResult(DataTypes::ListTrackDataType &newFiles, const FileScanPipeline::ScanResult &scanResult);
+
+    bool skipUnchangedDirectory(DataTypes::ListTrackDataType &newFiles, const QString &directoryPath,
+                                const QFileInfo &directoryInfo, FileSystemWatchingModes watchForFileSystemChanges);
+
+    void scanSubDirectories(DataTypes::ListTrackDataType &newFiles, const QString &directoryPath,
+                            const QStringList &subDirectories, FileSystemWatchingModes watchForFileSystemChanges);
+
+    void addPendingFingerprint(const QString &directoryPath, const DirectoryFingerprint &fingerprint);
+
+    void commitPendingFingerprints();
+
+    [[nodiscard]] bool skipKnownSubDirectory(const QString &subDirectoryPath) const;
+
+    void signalErrorWatchingFileSystemChanges();
+
+    void scheduleFileSystemChanges();
+
     std::unique_ptr<AbstractFileListingPrivate> d;
 
 };
@@ -0,0 +1,247 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "directoryfingerprints.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include <QFileInfo>
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QHash>
+
+#include <algorithm>
+
+namespace {
+
+constexpr quint32 FingerprintsFileMagic = 0x454c4446;
+
+constexpr quint32 FingerprintsFileVersion = 3;
+
+qint64 timestamp(const QDateTime &time)
+{
+    return time.isValid() ? time.toMSecsSinceEpoch() : 0;
+}
+
+QString subtreePrefix(const QString &directoryPath)
+{
+    return directoryPath.endsWith(QLatin1Char('/')) ? directoryPath : directoryPath + QLatin1Char('/');
+}
+
+}
+
+DirectoryFingerprint::DirectoryFingerprint(const QFileInfo &directoryInfo)
+    : modificationTime(timestamp(directoryInfo.lastModified())),
+      changeTime(timestamp(directoryInfo.metadataChangeTime())),
+      newestChangeTime(std::max(modificationTime, changeTime))
+{
+}
+
+void DirectoryFingerprint::addEntry(const DirectoryWalker::Entry &entry)
+{
+    ++entriesCount;
+    // the entries are combined by addition so that the hash does not depend on the listing order
+    entriesHash += qHashMulti(0, entry.fileName, entry.size, entry.modificationTime, entry.changeTime);
+    newestChangeTime = std::max({newestChangeTime, entry.modificationTime, entry.changeTime});
+
+    if (entry.isDirectory) {
+        subDirectories.push_back(entry.canonicalPath);
+    }
+}
+
+bool DirectoryFingerprint::hasSameTimestamps(const QFileInfo &directoryInfo) const
+{
+    return modificationTime == timestamp(directoryInfo.lastModified()) &&
+            changeTime == timestamp(directoryInfo.metadataChangeTime());
+}
+
+bool DirectoryFingerprint::hasSameEntries(const DirectoryFingerprint &other) const
+{
+    return entriesCount == other.entriesCount && entriesHash == other.entriesHash;
+}
+
+bool DirectoryFingerprint::isStable(const QDateTime &now, qint64 quietPeriodMs) const
+{
+    return newestChangeTime < timestamp(now) - quietPeriodMs;
+}
+
+class DirectoryFingerprintsPrivate
+{
+public:
+
+    QHash<QString, DirectoryFingerprint> mFingerprints;
+
+    QString mFileName;
+
+    bool mIsLoaded = false;
+
+    bool mIsModified = false;
+
+};
+
+DirectoryFingerprints::DirectoryFingerprints() : d(std::make_unique<DirectoryFingerprintsPrivate>())
+{
+}
+
+DirectoryFingerprints::~DirectoryFingerprints() = default;
+
+void DirectoryFingerprints::setFileName(const QString &fileName)
+{
+    if (d->mFileName == fileName) {
+        return;
+    }
+
+    d->mFileName = fileName;
+    d->mIsLoaded = false;
+}
+
+const QString &DirectoryFingerprints::fileName() const
+{
+    return d->mFileName;
+}
+
+void DirectoryFingerprints::load()
+{
+    if (d->mIsLoaded) {
+        return;
+    }
+
+    d->mIsLoaded = true;
+    d->mIsModified = false;
+    d->mFingerprints.clear();
+
+    if (d->mFileName.isEmpty()) {
+        return;
+    }
+
+    QFile fingerprintsFile(d->mFileName);
+    if (!fingerprintsFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream inputStream(&fingerprintsFile);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 fingerprintsCount = 0;
+
+    inputStream >> magic >> version >> fingerprintsCount;
+    if (magic != FingerprintsFileMagic || version != FingerprintsFileVersion || fingerprintsCount < 0) {
+        qCDebug(orgKdeElisaIndexer()) << "DirectoryFingerprints::load" << d->mFileName << "has an unknown format";
+        return;
+    }
+
+    d->mFingerprints.reserve(fingerprintsCount);
+
+    for (qint32 i = 0; i < fingerprintsCount; ++i) {
+        QString directoryPath;
+        DirectoryFingerprint oneFingerprint;
+
+        inputStream >> directoryPath >> oneFingerprint.modificationTime >> oneFingerprint.changeTime
+                    >> oneFingerprint.entriesCount >> oneFingerprint.entriesHash
+                    >> oneFingerprint.indexedFilesCount >> oneFingerprint.subDirectories;
+
+        if (inputStream.status() != QDataStream::Ok) {
+            qCDebug(orgKdeElisaIndexer()) << "DirectoryFingerprints::load" << d->mFileName << "is truncated";
+            d->mFingerprints.clear();
+            return;
+        }
+
+        d->mFingerprints.insert(directoryPath, oneFingerprint);
+    }
+
+    qCDebug(orgKdeElisaIndexer()) << "DirectoryFingerprints::load" << d->mFingerprints.size() << "directories from" << d->mFileName;
+}
+
+bool DirectoryFingerprints::save()
+{
+    if (!d->mIsModified || d->mFileName.isEmpty()) {
+        return true;
+    }
+
+    QSaveFile fingerprintsFile(d->mFileName);
+    if (!fingerprintsFile.open(QIODevice::WriteOnly)) {
+        qCDebug(orgKdeElisaIndexer()) << "DirectoryFingerprints::save" << "cannot open" << d->mFileName;
+        return false;
+    }
+
+    QDataStream outputStream(&fingerprintsFile);
+
+    outputStream << FingerprintsFileMagic << FingerprintsFileVersion << static_cast<qint32>(d->mFingerprints.size());
+
+    for (const auto &oneFingerprint : d->mFingerprints.asKeyValueRange()) {
+        outputStream << oneFingerprint.first << oneFingerprint.second.modificationTime << oneFingerprint.second.changeTime
+                     << oneFingerprint.second.entriesCount << oneFingerprint.second.entriesHash
+                     << oneFingerprint.second.indexedFilesCount << oneFingerprint.second.subDirectories;
+    }
+
+    if (!fingerprintsFile.commit()) {
+        qCDebug(orgKdeElisaIndexer()) << "DirectoryFingerprints::save" << "cannot write" << d->mFileName;
+        return false;
+    }
+
+    d->mIsModified = false;
+
+    return true;
+}
+
+void DirectoryFingerprints::clear()
+{
+    d->mIsLoaded = true;
+    d->mIsModified = true;
+    d->mFingerprints.clear();
+}
+
+int DirectoryFingerprints::count() const
+{
+    return static_cast<int>(d->mFingerprints.size());
+}
+
+const DirectoryFingerprint *DirectoryFingerprints::fingerprint(const QString &directoryPath) const
+{
+    const auto itFingerprint = d->mFingerprints.constFind(directoryPath);
+    if (itFingerprint == d->mFingerprints.cend()) {
+        return nullptr;
+    }
+
+    return &(*itFingerprint);
+}
+
+void DirectoryFingerprints::setFingerprint(const QString &directoryPath, const DirectoryFingerprint &fingerprint)
+{
+    d->mFingerprints.insert(directoryPath, fingerprint);
+    d->mIsModified = true;
+}
+
+void DirectoryFingerprints::removeSubtree(const QString &directoryPath)
+{
+    const auto prefix = subtreePrefix(directoryPath);
+
+    const auto removedCount = d->mFingerprints.removeIf([&](const auto &oneFingerprint) {
+        return oneFingerprint.key() == directoryPath || oneFingerprint.key().startsWith(prefix);
+    });
+
+    d->mIsModified = d->mIsModified || removedCount > 0;
+}
+
+void DirectoryFingerprints::retainRootPaths(const QStringList &rootPaths)
+{
+    QStringList allPrefixes;
+    allPrefixes.reserve(rootPaths.size());
+    for (const auto &oneRootPath : rootPaths) {
+        allPrefixes.push_back(subtreePrefix(oneRootPath));
+    }
+
+    const auto removedCount = d->mFingerprints.removeIf([&](const auto &oneFingerprint) {
+        const auto directoryPath = subtreePrefix(oneFingerprint.key());
+        return std::none_of(allPrefixes.cbegin(), allPrefixes.cend(), [&](const auto &onePrefix) {
+            return directoryPath.startsWith(onePrefix);
+        });
+    });
+
+    d->mIsModified = d->mIsModified || removedCount > 0;
+}
@@ -0,0 +1,120 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef DIRECTORYFINGERPRINTS_H
+#define DIRECTORYFINGERPRINTS_H
+
+#include "elisaLib_export.h"
+
+#include "abstractfile/directorywalker.h"
+
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+
+#include <memory>
+
+class DirectoryFingerprintsPrivate;
+class QFileInfo;
+
+/**
+ * Summary of the content of a directory at the time it was listed
+ *
+ * The timestamps of the directory change when an entry is added, removed or renamed.
+ * The entries hash covers the name, size, modification and change times of each entry and
+ * allows to detect listings that did not change even if the directory was touched.
+ */
+struct ELISALIB_EXPORT DirectoryFingerprint {
+
+    DirectoryFingerprint() = default;
+
+    explicit DirectoryFingerprint(const QFileInfo &directoryInfo);
+
+    void addEntry(const DirectoryWalker::Entry &entry);
+
+    /**
+     * Returns true if no entry was added, removed or renamed since the fingerprint was taken
+     *
+     * A file whose tags are rewritten in place does not modify the timestamps of its directory.
+     */
+    [[nodiscard]] bool hasSameTimestamps(const QFileInfo &directoryInfo) const;
+
+    [[nodiscard]] bool hasSameEntries(const DirectoryFingerprint &other) const;
+
+    /**
+     * Returns true if nothing in the directory changed during the last @p quietPeriodMs before @p now
+     *
+     * A directory still being written to could change again without its own timestamps
+     * changing if the file system timestamps are coarse: its fingerprint cannot be trusted.
+     */
+    [[nodiscard]] bool isStable(const QDateTime &now, qint64 quietPeriodMs) const;
+
+    qint64 modificationTime = 0;
+
+    qint64 changeTime = 0;
+
+    int entriesCount = 0;
+
+    quint64 entriesHash = 0;
+
+    int indexedFilesCount = 0;
+
+    QStringList subDirectories;
+
+    qint64 newestChangeTime = 0;
+
+};
+
+/**
+ * Fingerprints of all the directories listed by a file listing, persisted between runs
+ */
+class ELISALIB_EXPORT DirectoryFingerprints
+{
+public:
+
+    DirectoryFingerprints();
+
+    ~DirectoryFingerprints();
+
+    void setFileName(const QString &fileName);
+
+    [[nodiscard]] const QString &fileName() const;
+
+    /**
+     * Read the persisted fingerprints once: later calls do nothing
+     */
+    void load();
+
+    /**
+     * Write the fingerprints if they were modified since the last load or save
+     */
+    bool save();
+
+    void clear();
+
+    [[nodiscard]] int count() const;
+
+    [[nodiscard]] const DirectoryFingerprint *fingerprint(const QString &directoryPath) const;
+
+    void setFingerprint(const QString &directoryPath, const DirectoryFingerprint &fingerprint);
+
+    /**
+     * Forget @p directoryPath and all the directories below it
+     */
+    void removeSubtree(const QString &directoryPath);
+
+    /**
+     * Forget all the directories that are not inside one of @p rootPaths
+     */
+    void retainRootPaths(const QStringList &rootPaths);
+
+private:
+
+    std::unique_ptr<DirectoryFingerprintsPrivate> d;
+
+};
+
+#endif // DIRECTORYFINGERPRINTS_H
@@ -0,0 +1,383 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "directorytree.h"
+
+#include <QHash>
+
+#include <algorithm>
+#include <limits>
+
+class DirectoryTreePrivate
+{
+public:
+
+    static constexpr int RootNode = 0;
+
+    static constexpr qint64 UnknownModificationTime = std::numeric_limits<qint64>::min();
+
+    struct Node {
+        QHash<quint32, int> mChildren;
+        qint64 mLastModified = UnknownModificationTime;
+        int mParent = -1;
+        quint32 mName = 0;
+        bool mIsFile = false;
+        bool mIsDiscovered = false;
+        bool mIsRoot = false;
+    };
+
+    DirectoryTreePrivate()
+    {
+        mNodes.push_back({});
+    }
+
+    static QStringList splitPath(const QString &path);
+
+    static qint64 modificationTime(const QDateTime &lastModified)
+    {
+        return lastModified.isValid() ? lastModified.toMSecsSinceEpoch() : UnknownModificationTime;
+    }
+
+    [[nodiscard]] int findNode(const QString &path) const;
+
+    int findOrCreateNode(const QString &path);
+
+    int allocateNode(int parentNode, quint32 name);
+
+    void releaseSubtree(int nodeId);
+
+    void collectFiles(int nodeId, QStringList &allFiles) const;
+
+    [[nodiscard]] QString nodePath(int nodeId) const;
+
+    QList<Node> mNodes;
+
+    QList<int> mFreeNodes;
+
+    QList<int> mRootNodes;
+
+    QHash<QString, quint32> mComponentIds;
+
+    QStringList mComponents;
+
+    int mUsedNodesCount = 0;
+
+};
+
+QStringList DirectoryTreePrivate::splitPath(const QString &path)
+{
+    auto components = path.split(QLatin1Char('/'));
+
+    // the leading empty component of an absolute path stands for the file system root
+    if (components.size() > 1) {
+        components.erase(std::remove_if(components.begin() + 1, components.end(),
+                                        [](const auto &oneComponent) {return oneComponent.isEmpty();}),
+                         components.end());
+    }
+
+    return components;
+}
+
+int DirectoryTreePrivate::findNode(const QString &path) const
+{
+    auto nodeId = RootNode;
+
+    const auto components = splitPath(path);
+    for (const auto &oneComponent : components) {
+        const auto itComponent = mComponentIds.constFind(oneComponent);
+        if (itComponent == mComponentIds.cend()) {
+            return -1;
+        }
+
+        const auto &children = mNodes[nodeId].mChildren;
+        const auto itChild = children.constFind(*itComponent);
+        if (itChild == children.cend()) {
+            return -1;
+        }
+
+        nodeId = *itChild;
+    }
+
+    return nodeId;
+}
+
+int DirectoryTreePrivate::findOrCreateNode(const QString &path)
+{
+    auto nodeId = RootNode;
+
+    const auto components = splitPath(path);
+    for (const auto &oneComponent : components) {
+        auto itComponent = mComponentIds.constFind(oneComponent);
+        if (itComponent == mComponentIds.cend()) {
+            itComponent = mComponentIds.insert(oneComponent, static_cast<quint32>(mComponents.size()));
+            mComponents.push_back(oneComponent);
+        }
+
+        const auto componentId = *itComponent;
+        const auto itChild = mNodes[nodeId].mChildren.constFind(componentId);
+        if (itChild != mNodes[nodeId].mChildren.cend()) {
+            nodeId = *itChild;
+            continue;
+        }
+
+        const auto newNode = allocateNode(nodeId, componentId);
+        mNodes[nodeId].mChildren.insert(componentId, newNode);
+        nodeId = newNode;
+    }
+
+    return nodeId;
+}
+
+int DirectoryTreePrivate::allocateNode(int parentNode, quint32 name)
+{
+    auto newNode = 0;
+
+    if (!mFreeNodes.isEmpty()) {
+        newNode = mFreeNodes.takeLast();
+        mNodes[newNode] = {};
+    } else {
+        newNode = static_cast<int>(mNodes.size());
+        mNodes.push_back({});
+    }
+
+    mNodes[newNode].mParent = parentNode;
+    mNodes[newNode].mName = name;
+    ++mUsedNodesCount;
+
+    return newNode;
+}
+
+void DirectoryTreePrivate::releaseSubtree(int nodeId)
+{
+    QList<int> pendingNodes{nodeId};
+
+    while (!pendingNodes.isEmpty()) {
+        const auto currentNode = pendingNodes.takeLast();
+
+        for (const auto childNode : std::as_const(mNodes[currentNode].mChildren)) {
+            pendingNodes.push_back(childNode);
+        }
+
+        // the node may be reused by any other path
+        if (mNodes[currentNode].mIsRoot) {
+            mRootNodes.removeAll(currentNode);
+        }
+
+        mNodes[currentNode] = {};
+        mFreeNodes.push_back(currentNode);
+        --mUsedNodesCount;
+    }
+}
+
+void DirectoryTreePrivate::collectFiles(int nodeId, QStringList &allFiles) const
+{
+    QList<int> pendingNodes{nodeId};
+
+    while (!pendingNodes.isEmpty()) {
+        const auto currentNode = pendingNodes.takeLast();
+        const auto &node = mNodes[currentNode];
+
+        if (node.mIsFile) {
+            allFiles.push_back(nodePath(currentNode));
+        }
+
+        for (const auto childNode : node.mChildren) {
+            pendingNodes.push_back(childNode);
+        }
+    }
+}
+
+QString DirectoryTreePrivate::nodePath(int nodeId) const
+{
+    QStringList components;
+
+    while (nodeId != RootNode && nodeId >= 0) {
+        components.push_front(mComponents[mNodes[nodeId].mName]);
+        nodeId = mNodes[nodeId].mParent;
+    }
+
+    auto path = components.join(QLatin1Char('/'));
+    if (path.isEmpty()) {
+        path = QStringLiteral("/");
+    }
+
+    return path;
+}
+
+DirectoryTree::DirectoryTree() : d(std::make_unique<DirectoryTreePrivate>())
+{
+}
+
+DirectoryTree::~DirectoryTree() = default;
+
+void DirectoryTree::clear()
+{
+    d = std::make_unique<DirectoryTreePrivate>();
+}
+
+void DirectoryTree::setRootPaths(const QStringList &rootPaths)
+{
+    for (const auto rootNode : std::as_const(d->mRootNodes)) {
+        d->mNodes[rootNode].mIsRoot = false;
+    }
+    d->mRootNodes.clear();
+
+    for (const auto &oneRootPath : rootPaths) {
+        const auto rootNode = d->findOrCreateNode(oneRootPath);
+        d->mNodes[rootNode].mIsRoot = true;
+        d->mRootNodes.push_back(rootNode);
+    }
+}
+
+bool DirectoryTree::isInsideRootPaths(const QString &path) const
+{
+    auto nodeId = DirectoryTreePrivate::RootNode;
+
+    const auto components = DirectoryTreePrivate::splitPath(path);
+    for (qsizetype componentIndex = 0; componentIndex < components.size() - 1; ++componentIndex) {
+        const auto itComponent = d->mComponentIds.constFind(components[componentIndex]);
+        if (itComponent == d->mComponentIds.cend()) {
+            return false;
+        }
+
+        const auto &children = d->mNodes[nodeId].mChildren;
+        const auto itChild = children.constFind(*itComponent);
+        if (itChild == children.cend()) {
+            return false;
+        }
+
+        nodeId = *itChild;
+
+        if (d->mNodes[nodeId].mIsRoot) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool DirectoryTree::isDiscoveredDirectory(const QString &directoryPath) const
+{
+    const auto nodeId = d->findNode(directoryPath);
+
+    return nodeId > DirectoryTreePrivate::RootNode && d->mNodes[nodeId].mIsDiscovered;
+}
+
+void DirectoryTree::markDiscoveredDirectory(const QString &directoryPath)
+{
+    const auto nodeId = d->findOrCreateNode(directoryPath);
+
+    d->mNodes[nodeId].mIsDiscovered = true;
+}
+
+void DirectoryTree::addEntry(const QString &entryPath, bool isFile, const QDateTime &lastModified)
+{
+    const auto nodeId = d->findOrCreateNode(entryPath);
+    if (nodeId == DirectoryTreePrivate::RootNode) {
+        return;
+    }
+
+    auto &node = d->mNodes[nodeId];
+    node.mIsFile = isFile;
+    node.mLastModified = DirectoryTreePrivate::modificationTime(lastModified);
+
+    if (node.mParent != DirectoryTreePrivate::RootNode) {
+        d->mNodes[node.mParent].mIsDiscovered = true;
+    }
+}
+
+void DirectoryTree::removeEntry(const QString &entryPath)
+{
+    const auto nodeId = d->findNode(entryPath);
+    if (nodeId <= DirectoryTreePrivate::RootNode) {
+        return;
+    }
+
+    const auto &node = d->mNodes[nodeId];
+    d->mNodes[node.mParent].mChildren.remove(node.mName);
+
+    d->releaseSubtree(nodeId);
+}
+
+QStringList DirectoryTree::removeDirectoryContent(const QString &directoryPath)
+{
+    QStringList allFiles;
+
+    const auto nodeId = d->findNode(directoryPath);
+    if (nodeId <= DirectoryTreePrivate::RootNode) {
+        return allFiles;
+    }
+
+    const auto children = d->mNodes[nodeId].mChildren;
+    for (const auto childNode : children) {
+        d->collectFiles(childNode, allFiles);
+        d->releaseSubtree(childNode);
+    }
+
+    d->mNodes[nodeId].mChildren.clear();
+    d->mNodes[nodeId].mIsDiscovered = false;
+
+    return allFiles;
+}
+
+QList<DirectoryTree::Entry> DirectoryTree::entries(const QString &directoryPath) const
+{
+    QList<Entry> result;
+
+    const auto nodeId = d->findNode(directoryPath);
+    if (nodeId < DirectoryTreePrivate::RootNode) {
+        return result;
+    }
+
+    auto pathPrefix = d->nodePath(nodeId);
+    if (!pathPrefix.endsWith(QLatin1Char('/'))) {
+        pathPrefix += QLatin1Char('/');
+    }
+
+    const auto &children = d->mNodes[nodeId].mChildren;
+    result.reserve(children.size());
+
+    for (const auto childNode : children) {
+        const auto &node = d->mNodes[childNode];
+        result.push_back({pathPrefix + d->mComponents[node.mName], node.mIsFile});
+    }
+
+    return result;
+}
+
+int DirectoryTree::fileEntriesCount(const QString &directoryPath) const
+{
+    const auto nodeId = d->findNode(directoryPath);
+    if (nodeId < DirectoryTreePrivate::RootNode) {
+        return 0;
+    }
+
+    const auto &children = d->mNodes[nodeId].mChildren;
+    return static_cast<int>(std::count_if(children.cbegin(), children.cend(),
+                                          [this](const auto childNode) {return d->mNodes[childNode].mIsFile;}));
+}
+
+bool DirectoryTree::containsFile(const QString &filePath) const
+{
+    const auto nodeId = d->findNode(filePath);
+
+    return nodeId > DirectoryTreePrivate::RootNode && d->mNodes[nodeId].mIsFile;
+}
+
+bool DirectoryTree::isEntryOutdated(const QString &entryPath, const QDateTime &lastModified) const
+{
+    const auto nodeId = d->findNode(entryPath);
+    if (nodeId <= DirectoryTreePrivate::RootNode) {
+        return true;
+    }
+
+    return d->mNodes[nodeId].mLastModified < DirectoryTreePrivate::modificationTime(lastModified);
+}
+
+int DirectoryTree::nodesCount() const
+{
+    return d->mUsedNodesCount;
+}
@@ -0,0 +1,98 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef DIRECTORYTREE_H
+#define DIRECTORYTREE_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QList>
+
+#include <memory>
+
+class DirectoryTreePrivate;
+
+/**
+ * In-memory tree of the files and directories known by a file listing
+ *
+ * Each node stores one interned path component, so common prefixes of paths are stored
+ * once. Finding, adding or removing a path, or checking if it is inside a root path,
+ * costs one hash lookup per path component.
+ *
+ * A directory is discovered once its content is known: it has been scanned or contains
+ * known entries.
+ */
+class ELISALIB_EXPORT DirectoryTree
+{
+public:
+
+    struct Entry {
+        QString path;
+        bool isFile = false;
+    };
+
+    DirectoryTree();
+
+    ~DirectoryTree();
+
+    void clear();
+
+    void setRootPaths(const QStringList &rootPaths);
+
+    /**
+     * Returns true if @p path is strictly inside one of the root paths
+     */
+    [[nodiscard]] bool isInsideRootPaths(const QString &path) const;
+
+    [[nodiscard]] bool isDiscoveredDirectory(const QString &directoryPath) const;
+
+    void markDiscoveredDirectory(const QString &directoryPath);
+
+    /**
+     * Add or update @p entryPath and mark its parent directory as discovered
+     */
+    void addEntry(const QString &entryPath, bool isFile, const QDateTime &lastModified);
+
+    /**
+     * Remove @p entryPath and everything below it
+     *
+     * The root paths removed with it are forgotten until the next call to setRootPaths().
+     */
+    void removeEntry(const QString &entryPath);
+
+    /**
+     * Forget the content of @p directoryPath that is no longer discovered
+     *
+     * Returns the files that were known below it, at any depth.
+     */
+    QStringList removeDirectoryContent(const QString &directoryPath);
+
+    [[nodiscard]] QList<Entry> entries(const QString &directoryPath) const;
+
+    /**
+     * Returns the number of files directly inside @p directoryPath
+     */
+    [[nodiscard]] int fileEntriesCount(const QString &directoryPath) const;
+
+    [[nodiscard]] bool containsFile(const QString &filePath) const;
+
+    /**
+     * Returns true if @p entryPath is unknown or was modified before @p lastModified
+     */
+    [[nodiscard]] bool isEntryOutdated(const QString &entryPath, const QDateTime &lastModified) const;
+
+    [[nodiscard]] int nodesCount() const;
+
+private:
+
+    std::unique_ptr<DirectoryTreePrivate> d;
+
+};
+
+#endif // DIRECTORYTREE_H
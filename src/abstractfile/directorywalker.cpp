@@ -0,0 +1,219 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "directorywalker.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+
+#if defined(SYS_getdents64) && defined(STATX_BASIC_STATS)
+#define ELISA_HAS_NATIVE_DIRECTORY_WALKER 1
+#endif
+#endif
+
+#if !defined(ELISA_HAS_NATIVE_DIRECTORY_WALKER)
+#define ELISA_HAS_NATIVE_DIRECTORY_WALKER 0
+#endif
+
+namespace {
+
+qint64 timestamp(const QDateTime &time)
+{
+    return time.isValid() ? time.toMSecsSinceEpoch() : 0;
+}
+
+#if ELISA_HAS_NATIVE_DIRECTORY_WALKER
+
+// layout of the records returned by the getdents64 system call
+struct KernelDirectoryEntry {
+    quint64 inode;
+    qint64 offset;
+    unsigned short recordLength;
+    unsigned char type;
+    char name[1];
+};
+
+constexpr auto StatxMask = STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_MTIME | STATX_CTIME;
+
+constexpr int DirectoryBufferSize = 32 * 1024;
+
+qint64 timestamp(const struct statx_timestamp &time)
+{
+    return time.tv_sec * 1000 + time.tv_nsec / 1000000;
+}
+
+#endif
+
+}
+
+class DirectoryWalkerPrivate
+{
+public:
+
+    [[nodiscard]] static QList<DirectoryWalker::Entry> qtEntries(const QString &directoryPath);
+
+#if ELISA_HAS_NATIVE_DIRECTORY_WALKER
+    [[nodiscard]] QList<DirectoryWalker::Entry> nativeEntries(const QString &directoryPath);
+
+    std::unique_ptr<quint64[]> mDirectoryBuffer = std::make_unique<quint64[]>(DirectoryBufferSize / sizeof(quint64));
+#endif
+
+    qint64 mSystemCallsCount = 0;
+
+    bool mUseNativeBackend = ELISA_HAS_NATIVE_DIRECTORY_WALKER;
+
+};
+
+QList<DirectoryWalker::Entry> DirectoryWalkerPrivate::qtEntries(const QString &directoryPath)
+{
+    QList<DirectoryWalker::Entry> result;
+
+    const auto entryList = QDir(directoryPath).entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+    result.reserve(entryList.size());
+
+    for (const auto &oneEntry : entryList) {
+        if (!oneEntry.isDir() && !oneEntry.isFile()) {
+            continue;
+        }
+
+        result.push_back({oneEntry.fileName(), oneEntry.canonicalFilePath(), oneEntry.size(),
+                          timestamp(oneEntry.lastModified()), timestamp(oneEntry.metadataChangeTime()), oneEntry.isDir()});
+    }
+
+    return result;
+}
+
+#if ELISA_HAS_NATIVE_DIRECTORY_WALKER
+QList<DirectoryWalker::Entry> DirectoryWalkerPrivate::nativeEntries(const QString &directoryPath)
+{
+    QList<DirectoryWalker::Entry> result;
+
+    const auto canonicalDirectoryPath = QFileInfo(directoryPath).canonicalFilePath();
+    if (canonicalDirectoryPath.isEmpty()) {
+        return result;
+    }
+
+    const auto pathPrefix = canonicalDirectoryPath.endsWith(QLatin1Char('/')) ? canonicalDirectoryPath : canonicalDirectoryPath + QLatin1Char('/');
+
+    ++mSystemCallsCount;
+    const auto directoryDescriptor = ::open(QFile::encodeName(canonicalDirectoryPath).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (directoryDescriptor < 0) {
+        qCDebug(orgKdeElisaIndexer()) << "DirectoryWalker::entries" << "cannot open" << directoryPath << errno;
+        return result;
+    }
+
+    auto *directoryBuffer = reinterpret_cast<char *>(mDirectoryBuffer.get());
+
+    while (true) {
+        ++mSystemCallsCount;
+        const auto readBytes = ::syscall(SYS_getdents64, directoryDescriptor, directoryBuffer, DirectoryBufferSize);
+        if (readBytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (readBytes <= 0) {
+            break;
+        }
+
+        for (long bufferOffset = 0; bufferOffset < readBytes;) {
+            const auto *recordStart = directoryBuffer + bufferOffset;
+            const auto *directoryEntry = reinterpret_cast<const KernelDirectoryEntry *>(recordStart);
+            const auto *entryName = recordStart + offsetof(KernelDirectoryEntry, name);
+
+            bufferOffset += directoryEntry->recordLength;
+
+            // hidden entries, including . and ..
+            if (entryName[0] == '.') {
+                continue;
+            }
+
+            struct statx entryStatus = {};
+
+            ++mSystemCallsCount;
+            if (::statx(directoryDescriptor, entryName, AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT, StatxMask, &entryStatus) != 0) {
+                continue;
+            }
+
+            const auto fileName = QFile::decodeName(entryName);
+            auto canonicalPath = pathPrefix + fileName;
+
+            if (S_ISLNK(entryStatus.stx_mode)) {
+                ++mSystemCallsCount;
+                if (::statx(directoryDescriptor, entryName, AT_NO_AUTOMOUNT, StatxMask, &entryStatus) != 0) {
+                    continue;
+                }
+
+                canonicalPath = QFileInfo(canonicalPath).canonicalFilePath();
+                if (canonicalPath.isEmpty()) {
+                    continue;
+                }
+            }
+
+            const auto isDirectory = S_ISDIR(entryStatus.stx_mode);
+            if (!isDirectory && !S_ISREG(entryStatus.stx_mode)) {
+                continue;
+            }
+
+            result.push_back({fileName, canonicalPath, static_cast<qint64>(entryStatus.stx_size),
+                              timestamp(entryStatus.stx_mtime), timestamp(entryStatus.stx_ctime), isDirectory});
+        }
+    }
+
+    ++mSystemCallsCount;
+    ::close(directoryDescriptor);
+
+    return result;
+}
+#endif
+
+DirectoryWalker::DirectoryWalker() : d(std::make_unique<DirectoryWalkerPrivate>())
+{
+}
+
+DirectoryWalker::~DirectoryWalker() = default;
+
+bool DirectoryWalker::hasNativeBackend()
+{
+    return ELISA_HAS_NATIVE_DIRECTORY_WALKER;
+}
+
+void DirectoryWalker::setNativeBackendEnabled(bool enabled)
+{
+    d->mUseNativeBackend = enabled && hasNativeBackend();
+}
+
+bool DirectoryWalker::isNativeBackendEnabled() const
+{
+    return d->mUseNativeBackend;
+}
+
+QList<DirectoryWalker::Entry> DirectoryWalker::entries(const QString &directoryPath)
+{
+#if ELISA_HAS_NATIVE_DIRECTORY_WALKER
+    if (d->mUseNativeBackend) {
+        return d->nativeEntries(directoryPath);
+    }
+#endif
+
+    return DirectoryWalkerPrivate::qtEntries(directoryPath);
+}
+
+qint64 DirectoryWalker::systemCallsCount() const
+{
+    return d->mSystemCallsCount;
+}
@@ -0,0 +1,71 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef DIRECTORYWALKER_H
+#define DIRECTORYWALKER_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QList>
+
+#include <memory>
+
+class DirectoryWalkerPrivate;
+
+/**
+ * List the directories and regular files inside a directory with their properties
+ *
+ * Hidden entries, broken symbolic links and special files are skipped like QDir does
+ * with QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs.
+ *
+ * On Linux, the entries are read in bulk with getdents64 and each one costs a single
+ * statx relative to the directory. Only symbolic links need their path canonicalized.
+ * Other platforms use QDir.
+ */
+class ELISALIB_EXPORT DirectoryWalker
+{
+public:
+
+    struct Entry {
+        QString fileName;
+        QString canonicalPath;
+        qint64 size = 0;
+        qint64 modificationTime = 0;
+        qint64 changeTime = 0;
+        bool isDirectory = false;
+    };
+
+    DirectoryWalker();
+
+    ~DirectoryWalker();
+
+    [[nodiscard]] static bool hasNativeBackend();
+
+    /**
+     * Use QDir even if a native backend is available
+     */
+    void setNativeBackendEnabled(bool enabled);
+
+    [[nodiscard]] bool isNativeBackendEnabled() const;
+
+    /**
+     * Returns the entries of @p directoryPath, empty if it cannot be read
+     */
+    [[nodiscard]] QList<Entry> entries(const QString &directoryPath);
+
+    /**
+     * Number of system calls issued by the native backend since its creation
+     */
+    [[nodiscard]] qint64 systemCallsCount() const;
+
+private:
+
+    std::unique_ptr<DirectoryWalkerPrivate> d;
+
+};
+
+#endif // DIRECTORYWALKER_H
@@ -0,0 +1,212 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "filescanpipeline.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include "filescanner.h"
+
+#include <QThread>
+#include <QThreadPool>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QHash>
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+class FileScanPipelinePrivate
+{
+public:
+
+    struct ScanJob {
+        qulonglong sequence;
+        QUrl fileName;
+        QUrl parentDirectory;
+    };
+
+    FileScanPipelinePrivate(int workerCount, const QAtomicInt &stopRequest)
+        : mStopRequest(stopRequest), mWorkerCount(workerCount), mCapacity(4 * workerCount)
+    {
+    }
+
+    void workerLoop();
+
+    const QAtomicInt &mStopRequest;
+
+    QThreadPool mThreadPool;
+
+    mutable QMutex mMutex;
+
+    QWaitCondition mJobAvailable;
+
+    QWaitCondition mResultAvailable;
+
+    std::deque<ScanJob> mJobs;
+
+    QHash<qulonglong, FileScanPipeline::ScanResult> mFinishedJobs;
+
+    qulonglong mNextSubmittedSequence = 0;
+
+    qulonglong mNextDeliveredSequence = 0;
+
+    const int mWorkerCount;
+
+    const int mCapacity;
+
+    bool mQuit = false;
+
+};
+
+void FileScanPipelinePrivate::workerLoop()
+{
+    FileScanner fileScanner;
+
+    QMutexLocker locker(&mMutex);
+
+    while (true) {
+        while (mJobs.empty() && !mQuit) {
+            mJobAvailable.wait(&mMutex);
+        }
+
+        if (mQuit) {
+            return;
+        }
+
+        auto currentJob = std::move(mJobs.front());
+        mJobs.pop_front();
+
+        locker.unlock();
+
+        auto result = FileScanPipeline::ScanResult{currentJob.fileName, currentJob.parentDirectory, {}};
+
+        if (mStopRequest.loadRelaxed() == 0) {
+            QElapsedTimer extractionTimer;
+            extractionTimer.start();
+
+            result.track = fileScanner.scanOneFile(currentJob.fileName, QFileInfo{currentJob.fileName.toLocalFile()});
+            result.extractionTimeNs = extractionTimer.nsecsElapsed();
+        }
+
+        locker.relock();
+
+        mFinishedJobs.insert(currentJob.sequence, std::move(result));
+        mResultAvailable.wakeAll();
+    }
+}
+
+FileScanPipeline::FileScanPipeline(int workerCount, const QAtomicInt &stopRequest)
+    : d(std::make_unique<FileScanPipelinePrivate>(std::max(1, workerCount), stopRequest))
+{
+    d->mThreadPool.setMaxThreadCount(d->mWorkerCount);
+
+    for (int i = 0; i < d->mWorkerCount; ++i) {
+        d->mThreadPool.start([this]() {
+            d->workerLoop();
+        });
+    }
+
+    qCDebug(orgKdeElisaIndexer) << "FileScanPipeline::FileScanPipeline" << d->mWorkerCount << "workers";
+}
+
+FileScanPipeline::~FileScanPipeline()
+{
+    {
+        QMutexLocker locker(&d->mMutex);
+        d->mQuit = true;
+        d->mJobAvailable.wakeAll();
+    }
+
+    d->mThreadPool.waitForDone();
+}
+
+int FileScanPipeline::workerCount() const
+{
+    return d->mWorkerCount;
+}
+
+int FileScanPipeline::capacity() const
+{
+    return d->mCapacity;
+}
+
+int FileScanPipeline::pendingCount() const
+{
+    QMutexLocker locker(&d->mMutex);
+    return static_cast<int>(d->mNextSubmittedSequence - d->mNextDeliveredSequence);
+}
+
+bool FileScanPipeline::isFull() const
+{
+    return pendingCount() >= d->mCapacity;
+}
+
+bool FileScanPipeline::submit(const QUrl &fileName, const QUrl &parentDirectory)
+{
+    QMutexLocker locker(&d->mMutex);
+
+    if (d->mNextSubmittedSequence - d->mNextDeliveredSequence >= static_cast<qulonglong>(d->mCapacity)) {
+        return false;
+    }
+
+    d->mJobs.push_back({d->mNextSubmittedSequence, fileName, parentDirectory});
+    ++d->mNextSubmittedSequence;
+
+    d->mJobAvailable.wakeOne();
+
+    return true;
+}
+
+std::optional<FileScanPipeline::ScanResult> FileScanPipeline::takeNextResult(bool waitForResult)
+{
+    QMutexLocker locker(&d->mMutex);
+
+    while (d->mNextDeliveredSequence != d->mNextSubmittedSequence) {
+        auto itResult = d->mFinishedJobs.find(d->mNextDeliveredSequence);
+
+        if (itResult != d->mFinishedJobs.end()) {
+            auto result = std::move(itResult.value());
+            d->mFinishedJobs.erase(itResult);
+            ++d->mNextDeliveredSequence;
+
+            return result;
+        }
+
+        if (!waitForResult) {
+            break;
+        }
+
+        d->mResultAvailable.wait(&d->mMutex);
+    }
+
+    return {};
+}
+
+void FileScanPipeline::cancelPending()
+{
+    QMutexLocker locker(&d->mMutex);
+
+    for (auto &oneJob : d->mJobs) {
+        d->mFinishedJobs.insert(oneJob.sequence, {oneJob.fileName, oneJob.parentDirectory, {}});
+    }
+    d->mJobs.clear();
+
+    d->mResultAvailable.wakeAll();
+}
+
+int FileScanPipeline::effectiveWorkerCount(int configuredCount)
+{
+    if (configuredCount > 0) {
+        return configuredCount;
+    }
+
+    return std::max(1, QThread::idealThreadCount());
+}
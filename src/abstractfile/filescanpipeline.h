@@ -0,0 +1,81 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef FILESCANPIPELINE_H
+#define FILESCANPIPELINE_H
+
+#include "elisaLib_export.h"
+
+#include "datatypes.h"
+
+#include <QUrl>
+#include <QAtomicInt>
+
+#include <memory>
+#include <optional>
+
+class FileScanPipelinePrivate;
+
+/**
+ * Extract metadata of files on a pool of worker threads
+ *
+ * The directory walk stays on the thread owning the pipeline: it submits files and
+ * gets the results back in submission order. The number of files waiting or being
+ * extracted is bounded by capacity(): submitting into a full pipeline is refused and
+ * the caller is expected to take results first.
+ *
+ * Each worker owns its FileScanner because FileScanner is not thread-safe.
+ */
+class ELISALIB_EXPORT FileScanPipeline
+{
+public:
+
+    struct ScanResult {
+        QUrl fileName;
+        QUrl parentDirectory;
+        DataTypes::TrackDataType track;
+        qint64 extractionTimeNs = 0;
+    };
+
+    FileScanPipeline(int workerCount, const QAtomicInt &stopRequest);
+
+    ~FileScanPipeline();
+
+    [[nodiscard]] int workerCount() const;
+
+    [[nodiscard]] int capacity() const;
+
+    [[nodiscard]] int pendingCount() const;
+
+    [[nodiscard]] bool isFull() const;
+
+    bool submit(const QUrl &fileName, const QUrl &parentDirectory);
+
+    /**
+     * Returns the oldest submitted file if its extraction is finished
+     *
+     * When @p waitForResult is true, block until it is available. Returns an empty
+     * optional when nothing is pending.
+     */
+    std::optional<ScanResult> takeNextResult(bool waitForResult);
+
+    /**
+     * Drop files not yet handed to a worker
+     */
+    void cancelPending();
+
+    /**
+     * Number of workers to use for @p configuredCount: one per core when it is not strictly positive
+     */
+    static int effectiveWorkerCount(int configuredCount);
+
+private:
+
+    std::unique_ptr<FileScanPipelinePrivate> d;
+
+};
+
+#endif // FILESCANPIPELINE_H
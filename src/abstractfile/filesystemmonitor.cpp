@@ -0,0 +1,299 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "filesystemmonitor.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include <QFileSystemWatcher>
+#include <QSocketNotifier>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+
+#if defined(Q_OS_LINUX)
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#define ELISA_HAS_INOTIFY_MONITOR 1
+#else
+#define ELISA_HAS_INOTIFY_MONITOR 0
+#endif
+
+namespace {
+
+#if ELISA_HAS_INOTIFY_MONITOR
+constexpr quint32 DirectoryWatchMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+        IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+constexpr quint32 EntriesChangedMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+
+constexpr quint32 FileChangedMask = IN_CLOSE_WRITE | IN_ATTRIB;
+
+constexpr int EventsBufferSize = 64 * 1024;
+#endif
+
+/**
+ * Paths in the order they were first added
+ */
+class ChangedPaths
+{
+public:
+
+    void add(const QString &path)
+    {
+        if (!mKnownPaths.contains(path)) {
+            mKnownPaths.insert(path);
+            mPaths.push_back(path);
+        }
+    }
+
+    [[nodiscard]] const QStringList &paths() const
+    {
+        return mPaths;
+    }
+
+private:
+
+    QSet<QString> mKnownPaths;
+
+    QStringList mPaths;
+
+};
+
+}
+
+class FileSystemMonitorPrivate
+{
+public:
+
+    QFileSystemWatcher *mFileSystemWatcher = nullptr;
+
+    QSocketNotifier *mNativeEventsNotifier = nullptr;
+
+    QHash<int, QString> mWatchedDirectories;
+
+    QHash<QString, int> mWatchDescriptors;
+
+    std::unique_ptr<quint64[]> mEventsBuffer;
+
+    int mInotifyDescriptor = -1;
+
+    bool mUseNativeBackend = ELISA_HAS_INOTIFY_MONITOR;
+
+    bool mIsInitialized = false;
+
+};
+
+FileSystemMonitor::FileSystemMonitor(QObject *parent) : QObject(parent), d(std::make_unique<FileSystemMonitorPrivate>())
+{
+}
+
+FileSystemMonitor::~FileSystemMonitor()
+{
+#if ELISA_HAS_INOTIFY_MONITOR
+    if (d->mInotifyDescriptor >= 0) {
+        delete d->mNativeEventsNotifier;
+        ::close(d->mInotifyDescriptor);
+    }
+#endif
+}
+
+bool FileSystemMonitor::hasNativeBackend()
+{
+    return ELISA_HAS_INOTIFY_MONITOR;
+}
+
+void FileSystemMonitor::setNativeBackendEnabled(bool enabled)
+{
+    if (d->mIsInitialized) {
+        qCDebug(orgKdeElisaIndexer()) << "FileSystemMonitor::setNativeBackendEnabled" << "ignored, paths are already watched";
+        return;
+    }
+
+    d->mUseNativeBackend = enabled && hasNativeBackend();
+}
+
+bool FileSystemMonitor::isNativeBackendEnabled() const
+{
+    return d->mUseNativeBackend;
+}
+
+bool FileSystemMonitor::watchDirectory(const QString &directoryPath)
+{
+    initialize();
+
+    if (!d->mUseNativeBackend) {
+        return d->mFileSystemWatcher->addPath(directoryPath);
+    }
+
+#if ELISA_HAS_INOTIFY_MONITOR
+    const auto cleanDirectoryPath = QDir::cleanPath(directoryPath);
+    if (d->mWatchDescriptors.contains(cleanDirectoryPath)) {
+        return true;
+    }
+
+    const auto watchDescriptor = ::inotify_add_watch(d->mInotifyDescriptor, QFile::encodeName(cleanDirectoryPath).constData(), DirectoryWatchMask);
+    if (watchDescriptor < 0) {
+        qCDebug(orgKdeElisaIndexer()) << "FileSystemMonitor::watchDirectory" << cleanDirectoryPath << "failed" << errno;
+        return false;
+    }
+
+    // the same directory reached through another path keeps its watch descriptor
+    const auto itPreviousPath = d->mWatchedDirectories.constFind(watchDescriptor);
+    if (itPreviousPath != d->mWatchedDirectories.cend()) {
+        d->mWatchDescriptors.remove(*itPreviousPath);
+    }
+
+    d->mWatchedDirectories[watchDescriptor] = cleanDirectoryPath;
+    d->mWatchDescriptors[cleanDirectoryPath] = watchDescriptor;
+#endif
+
+    return true;
+}
+
+bool FileSystemMonitor::watchFile(const QString &fileName)
+{
+    initialize();
+
+    if (!d->mUseNativeBackend) {
+        return d->mFileSystemWatcher->addPath(fileName);
+    }
+
+    return true;
+}
+
+int FileSystemMonitor::watchesCount() const
+{
+    if (!d->mIsInitialized) {
+        return 0;
+    }
+
+    if (!d->mUseNativeBackend) {
+        return static_cast<int>(d->mFileSystemWatcher->directories().size() + d->mFileSystemWatcher->files().size());
+    }
+
+    return static_cast<int>(d->mWatchedDirectories.size());
+}
+
+void FileSystemMonitor::initialize()
+{
+    if (d->mIsInitialized) {
+        return;
+    }
+
+    d->mIsInitialized = true;
+
+#if ELISA_HAS_INOTIFY_MONITOR
+    if (d->mUseNativeBackend) {
+        d->mInotifyDescriptor = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+        if (d->mInotifyDescriptor >= 0) {
+            d->mNativeEventsNotifier = new QSocketNotifier(d->mInotifyDescriptor, QSocketNotifier::Read, this);
+            connect(d->mNativeEventsNotifier, &QSocketNotifier::activated,
+                    this, &FileSystemMonitor::readNativeEvents);
+            return;
+        }
+
+        qCInfo(orgKdeElisaIndexer()) << "FileSystemMonitor::initialize" << "inotify is not available, falling back to QFileSystemWatcher" << errno;
+        d->mUseNativeBackend = false;
+    }
+#endif
+
+    d->mFileSystemWatcher = new QFileSystemWatcher(this);
+    connect(d->mFileSystemWatcher, &QFileSystemWatcher::directoryChanged,
+            this, &FileSystemMonitor::directoryChanged);
+    connect(d->mFileSystemWatcher, &QFileSystemWatcher::fileChanged,
+            this, &FileSystemMonitor::fileChanged);
+}
+
+void FileSystemMonitor::readNativeEvents()
+{
+#if ELISA_HAS_INOTIFY_MONITOR
+    ChangedPaths changedDirectories;
+    ChangedPaths changedFiles;
+
+    if (!d->mEventsBuffer) {
+        d->mEventsBuffer = std::make_unique<quint64[]>(EventsBufferSize / sizeof(quint64));
+    }
+
+    auto *eventsData = reinterpret_cast<char *>(d->mEventsBuffer.get());
+
+    while (true) {
+        const auto readBytes = ::read(d->mInotifyDescriptor, eventsData, EventsBufferSize);
+        if (readBytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (readBytes <= 0) {
+            break;
+        }
+
+        for (ssize_t eventOffset = 0; eventOffset < readBytes;) {
+            const auto *oneEvent = reinterpret_cast<const inotify_event *>(eventsData + eventOffset);
+            eventOffset += static_cast<ssize_t>(sizeof(inotify_event) + oneEvent->len);
+
+            if (oneEvent->mask & IN_Q_OVERFLOW) {
+                qCInfo(orgKdeElisaIndexer()) << "FileSystemMonitor::readNativeEvents" << "events were lost, all directories are reported as changed";
+
+                for (const auto &oneDirectory : std::as_const(d->mWatchedDirectories)) {
+                    changedDirectories.add(oneDirectory);
+                }
+                continue;
+            }
+
+            const auto itDirectory = d->mWatchedDirectories.constFind(oneEvent->wd);
+            if (itDirectory == d->mWatchedDirectories.cend()) {
+                continue;
+            }
+
+            const auto directoryPath = *itDirectory;
+
+            if (oneEvent->mask & IN_IGNORED) {
+                if (d->mWatchDescriptors.value(directoryPath, -1) == oneEvent->wd) {
+                    d->mWatchDescriptors.remove(directoryPath);
+                }
+                d->mWatchedDirectories.remove(oneEvent->wd);
+                continue;
+            }
+
+            if (oneEvent->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+                changedDirectories.add(directoryPath);
+
+                // the watch follows a moved directory: it will be watched again under its new path
+                if (oneEvent->mask & IN_MOVE_SELF) {
+                    ::inotify_rm_watch(d->mInotifyDescriptor, oneEvent->wd);
+                }
+                continue;
+            }
+
+            if (oneEvent->len == 0) {
+                continue;
+            }
+
+            if (oneEvent->mask & EntriesChangedMask) {
+                changedDirectories.add(directoryPath);
+            } else if ((oneEvent->mask & FileChangedMask) && !(oneEvent->mask & IN_ISDIR)) {
+                changedFiles.add(directoryPath + QLatin1Char('/') + QFile::decodeName(oneEvent->name));
+            }
+        }
+    }
+
+    for (const auto &oneDirectory : changedDirectories.paths()) {
+        Q_EMIT directoryChanged(oneDirectory);
+    }
+
+    for (const auto &oneFile : changedFiles.paths()) {
+        Q_EMIT fileChanged(oneFile);
+    }
+#endif
+}
+
+
+#include "moc_filesystemmonitor.cpp"
@@ -0,0 +1,81 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef FILESYSTEMMONITOR_H
+#define FILESYSTEMMONITOR_H
+
+#include "elisaLib_export.h"
+
+#include <QObject>
+#include <QString>
+
+#include <memory>
+
+class FileSystemMonitorPrivate;
+
+/**
+ * Report changes of watched directories and of the files they contain
+ *
+ * On Linux, only directories are watched with inotify: a change of a file is reported
+ * through the watch of its directory, so watching a file costs nothing. The events
+ * read at once are coalesced: each changed path is reported once.
+ *
+ * Other platforms, or when inotify is not available, use QFileSystemWatcher with one
+ * watch per directory and per file.
+ */
+class ELISALIB_EXPORT FileSystemMonitor : public QObject
+{
+
+    Q_OBJECT
+
+public:
+
+    explicit FileSystemMonitor(QObject *parent = nullptr);
+
+    ~FileSystemMonitor() override;
+
+    [[nodiscard]] static bool hasNativeBackend();
+
+    /**
+     * Use QFileSystemWatcher even if a native backend is available
+     *
+     * Must be called before anything is watched.
+     */
+    void setNativeBackendEnabled(bool enabled);
+
+    [[nodiscard]] bool isNativeBackendEnabled() const;
+
+    bool watchDirectory(const QString &directoryPath);
+
+    bool watchFile(const QString &fileName);
+
+    /**
+     * Number of watches registered in the kernel
+     */
+    [[nodiscard]] int watchesCount() const;
+
+Q_SIGNALS:
+
+    /**
+     * An entry of @p directoryPath was created, removed or renamed, or the directory itself was removed
+     */
+    void directoryChanged(const QString &directoryPath);
+
+    void fileChanged(const QString &fileName);
+
+private Q_SLOTS:
+
+    void readNativeEvents();
+
+private:
+
+    void initialize();
+
+    std::unique_ptr<FileSystemMonitorPrivate> d;
+
+};
+
+#endif // FILESYSTEMMONITOR_H
@@ -0,0 +1,220 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "indexerstatistics.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QList>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+double milliseconds(qint64 durationNs)
+{
+    return static_cast<double>(durationNs) / 1e6;
+}
+
+}
+
+class IndexerStatisticsPrivate
+{
+public:
+
+    struct Extraction {
+        QUrl fileName;
+        qint64 durationNs;
+    };
+
+    struct DatabaseBatch {
+        int tracksCount;
+        qint64 durationNs;
+    };
+
+    [[nodiscard]] QList<qint64> sortedExtractionTimes() const
+    {
+        auto result = QList<qint64>{};
+        result.reserve(mExtractions.size());
+
+        for (const auto &oneExtraction : mExtractions) {
+            result.push_back(oneExtraction.durationNs);
+        }
+
+        std::sort(result.begin(), result.end());
+
+        return result;
+    }
+
+    static qint64 percentile(const QList<qint64> &sortedValues, double percentile)
+    {
+        if (sortedValues.isEmpty()) {
+            return 0;
+        }
+
+        // nearest rank
+        const auto rank = static_cast<qsizetype>(std::ceil(percentile * static_cast<double>(sortedValues.size()) / 100.));
+
+        return sortedValues[std::clamp<qsizetype>(rank - 1, 0, sortedValues.size() - 1)];
+    }
+
+    mutable QMutex mMutex;
+
+    QElapsedTimer mRunTimer;
+
+    QList<Extraction> mExtractions;
+
+    QList<DatabaseBatch> mDatabaseBatches;
+
+    qint64 mElapsedMs = 0;
+
+    int mValidTracksCount = 0;
+
+    int mErrorsCount = 0;
+
+};
+
+IndexerStatistics::IndexerStatistics() : d(std::make_unique<IndexerStatisticsPrivate>())
+{
+}
+
+IndexerStatistics::~IndexerStatistics() = default;
+
+void IndexerStatistics::start()
+{
+    QMutexLocker locker(&d->mMutex);
+
+    d->mRunTimer.start();
+    d->mElapsedMs = 0;
+}
+
+void IndexerStatistics::stop()
+{
+    QMutexLocker locker(&d->mMutex);
+
+    if (d->mRunTimer.isValid()) {
+        d->mElapsedMs = d->mRunTimer.elapsed();
+    }
+}
+
+void IndexerStatistics::addExtraction(const QUrl &fileName, qint64 durationNs, bool isValidTrack)
+{
+    QMutexLocker locker(&d->mMutex);
+
+    d->mExtractions.push_back({fileName, durationNs});
+
+    if (isValidTrack) {
+        ++d->mValidTracksCount;
+    }
+}
+
+void IndexerStatistics::addDatabaseBatch(int tracksCount, qint64 durationNs)
+{
+    QMutexLocker locker(&d->mMutex);
+
+    d->mDatabaseBatches.push_back({tracksCount, durationNs});
+}
+
+void IndexerStatistics::addError()
+{
+    QMutexLocker locker(&d->mMutex);
+
+    ++d->mErrorsCount;
+}
+
+int IndexerStatistics::extractedFilesCount() const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    return static_cast<int>(d->mExtractions.size());
+}
+
+int IndexerStatistics::errorsCount() const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    return d->mErrorsCount;
+}
+
+qint64 IndexerStatistics::extractionTimePercentile(double percentile) const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    return IndexerStatisticsPrivate::percentile(d->sortedExtractionTimes(), percentile);
+}
+
+QJsonObject IndexerStatistics::toJson(int slowestFilesCount) const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    const auto elapsedMs = d->mRunTimer.isValid() && d->mElapsedMs == 0 ? d->mRunTimer.elapsed() : d->mElapsedMs;
+    const auto extractionTimes = d->sortedExtractionTimes();
+
+    auto totalExtractionNs = qint64{0};
+    for (const auto oneDuration : extractionTimes) {
+        totalExtractionNs += oneDuration;
+    }
+
+    auto extraction = QJsonObject{
+        {QStringLiteral("files"), static_cast<qint64>(extractionTimes.size())},
+        {QStringLiteral("validTracks"), d->mValidTracksCount},
+        {QStringLiteral("totalMs"), milliseconds(totalExtractionNs)},
+        {QStringLiteral("p50Ms"), milliseconds(IndexerStatisticsPrivate::percentile(extractionTimes, 50))},
+        {QStringLiteral("p90Ms"), milliseconds(IndexerStatisticsPrivate::percentile(extractionTimes, 90))},
+        {QStringLiteral("p99Ms"), milliseconds(IndexerStatisticsPrivate::percentile(extractionTimes, 99))},
+        {QStringLiteral("maxMs"), milliseconds(extractionTimes.isEmpty() ? 0 : extractionTimes.constLast())},
+    };
+
+    auto batches = QJsonArray{};
+    auto insertedTracksCount = 0;
+    auto totalInsertionNs = qint64{0};
+
+    for (const auto &oneBatch : std::as_const(d->mDatabaseBatches)) {
+        batches.push_back(QJsonObject{
+            {QStringLiteral("tracks"), oneBatch.tracksCount},
+            {QStringLiteral("ms"), milliseconds(oneBatch.durationNs)},
+        });
+
+        insertedTracksCount += oneBatch.tracksCount;
+        totalInsertionNs += oneBatch.durationNs;
+    }
+
+    auto database = QJsonObject{
+        {QStringLiteral("batchesCount"), static_cast<qint64>(d->mDatabaseBatches.size())},
+        {QStringLiteral("tracks"), insertedTracksCount},
+        {QStringLiteral("totalMs"), milliseconds(totalInsertionNs)},
+        {QStringLiteral("msPerTrack"), insertedTracksCount > 0 ? milliseconds(totalInsertionNs) / insertedTracksCount : 0.},
+        {QStringLiteral("batches"), batches},
+    };
+
+    auto slowestExtractions = d->mExtractions;
+    const auto slowestCount = std::min<qsizetype>(std::max(0, slowestFilesCount), slowestExtractions.size());
+
+    std::partial_sort(slowestExtractions.begin(), slowestExtractions.begin() + slowestCount, slowestExtractions.end(),
+                      [](const auto &left, const auto &right) {
+                          return left.durationNs > right.durationNs;
+                      });
+
+    auto slowestFiles = QJsonArray{};
+    for (qsizetype i = 0; i < slowestCount; ++i) {
+        slowestFiles.push_back(QJsonObject{
+            {QStringLiteral("file"), slowestExtractions[i].fileName.toLocalFile()},
+            {QStringLiteral("ms"), milliseconds(slowestExtractions[i].durationNs)},
+        });
+    }
+
+    return {
+        {QStringLiteral("elapsedMs"), elapsedMs},
+        {QStringLiteral("filesPerSecond"), elapsedMs > 0 ? 1000. * static_cast<double>(extractionTimes.size()) / static_cast<double>(elapsedMs) : 0.},
+        {QStringLiteral("extraction"), extraction},
+        {QStringLiteral("database"), database},
+        {QStringLiteral("slowestFiles"), slowestFiles},
+        {QStringLiteral("errors"), d->mErrorsCount},
+    };
+}
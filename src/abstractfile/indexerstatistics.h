@@ -0,0 +1,62 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INDEXERSTATISTICS_H
+#define INDEXERSTATISTICS_H
+
+#include "elisaLib_export.h"
+
+#include <QUrl>
+#include <QJsonObject>
+
+#include <memory>
+
+class IndexerStatisticsPrivate;
+
+/**
+ * Timings of an indexing run: metadata extraction of each file and insertion of each batch of tracks
+ *
+ * The extraction and the insertion happen on different threads: all methods are thread-safe.
+ */
+class ELISALIB_EXPORT IndexerStatistics
+{
+public:
+
+    IndexerStatistics();
+
+    ~IndexerStatistics();
+
+    void start();
+
+    void stop();
+
+    void addExtraction(const QUrl &fileName, qint64 durationNs, bool isValidTrack);
+
+    void addDatabaseBatch(int tracksCount, qint64 durationNs);
+
+    void addError();
+
+    [[nodiscard]] int extractedFilesCount() const;
+
+    [[nodiscard]] int errorsCount() const;
+
+    /**
+     * Extraction time in nanoseconds below which @p percentile percent of the files were extracted
+     */
+    [[nodiscard]] qint64 extractionTimePercentile(double percentile) const;
+
+    /**
+     * Summary of the run with the @p slowestFilesCount slowest files
+     */
+    [[nodiscard]] QJsonObject toJson(int slowestFilesCount = 10) const;
+
+private:
+
+    std::unique_ptr<IndexerStatisticsPrivate> d;
+
+};
+
+#endif // INDEXERSTATISTICS_H
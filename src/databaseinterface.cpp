@@ -7,6 +7,8 @@
 #include "databaseinterface.h"
 
 #include "databaseLogging.h"
+#include "databasestatistics.h"
+#include "librarysnapshot.h"
 
 #include <KLocalizedString>
 
@@ -19,10 +21,13 @@
 #include <QSqlError>
 
 #include <QFile>
+#include <QTimer>
 #include <QMutex>
 #include <QVariant>
 #include <QAtomicInt>
 #include <QElapsedTimer>
+#include <QScopeGuard>
+#include <QThread>
 #include <QDebug>
 
 #ifdef Q_OS_ANDROID
@@ -30,6 +35,71 @@
 #endif
 
 #include <algorithm>
+#include <limits>
+#include <map>
+
+/**
+ * A query compiled by SQLite on its first use
+ *
+ * DatabaseInterface::initDataQueries only gives the text of each statement. It is prepared before
+ * the first value is bound or before its first execution, or in the background once the views
+ * got their first data.
+ */
+class DatabaseStatement : public QSqlQuery
+{
+public:
+
+    DatabaseStatement() = default;
+
+    explicit DatabaseStatement(const QSqlDatabase &database) : QSqlQuery(database)
+    {
+    }
+
+    void setStatementText(const QString &queryText)
+    {
+        mQueryText = queryText;
+        mIsPrepared = false;
+    }
+
+    [[nodiscard]] bool isPrepared() const
+    {
+        return mIsPrepared;
+    }
+
+    bool prepareStatement()
+    {
+        if (!mIsPrepared && !mQueryText.isEmpty()) {
+            setForwardOnly(true);
+            mIsPrepared = prepare(mQueryText);
+        }
+
+        return mIsPrepared;
+    }
+
+    /**
+     * The statement once prepared, to be copied: a copy of a statement not yet prepared would be prepared again
+     */
+    DatabaseStatement &prepared()
+    {
+        prepareStatement();
+
+        return *this;
+    }
+
+    // preparing a query clears its bound values
+    void bindValue(const QString &placeholder, const QVariant &value)
+    {
+        prepareStatement();
+        QSqlQuery::bindValue(placeholder, value);
+    }
+
+private:
+
+    QString mQueryText;
+
+    bool mIsPrepared = false;
+
+};
 
 class DatabaseInterfacePrivate
 {
@@ -126,7 +196,7 @@ public:
           mInsertArtistsQuery(mTracksDatabase), mSelectArtistByNameQuery(mTracksDatabase),
           mSelectArtistQuery(mTracksDatabase),
           mUpdateTrackStartedStatistics(mTracksDatabase), mUpdateTrackFinishedStatistics(mTracksDatabase),
-          mRemoveTrackQuery(mTracksDatabase), mRemoveAlbumQuery(mTracksDatabase),
+          mRemoveAlbumQuery(mTracksDatabase),
           mRemoveArtistQuery(mTracksDatabase), mSelectAllTracksQuery(mTracksDatabase),
           mSelectAllRadiosQuery(mTracksDatabase),
           mInsertTrackMapping(mTracksDatabase), mUpdateTrackFirstPlayStatistics(mTracksDatabase),
@@ -137,8 +207,8 @@ public:
           mUpdateAlbumArtUriFromAlbumIdQuery(mTracksDatabase),
           mSelectUpToFourLatestCoversFromArtistNameQuery(mTracksDatabase),
           mSelectTracksMappingPriorityByTrackId(mTracksDatabase),
-          mSelectAlbumIdsFromArtist(mTracksDatabase), mSelectAllTrackFilesQuery(mTracksDatabase),
-          mRemoveTracksMappingFromSource(mTracksDatabase), mRemoveTracksMapping(mTracksDatabase),
+          mSelectAllTrackFilesQuery(mTracksDatabase),
+          mRemoveTracksMappingFromSource(mTracksDatabase),
           mSelectTracksWithoutMappingQuery(mTracksDatabase), mSelectAlbumIdFromTitleAndArtistQuery(mTracksDatabase),
           mSelectAlbumIdFromTitleWithoutArtistQuery(mTracksDatabase),
           mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery(mTracksDatabase), mSelectAlbumArtUriFromAlbumIdQuery(mTracksDatabase),
@@ -165,7 +235,15 @@ public:
           mArtistMatchGenreQuery(mTracksDatabase), mSelectTrackIdQuery(mTracksDatabase),
           mInsertRadioQuery(mTracksDatabase), mDeleteRadioQuery(mTracksDatabase),
           mSelectTrackFromIdAndUrlQuery(mTracksDatabase),
-          mUpdateDatabaseVersionQuery(mTracksDatabase), mSelectDatabaseVersionQuery(mTracksDatabase)
+          mUpdateDatabaseVersionQuery(mTracksDatabase), mSelectDatabaseVersionQuery(mTracksDatabase),
+          mClearNotifiedIdsQuery(mTracksDatabase), mInsertNotifiedIdQuery(mTracksDatabase),
+          mSelectNotifiedTracksQuery(mTracksDatabase), mSelectNotifiedAlbumsQuery(mTracksDatabase),
+          mSelectNotifiedArtistsQuery(mTracksDatabase), mClearRemovedFileNamesQuery(mTracksDatabase),
+          mInsertRemovedFileNameQuery(mTracksDatabase), mClearRemovedTracksQuery(mTracksDatabase),
+          mInsertRemovedTracksQuery(mTracksDatabase), mSelectRemovedTracksIdsQuery(mTracksDatabase),
+          mRemoveTracksFromRemovedFileNamesQuery(mTracksDatabase), mRemoveTracksDataFromRemovedFileNamesQuery(mTracksDatabase),
+          mSelectRemovedTracksAlbumsQuery(mTracksDatabase), mSelectRemovedTracksOrphanArtistsQuery(mTracksDatabase),
+          mLibrarySearchQuery(mTracksDatabase)
     {
     }
 
@@ -175,189 +253,215 @@ public:
 
     const QString mDatabaseFileName;
 
-    QSqlQuery mSelectAlbumQuery;
+    DatabaseStatement mSelectAlbumQuery;
+
+    DatabaseStatement mSelectTrackQuery;
+
+    DatabaseStatement mSelectAlbumIdFromTitleQuery;
+
+    DatabaseStatement mInsertAlbumQuery;
 
-    QSqlQuery mSelectTrackQuery;
+    DatabaseStatement mSelectTrackIdFromTitleAlbumIdArtistQuery;
 
-    QSqlQuery mSelectAlbumIdFromTitleQuery;
+    DatabaseStatement mInsertTrackQuery;
 
-    QSqlQuery mInsertAlbumQuery;
+    DatabaseStatement mSelectTracksFromArtist;
 
-    QSqlQuery mSelectTrackIdFromTitleAlbumIdArtistQuery;
+    DatabaseStatement mSelectTracksFromGenre;
 
-    QSqlQuery mInsertTrackQuery;
+    DatabaseStatement mSelectTrackFromIdQuery;
 
-    QSqlQuery mSelectTracksFromArtist;
+    DatabaseStatement mSelectRadioFromIdQuery;
 
-    QSqlQuery mSelectTracksFromGenre;
+    DatabaseStatement mSelectCountAlbumsForArtistQuery;
 
-    QSqlQuery mSelectTrackFromIdQuery;
+    DatabaseStatement mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery;
 
-    QSqlQuery mSelectRadioFromIdQuery;
+    DatabaseStatement mSelectAllAlbumsFromArtistQuery;
 
-    QSqlQuery mSelectCountAlbumsForArtistQuery;
+    DatabaseStatement mSelectAllArtistsQuery;
 
-    QSqlQuery mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery;
+    DatabaseStatement mInsertArtistsQuery;
 
-    QSqlQuery mSelectAllAlbumsFromArtistQuery;
+    DatabaseStatement mSelectArtistByNameQuery;
 
-    QSqlQuery mSelectAllArtistsQuery;
+    DatabaseStatement mSelectArtistQuery;
 
-    QSqlQuery mInsertArtistsQuery;
+    DatabaseStatement mUpdateTrackStartedStatistics;
 
-    QSqlQuery mSelectArtistByNameQuery;
+    DatabaseStatement mUpdateTrackFinishedStatistics;
 
-    QSqlQuery mSelectArtistQuery;
+    DatabaseStatement mRemoveAlbumQuery;
 
-    QSqlQuery mUpdateTrackStartedStatistics;
+    DatabaseStatement mRemoveArtistQuery;
 
-    QSqlQuery mUpdateTrackFinishedStatistics;
+    DatabaseStatement mSelectAllTracksQuery;
 
-    QSqlQuery mRemoveTrackQuery;
+    DatabaseStatement mSelectAllRadiosQuery;
 
-    QSqlQuery mRemoveAlbumQuery;
+    DatabaseStatement mInsertTrackMapping;
 
-    QSqlQuery mRemoveArtistQuery;
+    DatabaseStatement mUpdateTrackFirstPlayStatistics;
 
-    QSqlQuery mSelectAllTracksQuery;
+    DatabaseStatement mInsertMusicSource;
 
-    QSqlQuery mSelectAllRadiosQuery;
+    DatabaseStatement mSelectMusicSource;
 
-    QSqlQuery mInsertTrackMapping;
+    DatabaseStatement mUpdateTrackPriority;
 
-    QSqlQuery mUpdateTrackFirstPlayStatistics;
+    DatabaseStatement mUpdateTrackFileModifiedTime;
 
-    QSqlQuery mInsertMusicSource;
+    DatabaseStatement mSelectTracksMapping;
 
-    QSqlQuery mSelectMusicSource;
+    DatabaseStatement mSelectTracksMappingPriority;
 
-    QSqlQuery mUpdateTrackPriority;
+    DatabaseStatement mSelectRadioIdFromHttpAddress;
 
-    QSqlQuery mUpdateTrackFileModifiedTime;
+    DatabaseStatement mUpdateAlbumArtUriFromAlbumIdQuery;
 
-    QSqlQuery mSelectTracksMapping;
+    DatabaseStatement mSelectUpToFourLatestCoversFromArtistNameQuery;
 
-    QSqlQuery mSelectTracksMappingPriority;
+    DatabaseStatement mSelectTracksMappingPriorityByTrackId;
 
-    QSqlQuery mSelectRadioIdFromHttpAddress;
+    DatabaseStatement mSelectAllTrackFilesQuery;
 
-    QSqlQuery mUpdateAlbumArtUriFromAlbumIdQuery;
+    DatabaseStatement mRemoveTracksMappingFromSource;
 
-    QSqlQuery mSelectUpToFourLatestCoversFromArtistNameQuery;
+    DatabaseStatement mSelectTracksWithoutMappingQuery;
 
-    QSqlQuery mSelectTracksMappingPriorityByTrackId;
+    DatabaseStatement mSelectAlbumIdFromTitleAndArtistQuery;
 
-    QSqlQuery mSelectAlbumIdsFromArtist;
+    DatabaseStatement mSelectAlbumIdFromTitleWithoutArtistQuery;
 
-    QSqlQuery mSelectAllTrackFilesQuery;
+    DatabaseStatement mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery;
 
-    QSqlQuery mRemoveTracksMappingFromSource;
+    DatabaseStatement mSelectAlbumArtUriFromAlbumIdQuery;
 
-    QSqlQuery mRemoveTracksMapping;
+    DatabaseStatement mInsertComposerQuery;
 
-    QSqlQuery mSelectTracksWithoutMappingQuery;
+    DatabaseStatement mSelectComposerByNameQuery;
 
-    QSqlQuery mSelectAlbumIdFromTitleAndArtistQuery;
+    DatabaseStatement mSelectComposerQuery;
 
-    QSqlQuery mSelectAlbumIdFromTitleWithoutArtistQuery;
+    DatabaseStatement mInsertLyricistQuery;
 
-    QSqlQuery mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery;
+    DatabaseStatement mSelectLyricistByNameQuery;
 
-    QSqlQuery mSelectAlbumArtUriFromAlbumIdQuery;
+    DatabaseStatement mSelectLyricistQuery;
 
-    QSqlQuery mInsertComposerQuery;
+    DatabaseStatement mInsertGenreQuery;
 
-    QSqlQuery mSelectComposerByNameQuery;
+    DatabaseStatement mSelectGenreByNameQuery;
 
-    QSqlQuery mSelectComposerQuery;
+    DatabaseStatement mSelectGenreQuery;
 
-    QSqlQuery mInsertLyricistQuery;
+    DatabaseStatement mSelectAllTracksShortQuery;
 
-    QSqlQuery mSelectLyricistByNameQuery;
+    DatabaseStatement mSelectAllAlbumsShortQuery;
 
-    QSqlQuery mSelectLyricistQuery;
+    DatabaseStatement mSelectAllComposersQuery;
 
-    QSqlQuery mInsertGenreQuery;
+    DatabaseStatement mSelectAllLyricistsQuery;
 
-    QSqlQuery mSelectGenreByNameQuery;
+    DatabaseStatement mSelectCountAlbumsForComposerQuery;
 
-    QSqlQuery mSelectGenreQuery;
+    DatabaseStatement mSelectCountAlbumsForLyricistQuery;
 
-    QSqlQuery mSelectAllTracksShortQuery;
+    DatabaseStatement mSelectAllGenresQuery;
 
-    QSqlQuery mSelectAllAlbumsShortQuery;
+    DatabaseStatement mSelectGenreForArtistQuery;
 
-    QSqlQuery mSelectAllComposersQuery;
+    DatabaseStatement mSelectGenreForAlbumQuery;
 
-    QSqlQuery mSelectAllLyricistsQuery;
+    DatabaseStatement mUpdateTrackQuery;
 
-    QSqlQuery mSelectCountAlbumsForComposerQuery;
+    DatabaseStatement mUpdateAlbumArtistQuery;
 
-    QSqlQuery mSelectCountAlbumsForLyricistQuery;
+    DatabaseStatement mUpdateRadioQuery;
 
-    QSqlQuery mSelectAllGenresQuery;
+    DatabaseStatement mUpdateAlbumArtistInTracksQuery;
 
-    QSqlQuery mSelectGenreForArtistQuery;
+    DatabaseStatement mQueryMaximumTrackIdQuery;
 
-    QSqlQuery mSelectGenreForAlbumQuery;
+    DatabaseStatement mQueryMaximumAlbumIdQuery;
 
-    QSqlQuery mUpdateTrackQuery;
+    DatabaseStatement mQueryMaximumArtistIdQuery;
 
-    QSqlQuery mUpdateAlbumArtistQuery;
+    DatabaseStatement mQueryMaximumLyricistIdQuery;
 
-    QSqlQuery mUpdateRadioQuery;
+    DatabaseStatement mQueryMaximumComposerIdQuery;
 
-    QSqlQuery mUpdateAlbumArtistInTracksQuery;
+    DatabaseStatement mQueryMaximumGenreIdQuery;
 
-    QSqlQuery mQueryMaximumTrackIdQuery;
+    DatabaseStatement mSelectAllArtistsWithGenreFilterQuery;
 
-    QSqlQuery mQueryMaximumAlbumIdQuery;
+    DatabaseStatement mSelectAllAlbumsShortWithGenreArtistFilterQuery;
 
-    QSqlQuery mQueryMaximumArtistIdQuery;
+    DatabaseStatement mSelectAllAlbumsShortWithArtistFilterQuery;
 
-    QSqlQuery mQueryMaximumLyricistIdQuery;
+    DatabaseStatement mSelectAllRecentlyPlayedTracksQuery;
 
-    QSqlQuery mQueryMaximumComposerIdQuery;
+    DatabaseStatement mSelectAllFrequentlyPlayedTracksQuery;
 
-    QSqlQuery mQueryMaximumGenreIdQuery;
+    DatabaseStatement mClearTracksDataTable;
 
-    QSqlQuery mSelectAllArtistsWithGenreFilterQuery;
+    DatabaseStatement mClearTracksTable;
 
-    QSqlQuery mSelectAllAlbumsShortWithGenreArtistFilterQuery;
+    DatabaseStatement mClearAlbumsTable;
 
-    QSqlQuery mSelectAllAlbumsShortWithArtistFilterQuery;
+    DatabaseStatement mClearArtistsTable;
 
-    QSqlQuery mSelectAllRecentlyPlayedTracksQuery;
+    DatabaseStatement mClearComposerTable;
 
-    QSqlQuery mSelectAllFrequentlyPlayedTracksQuery;
+    DatabaseStatement mClearGenreTable;
 
-    QSqlQuery mClearTracksDataTable;
+    DatabaseStatement mClearLyricistTable;
 
-    QSqlQuery mClearTracksTable;
+    DatabaseStatement mArtistMatchGenreQuery;
 
-    QSqlQuery mClearAlbumsTable;
+    DatabaseStatement mSelectTrackIdQuery;
 
-    QSqlQuery mClearArtistsTable;
+    DatabaseStatement mInsertRadioQuery;
 
-    QSqlQuery mClearComposerTable;
+    DatabaseStatement mDeleteRadioQuery;
 
-    QSqlQuery mClearGenreTable;
+    DatabaseStatement mSelectTrackFromIdAndUrlQuery;
 
-    QSqlQuery mClearLyricistTable;
+    DatabaseStatement mUpdateDatabaseVersionQuery;
 
-    QSqlQuery mArtistMatchGenreQuery;
+    DatabaseStatement mSelectDatabaseVersionQuery;
 
-    QSqlQuery mSelectTrackIdQuery;
+    DatabaseStatement mClearNotifiedIdsQuery;
 
-    QSqlQuery mInsertRadioQuery;
+    DatabaseStatement mInsertNotifiedIdQuery;
 
-    QSqlQuery mDeleteRadioQuery;
+    DatabaseStatement mSelectNotifiedTracksQuery;
 
-    QSqlQuery mSelectTrackFromIdAndUrlQuery;
+    DatabaseStatement mSelectNotifiedAlbumsQuery;
 
-    QSqlQuery mUpdateDatabaseVersionQuery;
+    DatabaseStatement mSelectNotifiedArtistsQuery;
 
-    QSqlQuery mSelectDatabaseVersionQuery;
+    DatabaseStatement mClearRemovedFileNamesQuery;
+
+    DatabaseStatement mInsertRemovedFileNameQuery;
+
+    DatabaseStatement mClearRemovedTracksQuery;
+
+    DatabaseStatement mInsertRemovedTracksQuery;
+
+    DatabaseStatement mSelectRemovedTracksIdsQuery;
+
+    DatabaseStatement mRemoveTracksFromRemovedFileNamesQuery;
+
+    DatabaseStatement mRemoveTracksDataFromRemovedFileNamesQuery;
+
+    DatabaseStatement mSelectRemovedTracksAlbumsQuery;
+
+    DatabaseStatement mSelectRemovedTracksOrphanArtistsQuery;
+
+    DatabaseStatement mLibrarySearchQuery;
+
+    std::map<int, DatabaseStatement> mSelectTracksPageQueries;
 
     QSet<qulonglong> mModifiedTrackIds;
 
@@ -371,6 +475,201 @@ public:
 
     QSet<qulonglong> mInsertedArtists;
 
+    QSet<qulonglong> mExternalInsertedTracks;
+
+    QSet<qulonglong> mExternalInsertedAlbums;
+
+    QSet<qulonglong> mExternalInsertedArtists;
+
+    QTimer *mExternalChangesTimer = nullptr;
+
+    bool mIsCommittingPendingWrites = false;
+
+    bool mIsInsertingTracksList = false;
+
+    QTimer *mPendingWritesTimer = nullptr;
+
+    static constexpr int PendingWritesLatency = 50;
+
+    // statistics of the statements, only when the profiling is enabled
+    std::shared_ptr<DatabaseStatistics> mStatistics;
+
+    QHash<QString, QString> mStatementNames;
+
+    // every statement in the order of initDataQueries, each one is compiled on its first use
+    QList<DatabaseStatement*> mStatements;
+
+    QHash<QString, DatabaseStatement*> mStatementsByName;
+
+    qsizetype mNextStatementToPrepare = 0;
+
+    // the statements giving the first data of the views shown at startup
+    static QStringList warmUpStatementNames()
+    {
+        return {
+            QStringLiteral("SelectAllAlbumsShortQuery"),
+            QStringLiteral("SelectAllArtistsQuery"),
+            QStringLiteral("SelectAllTracksQuery"),
+            QStringLiteral("SelectAllGenresQuery"),
+            QStringLiteral("SelectAllRadiosQuery"),
+            QStringLiteral("SelectAllRecentlyPlayedTracksQuery"),
+            QStringLiteral("SelectAllFrequentlyPlayedTracksQuery"),
+            QStringLiteral("SelectAllTrackFilesQuery"),
+        };
+    }
+
+    static constexpr int BackgroundPreparationDelay = 2000;
+
+    static constexpr int BackgroundPreparationSliceSize = 8;
+
+    enum class MaintenanceStep {
+        Optimize,
+        Vacuum,
+        IntegrityCheck,
+    };
+
+    MaintenanceStep mNextMaintenanceStep = MaintenanceStep::Optimize;
+
+    QTimer *mMaintenanceTimer = nullptr;
+
+    // tables still to be checked by the running integrity check
+    QStringList mTablesToCheck;
+
+    int mIntegrityErrorsCount = 0;
+
+    qint64 mIntegrityCheckElapsedMs = 0;
+
+    // set by runMaintenance: all the tables are checked at once and the database may be rebuilt
+    bool mIsMaintenanceForced = false;
+
+    int mVacuumPagesPerStep = 128;
+
+    qlonglong mReclaimedPagesCount = 0;
+
+    bool mIsMaintenanceAllowed = false;
+
+    // data were inserted or removed since the last maintenance, always true at startup
+    bool mIsMaintenanceNeeded = true;
+
+    static constexpr int MaintenanceIdleDelay = 60000;
+
+    static constexpr int MaintenanceStepInterval = 50;
+
+    static constexpr qint64 MaintenanceStepBudgetMs = 5;
+
+    // the tables not reached in this time are checked by the next maintenance
+    static constexpr qint64 MaintenanceIntegrityCheckBudgetMs = 100;
+
+    // the check of one table cannot be split, larger tables are only checked by runMaintenance
+    static constexpr qlonglong MaintenanceIdleCheckedRows = 5000;
+
+    // a database with more used pages is not rebuilt to switch to the incremental vacuum
+    static constexpr qlonglong MaintenanceFullVacuumPages = 2048;
+
+    static constexpr qlonglong IncrementalAutoVacuum = 2;
+
+    QString mLibrarySnapshotFileName;
+
+    // the snapshot of the previous run may not match the database, it is written again once
+    bool mIsLibrarySnapshotStale = true;
+
+    // set by a model data loader for the duration of one of its loads
+    const QAtomicInt *mLoadCancellation = nullptr;
+
+    static constexpr qsizetype LoadCancellationRowsBatch = 100;
+
+    QElapsedTimer mTransactionTimer;
+
+    bool mIsWriteTransaction = false;
+
+    struct NameIds {
+        QString mTableName;
+
+        QHash<QString, qulonglong> mIds;
+
+        bool mIsLoaded = false;
+    };
+
+    struct AlbumKey {
+        QString mTitle;
+
+        QString mArtist;
+
+        QString mPath;
+
+        bool operator==(const AlbumKey &other) const
+        {
+            return mTitle == other.mTitle && mArtist == other.mArtist && mPath == other.mPath;
+        }
+
+        friend size_t qHash(const AlbumKey &key, size_t seed = 0)
+        {
+            return qHashMulti(seed, key.mTitle, key.mArtist, key.mPath);
+        }
+    };
+
+    /**
+     * Identifier of @p name, 0 when it is not in the table, no value when the table could not be read
+     *
+     * The whole table is read the first time.
+     */
+    std::optional<qulonglong> knownNameId(NameIds &nameIds, const QString &name)
+    {
+        if (!mUseIdsCaches) {
+            return {};
+        }
+
+        if (!nameIds.mIsLoaded) {
+            auto selectQuery = QSqlQuery(mTracksDatabase);
+
+            if (!selectQuery.exec(QStringLiteral("SELECT `ID`, `Name` FROM `%1`").arg(nameIds.mTableName))) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterfacePrivate::knownNameId" << selectQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterfacePrivate::knownNameId" << selectQuery.lastError();
+
+                return {};
+            }
+
+            while (selectQuery.next()) {
+                nameIds.mIds.insert(selectQuery.value(1).toString(), selectQuery.value(0).toULongLong());
+            }
+
+            nameIds.mIsLoaded = true;
+        }
+
+        return nameIds.mIds.value(name, 0);
+    }
+
+    static void clearNameIds(NameIds &nameIds)
+    {
+        nameIds.mIds.clear();
+        nameIds.mIsLoaded = false;
+    }
+
+    void clearIdsCaches()
+    {
+        clearNameIds(mArtistIds);
+        clearNameIds(mGenreIds);
+        clearNameIds(mComposerIds);
+        clearNameIds(mLyricistIds);
+        mAlbumIds.clear();
+    }
+
+    // identifiers of the names and albums inserted or seen by this connection
+    NameIds mArtistIds{QStringLiteral("Artists")};
+
+    NameIds mGenreIds{QStringLiteral("Genre")};
+
+    NameIds mComposerIds{QStringLiteral("Composer")};
+
+    NameIds mLyricistIds{QStringLiteral("Lyricist")};
+
+    QHash<AlbumKey, qulonglong> mAlbumIds;
+
+    // another connection may change the data seen by a read-only connection
+    bool mUseIdsCaches = true;
+
+    qlonglong mDataVersion = 0;
+
     qulonglong mAlbumId = 1;
 
     qulonglong mArtistId = 1;
@@ -387,7 +686,7 @@ public:
 
     bool mInitFinished = false;
 
-    const DatabaseInterface::DatabaseVersion mLatestDatabaseVersion = DatabaseInterface::V17;
+    const DatabaseInterface::DatabaseVersion mLatestDatabaseVersion = DatabaseInterface::V21;
 
     struct TableSchema {
         QString name;
@@ -438,7 +737,39 @@ public:
     };
 };
 
-DatabaseInterface::DatabaseInterface(QObject *parent) : QObject(parent), d(nullptr)
+// small writes queued from any thread, grouped in one write transaction
+// they exist before init and are kept by a reset of the database
+class DatabaseInterfacePendingWrites
+{
+public:
+
+    struct PendingFinishedPlays {
+        int mPlayCount = 0;
+
+        QDateTime mFirstPlayDate;
+    };
+
+    QMutex mMutex;
+
+    QHash<QUrl, QDateTime> mStartedPlays;
+
+    QHash<QUrl, PendingFinishedPlays> mFinishedPlays;
+
+    QHash<QUrl, DataTypes::TrackDataType> mModifiedTracks;
+
+    QHash<QString, QUrl> mCovers;
+
+    int mSavesCount = 0;
+
+    QList<qulonglong> mRemovedRadios;
+
+    QElapsedTimer mAge;
+
+    QAtomicInt mHasWrites = 0;
+};
+
+DatabaseInterface::DatabaseInterface(QObject *parent) : QObject(parent), d(nullptr),
+    mPendingWrites(std::make_unique<DatabaseInterfacePendingWrites>())
 {
 }
 
@@ -466,147 +797,431 @@ void DatabaseInterface::init(const QString &dbName, const QString &databaseFileN
     }
 }
 
-qulonglong DatabaseInterface::albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath)
+void DatabaseInterface::setExternalChangesPollInterval(int interval)
 {
-    auto result = qulonglong{0};
+    if (interval <= 0) {
+        if (d && d->mExternalChangesTimer) {
+            d->mExternalChangesTimer->stop();
+        }
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
+        return;
     }
 
-    result = internalAlbumIdFromTitleAndArtist(title, artist, albumPath);
+    if (!d) {
+        return;
+    }
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
+    if (!d->mExternalChangesTimer) {
+        d->mExternalChangesTimer = new QTimer(this);
+
+        connect(d->mExternalChangesTimer, &QTimer::timeout,
+                this, &DatabaseInterface::checkExternalChanges);
     }
 
-    return result;
+    d->mExternalChangesTimer->start(interval);
 }
 
-DataTypes::ListTrackDataType DatabaseInterface::allTracksData()
+void DatabaseInterface::checkExternalChanges()
 {
-    auto result = DataTypes::ListTrackDataType{};
-
-    if (!d) {
-        return result;
+    if (!d || d->mStopRequest == 1) {
+        return;
     }
 
     auto transactionResult = startTransaction();
     if (!transactionResult) {
-        return result;
+        return;
     }
 
-    result = internalAllTracksPartialData();
+    internalCollectExternalChanges();
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
+    if (d->mExternalInsertedTracks.isEmpty() && d->mExternalInsertedAlbums.isEmpty() && d->mExternalInsertedArtists.isEmpty()) {
+        finishTransaction();
+        return;
     }
 
-    return result;
+    scheduleMaintenance();
+
+    initChangesTrackers();
+
+    notifyTrackedChanges();
+
+    finishTransaction();
 }
 
-DataTypes::ListRadioDataType DatabaseInterface::allRadiosData()
+void DatabaseInterface::setMaintenanceAllowed(bool allowed)
 {
-    auto result = DataTypes::ListRadioDataType{};
-
     if (!d) {
-        return result;
-    }
-
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
+        return;
     }
 
-    result = internalAllRadiosPartialData();
+    d->mIsMaintenanceAllowed = allowed;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
+    if (allowed) {
+        d->mMaintenanceTimer->start(DatabaseInterfacePrivate::MaintenanceIdleDelay);
+    } else {
+        d->mMaintenanceTimer->stop();
     }
-
-    return result;
 }
 
-DataTypes::ListTrackDataType DatabaseInterface::recentlyPlayedTracksData(int count)
+void DatabaseInterface::runMaintenance()
 {
-    auto result = DataTypes::ListTrackDataType{};
-
     if (!d) {
-        return result;
+        return;
     }
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    d->mMaintenanceTimer->stop();
 
-    result = internalRecentlyPlayedTracksData(count);
+    d->mIsMaintenanceNeeded = true;
+    d->mNextMaintenanceStep = DatabaseInterfacePrivate::MaintenanceStep::Optimize;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
+    d->mIsMaintenanceForced = true;
+
+    // the tables left by the idle maintenance do not include the large ones
+    d->mTablesToCheck.clear();
+
+    while (d->mIsMaintenanceNeeded && d->mStopRequest == 0) {
+        internalMaintenanceStep();
     }
 
-    return result;
+    d->mIsMaintenanceForced = false;
 }
 
-DataTypes::ListTrackDataType DatabaseInterface::frequentlyPlayedTracksData(int count)
+void DatabaseInterface::setLibrarySnapshotFileName(const QString &fileName)
 {
-    auto result = DataTypes::ListTrackDataType{};
-
     if (!d) {
-        return result;
+        return;
     }
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
+    d->mLibrarySnapshotFileName = fileName;
+}
+
+void DatabaseInterface::writeLibrarySnapshot()
+{
+    if (!d || d->mLibrarySnapshotFileName.isEmpty() || !d->mIsLibrarySnapshotStale) {
+        return;
     }
 
-    result = internalFrequentlyPlayedTracksData(count);
+    auto timer = QElapsedTimer{};
+    timer.start();
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
+    const auto albums = allAlbumsData();
+    const auto artists = allArtistsData();
+
+    if (!LibrarySnapshot::write(d->mLibrarySnapshotFileName, albums, artists)) {
+        return;
     }
 
-    return result;
+    d->mIsLibrarySnapshotStale = false;
+
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::writeLibrarySnapshot" << albums.size() << "albums and" << artists.size()
+                                << "artists written in" << timer.elapsed() << "ms";
 }
 
-DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsData()
+void DatabaseInterface::scheduleMaintenance()
 {
-    auto result = DataTypes::ListAlbumDataType{};
+    // the albums or artists may have changed
+    d->mIsLibrarySnapshotStale = true;
 
-    if (!d) {
-        return result;
-    }
+    d->mIsMaintenanceNeeded = true;
+    d->mNextMaintenanceStep = DatabaseInterfacePrivate::MaintenanceStep::Optimize;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
+    // the idle delay starts again after each change of the tracks
+    if (d->mIsMaintenanceAllowed) {
+        d->mMaintenanceTimer->start(DatabaseInterfacePrivate::MaintenanceIdleDelay);
     }
+}
 
-    result = internalAllAlbumsPartialData(d->mSelectAllAlbumsShortQuery);
+void DatabaseInterface::runMaintenanceStep()
+{
+    if (!d || d->mStopRequest == 1 || !d->mIsMaintenanceAllowed || !d->mIsMaintenanceNeeded) {
+        return;
+    }
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
+    // the writes of the user go first
+    if (mPendingWrites->mHasWrites == 0) {
+        internalMaintenanceStep();
     }
 
-    return result;
+    if (d->mIsMaintenanceNeeded) {
+        d->mMaintenanceTimer->start(DatabaseInterfacePrivate::MaintenanceStepInterval);
+    }
 }
 
-DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsDataByGenreAndArtist(const QString &genre, const QString &artist)
+void DatabaseInterface::internalMaintenanceStep()
 {
-    auto result = DataTypes::ListAlbumDataType{};
-
-    if (!d) {
-        return result;
-    }
+    switch (d->mNextMaintenanceStep)
+    {
+    case DatabaseInterfacePrivate::MaintenanceStep::Optimize:
+        internalMaintenanceOptimize();
+
+        d->mNextMaintenanceStep = DatabaseInterfacePrivate::MaintenanceStep::Vacuum;
+        break;
+    case DatabaseInterfacePrivate::MaintenanceStep::Vacuum:
+        if (internalMaintenanceVacuum()) {
+            // a check stopped by its time budget goes on with the tables it did not reach
+            if (d->mTablesToCheck.isEmpty()) {
+                d->mTablesToCheck = internalMaintenanceCheckedTables();
+            }
+            d->mIntegrityErrorsCount = 0;
+            d->mIntegrityCheckElapsedMs = 0;
+
+            d->mNextMaintenanceStep = DatabaseInterfacePrivate::MaintenanceStep::IntegrityCheck;
+        }
+        break;
+    case DatabaseInterfacePrivate::MaintenanceStep::IntegrityCheck:
+        if (internalMaintenanceIntegrityCheck()) {
+            writeLibrarySnapshot();
+
+            d->mIsMaintenanceNeeded = false;
+
+            d->mNextMaintenanceStep = DatabaseInterfacePrivate::MaintenanceStep::Optimize;
+        }
+        break;
+    }
+}
+
+void DatabaseInterface::initReadOnly(const QString &dbName, const QString &databaseFileName)
+{
+    initConnection(dbName, databaseFileName, ConnectionMode::ReadOnly);
+
+    d->mUseIdsCaches = false;
+
+    // the schema is created or upgraded by the connection opened with init
+    initDataQueries();
+}
+
+QString DatabaseInterface::journalMode()
+{
+    auto result = QString{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto journalModeQuery = d->mTracksDatabase.exec(QStringLiteral("PRAGMA journal_mode;"));
+    if (journalModeQuery.next()) {
+        result = journalModeQuery.value(0).toString();
+    }
+
+    return result;
+}
+
+qulonglong DatabaseInterface::albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath)
+{
+    auto result = qulonglong{0};
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    result = internalAlbumIdFromTitleAndArtist(title, artist, albumPath);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListTrackDataType DatabaseInterface::allTracksData()
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    result = internalAllTracksPartialData();
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListRadioDataType DatabaseInterface::allRadiosData()
+{
+    auto result = DataTypes::ListRadioDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    result = internalAllRadiosPartialData();
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListTrackDataType DatabaseInterface::recentlyPlayedTracksData(int count)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    result = internalRecentlyPlayedTracksData(count);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListTrackDataType DatabaseInterface::frequentlyPlayedTracksData(int count)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    result = internalFrequentlyPlayedTracksData(count);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListTrackDataType DatabaseInterface::tracksDataPage(DataTypes::ColumnsRoles sortRole, Qt::SortOrder sortOrder,
+                                                               const QVariant &afterSortValue, qulonglong afterDatabaseId, int count)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    result = internalTracksDataPage(sortRole, sortOrder, afterSortValue, afterDatabaseId, count);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+bool DatabaseInterface::isTracksPageSortRole(DataTypes::ColumnsRoles sortRole)
+{
+    return !trackSortExpression(sortRole).isEmpty();
+}
+
+QVariant DatabaseInterface::trackSortValue(const DataTypes::TrackDataType &track, DataTypes::ColumnsRoles sortRole)
+{
+    switch (sortRole)
+    {
+    case DataTypes::YearRole:
+        return track.value(DataTypes::YearRole, 0).toInt();
+    case DataTypes::DurationRole:
+        return track.value(DataTypes::DurationRole).toTime().msecsSinceStartOfDay();
+    case DataTypes::FileModificationTime:
+        return track.value(DataTypes::FileModificationTime);
+    default:
+    {
+        // a null string would be bound as NULL and match no track
+        auto value = track.value(sortRole).toString();
+        if (value.isNull()) {
+            value = QStringLiteral("");
+        }
+
+        return value;
+    }
+    }
+}
+
+DataTypes::ListMusicDataType DatabaseInterface::librarySearch(const QString &searchText, int maximumCount, int offset)
+{
+    auto result = DataTypes::ListMusicDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    result = internalLibrarySearch(searchText, maximumCount, offset);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsData()
+{
+    auto result = DataTypes::ListAlbumDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    result = internalAllAlbumsPartialData(d->mSelectAllAlbumsShortQuery);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsDataByGenreAndArtist(const QString &genre, const QString &artist)
+{
+    auto result = DataTypes::ListAlbumDataType{};
+
+    if (!d) {
+        return result;
+    }
 
     auto transactionResult = startTransaction();
     if (!transactionResult) {
@@ -1030,6 +1645,21 @@ qulonglong DatabaseInterface::radioIdFromFileName(const QUrl &fileName)
 void DatabaseInterface::applicationAboutToQuit()
 {
     d->mStopRequest = 1;
+
+    // the last plays and edits are written before the database thread stops, then the views of the next run
+    if (QThread::currentThread() == thread()) {
+        commitPendingWrites();
+        writeLibrarySnapshot();
+    } else if (thread()->isRunning()) {
+        QMetaObject::invokeMethod(this, [this]() {
+            commitPendingWrites();
+            writeLibrarySnapshot();
+        }, Qt::BlockingQueuedConnection);
+    }
+
+    if (d->mStatistics) {
+        d->mStatistics->dump();
+    }
 }
 
 void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers)
@@ -1040,14 +1670,21 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
         return;
     }
 
-    auto transactionResult = startTransaction();
+    auto transactionResult = startWriteTransaction();
     if (!transactionResult) {
         Q_EMIT finishInsertingTracksList();
         return;
     }
 
+    scheduleMaintenance();
+
     initChangesTrackers();
 
+    d->mIsInsertingTracksList = true;
+    auto insertingGuard = qScopeGuard([this]() {
+        d->mIsInsertingTracksList = false;
+    });
+
     for(const auto &oneTrack : tracks) {
         switch (oneTrack.elementType())
         {
@@ -1085,50 +1722,39 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
             Q_EMIT finishInsertingTracksList();
             return;
         }
-    }
 
-    if (!d->mInsertedArtists.isEmpty()) {
-        DataTypes::ListArtistDataType newArtists;
+        // interactive writes do not wait for the end of a large import
+        if (hasPendingWritesDue()) {
+            transactionResult = finishTransaction();
+            if (!transactionResult) {
+                Q_EMIT finishInsertingTracksList();
+                return;
+            }
 
-        for (auto newArtistId : std::as_const(d->mInsertedArtists)) {
-            newArtists.push_back(internalOneArtistPartialData(newArtistId));
+            commitPendingWrites();
+
+            transactionResult = startWriteTransaction();
+            if (!transactionResult) {
+                Q_EMIT finishInsertingTracksList();
+                return;
+            }
         }
+    }
 
-        qCInfo(orgKdeElisaDatabase) << "artistsAdded" << newArtists.size();
-        Q_EMIT artistsAdded(newArtists);
+    // the views read with other connections: they must see the new data when notified
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        Q_EMIT finishInsertingTracksList();
+        return;
     }
 
-    if (!d->mInsertedAlbums.isEmpty()) {
-        DataTypes::ListAlbumDataType newAlbums;
-
-        for (auto albumId : std::as_const(d->mInsertedAlbums)) {
-            d->mModifiedAlbumIds.remove(albumId);
-            newAlbums.push_back(internalOneAlbumPartialData(albumId));
-        }
-
-        qCInfo(orgKdeElisaDatabase) << "albumsAdded" << newAlbums.size();
-        Q_EMIT albumsAdded(newAlbums);
-    }
-
-    for (auto albumId : std::as_const(d->mModifiedAlbumIds)) {
-        Q_EMIT albumModified({{DataTypes::DatabaseIdRole, albumId}}, albumId);
-    }
-
-    if (!d->mInsertedTracks.isEmpty()) {
-        DataTypes::ListTrackDataType newTracks;
-
-        for (auto trackId : std::as_const(d->mInsertedTracks)) {
-            newTracks.push_back(internalOneTrackPartialData(trackId));
-            d->mModifiedTrackIds.remove(trackId);
-        }
-
-        qCInfo(orgKdeElisaDatabase) << "tracksAdded" << newTracks.size();
-        Q_EMIT tracksAdded(newTracks);
+    transactionResult = startTransaction();
+    if (!transactionResult) {
+        Q_EMIT finishInsertingTracksList();
+        return;
     }
 
-    for (auto trackId : std::as_const(d->mModifiedTrackIds)) {
-        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
-    }
+    notifyTrackedChanges();
 
     transactionResult = finishTransaction();
     if (!transactionResult) {
@@ -1140,12 +1766,14 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
 
 void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
 {
-    auto transactionResult = startTransaction();
+    auto transactionResult = startWriteTransaction();
     if (!transactionResult) {
         Q_EMIT finishRemovingTracksList();
         return;
     }
 
+    scheduleMaintenance();
+
     initChangesTrackers();
 
     internalRemoveTracksList(removedTracks);
@@ -1186,41 +1814,185 @@ void DatabaseInterface::askRestoredTracks()
 
 void DatabaseInterface::trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time)
 {
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
+    QMutexLocker locker(&mPendingWrites->mMutex);
+
+    auto &lastPlayDate = mPendingWrites->mStartedPlays[fileName];
+    if (!lastPlayDate.isValid() || lastPlayDate < time) {
+        lastPlayDate = time;
+    }
+
+    pendingWriteQueued();
+}
+
+void DatabaseInterface::trackHasFinishedPlaying(const QUrl &fileName, const QDateTime &time)
+{
+    QMutexLocker locker(&mPendingWrites->mMutex);
+
+    auto &finishedPlays = mPendingWrites->mFinishedPlays[fileName];
+    ++finishedPlays.mPlayCount;
+    if (!finishedPlays.mFirstPlayDate.isValid() || time < finishedPlays.mFirstPlayDate) {
+        finishedPlays.mFirstPlayDate = time;
+    }
+
+    pendingWriteQueued();
+}
+
+void DatabaseInterface::saveModifiedTracks(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers)
+{
+    QMutexLocker locker(&mPendingWrites->mMutex);
+
+    for (const auto &oneTrack : tracks) {
+        mPendingWrites->mModifiedTracks[oneTrack.resourceURI()] = oneTrack;
+    }
+    mPendingWrites->mCovers.insert(covers);
+    ++mPendingWrites->mSavesCount;
+
+    pendingWriteQueued();
+}
+
+void DatabaseInterface::pendingWriteQueued()
+{
+    if (mPendingWrites->mHasWrites.fetchAndStoreOrdered(1) != 0) {
         return;
     }
 
-    updateTrackStartedStatistics(fileName, time);
+    mPendingWrites->mAge.start();
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
+    // the timer lives in the thread of the database
+    QMetaObject::invokeMethod(this, [this]() {
+        schedulePendingWrites();
+    }, Qt::QueuedConnection);
+}
+
+void DatabaseInterface::schedulePendingWrites()
+{
+    if (!d || !d->mInitFinished || mPendingWrites->mHasWrites == 0) {
         return;
     }
+
+    auto remainingLatency = 0;
+    {
+        QMutexLocker locker(&mPendingWrites->mMutex);
+        remainingLatency = std::max(0, DatabaseInterfacePrivate::PendingWritesLatency - static_cast<int>(mPendingWrites->mAge.elapsed()));
+    }
+
+    if (!d->mPendingWritesTimer->isActive()) {
+        d->mPendingWritesTimer->start(remainingLatency);
+    }
 }
 
-void DatabaseInterface::trackHasFinishedPlaying(const QUrl &fileName, const QDateTime &time)
+bool DatabaseInterface::hasPendingWritesDue()
 {
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
+    if (mPendingWrites->mHasWrites == 0) {
+        return false;
+    }
+
+    QMutexLocker locker(&mPendingWrites->mMutex);
+
+    return mPendingWrites->mAge.elapsed() >= DatabaseInterfacePrivate::PendingWritesLatency;
+}
+
+void DatabaseInterface::commitPendingWrites()
+{
+    if (!d || !d->mInitFinished || d->mIsCommittingPendingWrites || mPendingWrites->mHasWrites == 0) {
         return;
     }
 
-    updateTrackFinishedStatistics(fileName, time);
+    d->mPendingWritesTimer->stop();
+
+    QHash<QUrl, QDateTime> startedPlays;
+    QHash<QUrl, DatabaseInterfacePendingWrites::PendingFinishedPlays> finishedPlays;
+    QHash<QUrl, DataTypes::TrackDataType> modifiedTracks;
+    QHash<QString, QUrl> covers;
+    QList<qulonglong> removedRadios;
+    auto savesCount = 0;
+    {
+        QMutexLocker locker(&mPendingWrites->mMutex);
+
+        startedPlays.swap(mPendingWrites->mStartedPlays);
+        finishedPlays.swap(mPendingWrites->mFinishedPlays);
+        modifiedTracks.swap(mPendingWrites->mModifiedTracks);
+        covers.swap(mPendingWrites->mCovers);
+        removedRadios.swap(mPendingWrites->mRemovedRadios);
+        std::swap(savesCount, mPendingWrites->mSavesCount);
+
+        mPendingWrites->mHasWrites = 0;
+    }
+
+    d->mIsCommittingPendingWrites = true;
+
+    // the changes of an interrupted tracks list are notified with the modified tracks
+    if (!d->mIsInsertingTracksList) {
+        initChangesTrackers();
+    }
+
+    QList<qulonglong> deletedRadios;
+
+    auto transactionResult = startWriteTransaction();
+    if (transactionResult) {
+        for (auto itStartedPlay = startedPlays.cbegin(); itStartedPlay != startedPlays.cend(); ++itStartedPlay) {
+            updateTrackStartedStatistics(itStartedPlay.key(), itStartedPlay.value());
+        }
+
+        for (auto itFinishedPlay = finishedPlays.cbegin(); itFinishedPlay != finishedPlays.cend(); ++itFinishedPlay) {
+            updateTrackFinishedStatistics(itFinishedPlay.key(), itFinishedPlay->mFirstPlayDate, itFinishedPlay->mPlayCount);
+        }
+
+        for (const auto &oneTrack : std::as_const(modifiedTracks)) {
+            if (oneTrack.elementType() == ElisaUtils::Radio) {
+                internalInsertOneRadio(oneTrack);
+            } else if (oneTrack.elementType() == ElisaUtils::Track) {
+                internalInsertOneTrack(oneTrack, covers);
+            }
+        }
+
+        for (auto oneRadioId : std::as_const(removedRadios)) {
+            if (internalRemoveRadio(oneRadioId)) {
+                deletedRadios.push_back(oneRadioId);
+            }
+        }
+
+        transactionResult = finishTransaction();
+    }
+
+    if (transactionResult && !modifiedTracks.isEmpty()) {
+        scheduleMaintenance();
+
+        if (startTransaction()) {
+            notifyTrackedChanges();
+
+            finishTransaction();
+        }
+
+        initChangesTrackers();
+    }
+
+    d->mIsCommittingPendingWrites = false;
 
-    transactionResult = finishTransaction();
     if (!transactionResult) {
-        return;
+        deletedRadios.clear();
+    }
+
+    for (auto oneRadioId : std::as_const(deletedRadios)) {
+        Q_EMIT radioRemoved(oneRadioId);
+    }
+
+    for (auto i = 0; i < savesCount; ++i) {
+        Q_EMIT finishInsertingTracksList();
     }
 }
 
 void DatabaseInterface::clearData()
 {
-    auto transactionResult = startTransaction();
+    auto transactionResult = startWriteTransaction();
     if (!transactionResult) {
         return;
     }
 
+    scheduleMaintenance();
+
+    d->clearIdsCaches();
+
     auto queryResult = execQuery(d->mClearTracksTable);
 
     if (!queryResult || !d->mClearTracksTable.isActive()) {
@@ -1310,12 +2082,15 @@ void DatabaseInterface::clearData()
         return;
     }
 
+    // the rescan asked by the user is the time to rebuild a database created before the incremental vacuum
+    internalMaintenanceEnableIncrementalVacuum();
+
     Q_EMIT cleanedDatabase();
 }
 
 /********* Init and upgrade methods *********/
 
-void DatabaseInterface::initConnection(const QString &connectionName, const QString &databaseFileName)
+void DatabaseInterface::initConnection(const QString &connectionName, const QString &databaseFileName, ConnectionMode mode)
 {
     QSqlDatabase tracksDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connectionName);
 
@@ -1324,7 +2099,13 @@ void DatabaseInterface::initConnection(const QString &connectionName, const QStr
     } else {
         tracksDatabase.setDatabaseName(QStringLiteral("file:memdb1?mode=memory"));
     }
-    tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;locking_mode = EXCLUSIVE;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+
+    if (mode == ConnectionMode::ReadOnly) {
+        tracksDatabase.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=30000"));
+    } else {
+        // another process may write to the same database: the write transactions wait for each other
+        tracksDatabase.setConnectOptions(QStringLiteral("QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=30000"));
+    }
 
     auto result = tracksDatabase.open();
     if (result) {
@@ -1336,7 +2117,38 @@ void DatabaseInterface::initConnection(const QString &connectionName, const QStr
 
     tracksDatabase.exec(QStringLiteral("PRAGMA foreign_keys = ON;"));
 
+    if (mode == ConnectionMode::ReadWrite) {
+        // only effective before the tables are created, pages freed later are reclaimed by the maintenance
+        tracksDatabase.exec(QStringLiteral("PRAGMA auto_vacuum = INCREMENTAL;"));
+    }
+
+    if (mode == ConnectionMode::ReadWrite && !databaseFileName.isEmpty()) {
+        // readers on other connections see the last committed snapshot while the writer inserts tracks
+        auto journalModeQuery = tracksDatabase.exec(QStringLiteral("PRAGMA journal_mode = WAL;"));
+        if (!journalModeQuery.next() || journalModeQuery.value(0).toString() != QStringLiteral("wal")) {
+            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initConnection" << "write-ahead log not available" << journalModeQuery.lastError();
+        }
+
+        tracksDatabase.exec(QStringLiteral("PRAGMA synchronous = NORMAL;"));
+    }
+
     d = std::make_unique<DatabaseInterfacePrivate>(tracksDatabase, connectionName, databaseFileName);
+
+    if (qEnvironmentVariableIntValue("ELISA_DATABASE_PROFILING") != 0) {
+        d->mStatistics = std::make_shared<DatabaseStatistics>();
+    }
+
+    d->mPendingWritesTimer = new QTimer(this);
+    d->mPendingWritesTimer->setSingleShot(true);
+
+    connect(d->mPendingWritesTimer, &QTimer::timeout,
+            this, &DatabaseInterface::commitPendingWrites);
+
+    d->mMaintenanceTimer = new QTimer(this);
+    d->mMaintenanceTimer->setSingleShot(true);
+
+    connect(d->mMaintenanceTimer, &QTimer::timeout,
+            this, &DatabaseInterface::runMaintenanceStep);
 }
 
 bool DatabaseInterface::initDatabase()
@@ -3241,6 +4053,296 @@ void DatabaseInterface::upgradeDatabaseV17()
 {
 }
 
+void DatabaseInterface::upgradeDatabaseV18()
+{
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "begin update to v18 of database schema";
+
+    // the rowid of each search entry is the ID of the indexed item times 8 plus its kind:
+    // 0 for tracks, 1 for albums, 2 for artists, 3 for composers and 4 for genres
+    // the index is only filled when it is created, running this upgrade again must not duplicate its entries
+    const bool hasSearchIndex = d->mTracksDatabase.tables().contains(QLatin1String("LibrarySearch"));
+
+    QStringList sqlUpdates = {
+        QStringLiteral("CREATE VIRTUAL TABLE IF NOT EXISTS `LibrarySearch` USING fts5("
+                       "`Kind` UNINDEXED, "
+                       "`ItemID` UNINDEXED, "
+                       "`Title`, "
+                       "`Artist`, "
+                       "`Album`, "
+                       "`Composer`, "
+                       "`Genre`, "
+                       "tokenize = 'unicode61 remove_diacritics 2', "
+                       "prefix = '2 3')"),
+
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchTracksInsert` AFTER INSERT ON `Tracks` BEGIN "
+                       "INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`, `Artist`, `Album`, `Composer`, `Genre`) "
+                       "VALUES (new.`ID` * 8, 0, new.`ID`, new.`Title`, new.`ArtistName`, new.`AlbumTitle`, new.`Composer`, new.`Genre`); "
+                       "END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchTracksDelete` AFTER DELETE ON `Tracks` BEGIN "
+                       "DELETE FROM `LibrarySearch` WHERE rowid = old.`ID` * 8; "
+                       "END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchTracksUpdate` AFTER UPDATE OF `Title`, `ArtistName`, `AlbumTitle`, `Composer`, `Genre` ON `Tracks` BEGIN "
+                       "DELETE FROM `LibrarySearch` WHERE rowid = old.`ID` * 8; "
+                       "INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`, `Artist`, `Album`, `Composer`, `Genre`) "
+                       "VALUES (new.`ID` * 8, 0, new.`ID`, new.`Title`, new.`ArtistName`, new.`AlbumTitle`, new.`Composer`, new.`Genre`); "
+                       "END"),
+
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchAlbumsInsert` AFTER INSERT ON `Albums` BEGIN "
+                       "INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`, `Artist`) "
+                       "VALUES (new.`ID` * 8 + 1, 1, new.`ID`, new.`Title`, new.`ArtistName`); "
+                       "END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchAlbumsDelete` AFTER DELETE ON `Albums` BEGIN "
+                       "DELETE FROM `LibrarySearch` WHERE rowid = old.`ID` * 8 + 1; "
+                       "END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchAlbumsUpdate` AFTER UPDATE OF `Title`, `ArtistName` ON `Albums` BEGIN "
+                       "DELETE FROM `LibrarySearch` WHERE rowid = old.`ID` * 8 + 1; "
+                       "INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`, `Artist`) "
+                       "VALUES (new.`ID` * 8 + 1, 1, new.`ID`, new.`Title`, new.`ArtistName`); "
+                       "END"),
+
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchArtistsInsert` AFTER INSERT ON `Artists` BEGIN "
+                       "INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`) "
+                       "VALUES (new.`ID` * 8 + 2, 2, new.`ID`, new.`Name`); "
+                       "END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchArtistsDelete` AFTER DELETE ON `Artists` BEGIN "
+                       "DELETE FROM `LibrarySearch` WHERE rowid = old.`ID` * 8 + 2; "
+                       "END"),
+
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchComposerInsert` AFTER INSERT ON `Composer` BEGIN "
+                       "INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`) "
+                       "VALUES (new.`ID` * 8 + 3, 3, new.`ID`, new.`Name`); "
+                       "END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchComposerDelete` AFTER DELETE ON `Composer` BEGIN "
+                       "DELETE FROM `LibrarySearch` WHERE rowid = old.`ID` * 8 + 3; "
+                       "END"),
+
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchGenreInsert` AFTER INSERT ON `Genre` BEGIN "
+                       "INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`) "
+                       "VALUES (new.`ID` * 8 + 4, 4, new.`ID`, new.`Name`); "
+                       "END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `LibrarySearchGenreDelete` AFTER DELETE ON `Genre` BEGIN "
+                       "DELETE FROM `LibrarySearch` WHERE rowid = old.`ID` * 8 + 4; "
+                       "END"),
+    };
+
+    const QStringList searchIndexFill = {
+        QStringLiteral("INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`, `Artist`, `Album`, `Composer`, `Genre`) "
+                       "SELECT `ID` * 8, 0, `ID`, `Title`, `ArtistName`, `AlbumTitle`, `Composer`, `Genre` FROM `Tracks`"),
+        QStringLiteral("INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`, `Artist`) "
+                       "SELECT `ID` * 8 + 1, 1, `ID`, `Title`, `ArtistName` FROM `Albums`"),
+        QStringLiteral("INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`) "
+                       "SELECT `ID` * 8 + 2, 2, `ID`, `Name` FROM `Artists`"),
+        QStringLiteral("INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`) "
+                       "SELECT `ID` * 8 + 3, 3, `ID`, `Name` FROM `Composer`"),
+        QStringLiteral("INSERT INTO `LibrarySearch` (rowid, `Kind`, `ItemID`, `Title`) "
+                       "SELECT `ID` * 8 + 4, 4, `ID`, `Name` FROM `Genre`"),
+    };
+
+    if (!hasSearchIndex) {
+        sqlUpdates += searchIndexFill;
+    }
+
+    QSqlQuery sqlQuery(d->mTracksDatabase);
+
+    for (const QString& oneSqlUpdate : sqlUpdates)
+    {
+        if (!sqlQuery.exec(oneSqlUpdate)) {
+            qCWarning(orgKdeElisaDatabase) << __FUNCTION__ << sqlQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << __FUNCTION__ << sqlQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v18 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV19()
+{
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "begin update to v19 of database schema";
+
+    // one index per sort key of the paged tracks view, see trackSortExpression
+    const QStringList sqlUpdates = {
+        QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksTitleSortIndex` ON `Tracks` (IFNULL(`Title`, '') COLLATE NOCASE)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksAlbumSortIndex` ON `Tracks` (IFNULL(`AlbumTitle`, '') COLLATE NOCASE)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksArtistSortIndex` ON `Tracks` (IFNULL(`ArtistName`, '') COLLATE NOCASE)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksGenreSortIndex` ON `Tracks` (IFNULL(`Genre`, '') COLLATE NOCASE)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksComposerSortIndex` ON `Tracks` (IFNULL(`Composer`, '') COLLATE NOCASE)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksLyricistSortIndex` ON `Tracks` (IFNULL(`Lyricist`, '') COLLATE NOCASE)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksYearSortIndex` ON `Tracks` (IFNULL(`Year`, 0))"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksDurationSortIndex` ON `Tracks` (`Duration`)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksDataFileModifiedTimeIndex` ON `TracksData` (`FileModifiedTime`)"),
+    };
+
+    QSqlQuery sqlQuery(d->mTracksDatabase);
+
+    for (const QString& oneSqlUpdate : sqlUpdates)
+    {
+        if (!sqlQuery.exec(oneSqlUpdate)) {
+            qCWarning(orgKdeElisaDatabase) << __FUNCTION__ << sqlQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << __FUNCTION__ << sqlQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v19 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV20()
+{
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "begin update to v20 of database schema";
+
+    // the summary of an album only exists while the album has tracks, like in the albums views
+    const auto albumsSummaryInsert = [](const QString &albumCondition) {
+        return QStringLiteral("INSERT INTO `AlbumsSummary` (`AlbumID`, `Year`, `ArtistsCount`, `AllArtists`, "
+                              "`HighestRating`, `AllGenres`, `IsSingleDiscAlbum`, `EmbeddedCover`) "
+                              "SELECT "
+                              "album.`ID`, "
+                              "GROUP_CONCAT(tracks.`Year`, ', '), "
+                              "COUNT(DISTINCT tracks.`ArtistName`), "
+                              "GROUP_CONCAT(tracks.`ArtistName`, ', '), "
+                              "MAX(tracks.`Rating`), "
+                              "GROUP_CONCAT(genres.`Name`, ', '), "
+                              "COUNT(DISTINCT tracks.`DiscNumber`) <= 1, "
+                              "MIN(CASE WHEN tracks.`HasEmbeddedCover` = 1 THEN tracks.`FileName` END) "
+                              "FROM "
+                              "`Albums` album, "
+                              "`Tracks` tracks LEFT JOIN "
+                              "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                              "WHERE "
+                              "%1 AND "
+                              "tracks.`AlbumTitle` = album.`Title` AND "
+                              "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
+                              "(tracks.`AlbumArtistName` IS NULL AND "
+                              "album.`ArtistName` IS NULL"
+                              ") "
+                              ") AND "
+                              "tracks.`AlbumPath` = album.`AlbumPath` "
+                              "GROUP BY album.`ID`").arg(albumCondition);
+    };
+
+    const auto albumsSummaryUpdate = [&albumsSummaryInsert](const QString &albumCondition) {
+        return QStringLiteral("DELETE FROM `AlbumsSummary` WHERE `AlbumID` IN (SELECT album.`ID` FROM `Albums` album WHERE %1); ").arg(albumCondition) +
+                albumsSummaryInsert(albumCondition) + QStringLiteral("; ");
+    };
+
+    const auto trackAlbumCondition = [](const QString &track) {
+        return QStringLiteral("album.`Title` = %1.`AlbumTitle` AND "
+                              "(album.`ArtistName` = %1.`AlbumArtistName` OR "
+                              "(album.`ArtistName` IS NULL AND %1.`AlbumArtistName` IS NULL)) AND "
+                              "album.`AlbumPath` = %1.`AlbumPath`").arg(track);
+    };
+
+    // every artist has a summary, even without tracks
+    const auto artistsSummaryInsert = [](const QString &artistCondition) {
+        return QStringLiteral("INSERT OR REPLACE INTO `ArtistsSummary` (`ArtistID`, `AllGenres`) "
+                              "SELECT "
+                              "artists.`ID`, "
+                              "GROUP_CONCAT(genres.`Name`, ', ') "
+                              "FROM `Artists` artists LEFT JOIN "
+                              "`Tracks` tracks ON artists.`Name` = tracks.`ArtistName` LEFT JOIN "
+                              "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                              "WHERE %1 "
+                              "GROUP BY artists.`ID`").arg(artistCondition);
+    };
+
+    const auto artistsSummaryUpdate = [&artistsSummaryInsert](const QString &artistCondition) {
+        return artistsSummaryInsert(artistCondition) + QStringLiteral("; ");
+    };
+
+    // the summaries are only computed when their tables are created, later changes are kept up to date by the triggers
+    const auto &existingTables = d->mTracksDatabase.tables();
+    const bool hasAlbumsSummary = existingTables.contains(QLatin1String("AlbumsSummary"));
+    const bool hasArtistsSummary = existingTables.contains(QLatin1String("ArtistsSummary"));
+
+    QStringList sqlUpdates = {
+        QStringLiteral("CREATE TABLE IF NOT EXISTS `AlbumsSummary` ("
+                       "`AlbumID` INTEGER PRIMARY KEY NOT NULL, "
+                       "`Year` TEXT, "
+                       "`ArtistsCount` INTEGER, "
+                       "`AllArtists` TEXT, "
+                       "`HighestRating` INTEGER, "
+                       "`AllGenres` TEXT, "
+                       "`IsSingleDiscAlbum` BOOLEAN, "
+                       "`EmbeddedCover` TEXT)"),
+        QStringLiteral("CREATE TABLE IF NOT EXISTS `ArtistsSummary` ("
+                       "`ArtistID` INTEGER PRIMARY KEY NOT NULL, "
+                       "`AllGenres` TEXT)"),
+
+        QStringLiteral("CREATE INDEX IF NOT EXISTS `AlbumsTitleSortIndex` ON `Albums` (`Title` COLLATE NOCASE)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS `ArtistsNameSortIndex` ON `Artists` (`Name` COLLATE NOCASE)"),
+
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `AlbumsSummaryTracksInsert` AFTER INSERT ON `Tracks` BEGIN ") +
+        albumsSummaryUpdate(trackAlbumCondition(QStringLiteral("new"))) +
+        QStringLiteral("END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `AlbumsSummaryTracksDelete` AFTER DELETE ON `Tracks` BEGIN ") +
+        albumsSummaryUpdate(trackAlbumCondition(QStringLiteral("old"))) +
+        QStringLiteral("END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `AlbumsSummaryTracksUpdate` AFTER UPDATE OF `Year`, `ArtistName`, `Rating`, `Genre`, "
+                       "`DiscNumber`, `HasEmbeddedCover`, `FileName`, `AlbumTitle`, `AlbumArtistName`, `AlbumPath` ON `Tracks` BEGIN ") +
+        albumsSummaryUpdate(trackAlbumCondition(QStringLiteral("old"))) +
+        albumsSummaryUpdate(trackAlbumCondition(QStringLiteral("new"))) +
+        QStringLiteral("END"),
+
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `AlbumsSummaryAlbumsInsert` AFTER INSERT ON `Albums` BEGIN ") +
+        albumsSummaryUpdate(QStringLiteral("album.`ID` = new.`ID`")) +
+        QStringLiteral("END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `AlbumsSummaryAlbumsUpdate` AFTER UPDATE OF `Title`, `ArtistName`, `AlbumPath` ON `Albums` BEGIN ") +
+        albumsSummaryUpdate(QStringLiteral("album.`ID` = new.`ID`")) +
+        QStringLiteral("END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `AlbumsSummaryAlbumsDelete` AFTER DELETE ON `Albums` BEGIN "
+                       "DELETE FROM `AlbumsSummary` WHERE `AlbumID` = old.`ID`; "
+                       "END"),
+
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `ArtistsSummaryTracksInsert` AFTER INSERT ON `Tracks` BEGIN ") +
+        artistsSummaryUpdate(QStringLiteral("artists.`Name` = new.`ArtistName`")) +
+        QStringLiteral("END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `ArtistsSummaryTracksDelete` AFTER DELETE ON `Tracks` BEGIN ") +
+        artistsSummaryUpdate(QStringLiteral("artists.`Name` = old.`ArtistName`")) +
+        QStringLiteral("END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `ArtistsSummaryTracksUpdate` AFTER UPDATE OF `ArtistName`, `Genre` ON `Tracks` BEGIN ") +
+        artistsSummaryUpdate(QStringLiteral("artists.`Name` = old.`ArtistName`")) +
+        artistsSummaryUpdate(QStringLiteral("artists.`Name` = new.`ArtistName`")) +
+        QStringLiteral("END"),
+
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `ArtistsSummaryArtistsInsert` AFTER INSERT ON `Artists` BEGIN ") +
+        artistsSummaryUpdate(QStringLiteral("artists.`ID` = new.`ID`")) +
+        QStringLiteral("END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `ArtistsSummaryArtistsUpdate` AFTER UPDATE OF `Name` ON `Artists` BEGIN ") +
+        artistsSummaryUpdate(QStringLiteral("artists.`ID` = new.`ID`")) +
+        QStringLiteral("END"),
+        QStringLiteral("CREATE TRIGGER IF NOT EXISTS `ArtistsSummaryArtistsDelete` AFTER DELETE ON `Artists` BEGIN "
+                       "DELETE FROM `ArtistsSummary` WHERE `ArtistID` = old.`ID`; "
+                       "END"),
+    };
+
+    if (!hasAlbumsSummary) {
+        sqlUpdates.push_back(albumsSummaryInsert(QStringLiteral("album.`ID` IS NOT NULL")));
+    }
+    if (!hasArtistsSummary) {
+        sqlUpdates.push_back(artistsSummaryInsert(QStringLiteral("artists.`ID` IS NOT NULL")));
+    }
+
+    QSqlQuery sqlQuery(d->mTracksDatabase);
+
+    for (const QString& oneSqlUpdate : sqlUpdates)
+    {
+        if (!sqlQuery.exec(oneSqlUpdate)) {
+            qCWarning(orgKdeElisaDatabase) << __FUNCTION__ << sqlQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << __FUNCTION__ << sqlQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v20 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV21()
+{
+}
+
 DatabaseInterface::DatabaseState DatabaseInterface::checkDatabaseSchema() const
 {
     const auto tables = d->mExpectedTableNamesAndFields;
@@ -3285,6 +4387,9 @@ bool DatabaseInterface::resetDatabase()
         return false;
     }
 
+    QFile::remove(databaseFileName + QStringLiteral("-wal"));
+    QFile::remove(databaseFileName + QStringLiteral("-shm"));
+
     initConnection(connectionName, databaseFileName);
     return true;
 }
@@ -3421,27 +4526,13 @@ void DatabaseInterface::initDatabaseVersionQueries()
     {
         auto  initDatabaseVersionQuery = QStringLiteral("UPDATE `DatabaseVersion` set `Version` = :version ");
 
-        auto result = prepareQuery(d->mUpdateDatabaseVersionQuery, initDatabaseVersionQuery);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mUpdateDatabaseVersionQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mUpdateDatabaseVersionQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mUpdateDatabaseVersionQuery, initDatabaseVersionQuery, QStringLiteral("UpdateDatabaseVersionQuery"));
     }
 
     {
         auto  selectDatabaseVersionQuery = QStringLiteral("SELECT versionTable.`Version` FROM `DatabaseVersion` versionTable");
 
-        auto result = prepareQuery(d->mSelectDatabaseVersionQuery, selectDatabaseVersionQuery);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mSelectDatabaseVersionQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mSelectDatabaseVersionQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectDatabaseVersionQuery, selectDatabaseVersionQuery, QStringLiteral("SelectDatabaseVersionQuery"));
     }
 }
 
@@ -3473,6 +4564,18 @@ void DatabaseInterface::callUpgradeFunctionForVersion(DatabaseVersion databaseVe
     case DatabaseInterface::V17:
         upgradeDatabaseV17();
         break;
+    case DatabaseInterface::V18:
+        upgradeDatabaseV18();
+        break;
+    case DatabaseInterface::V19:
+        upgradeDatabaseV19();
+        break;
+    case DatabaseInterface::V20:
+        upgradeDatabaseV20();
+        break;
+    case DatabaseInterface::V21:
+        upgradeDatabaseV21();
+        break;
     }
 }
 
@@ -3482,6 +4585,11 @@ bool DatabaseInterface::startTransaction()
 {
     auto result = false;
 
+    // a read must see the writes still waiting in the queue of this instance
+    if (mPendingWrites->mHasWrites != 0 && d->mInitFinished && !d->mIsCommittingPendingWrites && QThread::currentThread() == thread()) {
+        commitPendingWrites();
+    }
+
     auto transactionResult = d->mTracksDatabase.transaction();
     if (!transactionResult) {
         qCDebug(orgKdeElisaDatabase) << "transaction failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().driverText();
@@ -3489,17 +4597,41 @@ bool DatabaseInterface::startTransaction()
         return result;
     }
 
+    d->mTransactionTimer.start();
+    d->mIsWriteTransaction = false;
+
     result = true;
 
     return result;
 }
 
+bool DatabaseInterface::startWriteTransaction()
+{
+    // the write lock is taken at once: it cannot be upgraded later when another process wrote meanwhile
+    auto beginQuery = d->mTracksDatabase.exec(QStringLiteral("BEGIN IMMEDIATE"));
+    if (beginQuery.lastError().isValid()) {
+        qCDebug(orgKdeElisaDatabase) << "write transaction failed" << beginQuery.lastError() << beginQuery.lastError().driverText();
+
+        return false;
+    }
+
+    d->mTransactionTimer.start();
+    d->mIsWriteTransaction = true;
+
+    // the identifiers of new data must follow the ones allocated by another process
+    internalCollectExternalChanges();
+
+    return true;
+}
+
 bool DatabaseInterface::finishTransaction()
 {
     auto result = false;
 
     auto transactionResult = d->mTracksDatabase.commit();
 
+    transactionFinished();
+
     if (!transactionResult) {
         qCDebug(orgKdeElisaDatabase) << "commit failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().nativeErrorCode();
 
@@ -3515,8 +4647,13 @@ bool DatabaseInterface::rollBackTransaction()
 {
     auto result = false;
 
+    // identifiers inserted by the cancelled transaction are no longer valid
+    d->clearIdsCaches();
+
     auto transactionResult = d->mTracksDatabase.rollback();
 
+    transactionFinished();
+
     if (!transactionResult) {
         qCDebug(orgKdeElisaDatabase) << "commit failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().nativeErrorCode();
 
@@ -3528,59 +4665,416 @@ bool DatabaseInterface::rollBackTransaction()
     return result;
 }
 
-bool DatabaseInterface::prepareQuery(QSqlQuery &query, const QString &queryText) const
+void DatabaseInterface::prepareQuery(DatabaseStatement &query, const QString &queryText, const QString &statementName) const
 {
-    query.setForwardOnly(true);
-    return query.prepare(queryText);
+    // copies of a prepared query share its text: it identifies the statement in the statistics
+    d->mStatementNames.insert(queryText, statementName);
+
+    // compiled by SQLite on its first use or in the background, see prepareNextStatements
+    query.setStatementText(queryText);
+    d->mStatements.push_back(&query);
+    d->mStatementsByName.insert(statementName, &query);
 }
 
-bool DatabaseInterface::execQuery(QSqlQuery &query)
+bool DatabaseInterface::prepareStatement(DatabaseStatement &statement)
 {
-#if !defined NDEBUG
-    auto timer = QElapsedTimer{};
-    timer.start();
-#endif
+    if (statement.isPrepared()) {
+        return true;
+    }
 
-    auto result = query.exec();
+    auto result = statement.prepareStatement();
 
-#if !defined NDEBUG
-    if (timer.nsecsElapsed() > 10000000) {
-        qCDebug(orgKdeElisaDatabase) << "[[" << timer.nsecsElapsed() << "]]" << query.lastQuery();
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::prepareStatement" << statement.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::prepareStatement" << statement.lastError();
+
+        Q_EMIT databaseError();
     }
-#endif
 
     return result;
 }
 
-void DatabaseInterface::initDataQueries()
+void DatabaseInterface::prepareNextStatements()
 {
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
+    if (!d || d->mStopRequest == 1) {
         return;
     }
 
-    {
-        auto selectAlbumQueryText = QStringLiteral("SELECT "
-                                                   "album.`ID`, "
-                                                   "album.`Title`, "
-                                                   "album.`ArtistName`, "
-                                                   "album.`AlbumPath`, "
-                                                   "album.`CoverFileName`, "
-                                                   "("
-                                                   "SELECT "
-                                                   "COUNT(*) "
-                                                   "FROM "
-                                                   "`Tracks` tracks3 "
-                                                   "WHERE "
-                                                   "tracks3.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks3.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracks3.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks3.`AlbumPath` = album.`AlbumPath` "
-                                                   ") as `TracksCount`, "
-                                                   "("
+    const auto sliceEnd = std::min(d->mNextStatementToPrepare + DatabaseInterfacePrivate::BackgroundPreparationSliceSize,
+                                   d->mStatements.size());
+
+    for (; d->mNextStatementToPrepare < sliceEnd; ++d->mNextStatementToPrepare) {
+        prepareStatement(*d->mStatements[d->mNextStatementToPrepare]);
+    }
+
+    // one slice per turn of the event loop to not delay the requests of the views
+    if (d->mNextStatementToPrepare < d->mStatements.size()) {
+        QTimer::singleShot(0, this, &DatabaseInterface::prepareNextStatements);
+    }
+}
+
+bool DatabaseInterface::prepareAllStatements()
+{
+    if (!d) {
+        return false;
+    }
+
+    auto result = true;
+
+    for (auto oneStatement : std::as_const(d->mStatements)) {
+        result = prepareStatement(*oneStatement) && result;
+    }
+
+    d->mNextStatementToPrepare = d->mStatements.size();
+
+    return result;
+}
+
+bool DatabaseInterface::execQuery(DatabaseStatement &query)
+{
+    if (!query.prepareStatement()) {
+        return false;
+    }
+
+    if (d->mStatistics) {
+        return profiledExecQuery(query);
+    }
+
+#if !defined NDEBUG
+    auto timer = QElapsedTimer{};
+    timer.start();
+#endif
+
+    auto result = query.exec();
+
+#if !defined NDEBUG
+    if (timer.nsecsElapsed() > 10000000) {
+        qCDebug(orgKdeElisaDatabase) << "[[" << timer.nsecsElapsed() << "]]" << query.lastQuery();
+    }
+#endif
+
+    return result;
+}
+
+bool DatabaseInterface::profiledExecQuery(QSqlQuery &query)
+{
+    const auto queryText = query.lastQuery();
+    const auto statementName = d->mStatementNames.value(queryText, queryText);
+
+    if (!d->mStatistics->hasQueryPlan(statementName)) {
+        d->mStatistics->setQueryPlan(statementName, internalQueryPlan(query));
+    }
+
+    // the rows of a select can only be counted when they are all fetched by exec
+    query.setForwardOnly(false);
+
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    auto result = query.exec();
+
+    auto rowsCount = qint64{0};
+    if (result && query.isSelect()) {
+        if (query.last()) {
+            rowsCount = query.at() + 1;
+        }
+        query.seek(QSql::BeforeFirstRow);
+    } else if (result) {
+        rowsCount = query.numRowsAffected();
+    }
+
+    d->mStatistics->addExecution(statementName, queryText, timer.nsecsElapsed(), rowsCount, d->mTransactionTimer.isValid());
+
+    return result;
+}
+
+QStringList DatabaseInterface::internalQueryPlan(const QSqlQuery &query)
+{
+    auto result = QStringList{};
+
+    auto planQuery = QSqlQuery{d->mTracksDatabase};
+
+    if (!planQuery.prepare(QStringLiteral("EXPLAIN QUERY PLAN ") + query.lastQuery())) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalQueryPlan" << planQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalQueryPlan" << planQuery.lastError();
+
+        return result;
+    }
+
+    // the placeholders keep their order: the values bound to the query are reused by position
+    const auto boundValues = query.boundValues();
+    for (const auto &oneValue : boundValues) {
+        planQuery.addBindValue(oneValue);
+    }
+
+    if (!planQuery.exec()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalQueryPlan" << planQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalQueryPlan" << planQuery.lastError();
+
+        return result;
+    }
+
+    // the detail of each step of the plan is the fourth column
+    while (planQuery.next()) {
+        result.push_back(planQuery.value(3).toString());
+    }
+
+    planQuery.finish();
+
+    return result;
+}
+
+void DatabaseInterface::setStatementProfiling(bool enabled)
+{
+    if (!d || enabled == static_cast<bool>(d->mStatistics)) {
+        return;
+    }
+
+    d->mStatistics = enabled ? std::make_shared<DatabaseStatistics>() : nullptr;
+}
+
+std::shared_ptr<DatabaseStatistics> DatabaseInterface::statementStatistics() const
+{
+    if (!d) {
+        return {};
+    }
+
+    return d->mStatistics;
+}
+
+void DatabaseInterface::setStatementStatistics(std::shared_ptr<DatabaseStatistics> statistics)
+{
+    if (!d) {
+        return;
+    }
+
+    d->mStatistics = std::move(statistics);
+}
+
+void DatabaseInterface::setLoadCancellation(const QAtomicInt *isCancelled)
+{
+    if (!d) {
+        return;
+    }
+
+    d->mLoadCancellation = isCancelled;
+}
+
+bool DatabaseInterface::isLoadCancelled() const
+{
+    return d && d->mLoadCancellation && d->mLoadCancellation->loadRelaxed() == 1;
+}
+
+void DatabaseInterface::transactionFinished()
+{
+    if (d->mStatistics && d->mTransactionTimer.isValid()) {
+        d->mStatistics->addTransaction(d->mTransactionTimer.nsecsElapsed(), d->mIsWriteTransaction);
+    }
+
+    d->mTransactionTimer.invalidate();
+}
+
+void DatabaseInterface::initDataQueries()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    {
+        QSqlQuery createNotifiedIdsQuery(d->mTracksDatabase);
+
+        const auto &result = createNotifiedIdsQuery.exec(QStringLiteral("CREATE TEMPORARY TABLE IF NOT EXISTS `NotifiedIds` (`ID` INTEGER PRIMARY KEY NOT NULL)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << createNotifiedIdsQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << createNotifiedIdsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createRemovedFileNamesQuery(d->mTracksDatabase);
+
+        const auto &result = createRemovedFileNamesQuery.exec(QStringLiteral("CREATE TEMPORARY TABLE IF NOT EXISTS `RemovedFileNames` (`FileName` VARCHAR(255) PRIMARY KEY NOT NULL)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << createRemovedFileNamesQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << createRemovedFileNamesQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createRemovedTracksQuery(d->mTracksDatabase);
+
+        const auto &result = createRemovedTracksQuery.exec(QStringLiteral("CREATE TEMPORARY TABLE IF NOT EXISTS `RemovedTracks` ("
+                                                                          "`ID` INTEGER NOT NULL, "
+                                                                          "`ArtistName` VARCHAR(55), "
+                                                                          "`AlbumID` INTEGER, "
+                                                                          "`AlbumArtistName` VARCHAR(55))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << createRemovedTracksQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << createRemovedTracksQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearRemovedFileNamesQueryText = QStringLiteral("DELETE FROM temp.`RemovedFileNames`");
+
+        prepareQuery(d->mClearRemovedFileNamesQuery, clearRemovedFileNamesQueryText, QStringLiteral("ClearRemovedFileNamesQuery"));
+    }
+
+    {
+        auto insertRemovedFileNameQueryText = QStringLiteral("INSERT OR IGNORE INTO temp.`RemovedFileNames` (`FileName`) VALUES (:fileName)");
+
+        prepareQuery(d->mInsertRemovedFileNameQuery, insertRemovedFileNameQueryText, QStringLiteral("InsertRemovedFileNameQuery"));
+    }
+
+    {
+        auto clearRemovedTracksQueryText = QStringLiteral("DELETE FROM temp.`RemovedTracks`");
+
+        prepareQuery(d->mClearRemovedTracksQuery, clearRemovedTracksQueryText, QStringLiteral("ClearRemovedTracksQuery"));
+    }
+
+    {
+        auto insertRemovedTracksQueryText = QStringLiteral("INSERT INTO temp.`RemovedTracks` (`ID`, `ArtistName`, `AlbumID`, `AlbumArtistName`) "
+                                                           "SELECT "
+                                                           "tracks.`ID`, "
+                                                           "tracks.`ArtistName`, "
+                                                           "album.`ID`, "
+                                                           "album.`ArtistName` "
+                                                           "FROM "
+                                                           "`Tracks` tracks "
+                                                           "LEFT JOIN "
+                                                           "`Albums` album "
+                                                           "ON "
+                                                           "tracks.`AlbumTitle` = album.`Title` AND "
+                                                           "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL) AND "
+                                                           "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                           "WHERE "
+                                                           "tracks.`FileName` IN (SELECT `FileName` FROM temp.`RemovedFileNames`)");
+
+        prepareQuery(d->mInsertRemovedTracksQuery, insertRemovedTracksQueryText, QStringLiteral("InsertRemovedTracksQuery"));
+    }
+
+    {
+        auto selectRemovedTracksIdsQueryText = QStringLiteral("SELECT DISTINCT `ID` FROM temp.`RemovedTracks`");
+
+        prepareQuery(d->mSelectRemovedTracksIdsQuery, selectRemovedTracksIdsQueryText, QStringLiteral("SelectRemovedTracksIdsQuery"));
+    }
+
+    {
+        auto removeTracksFromRemovedFileNamesQueryText = QStringLiteral("DELETE FROM `Tracks` "
+                                                                        "WHERE "
+                                                                        "`ID` IN (SELECT `ID` FROM temp.`RemovedTracks`)");
+
+        prepareQuery(d->mRemoveTracksFromRemovedFileNamesQuery, removeTracksFromRemovedFileNamesQueryText, QStringLiteral("RemoveTracksFromRemovedFileNamesQuery"));
+    }
+
+    {
+        auto removeTracksDataFromRemovedFileNamesQueryText = QStringLiteral("DELETE FROM `TracksData` "
+                                                                            "WHERE "
+                                                                            "`FileName` IN (SELECT `FileName` FROM temp.`RemovedFileNames`)");
+
+        prepareQuery(d->mRemoveTracksDataFromRemovedFileNamesQuery, removeTracksDataFromRemovedFileNamesQueryText, QStringLiteral("RemoveTracksDataFromRemovedFileNamesQuery"));
+    }
+
+    {
+        auto selectRemovedTracksAlbumsQueryText = QStringLiteral("SELECT "
+                                                                 "album.`ID`, "
+                                                                 "NOT EXISTS ("
+                                                                 "SELECT 1 "
+                                                                 "FROM "
+                                                                 "`Tracks` tracks "
+                                                                 "WHERE "
+                                                                 "tracks.`AlbumTitle` = album.`Title` AND "
+                                                                 "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL) AND "
+                                                                 "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                                 ") AS IsEmpty "
+                                                                 "FROM "
+                                                                 "`Albums` album "
+                                                                 "WHERE "
+                                                                 "album.`ID` IN (SELECT `AlbumID` FROM temp.`RemovedTracks`)");
+
+        prepareQuery(d->mSelectRemovedTracksAlbumsQuery, selectRemovedTracksAlbumsQueryText, QStringLiteral("SelectRemovedTracksAlbumsQuery"));
+    }
+
+    {
+        auto selectRemovedTracksOrphanArtistsQueryText = QStringLiteral("SELECT "
+                                                                        "artist.`ID` "
+                                                                        "FROM "
+                                                                        "`Artists` artist "
+                                                                        "WHERE "
+                                                                        "artist.`Name` IN ("
+                                                                        "SELECT `ArtistName` FROM temp.`RemovedTracks` "
+                                                                        "UNION "
+                                                                        "SELECT `AlbumArtistName` FROM temp.`RemovedTracks`"
+                                                                        ") AND "
+                                                                        "NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`ArtistName` = artist.`Name`) AND "
+                                                                        "NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`AlbumArtistName` = artist.`Name`) AND "
+                                                                        "NOT EXISTS (SELECT 1 FROM `Albums` album WHERE album.`ArtistName` = artist.`Name`)");
+
+        prepareQuery(d->mSelectRemovedTracksOrphanArtistsQuery, selectRemovedTracksOrphanArtistsQueryText, QStringLiteral("SelectRemovedTracksOrphanArtistsQuery"));
+    }
+
+    {
+        // the weights of bm25 follow the order of the columns: Kind, ItemID, Title, Artist, Album, Composer and Genre
+        auto librarySearchQueryText = QStringLiteral("SELECT "
+                                                     "`Kind`, "
+                                                     "`ItemID`, "
+                                                     "`Title`, "
+                                                     "`Artist`, "
+                                                     "`Album` "
+                                                     "FROM "
+                                                     "`LibrarySearch` "
+                                                     "WHERE "
+                                                     "`LibrarySearch` MATCH :pattern "
+                                                     "ORDER BY bm25(`LibrarySearch`, 0.0, 0.0, 10.0, 5.0, 3.0, 2.0, 1.0) "
+                                                     "LIMIT :maximumResults OFFSET :offset");
+
+        prepareQuery(d->mLibrarySearchQuery, librarySearchQueryText, QStringLiteral("LibrarySearchQuery"));
+    }
+
+    {
+        auto clearNotifiedIdsQueryText = QStringLiteral("DELETE FROM temp.`NotifiedIds`");
+
+        prepareQuery(d->mClearNotifiedIdsQuery, clearNotifiedIdsQueryText, QStringLiteral("ClearNotifiedIdsQuery"));
+    }
+
+    {
+        auto insertNotifiedIdQueryText = QStringLiteral("INSERT OR IGNORE INTO temp.`NotifiedIds` (`ID`) VALUES (:id)");
+
+        prepareQuery(d->mInsertNotifiedIdQuery, insertNotifiedIdQueryText, QStringLiteral("InsertNotifiedIdQuery"));
+    }
+
+    {
+        auto selectAlbumsDataQueryText = QStringLiteral("SELECT "
+                                                   "album.`ID`, "
+                                                   "album.`Title`, "
+                                                   "album.`ArtistName`, "
+                                                   "album.`AlbumPath`, "
+                                                   "album.`CoverFileName`, "
+                                                   "("
+                                                   "SELECT "
+                                                   "COUNT(*) "
+                                                   "FROM "
+                                                   "`Tracks` tracks3 "
+                                                   "WHERE "
+                                                   "tracks3.`AlbumTitle` = album.`Title` AND "
+                                                   "(tracks3.`AlbumArtistName` = album.`ArtistName` OR "
+                                                   "(tracks3.`AlbumArtistName` IS NULL AND "
+                                                   "album.`ArtistName` IS NULL"
+                                                   ")"
+                                                   ") AND "
+                                                   "tracks3.`AlbumPath` = album.`AlbumPath` "
+                                                   ") as `TracksCount`, "
+                                                   "("
                                                    "SELECT "
                                                    "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
                                                    "FROM "
@@ -3625,19 +5119,19 @@ void DatabaseInterface::initDataQueries()
                                                    ") AND "
                                                    "tracks.`AlbumPath` = album.`AlbumPath`"
                                                    "LEFT JOIN "
-                                                   "`Genre` genres ON tracks.`Genre` = genres.`Name` "
-                                                   "WHERE "
-                                                   "album.`ID` = :albumId "
-                                                   "GROUP BY album.`ID`");
+                                                   "`Genre` genres ON tracks.`Genre` = genres.`Name` ");
 
-        auto result = prepareQuery(d->mSelectAlbumQuery, selectAlbumQueryText);
+        auto selectAlbumQueryText = selectAlbumsDataQueryText + QStringLiteral("WHERE "
+                                                                               "album.`ID` = :albumId "
+                                                                               "GROUP BY album.`ID`");
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumQuery.lastError();
+        prepareQuery(d->mSelectAlbumQuery, selectAlbumQueryText, QStringLiteral("SelectAlbumQuery"));
 
-            Q_EMIT databaseError();
-        }
+        auto selectNotifiedAlbumsQueryText = selectAlbumsDataQueryText + QStringLiteral("WHERE "
+                                                                                        "album.`ID` IN (SELECT `ID` FROM temp.`NotifiedIds`) "
+                                                                                        "GROUP BY album.`ID`");
+
+        prepareQuery(d->mSelectNotifiedAlbumsQuery, selectNotifiedAlbumsQueryText, QStringLiteral("SelectNotifiedAlbumsQuery"));
     }
 
     {
@@ -3647,14 +5141,7 @@ void DatabaseInterface::initDataQueries()
                                                   "FROM `Genre` genre "
                                                   "ORDER BY genre.`Name` COLLATE NOCASE");
 
-        auto result = prepareQuery(d->mSelectAllGenresQuery, selectAllGenresText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllGenresQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllGenresQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllGenresQuery, selectAllGenresText, QStringLiteral("SelectAllGenresQuery"));
     }
 
     {
@@ -3664,62 +5151,21 @@ void DatabaseInterface::initDataQueries()
                                                   "album.`ArtistName` as SecondaryText, "
                                                   "album.`CoverFileName`, "
                                                   "album.`ArtistName`, "
-                                                  "GROUP_CONCAT(tracks.`Year`, ', ') as Year, "
-                                                  "COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, "
-                                                  "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
-                                                  "MAX(tracks.`Rating`) as HighestRating, "
-                                                  "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, "
-                                                  "("
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                  "FROM "
-                                                  "`Tracks` tracks2 "
-                                                  "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as `IsSingleDiscAlbum`, "
-                                                  "( "
-                                                  "SELECT tracksCover.`FileName` "
-                                                  "FROM "
-                                                  "`Tracks` tracksCover "
-                                                  "WHERE "
-                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as EmbeddedCover "
+                                                  "summary.`Year`, "
+                                                  "summary.`ArtistsCount`, "
+                                                  "summary.`AllArtists`, "
+                                                  "summary.`HighestRating`, "
+                                                  "summary.`AllGenres`, "
+                                                  "summary.`IsSingleDiscAlbum`, "
+                                                  "summary.`EmbeddedCover` "
                                                   "FROM "
                                                   "`Albums` album, "
-                                                  "`Tracks` tracks LEFT JOIN "
-                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                  "`AlbumsSummary` summary "
                                                   "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ") "
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                  "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` "
+                                                  "summary.`AlbumID` = album.`ID` "
                                                   "ORDER BY album.`Title` COLLATE NOCASE");
 
-        auto result = prepareQuery(d->mSelectAllAlbumsShortQuery, selectAllAlbumsText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllAlbumsShortQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllAlbumsShortQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllAlbumsShortQuery, selectAllAlbumsText, QStringLiteral("SelectAllAlbumsShortQuery"));
     }
 
     {
@@ -3729,51 +5175,18 @@ void DatabaseInterface::initDataQueries()
                                                   "album.`ArtistName` as SecondaryText, "
                                                   "album.`CoverFileName`, "
                                                   "album.`ArtistName`, "
-                                                  "GROUP_CONCAT(tracks.`Year`, ', ') as Year, "
-                                                  "COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, "
-                                                  "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
-                                                  "MAX(tracks.`Rating`) as HighestRating, "
-                                                  "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, "
-                                                  "("
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                  "FROM "
-                                                  "`Tracks` tracks2 "
-                                                  "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as `IsSingleDiscAlbum`, "
-                                                  "( "
-                                                  "SELECT tracksCover.`FileName` "
-                                                  "FROM "
-                                                  "`Tracks` tracksCover "
-                                                  "WHERE "
-                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as EmbeddedCover "
+                                                  "summary.`Year`, "
+                                                  "summary.`ArtistsCount`, "
+                                                  "summary.`AllArtists`, "
+                                                  "summary.`HighestRating`, "
+                                                  "summary.`AllGenres`, "
+                                                  "summary.`IsSingleDiscAlbum`, "
+                                                  "summary.`EmbeddedCover` "
                                                   "FROM "
                                                   "`Albums` album, "
-                                                  "`Tracks` tracks LEFT JOIN "
-                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                  "`AlbumsSummary` summary "
                                                   "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` AND "
+                                                  "summary.`AlbumID` = album.`ID` AND "
                                                   "EXISTS ("
                                                   "  SELECT tracks2.`Genre` "
                                                   "  FROM "
@@ -3790,17 +5203,9 @@ void DatabaseInterface::initDataQueries()
                                                   "  genre2.`Name` = :genreFilter AND "
                                                   "  (tracks2.`ArtistName` = :artistFilter OR tracks2.`AlbumArtistName` = :artistFilter) "
                                                   ") "
-                                                  "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` "
                                                   "ORDER BY album.`Title` COLLATE NOCASE");
 
-        auto result = prepareQuery(d->mSelectAllAlbumsShortWithGenreArtistFilterQuery, selectAllAlbumsText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllAlbumsShortWithGenreArtistFilterQuery, selectAllAlbumsText, QStringLiteral("SelectAllAlbumsShortWithGenreArtistFilterQuery"));
     }
 
     {
@@ -3810,51 +5215,18 @@ void DatabaseInterface::initDataQueries()
                                                   "album.`ArtistName` as SecondaryText, "
                                                   "album.`CoverFileName`, "
                                                   "album.`ArtistName`, "
-                                                  "GROUP_CONCAT(tracks.`Year`, ', ') as Year, "
-                                                  "COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, "
-                                                  "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
-                                                  "MAX(tracks.`Rating`) as HighestRating, "
-                                                  "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, "
-                                                  "("
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                  "FROM "
-                                                  "`Tracks` tracks2 "
-                                                  "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as `IsSingleDiscAlbum`, "
-                                                  "( "
-                                                  "SELECT tracksCover.`FileName` "
-                                                  "FROM "
-                                                  "`Tracks` tracksCover "
-                                                  "WHERE "
-                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as EmbeddedCover "
+                                                  "summary.`Year`, "
+                                                  "summary.`ArtistsCount`, "
+                                                  "summary.`AllArtists`, "
+                                                  "summary.`HighestRating`, "
+                                                  "summary.`AllGenres`, "
+                                                  "summary.`IsSingleDiscAlbum`, "
+                                                  "summary.`EmbeddedCover` "
                                                   "FROM "
                                                   "`Albums` album, "
-                                                  "`Tracks` tracks LEFT JOIN "
-                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                  "`AlbumsSummary` summary "
                                                   "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` AND "
+                                                  "summary.`AlbumID` = album.`ID` AND "
                                                   "EXISTS ("
                                                   "  SELECT tracks2.`Genre` "
                                                   "  FROM "
@@ -3870,37 +5242,22 @@ void DatabaseInterface::initDataQueries()
                                                   "  ) AND "
                                                   "  (tracks2.`ArtistName` = :artistFilter OR tracks2.`AlbumArtistName` = :artistFilter) "
                                                   ") "
-                                                  "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` "
                                                   "ORDER BY album.`Title` COLLATE NOCASE");
 
-        auto result = prepareQuery(d->mSelectAllAlbumsShortWithArtistFilterQuery, selectAllAlbumsText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllAlbumsShortWithArtistFilterQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllAlbumsShortWithArtistFilterQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllAlbumsShortWithArtistFilterQuery, selectAllAlbumsText, QStringLiteral("SelectAllAlbumsShortWithArtistFilterQuery"));
     }
 
     {
         auto selectAllArtistsWithFilterText = QStringLiteral("SELECT artists.`ID`, "
                                                              "artists.`Name`, "
-                                                             "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres "
-                                                             "FROM `Artists` artists  LEFT JOIN "
-                                                             "`Tracks` tracks ON artists.`Name` = tracks.`ArtistName` LEFT JOIN "
-                                                             "`Genre` genres ON tracks.`Genre` = genres.`Name` "
-                                                             "GROUP BY artists.`ID` "
+                                                             "summary.`AllGenres` "
+                                                             "FROM `Artists` artists, "
+                                                             "`ArtistsSummary` summary "
+                                                             "WHERE "
+                                                             "summary.`ArtistID` = artists.`ID` "
                                                              "ORDER BY artists.`Name` COLLATE NOCASE");
 
-        auto result = prepareQuery(d->mSelectAllArtistsQuery, selectAllArtistsWithFilterText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllArtistsQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllArtistsQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllArtistsQuery, selectAllArtistsWithFilterText, QStringLiteral("SelectAllArtistsQuery"));
     }
 
     {
@@ -3924,14 +5281,7 @@ void DatabaseInterface::initDataQueries()
                                                                   "GROUP BY artists.`ID` "
                                                                   "ORDER BY artists.`Name` COLLATE NOCASE");
 
-        auto result = prepareQuery(d->mSelectAllArtistsWithGenreFilterQuery, selectAllArtistsWithGenreFilterText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllArtistsWithGenreFilterQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllArtistsWithGenreFilterQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllArtistsWithGenreFilterQuery, selectAllArtistsWithGenreFilterText, QStringLiteral("SelectAllArtistsWithGenreFilterQuery"));
     }
 
     {
@@ -3952,14 +5302,7 @@ void DatabaseInterface::initDataQueries()
                                                    ") AND "
                                                    "artists.`ID` = :databaseId");
 
-        auto result = prepareQuery(d->mArtistMatchGenreQuery, artistMatchGenreText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mArtistMatchGenreQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mArtistMatchGenreQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mArtistMatchGenreQuery, artistMatchGenreText, QStringLiteral("ArtistMatchGenreQuery"));
     }
 
     {
@@ -3968,14 +5311,7 @@ void DatabaseInterface::initDataQueries()
                                                                "FROM `Artists` "
                                                                "ORDER BY `Name` COLLATE NOCASE");
 
-        auto result = prepareQuery(d->mSelectAllComposersQuery, selectAllComposersWithFilterText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllComposersQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllComposersQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllComposersQuery, selectAllComposersWithFilterText, QStringLiteral("SelectAllComposersQuery"));
     }
 
     {
@@ -3984,14 +5320,7 @@ void DatabaseInterface::initDataQueries()
                                                                "FROM `Lyricist` "
                                                                "ORDER BY `Name` COLLATE NOCASE");
 
-        auto result = prepareQuery(d->mSelectAllLyricistsQuery, selectAllLyricistsWithFilterText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllLyricistsQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllLyricistsQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllLyricistsQuery, selectAllLyricistsWithFilterText, QStringLiteral("SelectAllLyricistsQuery"));
     }
 
     {
@@ -4115,14 +5444,7 @@ void DatabaseInterface::initDataQueries()
                                                   ")"
                                                   "");
 
-        auto result = prepareQuery(d->mSelectAllTracksQuery, selectAllTracksText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllTracksQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllTracksQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllTracksQuery, selectAllTracksText, QStringLiteral("SelectAllTracksQuery"));
     }
 
     {
@@ -4139,14 +5461,7 @@ void DatabaseInterface::initDataQueries()
                                                   "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = radios.`Genre` "
                                                   "");
 
-        auto result = prepareQuery(d->mSelectAllRadiosQuery, selectAllRadiosText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllRadiosQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllRadiosQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllRadiosQuery, selectAllRadiosText, QStringLiteral("SelectAllRadiosQuery"));
     }
 
     {
@@ -4269,14 +5584,7 @@ void DatabaseInterface::initDataQueries()
                                                   "ORDER BY tracksMapping.`LastPlayDate` DESC "
                                                   "LIMIT :maximumResults");
 
-        auto result = prepareQuery(d->mSelectAllRecentlyPlayedTracksQuery, selectAllTracksText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllRecentlyPlayedTracksQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllRecentlyPlayedTracksQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllRecentlyPlayedTracksQuery, selectAllTracksText, QStringLiteral("SelectAllRecentlyPlayedTracksQuery"));
     }
 
     {
@@ -4399,105 +5707,49 @@ void DatabaseInterface::initDataQueries()
                                                   "ORDER BY tracksMapping.`PlayCounter` DESC "
                                                   "LIMIT :maximumResults");
 
-        auto result = prepareQuery(d->mSelectAllFrequentlyPlayedTracksQuery, selectAllTracksText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllFrequentlyPlayedTracksQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllFrequentlyPlayedTracksQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllFrequentlyPlayedTracksQuery, selectAllTracksText, QStringLiteral("SelectAllFrequentlyPlayedTracksQuery"));
     }
 
     {
         auto clearAlbumsTableText = QStringLiteral("DELETE FROM `Albums`");
 
-        auto result = prepareQuery(d->mClearAlbumsTable, clearAlbumsTableText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearAlbumsTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearAlbumsTable.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mClearAlbumsTable, clearAlbumsTableText, QStringLiteral("ClearAlbumsTable"));
     }
 
     {
         auto clearArtistsTableText = QStringLiteral("DELETE FROM `Artists`");
 
-        auto result = prepareQuery(d->mClearArtistsTable, clearArtistsTableText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearArtistsTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearArtistsTable.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mClearArtistsTable, clearArtistsTableText, QStringLiteral("ClearArtistsTable"));
     }
 
     {
         auto clearComposerTableText = QStringLiteral("DELETE FROM `Composer`");
 
-        auto result = prepareQuery(d->mClearComposerTable, clearComposerTableText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearComposerTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearComposerTable.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mClearComposerTable, clearComposerTableText, QStringLiteral("ClearComposerTable"));
     }
 
     {
         auto clearGenreTableText = QStringLiteral("DELETE FROM `Genre`");
 
-        auto result = prepareQuery(d->mClearGenreTable, clearGenreTableText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearGenreTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearGenreTable.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mClearGenreTable, clearGenreTableText, QStringLiteral("ClearGenreTable"));
     }
 
     {
         auto clearLyricistTableText = QStringLiteral("DELETE FROM `Lyricist`");
 
-        auto result = prepareQuery(d->mClearLyricistTable, clearLyricistTableText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearLyricistTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearLyricistTable.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mClearLyricistTable, clearLyricistTableText, QStringLiteral("ClearLyricistTable"));
     }
 
     {
         auto clearTracksDataTableText = QStringLiteral("DELETE FROM `TracksData`");
 
-        auto result = prepareQuery(d->mClearTracksDataTable, clearTracksDataTableText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearTracksDataTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearTracksDataTable.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mClearTracksDataTable, clearTracksDataTableText, QStringLiteral("ClearTracksDataTable"));
     }
 
     {
         auto clearTracksTableText = QStringLiteral("DELETE FROM `Tracks`");
 
-        auto result = prepareQuery(d->mClearTracksTable, clearTracksTableText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearTracksTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearTracksTable.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mClearTracksTable, clearTracksTableText, QStringLiteral("ClearTracksTable"));
     }
 
     {
@@ -4550,14 +5802,7 @@ void DatabaseInterface::initDataQueries()
                                                        "tracks.`AlbumPath` = album.`AlbumPath` "
                                                        "");
 
-        auto result = prepareQuery(d->mSelectAllTracksShortQuery, selectAllTracksShortText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllTracksShortQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllTracksShortQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllTracksShortQuery, selectAllTracksShortText, QStringLiteral("SelectAllTracksShortQuery"));
     }
 
     {
@@ -4567,14 +5812,7 @@ void DatabaseInterface::initDataQueries()
                                                      "WHERE "
                                                      "`Name` = :name");
 
-        auto result = prepareQuery(d->mSelectArtistByNameQuery, selectArtistByNameText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectArtistByNameQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectArtistByNameQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectArtistByNameQuery, selectArtistByNameText, QStringLiteral("SelectArtistByNameQuery"));
     }
 
     {
@@ -4584,12 +5822,7 @@ void DatabaseInterface::initDataQueries()
                                                        "WHERE "
                                                        "`Name` = :name");
 
-        auto result = prepareQuery(d->mSelectComposerByNameQuery, selectComposerByNameText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectComposerByNameQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectComposerByNameQuery.lastError();
-        }
+        prepareQuery(d->mSelectComposerByNameQuery, selectComposerByNameText, QStringLiteral("SelectComposerByNameQuery"));
     }
 
     {
@@ -4599,12 +5832,7 @@ void DatabaseInterface::initDataQueries()
                                                        "WHERE "
                                                        "`Name` = :name");
 
-        auto result = prepareQuery(d->mSelectLyricistByNameQuery, selectLyricistByNameText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectLyricistByNameQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectLyricistByNameQuery.lastError();
-        }
+        prepareQuery(d->mSelectLyricistByNameQuery, selectLyricistByNameText, QStringLiteral("SelectLyricistByNameQuery"));
     }
 
     {
@@ -4614,66 +5842,35 @@ void DatabaseInterface::initDataQueries()
                                                     "WHERE "
                                                     "`Name` = :name");
 
-        auto result = prepareQuery(d->mSelectGenreByNameQuery, selectGenreByNameText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectGenreByNameQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectGenreByNameQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectGenreByNameQuery, selectGenreByNameText, QStringLiteral("SelectGenreByNameQuery"));
     }
 
     {
         auto insertArtistsText = QStringLiteral("INSERT INTO `Artists` (`ID`, `Name`) "
                                                 "VALUES (:artistId, :name)");
 
-        auto result = prepareQuery(d->mInsertArtistsQuery, insertArtistsText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertArtistsQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertArtistsQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mInsertArtistsQuery, insertArtistsText, QStringLiteral("InsertArtistsQuery"));
     }
 
     {
         auto insertGenreText = QStringLiteral("INSERT INTO `Genre` (`ID`, `Name`) "
                                               "VALUES (:genreId, :name)");
 
-        auto result = prepareQuery(d->mInsertGenreQuery, insertGenreText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertGenreQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertGenreQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mInsertGenreQuery, insertGenreText, QStringLiteral("InsertGenreQuery"));
     }
 
     {
         auto insertComposerText = QStringLiteral("INSERT INTO `Composer` (`ID`, `Name`) "
                                                  "VALUES (:composerId, :name)");
 
-        auto result = prepareQuery(d->mInsertComposerQuery, insertComposerText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertComposerQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertComposerQuery.lastError();
-        }
+        prepareQuery(d->mInsertComposerQuery, insertComposerText, QStringLiteral("InsertComposerQuery"));
     }
 
     {
         auto insertLyricistText = QStringLiteral("INSERT INTO `Lyricist` (`ID`, `Name`) "
                                                  "VALUES (:lyricistId, :name)");
 
-        auto result = prepareQuery(d->mInsertLyricistQuery, insertLyricistText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertLyricistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertLyricistQuery.lastError();
-        }
+        prepareQuery(d->mInsertLyricistQuery, insertLyricistText, QStringLiteral("InsertLyricistQuery"));
     }
 
     {
@@ -4797,14 +5994,7 @@ void DatabaseInterface::initDataQueries()
                                                    "ORDER BY tracks.`DiscNumber` ASC, "
                                                    "tracks.`TrackNumber` ASC");
 
-        auto result = prepareQuery(d->mSelectTrackQuery, selectTrackQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTrackQuery, selectTrackQueryText, QStringLiteral("SelectTrackQuery"));
     }
 
     {
@@ -4838,18 +6028,11 @@ void DatabaseInterface::initDataQueries()
                                                    "ORDER BY tracks.`DiscNumber` ASC, "
                                                    "tracks.`TrackNumber` ASC");
 
-        auto result = prepareQuery(d->mSelectTrackIdQuery, selectTrackQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackIdQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTrackIdQuery, selectTrackQueryText, QStringLiteral("SelectTrackIdQuery"));
     }
 
     {
-        auto selectTrackFromIdQueryText = QStringLiteral("SELECT "
+        auto selectTracksDataQueryText = QStringLiteral("SELECT "
                                                          "tracks.`Id`, "
                                                          "tracks.`Title`, "
                                                          "album.`ID`, "
@@ -4949,19 +6132,58 @@ void DatabaseInterface::initDataQueries()
                                                          "tracks.`AlbumPath` = album.`AlbumPath` "
                                                          "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
                                                          "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                         "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                         "WHERE "
-                                                         "tracks.`ID` = :trackId AND "
-                                                         "tracksMapping.`FileName` = tracks.`FileName`"
-                                                         "");
-
-        auto result = prepareQuery(d->mSelectTrackFromIdQuery, selectTrackFromIdQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackFromIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackFromIdQuery.lastError();
-
-            Q_EMIT databaseError();
+                                                         "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` ");
+
+        auto selectTrackFromIdQueryText = selectTracksDataQueryText + QStringLiteral("WHERE "
+                                                                                     "tracks.`ID` = :trackId AND "
+                                                                                     "tracksMapping.`FileName` = tracks.`FileName`");
+
+        prepareQuery(d->mSelectTrackFromIdQuery, selectTrackFromIdQueryText, QStringLiteral("SelectTrackFromIdQuery"));
+
+        auto selectNotifiedTracksQueryText = selectTracksDataQueryText + QStringLiteral("WHERE "
+                                                                                        "tracks.`ID` IN (SELECT `ID` FROM temp.`NotifiedIds`) AND "
+                                                                                        "tracksMapping.`FileName` = tracks.`FileName`");
+
+        prepareQuery(d->mSelectNotifiedTracksQuery, selectNotifiedTracksQueryText, QStringLiteral("SelectNotifiedTracksQuery"));
+
+        // keyset pagination: each page starts after the sort key and ID of the last track of the previous one
+        const auto pagedSortRoles = {DataTypes::TitleRole, DataTypes::AlbumRole, DataTypes::ArtistRole,
+                                     DataTypes::GenreRole, DataTypes::ComposerRole, DataTypes::LyricistRole,
+                                     DataTypes::YearRole, DataTypes::DurationRole, DataTypes::FileModificationTime};
+
+        for (const auto oneSortRole : pagedSortRoles) {
+            const auto sortExpression = trackSortExpression(oneSortRole);
+
+            for (const auto oneSortOrder : {Qt::AscendingOrder, Qt::DescendingOrder}) {
+                const auto comparison = (oneSortOrder == Qt::AscendingOrder ? QStringLiteral(">") : QStringLiteral("<"));
+                const auto direction = (oneSortOrder == Qt::AscendingOrder ? QStringLiteral("ASC") : QStringLiteral("DESC"));
+
+                auto selectTracksPageQueryText = selectTracksDataQueryText + QStringLiteral("WHERE "
+                                                                                            "tracksMapping.`FileName` = tracks.`FileName` AND "
+                                                                                            "%1 %2= :sortValue AND "
+                                                                                            "(%1 %2 :sortValue OR tracks.`ID` %2 :databaseId) AND "
+                                                                                            "(tracks.`Title` IS NULL OR "
+                                                                                            "tracks.`Priority` = ("
+                                                                                            "     SELECT "
+                                                                                            "     MIN(`Priority`) "
+                                                                                            "     FROM "
+                                                                                            "     `Tracks` tracks2 "
+                                                                                            "     WHERE "
+                                                                                            "     tracks.`Title` = tracks2.`Title` AND "
+                                                                                            "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
+                                                                                            "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
+                                                                                            "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
+                                                                                            "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
+                                                                                            ")) "
+                                                                                            "ORDER BY %1 %3, tracks.`ID` %3 "
+                                                                                            "LIMIT :maximumResults").arg(sortExpression, comparison, direction);
+
+                auto &selectTracksPageQuery = d->mSelectTracksPageQueries[tracksPageQueryKey(oneSortRole, oneSortOrder)];
+                selectTracksPageQuery = DatabaseStatement(d->mTracksDatabase);
+
+                prepareQuery(selectTracksPageQuery, selectTracksPageQueryText,
+                             QStringLiteral("SelectTracksPageQuery%1").arg(tracksPageQueryKey(oneSortRole, oneSortOrder)));
+            }
         }
     }
 
@@ -5073,14 +6295,7 @@ void DatabaseInterface::initDataQueries()
                                                          "tracksMapping.`FileName` = :trackUrl "
                                                          "");
 
-        auto result = prepareQuery(d->mSelectTrackFromIdAndUrlQuery, selectTrackFromIdAndUrlQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackFromIdAndUrlQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackFromIdAndUrlQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTrackFromIdAndUrlQuery, selectTrackFromIdAndUrlQueryText, QStringLiteral("SelectTrackFromIdAndUrlQuery"));
     }
 
     {
@@ -5099,28 +6314,14 @@ void DatabaseInterface::initDataQueries()
                                                   "radios.`ID` = :radioId "
                                                   "");
 
-        auto result = prepareQuery(d->mSelectRadioFromIdQuery, selectRadioFromIdQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectRadioFromIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectRadioFromIdQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectRadioFromIdQuery, selectRadioFromIdQueryText, QStringLiteral("SelectRadioFromIdQuery"));
     }
     {
         auto selectCountAlbumsQueryText = QStringLiteral("SELECT count(*) "
                                                          "FROM `Albums` album "
                                                          "WHERE album.`ArtistName` = :artistName ");
 
-        const auto result = prepareQuery(d->mSelectCountAlbumsForArtistQuery, selectCountAlbumsQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectCountAlbumsForArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectCountAlbumsForArtistQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        const prepareQuery(d->mSelectCountAlbumsForArtistQuery, selectCountAlbumsQueryText, QStringLiteral("SelectCountAlbumsForArtistQuery"));
     }
 
     {
@@ -5137,14 +6338,7 @@ void DatabaseInterface::initDataQueries()
                                                             "WHERE "
                                                             "album.`ArtistName` = :artistName");
 
-        const auto result = prepareQuery(d->mSelectGenreForArtistQuery, selectGenreForArtistQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectGenreForArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectGenreForArtistQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        const prepareQuery(d->mSelectGenreForArtistQuery, selectGenreForArtistQueryText, QStringLiteral("SelectGenreForArtistQuery"));
     }
 
     {
@@ -5161,14 +6355,7 @@ void DatabaseInterface::initDataQueries()
                                                            "WHERE "
                                                            "album.`ID` = :albumId");
 
-        const auto result = prepareQuery(d->mSelectGenreForAlbumQuery, selectGenreForAlbumQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectGenreForAlbumQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectGenreForAlbumQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        const prepareQuery(d->mSelectGenreForAlbumQuery, selectGenreForAlbumQueryText, QStringLiteral("SelectGenreForAlbumQuery"));
     }
 
     {
@@ -5183,14 +6370,7 @@ void DatabaseInterface::initDataQueries()
                                                          "(tracks.`AlbumPath` = album.`AlbumPath` OR tracks.`AlbumPath` IS NULL ) AND "
                                                          "albumComposer.`Name` = :artistName");
 
-        const auto result = prepareQuery(d->mSelectCountAlbumsForComposerQuery, selectCountAlbumsQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectCountAlbumsForComposerQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectCountAlbumsForComposerQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        const prepareQuery(d->mSelectCountAlbumsForComposerQuery, selectCountAlbumsQueryText, QStringLiteral("SelectCountAlbumsForComposerQuery"));
     }
 
     {
@@ -5205,14 +6385,7 @@ void DatabaseInterface::initDataQueries()
                                                          "(tracks.`AlbumPath` = album.`AlbumPath` OR tracks.`AlbumPath` IS NULL ) AND "
                                                          "albumLyricist.`Name` = :artistName");
 
-        const auto result = prepareQuery(d->mSelectCountAlbumsForLyricistQuery, selectCountAlbumsQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectCountAlbumsForLyricistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectCountAlbumsForLyricistQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        const prepareQuery(d->mSelectCountAlbumsForLyricistQuery, selectCountAlbumsQueryText, QStringLiteral("SelectCountAlbumsForLyricistQuery"));
     }
 
     {
@@ -5224,14 +6397,7 @@ void DatabaseInterface::initDataQueries()
                                                               "album.`ArtistName` = :artistName AND "
                                                               "album.`Title` = :title");
 
-        auto result = prepareQuery(d->mSelectAlbumIdFromTitleQuery, selectAlbumIdFromTitleQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumIdFromTitleQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumIdFromTitleQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAlbumIdFromTitleQuery, selectAlbumIdFromTitleQueryText, QStringLiteral("SelectAlbumIdFromTitleQuery"));
     }
 
     {
@@ -5244,14 +6410,7 @@ void DatabaseInterface::initDataQueries()
                                                                        "album.`Title` = :title AND "
                                                                        "album.`AlbumPath` = :albumPath");
 
-        auto result = prepareQuery(d->mSelectAlbumIdFromTitleAndArtistQuery, selectAlbumIdFromTitleAndArtistQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAlbumIdFromTitleAndArtistQuery, selectAlbumIdFromTitleAndArtistQueryText, QStringLiteral("SelectAlbumIdFromTitleAndArtistQuery"));
     }
 
     {
@@ -5264,14 +6423,7 @@ void DatabaseInterface::initDataQueries()
                                                                            "album.`Title` = :title AND "
                                                                            "album.`ArtistName` IS NULL");
 
-        auto result = prepareQuery(d->mSelectAlbumIdFromTitleWithoutArtistQuery, selectAlbumIdFromTitleWithoutArtistQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAlbumIdFromTitleWithoutArtistQuery, selectAlbumIdFromTitleWithoutArtistQueryText, QStringLiteral("SelectAlbumIdFromTitleWithoutArtistQuery"));
     }
 
     {
@@ -5288,14 +6440,7 @@ void DatabaseInterface::initDataQueries()
                                                    ":albumPath, "
                                                    ":coverFileName)");
 
-        auto result = prepareQuery(d->mInsertAlbumQuery, insertAlbumQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertAlbumQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertAlbumQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mInsertAlbumQuery, insertAlbumQueryText, QStringLiteral("InsertAlbumQuery"));
     }
 
     {
@@ -5307,14 +6452,7 @@ void DatabaseInterface::initDataQueries()
                                                           "`PlayCounter`) "
                                                           "VALUES (:fileName, :mtime, :importDate, 0)");
 
-        auto result = prepareQuery(d->mInsertTrackMapping, insertTrackMappingQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertTrackMapping.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertTrackMapping.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mInsertTrackMapping, insertTrackMappingQueryText, QStringLiteral("InsertTrackMapping"));
     }
 
     {
@@ -5323,14 +6461,7 @@ void DatabaseInterface::initDataQueries()
                                                                    "`FileModifiedTime` = :mtime "
                                                                    "WHERE `FileName` = :fileName");
 
-        auto result = prepareQuery(d->mUpdateTrackFileModifiedTime, initialUpdateTracksValidityQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackFileModifiedTime.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackFileModifiedTime.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mUpdateTrackFileModifiedTime, initialUpdateTracksValidityQueryText, QStringLiteral("UpdateTrackFileModifiedTime"));
     }
 
     {
@@ -5339,42 +6470,14 @@ void DatabaseInterface::initDataQueries()
                                                                    "`Priority` = :priority "
                                                                    "WHERE `FileName` = :fileName");
 
-        auto result = prepareQuery(d->mUpdateTrackPriority, initialUpdateTracksValidityQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackPriority.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackPriority.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mUpdateTrackPriority, initialUpdateTracksValidityQueryText, QStringLiteral("UpdateTrackPriority"));
     }
 
     {
         auto removeTracksMappingFromSourceQueryText = QStringLiteral("DELETE FROM `TracksData` "
                                                                      "WHERE `FileName` = :fileName");
 
-        auto result = prepareQuery(d->mRemoveTracksMappingFromSource, removeTracksMappingFromSourceQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveTracksMappingFromSource.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveTracksMappingFromSource.lastError();
-
-            Q_EMIT databaseError();
-        }
-    }
-
-    {
-        auto removeTracksMappingQueryText = QStringLiteral("DELETE FROM `TracksData` "
-                                                           "WHERE `FileName` = :fileName");
-
-        auto result = prepareQuery(d->mRemoveTracksMapping, removeTracksMappingQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveTracksMapping.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveTracksMapping.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mRemoveTracksMappingFromSource, removeTracksMappingFromSourceQueryText, QStringLiteral("RemoveTracksMappingFromSource"));
     }
 
     {
@@ -5483,14 +6586,7 @@ void DatabaseInterface::initDataQueries()
                                                                   "tracks.`FileName` = tracksMapping.`FileName` AND "
                                                                   "tracks.`FileName` NOT IN (SELECT tracksMapping2.`FileName` FROM `TracksData` tracksMapping2)");
 
-        auto result = prepareQuery(d->mSelectTracksWithoutMappingQuery, selectTracksWithoutMappingQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksWithoutMappingQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksWithoutMappingQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTracksWithoutMappingQuery, selectTracksWithoutMappingQueryText, QStringLiteral("SelectTracksWithoutMappingQuery"));
     }
 
     {
@@ -5508,14 +6604,7 @@ void DatabaseInterface::initDataQueries()
                                                            "WHERE "
                                                            "trackData.`FileName` = :fileName");
 
-        auto result = prepareQuery(d->mSelectTracksMapping, selectTracksMappingQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksMapping.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksMapping.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTracksMapping, selectTracksMappingQueryText, QStringLiteral("SelectTracksMapping"));
     }
 
     {
@@ -5526,14 +6615,7 @@ void DatabaseInterface::initDataQueries()
                                                            "WHERE "
                                                            "`HttpAddress` = :httpAddress");
 
-        auto result = prepareQuery(d->mSelectRadioIdFromHttpAddress, selectRadioIdFromHttpAddress);
-
-        if (!result) {
-            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectRadioIdFromHttpAddress.lastQuery();
-            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectRadioIdFromHttpAddress.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectRadioIdFromHttpAddress, selectRadioIdFromHttpAddress, QStringLiteral("SelectRadioIdFromHttpAddress"));
     }
 
     {
@@ -5549,14 +6631,7 @@ void DatabaseInterface::initDataQueries()
                                                                    "(tracks.`AlbumArtistName` = :albumArtist OR tracks.`AlbumArtistName` IS NULL) AND "
                                                                    "(tracks.`AlbumPath` = :albumPath OR tracks.`AlbumPath` IS NULL)");
 
-        auto result = prepareQuery(d->mSelectTracksMappingPriority, selectTracksMappingPriorityQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksMappingPriority.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksMappingPriority.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTracksMappingPriority, selectTracksMappingPriorityQueryText, QStringLiteral("SelectTracksMappingPriority"));
     }
 
     {
@@ -5569,14 +6644,7 @@ void DatabaseInterface::initDataQueries()
                                                                             "track.`ID` = :trackId AND "
                                                                             "trackData.`FileName` = track.`FileName`");
 
-        auto result = prepareQuery(d->mSelectTracksMappingPriorityByTrackId, selectTracksMappingPriorityQueryByTrackIdText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksMappingPriorityByTrackId.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksMappingPriorityByTrackId.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTracksMappingPriorityByTrackId, selectTracksMappingPriorityQueryByTrackIdText, QStringLiteral("SelectTracksMappingPriorityByTrackId"));
     }
 
     {
@@ -5586,41 +6654,20 @@ void DatabaseInterface::initDataQueries()
                                                                      "FROM "
                                                                      "`TracksData` tracksMapping");
 
-        auto result = prepareQuery(d->mSelectAllTrackFilesQuery, selectAllTrackFilesFromSourceQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllTrackFilesQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllTrackFilesQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAllTrackFilesQuery, selectAllTrackFilesFromSourceQueryText, QStringLiteral("SelectAllTrackFilesQuery"));
     }
 
     {
         auto insertMusicSourceQueryText = QStringLiteral("INSERT OR IGNORE INTO `DiscoverSource` (`ID`, `Name`) "
                                                          "VALUES (:discoverId, :name)");
 
-        auto result = prepareQuery(d->mInsertMusicSource, insertMusicSourceQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertMusicSource.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertMusicSource.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mInsertMusicSource, insertMusicSourceQueryText, QStringLiteral("InsertMusicSource"));
     }
 
     {
         auto selectMusicSourceQueryText = QStringLiteral("SELECT `ID` FROM `DiscoverSource` WHERE `Name` = :name");
 
-        auto result = prepareQuery(d->mSelectMusicSource, selectMusicSourceQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectMusicSource.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectMusicSource.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectMusicSource, selectMusicSourceQueryText, QStringLiteral("SelectMusicSource"));
     }
 
     {
@@ -5652,14 +6699,7 @@ void DatabaseInterface::initDataQueries()
                                                    ")"
                                                    "");
 
-        auto result = prepareQuery(d->mSelectTrackIdFromTitleAlbumIdArtistQuery, selectTrackQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackIdFromTitleAlbumIdArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackIdFromTitleAlbumIdArtistQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTrackIdFromTitleAlbumIdArtistQuery, selectTrackQueryText, QStringLiteral("SelectTrackIdFromTitleAlbumIdArtistQuery"));
     }
 
     {
@@ -5710,14 +6750,7 @@ void DatabaseInterface::initDataQueries()
                                                    ":trackRating, "
                                                    ":hasEmbeddedCover)");
 
-        auto result = prepareQuery(d->mInsertTrackQuery, insertTrackQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertTrackQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertTrackQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mInsertTrackQuery, insertTrackQueryText, QStringLiteral("InsertTrackQuery"));
     }
 
     {
@@ -5744,14 +6777,7 @@ void DatabaseInterface::initDataQueries()
                                                    "WHERE "
                                                    "`ID` = :trackId");
 
-        auto result = prepareQuery(d->mUpdateTrackQuery, updateTrackQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mUpdateTrackQuery, updateTrackQueryText, QStringLiteral("UpdateTrackQuery"));
     }
 
     {
@@ -5770,28 +6796,14 @@ void DatabaseInterface::initDataQueries()
                                                    ":trackRating,"
                                                    ":imageAddress)");
 
-        auto result = prepareQuery(d->mInsertRadioQuery, insertRadioQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertRadioQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertRadioQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mInsertRadioQuery, insertRadioQueryText, QStringLiteral("InsertRadioQuery"));
     }
 
     {
         auto deleteRadioQueryText = QStringLiteral("DELETE FROM `Radios` "
                                                    "WHERE `ID` = :radioId");
 
-        auto result = prepareQuery(d->mDeleteRadioQuery, deleteRadioQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mDeleteRadioQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mDeleteRadioQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mDeleteRadioQuery, deleteRadioQueryText, QStringLiteral("DeleteRadioQuery"));
     }
 
     {
@@ -5805,14 +6817,7 @@ void DatabaseInterface::initDataQueries()
                                                    "WHERE "
                                                    "`ID` = :radioId");
 
-        auto result = prepareQuery(d->mUpdateRadioQuery, updateRadioQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateRadioQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateRadioQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mUpdateRadioQuery, updateRadioQueryText, QStringLiteral("UpdateRadioQuery"));
     }
 
     {
@@ -5822,14 +6827,7 @@ void DatabaseInterface::initDataQueries()
                                                          "WHERE "
                                                          "`ID` = :albumId");
 
-        auto result = prepareQuery(d->mUpdateAlbumArtistQuery, updateAlbumArtistQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateAlbumArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateAlbumArtistQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mUpdateAlbumArtistQuery, updateAlbumArtistQueryText, QStringLiteral("UpdateAlbumArtistQuery"));
     }
 
     {
@@ -5841,14 +6839,7 @@ void DatabaseInterface::initDataQueries()
                                                                  "`AlbumPath` = :albumPath AND "
                                                                  "`AlbumArtistName` IS NULL");
 
-        auto result = prepareQuery(d->mUpdateAlbumArtistInTracksQuery, updateAlbumArtistInTracksQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateAlbumArtistInTracksQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateAlbumArtistInTracksQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mUpdateAlbumArtistInTracksQuery, updateAlbumArtistInTracksQueryText, QStringLiteral("UpdateAlbumArtistInTracksQuery"));
     }
 
     {
@@ -5856,14 +6847,7 @@ void DatabaseInterface::initDataQueries()
                                                            "FROM "
                                                            "`Tracks` tracks");
 
-        auto result = prepareQuery(d->mQueryMaximumTrackIdQuery, queryMaximumTrackIdQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumTrackIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumTrackIdQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mQueryMaximumTrackIdQuery, queryMaximumTrackIdQueryText, QStringLiteral("QueryMaximumTrackIdQuery"));
     }
 
     {
@@ -5871,14 +6855,7 @@ void DatabaseInterface::initDataQueries()
                                                            "FROM "
                                                            "`Albums` albums");
 
-        auto result = prepareQuery(d->mQueryMaximumAlbumIdQuery, queryMaximumAlbumIdQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumAlbumIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumAlbumIdQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mQueryMaximumAlbumIdQuery, queryMaximumAlbumIdQueryText, QStringLiteral("QueryMaximumAlbumIdQuery"));
     }
 
     {
@@ -5886,14 +6863,7 @@ void DatabaseInterface::initDataQueries()
                                                             "FROM "
                                                             "`Artists` artists");
 
-        auto result = prepareQuery(d->mQueryMaximumArtistIdQuery, queryMaximumArtistIdQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumArtistIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumArtistIdQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mQueryMaximumArtistIdQuery, queryMaximumArtistIdQueryText, QStringLiteral("QueryMaximumArtistIdQuery"));
     }
 
     {
@@ -5901,14 +6871,7 @@ void DatabaseInterface::initDataQueries()
                                                               "FROM "
                                                               "`Lyricist` lyricists");
 
-        auto result = prepareQuery(d->mQueryMaximumLyricistIdQuery, queryMaximumLyricistIdQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumLyricistIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumLyricistIdQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mQueryMaximumLyricistIdQuery, queryMaximumLyricistIdQueryText, QStringLiteral("QueryMaximumLyricistIdQuery"));
     }
 
     {
@@ -5916,14 +6879,7 @@ void DatabaseInterface::initDataQueries()
                                                               "FROM "
                                                               "`Composer` composers");
 
-        auto result = prepareQuery(d->mQueryMaximumComposerIdQuery, queryMaximumComposerIdQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumComposerIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumComposerIdQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mQueryMaximumComposerIdQuery, queryMaximumComposerIdQueryText, QStringLiteral("QueryMaximumComposerIdQuery"));
     }
 
     {
@@ -5931,14 +6887,7 @@ void DatabaseInterface::initDataQueries()
                                                            "FROM "
                                                            "`Genre` genres");
 
-        auto result = prepareQuery(d->mQueryMaximumGenreIdQuery, queryMaximumGenreIdQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumGenreIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mQueryMaximumGenreIdQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mQueryMaximumGenreIdQuery, queryMaximumGenreIdQueryText, QStringLiteral("QueryMaximumGenreIdQuery"));
     }
 
     {
@@ -5953,14 +6902,7 @@ void DatabaseInterface::initDataQueries()
                                                    "(tracks.`DiscNumber` = :discNumber OR (:discNumber IS NULL AND tracks.`DiscNumber` IS NULL)) AND "
                                                    "tracks.`ArtistName` = :artist");
 
-        auto result = prepareQuery(d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery, selectTrackQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery, selectTrackQueryText, QStringLiteral("SelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery"));
     }
 
     {
@@ -5980,14 +6922,7 @@ void DatabaseInterface::initDataQueries()
                                                    "(tracks.`DiscNumber` = :discNumber OR tracks.`DiscNumber` IS NULL) "
                                                    "");
 
-        auto result = prepareQuery(d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery, selectTrackQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery, selectTrackQueryText, QStringLiteral("SelectTrackIdFromTitleAlbumTrackDiscNumberQuery"));
     }
 
     {
@@ -5997,14 +6932,7 @@ void DatabaseInterface::initDataQueries()
                                                                     "WHERE "
                                                                     "`ID` = :albumId");
 
-        auto result = prepareQuery(d->mSelectAlbumArtUriFromAlbumIdQuery, selectAlbumArtUriFromAlbumIdQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectAlbumArtUriFromAlbumIdQuery, selectAlbumArtUriFromAlbumIdQueryText, QStringLiteral("SelectAlbumArtUriFromAlbumIdQuery"));
     }
 
     {
@@ -6013,14 +6941,7 @@ void DatabaseInterface::initDataQueries()
                                                                     "WHERE "
                                                                     "`ID` = :albumId");
 
-        auto result = prepareQuery(d->mUpdateAlbumArtUriFromAlbumIdQuery, updateAlbumArtUriFromAlbumIdQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mUpdateAlbumArtUriFromAlbumIdQuery, updateAlbumArtUriFromAlbumIdQueryText, QStringLiteral("UpdateAlbumArtUriFromAlbumIdQuery"));
     }
 
     {
@@ -6045,14 +6966,7 @@ void DatabaseInterface::initDataQueries()
                                                                               "ORDER BY track.`Year` DESC "
                                                                               "LIMIT 4 ");
 
-      auto result = prepareQuery(d->mSelectUpToFourLatestCoversFromArtistNameQuery, selectUpToFourLatestCoversFromArtistNameQueryText);
-
-      if (!result) {
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectUpToFourLatestCoversFromArtistNameQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectUpToFourLatestCoversFromArtistNameQuery.lastError();
-
-        Q_EMIT databaseError();
-        }
+      prepareQuery(d->mSelectUpToFourLatestCoversFromArtistNameQuery, selectUpToFourLatestCoversFromArtistNameQueryText, QStringLiteral("SelectUpToFourLatestCoversFromArtistNameQuery"));
     }
 
     {
@@ -6179,14 +7093,7 @@ void DatabaseInterface::initDataQueries()
                                                               "tracks.`Title` ASC"
                                                               "");
 
-        auto result = prepareQuery(d->mSelectTracksFromArtist, selectTracksFromArtistQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksFromArtist.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksFromArtist.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTracksFromArtist, selectTracksFromArtistQueryText, QStringLiteral("SelectTracksFromArtist"));
     }
 
     {
@@ -6313,32 +7220,7 @@ void DatabaseInterface::initDataQueries()
                                                              "tracks.`Title` ASC"
                                                              "");
 
-        auto result = prepareQuery(d->mSelectTracksFromGenre, selectTracksFromGenreQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksFromGenre.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksFromGenre.lastError();
-
-            Q_EMIT databaseError();
-        }
-    }
-
-    {
-        auto selectAlbumIdsFromArtistQueryText = QStringLiteral("SELECT "
-                                                                "album.`ID` "
-                                                                "FROM "
-                                                                "`Albums` album "
-                                                                "WHERE "
-                                                                "album.`ArtistName` = :artistName");
-
-        auto result = prepareQuery(d->mSelectAlbumIdsFromArtist, selectAlbumIdsFromArtistQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumIdsFromArtist.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumIdsFromArtist.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectTracksFromGenre, selectTracksFromGenreQueryText, QStringLiteral("SelectTracksFromGenre"));
     }
 
     {
@@ -6348,14 +7230,15 @@ void DatabaseInterface::initDataQueries()
                                                     "WHERE "
                                                     "`ID` = :artistId");
 
-        auto result = prepareQuery(d->mSelectArtistQuery, selectArtistQueryText);
+        prepareQuery(d->mSelectArtistQuery, selectArtistQueryText, QStringLiteral("SelectArtistQuery"));
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectArtistQuery.lastError();
+        auto selectNotifiedArtistsQueryText = QStringLiteral("SELECT `ID`, "
+                                                             "`Name` "
+                                                             "FROM `Artists` "
+                                                             "WHERE "
+                                                             "`ID` IN (SELECT `ID` FROM temp.`NotifiedIds`)");
 
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectNotifiedArtistsQuery, selectNotifiedArtistsQueryText, QStringLiteral("SelectNotifiedArtistsQuery"));
     }
 
     {
@@ -6365,31 +7248,17 @@ void DatabaseInterface::initDataQueries()
                                                              "WHERE "
                                                              "`FileName` = :fileName");
 
-        auto result = prepareQuery(d->mUpdateTrackStartedStatistics, updateTrackStartedStatisticsQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackStartedStatistics.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackStartedStatistics.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mUpdateTrackStartedStatistics, updateTrackStartedStatisticsQueryText, QStringLiteral("UpdateTrackStartedStatistics"));
     }
 
     {
         auto updateTrackFinishedStatisticsQueryText = QStringLiteral("UPDATE `TracksData` "
                                                              "SET "
-                                                             "`PlayCounter` = `PlayCounter` + 1 "
+                                                             "`PlayCounter` = `PlayCounter` + :playCount "
                                                              "WHERE "
                                                              "`FileName` = :fileName");
 
-        auto result = prepareQuery(d->mUpdateTrackFinishedStatistics, updateTrackFinishedStatisticsQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackFinishedStatistics.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackFinishedStatistics.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mUpdateTrackFinishedStatistics, updateTrackFinishedStatisticsQueryText, QStringLiteral("UpdateTrackFinishedStatistics"));
     }
 
     {
@@ -6400,14 +7269,7 @@ void DatabaseInterface::initDataQueries()
                                                                       "`FileName` = :fileName AND "
                                                                       "`FirstPlayDate` IS NULL");
 
-        auto result = prepareQuery(d->mUpdateTrackFirstPlayStatistics, updateTrackFirstPlayStatisticsQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackFirstPlayStatistics.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateTrackFirstPlayStatistics.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mUpdateTrackFirstPlayStatistics, updateTrackFirstPlayStatisticsQueryText, QStringLiteral("UpdateTrackFirstPlayStatistics"));
     }
 
     {
@@ -6417,14 +7279,7 @@ void DatabaseInterface::initDataQueries()
                                                    "WHERE "
                                                    "`ID` = :genreId");
 
-        auto result = prepareQuery(d->mSelectGenreQuery, selectGenreQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectGenreQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectGenreQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        prepareQuery(d->mSelectGenreQuery, selectGenreQueryText, QStringLiteral("SelectGenreQuery"));
     }
 
     {
@@ -6434,12 +7289,7 @@ void DatabaseInterface::initDataQueries()
                                                       "WHERE "
                                                       "`ID` = :composerId");
 
-        auto result = prepareQuery(d->mSelectComposerQuery, selectComposerQueryText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectComposerQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectComposerQuery.lastError();
-        }
+        prepareQuery(d->mSelectComposerQuery, selectComposerQueryText, QStringLiteral("SelectComposerQuery"));
     }
 
     {
@@ -6449,63 +7299,145 @@ void DatabaseInterface::initDataQueries()
                                                       "WHERE "
                                                       "`ID` = :lyricistId");
 
-        auto result = prepareQuery(d->mSelectLyricistQuery, selectLyricistQueryText);
+        prepareQuery(d->mSelectLyricistQuery, selectLyricistQueryText, QStringLiteral("SelectLyricistQuery"));
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectLyricistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectLyricistQuery.lastError();
-        }
+    {
+        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Albums` "
+                                                   "WHERE "
+                                                   "`ID` = :albumId");
+
+        prepareQuery(d->mRemoveAlbumQuery, removeAlbumQueryText, QStringLiteral("RemoveAlbumQuery"));
     }
 
     {
-        auto removeTrackQueryText = QStringLiteral("DELETE FROM `Tracks` "
+        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Artists` "
                                                    "WHERE "
-                                                   "`ID` = :trackId");
+                                                   "`ID` = :artistId");
 
-        auto result = prepareQuery(d->mRemoveTrackQuery, removeTrackQueryText);
+        prepareQuery(d->mRemoveArtistQuery, removeAlbumQueryText, QStringLiteral("RemoveArtistQuery"));
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveTrackQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveTrackQuery.lastError();
+    finishTransaction();
 
-            Q_EMIT databaseError();
+    const auto warmUpStatementNames = DatabaseInterfacePrivate::warmUpStatementNames();
+    for (const auto &oneStatementName : warmUpStatementNames) {
+        if (auto oneStatement = d->mStatementsByName.value(oneStatementName); oneStatement) {
+            prepareStatement(*oneStatement);
         }
     }
 
-    {
-        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Albums` "
-                                                   "WHERE "
-                                                   "`ID` = :albumId");
+    // the other statements are prepared once the views got their first data
+    QTimer::singleShot(DatabaseInterfacePrivate::BackgroundPreparationDelay, this, &DatabaseInterface::prepareNextStatements);
 
-        auto result = prepareQuery(d->mRemoveAlbumQuery, removeAlbumQueryText);
+    d->mInitFinished = true;
+    Q_EMIT requestsInitDone();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveAlbumQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveAlbumQuery.lastError();
+    // the writes queued before init or during a reset need the statements
+    schedulePendingWrites();
+}
 
-            Q_EMIT databaseError();
+void DatabaseInterface::notifyTrackedChanges()
+{
+    // one query per kind of data, data inserted by another process since the last notification included
+    auto allNotifiedTracks = d->mInsertedTracks;
+    allNotifiedTracks.unite(d->mModifiedTrackIds);
+    allNotifiedTracks.unite(d->mExternalInsertedTracks);
+
+    const auto notifiedTracks = internalNotifiedTracksPartialData(allNotifiedTracks);
+
+    for (auto trackId : std::as_const(d->mExternalInsertedTracks)) {
+        const auto itTrack = notifiedTracks.constFind(trackId);
+        if (itTrack == notifiedTracks.constEnd()) {
+            continue;
         }
+
+        d->mInsertedTracks.insert(trackId);
+        recordModifiedAlbum(itTrack->albumId());
     }
 
-    {
-        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Artists` "
-                                                   "WHERE "
-                                                   "`ID` = :artistId");
+    auto allNotifiedAlbums = d->mInsertedAlbums;
+    allNotifiedAlbums.unite(d->mExternalInsertedAlbums);
 
-        auto result = prepareQuery(d->mRemoveArtistQuery, removeAlbumQueryText);
+    const auto notifiedAlbums = internalNotifiedAlbumsPartialData(allNotifiedAlbums);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveArtistQuery.lastError();
+    for (auto albumId : std::as_const(d->mExternalInsertedAlbums)) {
+        if (notifiedAlbums.contains(albumId)) {
+            d->mInsertedAlbums.insert(albumId);
+        }
+    }
 
-            Q_EMIT databaseError();
+    auto allNotifiedArtists = d->mInsertedArtists;
+    allNotifiedArtists.unite(d->mExternalInsertedArtists);
+
+    const auto notifiedArtists = internalNotifiedArtistsPartialData(allNotifiedArtists);
+
+    for (auto artistId : std::as_const(d->mExternalInsertedArtists)) {
+        if (notifiedArtists.contains(artistId)) {
+            d->mInsertedArtists.insert(artistId);
         }
     }
 
-    finishTransaction();
+    d->mExternalInsertedTracks.clear();
+    d->mExternalInsertedAlbums.clear();
+    d->mExternalInsertedArtists.clear();
 
-    d->mInitFinished = true;
-    Q_EMIT requestsInitDone();
+    if (!d->mInsertedArtists.isEmpty()) {
+        DataTypes::ListArtistDataType newArtists;
+
+        for (auto newArtistId : std::as_const(d->mInsertedArtists)) {
+            const auto itArtist = notifiedArtists.constFind(newArtistId);
+            if (itArtist != notifiedArtists.constEnd()) {
+                newArtists.push_back(*itArtist);
+            }
+        }
+
+        qCInfo(orgKdeElisaDatabase) << "artistsAdded" << newArtists.size();
+        Q_EMIT artistsAdded(newArtists);
+    }
+
+    if (!d->mInsertedAlbums.isEmpty()) {
+        DataTypes::ListAlbumDataType newAlbums;
+
+        for (auto albumId : std::as_const(d->mInsertedAlbums)) {
+            d->mModifiedAlbumIds.remove(albumId);
+
+            const auto itAlbum = notifiedAlbums.constFind(albumId);
+            if (itAlbum != notifiedAlbums.constEnd()) {
+                newAlbums.push_back(*itAlbum);
+            }
+        }
+
+        qCInfo(orgKdeElisaDatabase) << "albumsAdded" << newAlbums.size();
+        Q_EMIT albumsAdded(newAlbums);
+    }
+
+    for (auto albumId : std::as_const(d->mModifiedAlbumIds)) {
+        Q_EMIT albumModified({{DataTypes::DatabaseIdRole, albumId}}, albumId);
+    }
+
+    if (!d->mInsertedTracks.isEmpty()) {
+        DataTypes::ListTrackDataType newTracks;
+
+        for (auto trackId : std::as_const(d->mInsertedTracks)) {
+            d->mModifiedTrackIds.remove(trackId);
+
+            const auto itTrack = notifiedTracks.constFind(trackId);
+            if (itTrack != notifiedTracks.constEnd()) {
+                newTracks.push_back(*itTrack);
+            }
+        }
+
+        qCInfo(orgKdeElisaDatabase) << "tracksAdded" << newTracks.size();
+        Q_EMIT tracksAdded(newTracks);
+    }
+
+    for (auto trackId : std::as_const(d->mModifiedTrackIds)) {
+        const auto itTrack = notifiedTracks.constFind(trackId);
+        if (itTrack != notifiedTracks.constEnd()) {
+            Q_EMIT trackModified(*itTrack);
+        }
+    }
 }
 
 void DatabaseInterface::initChangesTrackers()
@@ -6570,10 +7502,10 @@ void DatabaseInterface::internalInsertOneTrack(const DataTypes::TrackDataType &o
 
 void DatabaseInterface::internalInsertOneRadio(const DataTypes::TrackDataType &oneTrack)
 {
-    QSqlQuery query = d->mUpdateRadioQuery;
+    auto query = d->mUpdateRadioQuery.prepared();
 
     if (!oneTrack.hasDatabaseId()) {
-        query = d->mInsertRadioQuery;
+        query = d->mInsertRadioQuery.prepared();
     }
 
     query.bindValue(QStringLiteral(":httpAddress"), oneTrack.resourceURI());
@@ -6615,6 +7547,21 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
         return result;
     }
 
+    // an album without artist may still get one: only albums with an artist are cached
+    const auto albumKey = DatabaseInterfacePrivate::AlbumKey{title, albumArtist, trackPath};
+    if (!albumArtist.isEmpty()) {
+        if (const auto knownAlbum = d->mAlbumIds.constFind(albumKey); knownAlbum != d->mAlbumIds.constEnd()) {
+            result = knownAlbum.value();
+
+            updateAlbumArtist(result, title, trackPath, albumArtist);
+            if (updateAlbumCover(result, albumArtURI)) {
+                recordModifiedAlbum(result);
+            }
+
+            return result;
+        }
+    }
+
     d->mSelectAlbumIdFromTitleAndArtistQuery.bindValue(QStringLiteral(":title"), title);
     d->mSelectAlbumIdFromTitleAndArtistQuery.bindValue(QStringLiteral(":albumPath"), trackPath);
     d->mSelectAlbumIdFromTitleAndArtistQuery.bindValue(QStringLiteral(":artistName"), albumArtist);
@@ -6639,11 +7586,14 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
         d->mSelectAlbumIdFromTitleAndArtistQuery.finish();
 
         if (!albumArtist.isEmpty()) {
-            const auto similarAlbum = internalOneAlbumPartialData(result);
             updateAlbumArtist(result, title, trackPath, albumArtist);
             if (updateAlbumCover(result, albumArtURI)) {
                 recordModifiedAlbum(result);
             }
+
+            if (d->mUseIdsCaches) {
+                d->mAlbumIds.insert(albumKey, result);
+            }
         }
 
         return result;
@@ -6680,6 +7630,10 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
 
     d->mInsertAlbumQuery.finish();
 
+    if (!albumArtist.isEmpty() && d->mUseIdsCaches) {
+        d->mAlbumIds.insert(albumKey, result);
+    }
+
     ++d->mAlbumId;
 
     d->mInsertedAlbums.insert(result);
@@ -6711,31 +7665,43 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
         return result;
     }
 
-    d->mSelectArtistByNameQuery.bindValue(QStringLiteral(":name"), name);
+    const auto knownId = d->knownNameId(d->mArtistIds, name);
+    if (knownId && *knownId != 0) {
+        return *knownId;
+    }
 
-    auto queryResult = execQuery(d->mSelectArtistByNameQuery);
+    auto queryResult = true;
 
-    if (!queryResult || !d->mSelectArtistByNameQuery.isSelect() || !d->mSelectArtistByNameQuery.isActive()) {
-        Q_EMIT databaseError();
+    // the query is only needed when the table could not be read at once
+    if (!knownId) {
+        d->mSelectArtistByNameQuery.bindValue(QStringLiteral(":name"), name);
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastError();
+        queryResult = execQuery(d->mSelectArtistByNameQuery);
 
-        d->mSelectArtistByNameQuery.finish();
+        if (!queryResult || !d->mSelectArtistByNameQuery.isSelect() || !d->mSelectArtistByNameQuery.isActive()) {
+            Q_EMIT databaseError();
 
-        return result;
-    }
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastError();
 
-    if (d->mSelectArtistByNameQuery.next()) {
-        result = d->mSelectArtistByNameQuery.record().value(0).toULongLong();
+            d->mSelectArtistByNameQuery.finish();
 
-        d->mSelectArtistByNameQuery.finish();
+            return result;
+        }
 
-        return result;
-    }
+        if (d->mSelectArtistByNameQuery.next()) {
+            result = d->mSelectArtistByNameQuery.record().value(0).toULongLong();
 
-    d->mSelectArtistByNameQuery.finish();
+            d->mSelectArtistByNameQuery.finish();
+
+            d->mArtistIds.mIds.insert(name, result);
+
+            return result;
+        }
+
+        d->mSelectArtistByNameQuery.finish();
+    }
 
     d->mInsertArtistsQuery.bindValue(QStringLiteral(":artistId"), d->mArtistId);
     d->mInsertArtistsQuery.bindValue(QStringLiteral(":name"), name);
@@ -6756,6 +7722,8 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
 
     result = d->mArtistId;
 
+    d->mArtistIds.mIds.insert(name, result);
+
     ++d->mArtistId;
 
     d->mInsertedArtists.insert(result);
@@ -6773,32 +7741,42 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
         return result;
     }
 
-    d->mSelectComposerByNameQuery.bindValue(QStringLiteral(":name"), name);
+    const auto knownId = d->knownNameId(d->mComposerIds, name);
+    if (knownId && *knownId != 0) {
+        return *knownId;
+    }
 
-    auto queryResult = execQuery(d->mSelectComposerByNameQuery);
+    auto queryResult = true;
 
-    if (!queryResult || !d->mSelectComposerByNameQuery.isSelect() || !d->mSelectComposerByNameQuery.isActive()) {
-        Q_EMIT databaseError();
+    if (!knownId) {
+        d->mSelectComposerByNameQuery.bindValue(QStringLiteral(":name"), name);
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.lastError();
+        queryResult = execQuery(d->mSelectComposerByNameQuery);
 
-        d->mSelectComposerByNameQuery.finish();
+        if (!queryResult || !d->mSelectComposerByNameQuery.isSelect() || !d->mSelectComposerByNameQuery.isActive()) {
+            Q_EMIT databaseError();
 
-        return result;
-    }
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.lastError();
 
+            d->mSelectComposerByNameQuery.finish();
 
-    if (d->mSelectComposerByNameQuery.next()) {
-        result = d->mSelectComposerByNameQuery.record().value(0).toULongLong();
+            return result;
+        }
 
-        d->mSelectComposerByNameQuery.finish();
+        if (d->mSelectComposerByNameQuery.next()) {
+            result = d->mSelectComposerByNameQuery.record().value(0).toULongLong();
 
-        return result;
-    }
+            d->mSelectComposerByNameQuery.finish();
 
-    d->mSelectComposerByNameQuery.finish();
+            d->mComposerIds.mIds.insert(name, result);
+
+            return result;
+        }
+
+        d->mSelectComposerByNameQuery.finish();
+    }
 
     d->mInsertComposerQuery.bindValue(QStringLiteral(":composerId"), d->mComposerId);
     d->mInsertComposerQuery.bindValue(QStringLiteral(":name"), name);
@@ -6819,6 +7797,8 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
 
     result = d->mComposerId;
 
+    d->mComposerIds.mIds.insert(name, result);
+
     ++d->mComposerId;
 
     d->mInsertComposerQuery.finish();
@@ -6836,31 +7816,42 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
         return result;
     }
 
-    d->mSelectGenreByNameQuery.bindValue(QStringLiteral(":name"), name);
+    const auto knownId = d->knownNameId(d->mGenreIds, name);
+    if (knownId && *knownId != 0) {
+        return *knownId;
+    }
+
+    auto queryResult = true;
 
-    auto queryResult = execQuery(d->mSelectGenreByNameQuery);
+    if (!knownId) {
+        d->mSelectGenreByNameQuery.bindValue(QStringLiteral(":name"), name);
 
-    if (!queryResult || !d->mSelectGenreByNameQuery.isSelect() || !d->mSelectGenreByNameQuery.isActive()) {
-        Q_EMIT databaseError();
+        queryResult = execQuery(d->mSelectGenreByNameQuery);
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.lastError();
+        if (!queryResult || !d->mSelectGenreByNameQuery.isSelect() || !d->mSelectGenreByNameQuery.isActive()) {
+            Q_EMIT databaseError();
 
-        d->mSelectGenreByNameQuery.finish();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.lastError();
 
-        return result;
-    }
+            d->mSelectGenreByNameQuery.finish();
+
+            return result;
+        }
 
-    if (d->mSelectGenreByNameQuery.next()) {
-        result = d->mSelectGenreByNameQuery.record().value(0).toULongLong();
+        if (d->mSelectGenreByNameQuery.next()) {
+            result = d->mSelectGenreByNameQuery.record().value(0).toULongLong();
 
-        d->mSelectGenreByNameQuery.finish();
+            d->mSelectGenreByNameQuery.finish();
 
-        return result;
-    }
+            d->mGenreIds.mIds.insert(name, result);
 
-    d->mSelectGenreByNameQuery.finish();
+            return result;
+        }
+
+        d->mSelectGenreByNameQuery.finish();
+    }
 
     d->mInsertGenreQuery.bindValue(QStringLiteral(":genreId"), d->mGenreId);
     d->mInsertGenreQuery.bindValue(QStringLiteral(":name"), name);
@@ -6881,6 +7872,8 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
 
     result = d->mGenreId;
 
+    d->mGenreIds.mIds.insert(name, result);
+
     ++d->mGenreId;
 
     d->mInsertGenreQuery.finish();
@@ -7219,83 +8212,118 @@ DataTypes::TrackDataType DatabaseInterface::buildRadioDataFromDatabaseRecord(con
 
 void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTracks)
 {
-    QSet<qulonglong> modifiedAlbums;
-
     QUrl::FormattingOptions currentOptions = QUrl::PreferLocalFile |
             QUrl::RemoveAuthority | QUrl::RemoveFilename | QUrl::RemoveFragment |
             QUrl::RemovePassword | QUrl::RemovePort | QUrl::RemoveQuery |
             QUrl::RemoveScheme | QUrl::RemoveUserInfo;
 
+    if (!execAndFinishQuery(d->mClearRemovedFileNamesQuery) || !execAndFinishQuery(d->mClearRemovedTracksQuery)) {
+        return;
+    }
+
     for (const auto &removedTrackFileName : removedTracks) {
-        auto removedTrackId = internalTrackIdFromFileName(removedTrackFileName);
+        d->mInsertRemovedFileNameQuery.bindValue(QStringLiteral(":fileName"), removedTrackFileName.toString());
+
+        if (!execAndFinishQuery(d->mInsertRemovedFileNameQuery)) {
+            return;
+        }
+    }
+
+    // the removed tracks are kept with their artist and album to find what is left empty once they are deleted
+    if (!execAndFinishQuery(d->mInsertRemovedTracksQuery)) {
+        return;
+    }
+
+    if (!internalGenericPartialData(d->mSelectRemovedTracksIdsQuery)) {
+        return;
+    }
 
-        Q_EMIT trackRemoved(removedTrackId);
+    while (d->mSelectRemovedTracksIdsQuery.next()) {
+        Q_EMIT trackRemoved(d->mSelectRemovedTracksIdsQuery.record().value(0).toULongLong());
+    }
+
+    d->mSelectRemovedTracksIdsQuery.finish();
+
+    if (!execAndFinishQuery(d->mRemoveTracksFromRemovedFileNamesQuery) || !execAndFinishQuery(d->mRemoveTracksDataFromRemovedFileNamesQuery)) {
+        return;
+    }
+
+    if (!internalGenericPartialData(d->mSelectRemovedTracksAlbumsQuery)) {
+        return;
+    }
 
-        auto oneRemovedTrack = internalTrackFromDatabaseId(removedTrackId);
+    QList<qulonglong> modifiedAlbums;
+    QList<qulonglong> emptyAlbums;
 
-        removeTrackInDatabase(removedTrackId);
+    while (d->mSelectRemovedTracksAlbumsQuery.next()) {
+        const auto &currentRecord = d->mSelectRemovedTracksAlbumsQuery.record();
+        const auto albumId = currentRecord.value(0).toULongLong();
 
-        const auto &trackPath = oneRemovedTrack.resourceURI().toString(currentOptions);
-        const auto &modifiedAlbumId = internalAlbumIdFromTitleAndArtist(oneRemovedTrack.album(), oneRemovedTrack.albumArtist(), trackPath);
-        const auto &allTracksFromArtist = internalTracksFromAuthor(oneRemovedTrack.artist());
-        const auto &allAlbumsFromArtist = internalAlbumIdsFromAuthor(oneRemovedTrack.artist());
-        const auto &removedArtistId = internalArtistIdFromName(oneRemovedTrack.artist());
+        recordModifiedAlbum(albumId);
 
-        if (modifiedAlbumId) {
-            recordModifiedAlbum(modifiedAlbumId);
-            modifiedAlbums.insert(modifiedAlbumId);
+        if (currentRecord.value(1).toBool()) {
+            emptyAlbums.push_back(albumId);
+        } else {
+            modifiedAlbums.push_back(albumId);
         }
+    }
+
+    d->mSelectRemovedTracksAlbumsQuery.finish();
 
-        if (removedArtistId != 0 && allTracksFromArtist.isEmpty() && allAlbumsFromArtist.isEmpty()) {
-            removeArtistInDatabase(removedArtistId);
-            Q_EMIT artistRemoved(removedArtistId);
+    for (auto modifiedAlbumId : std::as_const(modifiedAlbums)) {
+        const auto modifiedAlbum = internalOneAlbumData(modifiedAlbumId);
+
+        if (!modifiedAlbum.isEmpty() &&
+                updateAlbumFromId(modifiedAlbumId, modifiedAlbum.at(0).albumCover(), modifiedAlbum.at(0), modifiedAlbum.at(0).resourceURI().toString(currentOptions))) {
+            for (const auto &oneTrack : modifiedAlbum) {
+                recordModifiedTrack(oneTrack.databaseId());
+            }
         }
 
-        d->mRemoveTracksMapping.bindValue(QStringLiteral(":fileName"), removedTrackFileName.toString());
+        Q_EMIT albumModified({{DataTypes::DatabaseIdRole, modifiedAlbumId}}, modifiedAlbumId);
+    }
+
+    for (auto emptyAlbumId : std::as_const(emptyAlbums)) {
+        removeAlbumInDatabase(emptyAlbumId);
+        Q_EMIT albumRemoved(emptyAlbumId);
+    }
 
-        auto result = execQuery(d->mRemoveTracksMapping);
+    // only once the empty albums are gone can their artists be found orphaned
+    if (!internalGenericPartialData(d->mSelectRemovedTracksOrphanArtistsQuery)) {
+        return;
+    }
 
-        if (!result || !d->mRemoveTracksMapping.isActive()) {
-            Q_EMIT databaseError();
+    QList<qulonglong> orphanArtists;
 
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.boundValues();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastError();
+    while (d->mSelectRemovedTracksOrphanArtistsQuery.next()) {
+        orphanArtists.push_back(d->mSelectRemovedTracksOrphanArtistsQuery.record().value(0).toULongLong());
+    }
 
-            continue;
-        }
+    d->mSelectRemovedTracksOrphanArtistsQuery.finish();
 
-        d->mRemoveTracksMapping.finish();
+    for (auto removedArtistId : std::as_const(orphanArtists)) {
+        removeArtistInDatabase(removedArtistId);
+        Q_EMIT artistRemoved(removedArtistId);
     }
+}
 
-    for (auto modifiedAlbumId : modifiedAlbums) {
-        const auto &modifiedAlbumData = internalOneAlbumPartialData(modifiedAlbumId);
+bool DatabaseInterface::execAndFinishQuery(DatabaseStatement &query)
+{
+    auto result = execQuery(query);
 
-        auto tracksCount = fetchTrackIds(modifiedAlbumId).count();
+    if (!result || !query.isActive()) {
+        Q_EMIT databaseError();
 
-        if (!modifiedAlbumData.isEmpty() && tracksCount) {
-            const auto modifiedAlbum = internalOneAlbumData(modifiedAlbumId);
-            if (updateAlbumFromId(modifiedAlbumId, modifiedAlbum.at(0).albumCover(), modifiedAlbum.at(0), modifiedAlbum.at(0).resourceURI().toString(currentOptions))) {
-                for (const auto &oneTrack : modifiedAlbum) {
-                    recordModifiedTrack(oneTrack.databaseId());
-                }
-            }
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::execAndFinishQuery" << query.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::execAndFinishQuery" << query.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::execAndFinishQuery" << query.lastError();
 
-            Q_EMIT albumModified({{DataTypes::DatabaseIdRole, modifiedAlbumId}}, modifiedAlbumId);
-        } else {
-            removeAlbumInDatabase(modifiedAlbumId);
-            Q_EMIT albumRemoved(modifiedAlbumId);
+        result = false;
+    }
 
-            const auto &allTracksFromArtist = internalTracksFromAuthor(modifiedAlbumData[DataTypes::AlbumDataType::key_type::ArtistRole].toString());
-            const auto &allAlbumsFromArtist = internalAlbumIdsFromAuthor(modifiedAlbumData[DataTypes::AlbumDataType::key_type::ArtistRole].toString());
-            const auto &removedArtistId = internalArtistIdFromName(modifiedAlbumData[DataTypes::AlbumDataType::key_type::ArtistRole].toString());
+    query.finish();
 
-            if (removedArtistId != 0 && allTracksFromArtist.isEmpty() && allAlbumsFromArtist.isEmpty()) {
-                removeArtistInDatabase(removedArtistId);
-                Q_EMIT artistRemoved(removedArtistId);
-            }
-        }
-    }
+    return result;
 }
 
 QUrl DatabaseInterface::internalAlbumArtUriFromAlbumId(qulonglong albumId)
@@ -7364,7 +8392,7 @@ bool DatabaseInterface::isValidArtist(qulonglong albumId)
     return result;
 }
 
-bool DatabaseInterface::internalGenericPartialData(QSqlQuery &query)
+bool DatabaseInterface::internalGenericPartialData(DatabaseStatement &query)
 {
     auto result = false;
 
@@ -7392,6 +8420,15 @@ bool DatabaseInterface::internalGenericPartialData(QSqlQuery &query)
     return result;
 }
 
+bool DatabaseInterface::internalIsLoadCancelled(qsizetype loadedRowsCount) const
+{
+    if (loadedRowsCount % DatabaseInterfacePrivate::LoadCancellationRowsBatch != 0) {
+        return false;
+    }
+
+    return isLoadCancelled();
+}
+
 qulonglong DatabaseInterface::insertLyricist(const QString &name)
 {
     auto result = qulonglong(0);
@@ -7400,31 +8437,42 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
         return result;
     }
 
-    d->mSelectLyricistByNameQuery.bindValue(QStringLiteral(":name"), name);
+    const auto knownId = d->knownNameId(d->mLyricistIds, name);
+    if (knownId && *knownId != 0) {
+        return *knownId;
+    }
 
-    auto queryResult = execQuery(d->mSelectLyricistByNameQuery);
+    auto queryResult = true;
 
-    if (!queryResult || !d->mSelectLyricistByNameQuery.isSelect() || !d->mSelectLyricistByNameQuery.isActive()) {
-        Q_EMIT databaseError();
+    if (!knownId) {
+        d->mSelectLyricistByNameQuery.bindValue(QStringLiteral(":name"), name);
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.lastError();
+        queryResult = execQuery(d->mSelectLyricistByNameQuery);
 
-        d->mSelectLyricistByNameQuery.finish();
+        if (!queryResult || !d->mSelectLyricistByNameQuery.isSelect() || !d->mSelectLyricistByNameQuery.isActive()) {
+            Q_EMIT databaseError();
 
-        return result;
-    }
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.lastError();
 
-    if (d->mSelectLyricistByNameQuery.next()) {
-        result = d->mSelectLyricistByNameQuery.record().value(0).toULongLong();
+            d->mSelectLyricistByNameQuery.finish();
 
-        d->mSelectLyricistByNameQuery.finish();
+            return result;
+        }
 
-        return result;
-    }
+        if (d->mSelectLyricistByNameQuery.next()) {
+            result = d->mSelectLyricistByNameQuery.record().value(0).toULongLong();
+
+            d->mSelectLyricistByNameQuery.finish();
+
+            d->mLyricistIds.mIds.insert(name, result);
 
-    d->mSelectLyricistByNameQuery.finish();
+            return result;
+        }
+
+        d->mSelectLyricistByNameQuery.finish();
+    }
 
     d->mInsertLyricistQuery.bindValue(QStringLiteral(":lyricistId"), d->mLyricistId);
     d->mInsertLyricistQuery.bindValue(QStringLiteral(":name"), name);
@@ -7445,6 +8493,8 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
 
     result = d->mLyricistId;
 
+    d->mLyricistIds.mIds.insert(name, result);
+
     ++d->mLyricistId;
 
     d->mInsertLyricistQuery.finish();
@@ -7492,6 +8542,10 @@ qulonglong DatabaseInterface::internalArtistIdFromName(const QString &name)
         return result;
     }
 
+    if (const auto knownId = d->knownNameId(d->mArtistIds, name); knownId) {
+        return *knownId;
+    }
+
     d->mSelectArtistByNameQuery.bindValue(QStringLiteral(":name"), name);
 
     auto queryResult = execQuery(d->mSelectArtistByNameQuery);
@@ -7521,23 +8575,6 @@ qulonglong DatabaseInterface::internalArtistIdFromName(const QString &name)
     return result;
 }
 
-void DatabaseInterface::removeTrackInDatabase(qulonglong trackId)
-{
-    d->mRemoveTrackQuery.bindValue(QStringLiteral(":trackId"), trackId);
-
-    auto result = execQuery(d->mRemoveTrackQuery);
-
-    if (!result || !d->mRemoveTrackQuery.isActive()) {
-        Q_EMIT databaseError();
-
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackInDatabase" << d->mRemoveTrackQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackInDatabase" << d->mRemoveTrackQuery.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackInDatabase" << d->mRemoveTrackQuery.lastError();
-    }
-
-    d->mRemoveTrackQuery.finish();
-}
-
 void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &oneTrack, const QString &albumPath)
 {
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
@@ -7612,111 +8649,433 @@ void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &on
 
 void DatabaseInterface::removeRadio(qulonglong radioId)
 {
-    QSqlQuery query = d->mDeleteRadioQuery;
+    QMutexLocker locker(&mPendingWrites->mMutex);
+
+    if (!mPendingWrites->mRemovedRadios.contains(radioId)) {
+        mPendingWrites->mRemovedRadios.push_back(radioId);
+    }
+
+    pendingWriteQueued();
+}
+
+bool DatabaseInterface::internalRemoveRadio(qulonglong radioId)
+{
+    auto query = d->mDeleteRadioQuery.prepared();
 
     query.bindValue(QStringLiteral(":radioId"), radioId);
 
     auto result = execQuery(query);
 
-    if (!result || !query.isActive()) {
-        Q_EMIT databaseError();
+    if (!result || !query.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveRadio" << query.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveRadio" << query.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveRadio" << query.lastError();
+
+        query.finish();
+
+        return false;
+    }
+
+    query.finish();
+
+    return true;
+}
+
+void DatabaseInterface::removeAlbumInDatabase(qulonglong albumId)
+{
+    d->mAlbumIds.clear();
+
+    d->mRemoveAlbumQuery.bindValue(QStringLiteral(":albumId"), albumId);
+
+    auto result = execQuery(d->mRemoveAlbumQuery);
+
+    if (!result || !d->mRemoveAlbumQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.lastError();
+    }
+
+    d->mRemoveAlbumQuery.finish();
+}
+
+void DatabaseInterface::removeArtistInDatabase(qulonglong artistId)
+{
+    DatabaseInterfacePrivate::clearNameIds(d->mArtistIds);
+
+    d->mRemoveArtistQuery.bindValue(QStringLiteral(":artistId"), artistId);
+
+    auto result = execQuery(d->mRemoveArtistQuery);
+
+    if (!result || !d->mRemoveArtistQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastError();
+    }
+
+    d->mRemoveArtistQuery.finish();
+}
+
+void DatabaseInterface::reloadExistingDatabase()
+{
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::reloadExistingDatabase";
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    d->mDataVersion = internalDataVersion();
+    internalReloadInitialIds();
+
+    finishTransaction();
+}
+
+void DatabaseInterface::internalReloadInitialIds()
+{
+    d->mArtistId = internalGenericInitialId(d->mQueryMaximumArtistIdQuery);
+    d->mComposerId = internalGenericInitialId(d->mQueryMaximumComposerIdQuery);
+    d->mLyricistId = internalGenericInitialId(d->mQueryMaximumLyricistIdQuery);
+    d->mAlbumId = internalGenericInitialId(d->mQueryMaximumAlbumIdQuery);
+    d->mTrackId = internalGenericInitialId(d->mQueryMaximumTrackIdQuery);
+    d->mGenreId = internalGenericInitialId(d->mQueryMaximumGenreIdQuery);
+}
+
+qulonglong DatabaseInterface::internalGenericInitialId(DatabaseStatement &request)
+{
+    auto result = qulonglong(0);
+
+    auto queryResult = execQuery(request);
+
+    if (!queryResult || !request.isSelect() || !request.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalGenericInitialId" << request.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalGenericInitialId" << request.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalGenericInitialId" << request.lastError();
+
+        request.finish();
+
+        return result;
+    }
+
+    if (request.next()) {
+        result = request.record().value(0).toULongLong() + 1;
+
+        request.finish();
+    }
+
+    return result;
+}
+
+qlonglong DatabaseInterface::internalPragmaValue(const QString &pragmaName)
+{
+    auto pragmaQuery = d->mTracksDatabase.exec(QStringLiteral("PRAGMA %1;").arg(pragmaName));
+
+    if (!pragmaQuery.next()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalPragmaValue" << pragmaName << pragmaQuery.lastError();
+
+        return -1;
+    }
+
+    return pragmaQuery.value(0).toLongLong();
+}
+
+void DatabaseInterface::internalMaintenanceOptimize()
+{
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    // each table is analyzed with a sample of its rows to keep the step short
+    d->mTracksDatabase.exec(QStringLiteral("PRAGMA analysis_limit = 400;"));
+
+    auto optimizeQuery = d->mTracksDatabase.exec(QStringLiteral("PRAGMA optimize;"));
+
+    if (optimizeQuery.lastError().isValid()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceOptimize" << optimizeQuery.lastError();
+
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceOptimize" << "statistics of the query planner updated in" << timer.elapsed() << "ms";
+}
+
+bool DatabaseInterface::internalMaintenanceVacuum()
+{
+    const auto freePagesCount = internalPragmaValue(QStringLiteral("freelist_count"));
+
+    if (freePagesCount <= 0) {
+        if (d->mReclaimedPagesCount > 0) {
+            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceVacuum" << "reclaimed" << d->mReclaimedPagesCount << "pages";
+        }
+
+        d->mReclaimedPagesCount = 0;
+
+        return true;
+    }
+
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    if (internalPragmaValue(QStringLiteral("auto_vacuum")) != DatabaseInterfacePrivate::IncrementalAutoVacuum) {
+        // databases created before the incremental vacuum are only rebuilt when little data is left, like after a full rescan
+        const auto usedPagesCount = internalPragmaValue(QStringLiteral("page_count")) - freePagesCount;
+
+        if (usedPagesCount > DatabaseInterfacePrivate::MaintenanceFullVacuumPages) {
+            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceVacuum" << freePagesCount << "free pages kept, the database is too large to be rebuilt";
+
+            return true;
+        }
+
+        // the rebuild blocks the database for its whole duration, it is never run while Elisa is idle
+        if (!d->mIsMaintenanceForced) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceVacuum" << freePagesCount << "free pages kept until an explicit maintenance";
+
+            return true;
+        }
+
+        internalMaintenanceEnableIncrementalVacuum();
+
+        return true;
+    }
+
+    auto vacuumQuery = QSqlQuery{d->mTracksDatabase};
+
+    if (!vacuumQuery.exec(QStringLiteral("PRAGMA incremental_vacuum(%1);").arg(d->mVacuumPagesPerStep))) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceVacuum" << vacuumQuery.lastError();
+
+        return true;
+    }
+
+    // SQLite frees the pages while the statement is stepped
+    while (vacuumQuery.next()) {
+    }
+    vacuumQuery.finish();
+
+    const auto reclaimedPagesCount = freePagesCount - internalPragmaValue(QStringLiteral("freelist_count"));
+
+    if (reclaimedPagesCount <= 0) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceVacuum" << "no page reclaimed," << freePagesCount << "free pages kept";
+
+        return true;
+    }
+
+    d->mReclaimedPagesCount += reclaimedPagesCount;
+
+    // the next steps reclaim as many pages as possible in the time budget
+    if (timer.elapsed() > DatabaseInterfacePrivate::MaintenanceStepBudgetMs) {
+        d->mVacuumPagesPerStep = std::max(16, d->mVacuumPagesPerStep / 2);
+    } else if (timer.elapsed() < DatabaseInterfacePrivate::MaintenanceStepBudgetMs / 2) {
+        d->mVacuumPagesPerStep = std::min(4096, d->mVacuumPagesPerStep * 2);
+    }
+
+    return false;
+}
+
+void DatabaseInterface::internalMaintenanceEnableIncrementalVacuum()
+{
+    if (internalPragmaValue(QStringLiteral("auto_vacuum")) == DatabaseInterfacePrivate::IncrementalAutoVacuum) {
+        return;
+    }
+
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    // the new mode is only applied by rebuilding the whole database
+    d->mTracksDatabase.exec(QStringLiteral("PRAGMA auto_vacuum = INCREMENTAL;"));
+
+    auto vacuumQuery = d->mTracksDatabase.exec(QStringLiteral("VACUUM;"));
+
+    if (vacuumQuery.lastError().isValid()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceEnableIncrementalVacuum" << vacuumQuery.lastError();
+
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceEnableIncrementalVacuum" << "database rebuilt in" << timer.elapsed() << "ms";
+}
+
+bool DatabaseInterface::internalMaintenanceIntegrityCheck()
+{
+    if (d->mTablesToCheck.isEmpty()) {
+        return true;
+    }
+
+    const auto tableName = d->mTablesToCheck.takeFirst();
+
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    // one table per step, the whole database is checked after a few steps
+    auto checkQuery = d->mTracksDatabase.exec(QStringLiteral("PRAGMA quick_check(%1);").arg(tableName));
+
+    while (checkQuery.next()) {
+        const auto checkResult = checkQuery.value(0).toString();
+
+        if (checkResult != QLatin1String("ok")) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceIntegrityCheck" << tableName << checkResult;
+
+            ++d->mIntegrityErrorsCount;
+        }
+    }
+
+    if (checkQuery.lastError().isValid()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceIntegrityCheck" << tableName << checkQuery.lastError();
+    }
+
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceIntegrityCheck" << tableName << "checked in" << timer.elapsed() << "ms";
+
+    d->mIntegrityCheckElapsedMs += timer.elapsed();
+
+    if (!d->mTablesToCheck.isEmpty()) {
+        if (d->mIsMaintenanceForced || d->mIntegrityCheckElapsedMs < DatabaseInterfacePrivate::MaintenanceIntegrityCheckBudgetMs) {
+            return false;
+        }
+
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceIntegrityCheck" << d->mTablesToCheck.size() << "tables left for the next maintenance";
+
+        return true;
+    }
+
+    if (d->mIntegrityErrorsCount == 0) {
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceIntegrityCheck" << "integrity check passed";
+    } else {
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceIntegrityCheck" << "integrity check found" << d->mIntegrityErrorsCount << "errors";
+    }
+
+    return true;
+}
+
+QStringList DatabaseInterface::internalMaintenanceCheckedTables()
+{
+    auto result = QStringList{};
+
+    // the temporary tables are not in sqlite_master, the full-text index and its shadow tables are skipped
+    auto tablesQuery = d->mTracksDatabase.exec(QStringLiteral("SELECT "
+                                                              "tables.`name` "
+                                                              "FROM "
+                                                              "sqlite_master tables "
+                                                              "WHERE "
+                                                              "tables.`type` = 'table' AND "
+                                                              "tables.`name` NOT LIKE 'sqlite\\_%' ESCAPE '\\' AND "
+                                                              "tables.`sql` NOT LIKE 'CREATE VIRTUAL TABLE%' AND "
+                                                              "NOT EXISTS ("
+                                                              "  SELECT virtualTables.`name` "
+                                                              "  FROM "
+                                                              "  sqlite_master virtualTables "
+                                                              "  WHERE "
+                                                              "  virtualTables.`type` = 'table' AND "
+                                                              "  virtualTables.`sql` LIKE 'CREATE VIRTUAL TABLE%' AND "
+                                                              "  tables.`name` LIKE virtualTables.`name` || '\\_%' ESCAPE '\\'"
+                                                              ")"));
+
+    while (tablesQuery.next()) {
+        result.push_back(tablesQuery.value(0).toString());
+    }
+
+    if (tablesQuery.lastError().isValid()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceCheckedTables" << tablesQuery.lastError();
+    }
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackInDatabase" << query.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackInDatabase" << query.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackInDatabase" << query.lastError();
-    }else{
-        Q_EMIT radioRemoved(radioId);
+    // the check of one table cannot be split, the large ones would block the idle maintenance
+    if (!d->mIsMaintenanceForced) {
+        const auto smallTables = internalMaintenanceSmallTables();
+        result.removeIf([&smallTables](const QString &tableName) { return !smallTables.contains(tableName); });
     }
 
-    query.finish();
+    return result;
 }
 
-void DatabaseInterface::removeAlbumInDatabase(qulonglong albumId)
+QSet<QString> DatabaseInterface::internalMaintenanceSmallTables()
 {
-    d->mRemoveAlbumQuery.bindValue(QStringLiteral(":albumId"), albumId);
-
-    auto result = execQuery(d->mRemoveAlbumQuery);
+    auto result = QSet<QString>{};
 
-    if (!result || !d->mRemoveAlbumQuery.isActive()) {
-        Q_EMIT databaseError();
+    // the rows are counted by the statistics of the query planner, their table only exists once they were gathered
+    auto statisticsTableQuery = d->mTracksDatabase.exec(QStringLiteral("SELECT "
+                                                                       "`name` "
+                                                                       "FROM "
+                                                                       "sqlite_master "
+                                                                       "WHERE "
+                                                                       "`type` = 'table' AND "
+                                                                       "`name` = 'sqlite_stat1'"));
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.lastError();
+    if (!statisticsTableQuery.next()) {
+        return result;
     }
 
-    d->mRemoveAlbumQuery.finish();
-}
-
-void DatabaseInterface::removeArtistInDatabase(qulonglong artistId)
-{
-    d->mRemoveArtistQuery.bindValue(QStringLiteral(":artistId"), artistId);
+    statisticsTableQuery.finish();
 
-    auto result = execQuery(d->mRemoveArtistQuery);
+    auto rowsCountQuery = d->mTracksDatabase.exec(QStringLiteral("SELECT "
+                                                                 "`tbl`, "
+                                                                 "MAX(CAST(`stat` AS INTEGER)) "
+                                                                 "FROM "
+                                                                 "sqlite_stat1 "
+                                                                 "GROUP BY "
+                                                                 "`tbl`"));
 
-    if (!result || !d->mRemoveArtistQuery.isActive()) {
-        Q_EMIT databaseError();
+    while (rowsCountQuery.next()) {
+        if (rowsCountQuery.value(1).toLongLong() <= DatabaseInterfacePrivate::MaintenanceIdleCheckedRows) {
+            result.insert(rowsCountQuery.value(0).toString());
+        }
+    }
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastError();
+    if (rowsCountQuery.lastError().isValid()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalMaintenanceSmallTables" << rowsCountQuery.lastError();
     }
 
-    d->mRemoveArtistQuery.finish();
+    return result;
 }
 
-void DatabaseInterface::reloadExistingDatabase()
+qlonglong DatabaseInterface::internalDataVersion()
 {
-    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::reloadExistingDatabase";
+    auto result = qlonglong(0);
+
+    // only changes when another connection commits
+    auto dataVersionQuery = d->mTracksDatabase.exec(QStringLiteral("PRAGMA data_version;"));
+    if (dataVersionQuery.next()) {
+        result = dataVersionQuery.value(0).toLongLong();
+    }
 
-    d->mArtistId = genericInitialId(d->mQueryMaximumArtistIdQuery);
-    d->mComposerId = genericInitialId(d->mQueryMaximumComposerIdQuery);
-    d->mLyricistId = genericInitialId(d->mQueryMaximumLyricistIdQuery);
-    d->mAlbumId = genericInitialId(d->mQueryMaximumAlbumIdQuery);
-    d->mTrackId = genericInitialId(d->mQueryMaximumTrackIdQuery);
-    d->mGenreId = genericInitialId(d->mQueryMaximumGenreIdQuery);
+    return result;
 }
 
-qulonglong DatabaseInterface::genericInitialId(QSqlQuery &request)
+void DatabaseInterface::internalCollectExternalChanges()
 {
-    auto result = qulonglong(0);
-
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
+    const auto dataVersion = internalDataVersion();
+    if (dataVersion == d->mDataVersion) {
+        return;
     }
 
-    auto queryResult = execQuery(request);
+    d->mDataVersion = dataVersion;
 
-    if (!queryResult || !request.isSelect() || !request.isActive()) {
-        Q_EMIT databaseError();
+    // the other process may also have removed data
+    d->clearIdsCaches();
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << request.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << request.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << request.lastError();
+    const auto firstNewArtistId = d->mArtistId;
+    const auto firstNewAlbumId = d->mAlbumId;
+    const auto firstNewTrackId = d->mTrackId;
 
-        request.finish();
+    internalReloadInitialIds();
 
-        transactionResult = finishTransaction();
-        if (!transactionResult) {
-            return result;
-        }
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalCollectExternalChanges" << "new tracks" << firstNewTrackId << d->mTrackId;
 
-        return result;
+    // the other process allocates the identifiers after the greatest existing one
+    for (auto artistId = firstNewArtistId; artistId < d->mArtistId; ++artistId) {
+        d->mExternalInsertedArtists.insert(artistId);
     }
 
-    if (request.next()) {
-        result = request.record().value(0).toULongLong() + 1;
-
-        request.finish();
+    for (auto albumId = firstNewAlbumId; albumId < d->mAlbumId; ++albumId) {
+        d->mExternalInsertedAlbums.insert(albumId);
     }
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
+    for (auto trackId = firstNewTrackId; trackId < d->mTrackId; ++trackId) {
+        d->mExternalInsertedTracks.insert(trackId);
     }
-
-    return result;
 }
 
 QList<qulonglong> DatabaseInterface::fetchTrackIds(qulonglong albumId)
@@ -8068,36 +9427,7 @@ DataTypes::ListTrackDataType DatabaseInterface::internalTracksFromGenre(const QS
 }
 
 
-QList<qulonglong> DatabaseInterface::internalAlbumIdsFromAuthor(const QString &ArtistName)
-{
-    auto allAlbumIds = QList<qulonglong>();
-
-    d->mSelectAlbumIdsFromArtist.bindValue(QStringLiteral(":artistName"), ArtistName);
-
-    auto result = execQuery(d->mSelectAlbumIdsFromArtist);
-
-    if (!result || !d->mSelectAlbumIdsFromArtist.isSelect() || !d->mSelectAlbumIdsFromArtist.isActive()) {
-        Q_EMIT databaseError();
-
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectAlbumIdsFromArtist.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectAlbumIdsFromArtist.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectAlbumIdsFromArtist.lastError();
-
-        return allAlbumIds;
-    }
-
-    while (d->mSelectAlbumIdsFromArtist.next()) {
-        const auto &currentRecord = d->mSelectAlbumIdsFromArtist.record();
-
-        allAlbumIds.push_back(currentRecord.value(0).toULongLong());
-    }
-
-    d->mSelectAlbumIdsFromArtist.finish();
-
-    return allAlbumIds;
-}
-
-DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(QSqlQuery &artistsQuery)
+DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(DatabaseStatement &artistsQuery)
 {
     auto result = DataTypes::ListArtistDataType{};
 
@@ -8106,6 +9436,11 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(Q
     }
 
     while(artistsQuery.next()) {
+        if (internalIsLoadCancelled(result.size())) {
+            artistsQuery.finish();
+            return {};
+        }
+
         auto newData = DataTypes::ArtistDataType{};
 
         const auto &currentRecord = artistsQuery.record();
@@ -8128,7 +9463,7 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(Q
     return result;
 }
 
-DataTypes::ListAlbumDataType DatabaseInterface::internalAllAlbumsPartialData(QSqlQuery &query)
+DataTypes::ListAlbumDataType DatabaseInterface::internalAllAlbumsPartialData(DatabaseStatement &query)
 {
     auto result = DataTypes::ListAlbumDataType{};
 
@@ -8137,6 +9472,11 @@ DataTypes::ListAlbumDataType DatabaseInterface::internalAllAlbumsPartialData(QSq
     }
 
     while(query.next()) {
+        if (internalIsLoadCancelled(result.size())) {
+            query.finish();
+            return {};
+        }
+
         auto newData = DataTypes::AlbumDataType{};
 
         const auto &currentRecord = query.record();
@@ -8200,6 +9540,11 @@ DataTypes::ListTrackDataType DatabaseInterface::internalOneAlbumData(qulonglong
     }
 
     while (d->mSelectTrackQuery.next()) {
+        if (internalIsLoadCancelled(result.size())) {
+            d->mSelectTrackQuery.finish();
+            return {};
+        }
+
         const auto &currentRecord = d->mSelectTrackQuery.record();
 
         result.push_back(buildTrackDataFromDatabaseRecord(currentRecord));
@@ -8221,37 +9566,7 @@ DataTypes::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(qulonglo
     }
 
     if (d->mSelectAlbumQuery.next()) {
-        const auto &currentRecord = d->mSelectAlbumQuery.record();
-
-        result[DataTypes::DatabaseIdRole] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumId);
-        result[DataTypes::TitleRole] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumTitle);
-        if (!currentRecord.value(DatabaseInterfacePrivate::SingleAlbumCoverFileName).toString().isEmpty()) {
-            result[DataTypes::ImageUrlRole] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumCoverFileName);
-        } else if (!currentRecord.value(DatabaseInterfacePrivate::SingleAlbumEmbeddedCover).toString().isEmpty()) {
-            result[DataTypes::ImageUrlRole] = QVariant{QLatin1String("image://cover/") + currentRecord.value(DatabaseInterfacePrivate::SingleAlbumEmbeddedCover).toUrl().toLocalFile()};
-        }
-
-        auto allArtists = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumAllArtists).toString().split(QStringLiteral(", "));
-        allArtists.removeDuplicates();
-        result[DataTypes::AllArtistsRole] = QVariant::fromValue(allArtists);
-
-        if (!currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistName).isNull()) {
-            result[DataTypes::IsValidAlbumArtistRole] = true;
-            result[DataTypes::SecondaryTextRole] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistName);
-        } else {
-            result[DataTypes::IsValidAlbumArtistRole] = false;
-            if (currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistsCount).toInt() == 1) {
-                result[DataTypes::SecondaryTextRole] = allArtists.first();
-            } else if (currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistsCount).toInt() > 1) {
-                result[DataTypes::SecondaryTextRole] = i18nc("@item:intable", "Various Artists");
-            }
-        }
-        result[DataTypes::ArtistRole] = result[DataTypes::SecondaryTextRole];
-        result[DataTypes::HighestTrackRating] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumHighestRating);
-        result[DataTypes::IsSingleDiscAlbumRole] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumIsSingleDiscAlbum);
-        result[DataTypes::GenreRole] = QVariant::fromValue(currentRecord.value(DatabaseInterfacePrivate::SingleAlbumAllGenres).toString().split(QStringLiteral(", ")));
-        result[DataTypes::ElementTypeRole] = ElisaUtils::Album;
-
+        result = buildAlbumDataFromDatabaseRecord(d->mSelectAlbumQuery.record());
     }
 
     d->mSelectAlbumQuery.finish();
@@ -8270,20 +9585,181 @@ DataTypes::ArtistDataType DatabaseInterface::internalOneArtistPartialData(qulong
     }
 
     if (d->mSelectArtistQuery.next()) {
-        const auto &currentRecord = d->mSelectArtistQuery.record();
+        result = buildArtistDataFromDatabaseRecord(d->mSelectArtistQuery.record());
+    }
 
-        result[DataTypes::DatabaseIdRole] = currentRecord.value(0);
-        result[DataTypes::TitleRole] = currentRecord.value(1);
-        result[DataTypes::GenreRole] = QVariant::fromValue(currentRecord.value(2).toString().split(QStringLiteral(", ")));
+    d->mSelectArtistQuery.finish();
 
-        const auto covers = internalGetLatestFourCoversForArtist(currentRecord.value(1).toString());
-        result[DataTypes::MultipleImageUrlsRole] = covers;
-        result[DataTypes::ImageUrlRole] = covers.value(0).toUrl();
+    return result;
+}
+
+DataTypes::AlbumDataType DatabaseInterface::buildAlbumDataFromDatabaseRecord(const QSqlRecord &albumRecord) const
+{
+    auto result = DataTypes::AlbumDataType{};
 
-        result[DataTypes::ElementTypeRole] = ElisaUtils::Artist;
+    result[DataTypes::DatabaseIdRole] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumId);
+    result[DataTypes::TitleRole] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumTitle);
+    if (!albumRecord.value(DatabaseInterfacePrivate::SingleAlbumCoverFileName).toString().isEmpty()) {
+        result[DataTypes::ImageUrlRole] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumCoverFileName);
+    } else if (!albumRecord.value(DatabaseInterfacePrivate::SingleAlbumEmbeddedCover).toString().isEmpty()) {
+        result[DataTypes::ImageUrlRole] = QVariant{QLatin1String("image://cover/") + albumRecord.value(DatabaseInterfacePrivate::SingleAlbumEmbeddedCover).toUrl().toLocalFile()};
     }
 
-    d->mSelectArtistQuery.finish();
+    auto allArtists = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumAllArtists).toString().split(QStringLiteral(", "));
+    allArtists.removeDuplicates();
+    result[DataTypes::AllArtistsRole] = QVariant::fromValue(allArtists);
+
+    if (!albumRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistName).isNull()) {
+        result[DataTypes::IsValidAlbumArtistRole] = true;
+        result[DataTypes::SecondaryTextRole] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistName);
+    } else {
+        result[DataTypes::IsValidAlbumArtistRole] = false;
+        if (albumRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistsCount).toInt() == 1) {
+            result[DataTypes::SecondaryTextRole] = allArtists.first();
+        } else if (albumRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistsCount).toInt() > 1) {
+            result[DataTypes::SecondaryTextRole] = i18nc("@item:intable", "Various Artists");
+        }
+    }
+    result[DataTypes::ArtistRole] = result[DataTypes::SecondaryTextRole];
+    result[DataTypes::HighestTrackRating] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumHighestRating);
+    result[DataTypes::IsSingleDiscAlbumRole] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumIsSingleDiscAlbum);
+    result[DataTypes::GenreRole] = QVariant::fromValue(albumRecord.value(DatabaseInterfacePrivate::SingleAlbumAllGenres).toString().split(QStringLiteral(", ")));
+    result[DataTypes::ElementTypeRole] = ElisaUtils::Album;
+
+    return result;
+}
+
+DataTypes::ArtistDataType DatabaseInterface::buildArtistDataFromDatabaseRecord(const QSqlRecord &artistRecord)
+{
+    auto result = DataTypes::ArtistDataType{};
+
+    result[DataTypes::DatabaseIdRole] = artistRecord.value(0);
+    result[DataTypes::TitleRole] = artistRecord.value(1);
+    result[DataTypes::GenreRole] = QVariant::fromValue(artistRecord.value(2).toString().split(QStringLiteral(", ")));
+
+    const auto covers = internalGetLatestFourCoversForArtist(artistRecord.value(1).toString());
+    result[DataTypes::MultipleImageUrlsRole] = covers;
+    result[DataTypes::ImageUrlRole] = covers.value(0).toUrl();
+
+    result[DataTypes::ElementTypeRole] = ElisaUtils::Artist;
+
+    return result;
+}
+
+bool DatabaseInterface::internalFillNotifiedIds(const QSet<qulonglong> &ids)
+{
+    auto queryResult = execQuery(d->mClearNotifiedIdsQuery);
+
+    if (!queryResult || !d->mClearNotifiedIdsQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalFillNotifiedIds" << d->mClearNotifiedIdsQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalFillNotifiedIds" << d->mClearNotifiedIdsQuery.lastError();
+
+        d->mClearNotifiedIdsQuery.finish();
+
+        return false;
+    }
+
+    d->mClearNotifiedIdsQuery.finish();
+
+    for (auto oneId : ids) {
+        d->mInsertNotifiedIdQuery.bindValue(QStringLiteral(":id"), oneId);
+
+        queryResult = execQuery(d->mInsertNotifiedIdQuery);
+
+        if (!queryResult || !d->mInsertNotifiedIdQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalFillNotifiedIds" << d->mInsertNotifiedIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalFillNotifiedIds" << d->mInsertNotifiedIdQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalFillNotifiedIds" << d->mInsertNotifiedIdQuery.lastError();
+
+            d->mInsertNotifiedIdQuery.finish();
+
+            return false;
+        }
+
+        d->mInsertNotifiedIdQuery.finish();
+    }
+
+    return true;
+}
+
+QHash<qulonglong, DataTypes::TrackDataType> DatabaseInterface::internalNotifiedTracksPartialData(const QSet<qulonglong> &tracksIds)
+{
+    auto result = QHash<qulonglong, DataTypes::TrackDataType>{};
+
+    if (tracksIds.isEmpty() || !internalFillNotifiedIds(tracksIds)) {
+        return result;
+    }
+
+    if (!internalGenericPartialData(d->mSelectNotifiedTracksQuery)) {
+        return result;
+    }
+
+    result.reserve(tracksIds.size());
+
+    while (d->mSelectNotifiedTracksQuery.next()) {
+        auto oneTrack = buildTrackDataFromDatabaseRecord(d->mSelectNotifiedTracksQuery.record());
+        const auto trackId = oneTrack.databaseId();
+
+        result[trackId] = std::move(oneTrack);
+    }
+
+    d->mSelectNotifiedTracksQuery.finish();
+
+    return result;
+}
+
+QHash<qulonglong, DataTypes::AlbumDataType> DatabaseInterface::internalNotifiedAlbumsPartialData(const QSet<qulonglong> &albumsIds)
+{
+    auto result = QHash<qulonglong, DataTypes::AlbumDataType>{};
+
+    if (albumsIds.isEmpty() || !internalFillNotifiedIds(albumsIds)) {
+        return result;
+    }
+
+    if (!internalGenericPartialData(d->mSelectNotifiedAlbumsQuery)) {
+        return result;
+    }
+
+    result.reserve(albumsIds.size());
+
+    while (d->mSelectNotifiedAlbumsQuery.next()) {
+        auto oneAlbum = buildAlbumDataFromDatabaseRecord(d->mSelectNotifiedAlbumsQuery.record());
+        const auto albumId = oneAlbum.databaseId();
+
+        result[albumId] = std::move(oneAlbum);
+    }
+
+    d->mSelectNotifiedAlbumsQuery.finish();
+
+    return result;
+}
+
+QHash<qulonglong, DataTypes::ArtistDataType> DatabaseInterface::internalNotifiedArtistsPartialData(const QSet<qulonglong> &artistsIds)
+{
+    auto result = QHash<qulonglong, DataTypes::ArtistDataType>{};
+
+    if (artistsIds.isEmpty() || !internalFillNotifiedIds(artistsIds)) {
+        return result;
+    }
+
+    if (!internalGenericPartialData(d->mSelectNotifiedArtistsQuery)) {
+        return result;
+    }
+
+    result.reserve(artistsIds.size());
+
+    while (d->mSelectNotifiedArtistsQuery.next()) {
+        auto oneArtist = buildArtistDataFromDatabaseRecord(d->mSelectNotifiedArtistsQuery.record());
+        const auto artistId = oneArtist.databaseId();
+
+        result[artistId] = std::move(oneArtist);
+    }
+
+    d->mSelectNotifiedArtistsQuery.finish();
 
     return result;
 }
@@ -8297,6 +9773,11 @@ DataTypes::ListTrackDataType DatabaseInterface::internalAllTracksPartialData()
     }
 
     while(d->mSelectAllTracksQuery.next()) {
+        if (internalIsLoadCancelled(result.size())) {
+            d->mSelectAllTracksQuery.finish();
+            return {};
+        }
+
         const auto &currentRecord = d->mSelectAllTracksQuery.record();
 
         auto newData = buildTrackDataFromDatabaseRecord(currentRecord);
@@ -8376,6 +9857,157 @@ DataTypes::ListTrackDataType DatabaseInterface::internalFrequentlyPlayedTracksDa
     return result;
 }
 
+DataTypes::ListTrackDataType DatabaseInterface::internalTracksDataPage(DataTypes::ColumnsRoles sortRole, Qt::SortOrder sortOrder,
+                                                                       const QVariant &afterSortValue, qulonglong afterDatabaseId, int count)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    auto itQuery = d->mSelectTracksPageQueries.find(tracksPageQueryKey(sortRole, sortOrder));
+    if (itQuery == d->mSelectTracksPageQueries.end()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTracksDataPage" << "no paged query for sort role" << sortRole;
+        return result;
+    }
+
+    auto &selectTracksPageQuery = itQuery->second;
+
+    if (afterSortValue.isNull()) {
+        // the first page starts after a value sorted before any key, an integer, or after one sorted
+        // after any key, a blob
+        if (sortOrder == Qt::AscendingOrder) {
+            selectTracksPageQuery.bindValue(QStringLiteral(":sortValue"), std::numeric_limits<qlonglong>::min());
+        } else {
+            selectTracksPageQuery.bindValue(QStringLiteral(":sortValue"), QByteArray(1, '\xff'));
+        }
+        selectTracksPageQuery.bindValue(QStringLiteral(":databaseId"), 0);
+    } else {
+        selectTracksPageQuery.bindValue(QStringLiteral(":sortValue"), afterSortValue);
+        selectTracksPageQuery.bindValue(QStringLiteral(":databaseId"), afterDatabaseId);
+    }
+    selectTracksPageQuery.bindValue(QStringLiteral(":maximumResults"), count);
+
+    if (!internalGenericPartialData(selectTracksPageQuery)) {
+        return result;
+    }
+
+    while(selectTracksPageQuery.next()) {
+        const auto &currentRecord = selectTracksPageQuery.record();
+
+        result.push_back(buildTrackDataFromDatabaseRecord(currentRecord));
+    }
+
+    selectTracksPageQuery.finish();
+
+    return result;
+}
+
+int DatabaseInterface::tracksPageQueryKey(DataTypes::ColumnsRoles sortRole, Qt::SortOrder sortOrder)
+{
+    return 2 * static_cast<int>(sortRole) + (sortOrder == Qt::AscendingOrder ? 0 : 1);
+}
+
+QString DatabaseInterface::trackSortExpression(DataTypes::ColumnsRoles sortRole)
+{
+    // each expression matches one index created by upgradeDatabaseV19
+    switch (sortRole)
+    {
+    case DataTypes::TitleRole:
+        return QStringLiteral("IFNULL(tracks.`Title`, '') COLLATE NOCASE");
+    case DataTypes::AlbumRole:
+        return QStringLiteral("IFNULL(tracks.`AlbumTitle`, '') COLLATE NOCASE");
+    case DataTypes::ArtistRole:
+        return QStringLiteral("IFNULL(tracks.`ArtistName`, '') COLLATE NOCASE");
+    case DataTypes::GenreRole:
+        return QStringLiteral("IFNULL(tracks.`Genre`, '') COLLATE NOCASE");
+    case DataTypes::ComposerRole:
+        return QStringLiteral("IFNULL(tracks.`Composer`, '') COLLATE NOCASE");
+    case DataTypes::LyricistRole:
+        return QStringLiteral("IFNULL(tracks.`Lyricist`, '') COLLATE NOCASE");
+    case DataTypes::YearRole:
+        return QStringLiteral("IFNULL(tracks.`Year`, 0)");
+    case DataTypes::DurationRole:
+        return QStringLiteral("tracks.`Duration`");
+    case DataTypes::FileModificationTime:
+        return QStringLiteral("tracksMapping.`FileModifiedTime`");
+    default:
+        return {};
+    }
+}
+
+DataTypes::ListMusicDataType DatabaseInterface::internalLibrarySearch(const QString &searchText, int maximumCount, int offset)
+{
+    auto result = DataTypes::ListMusicDataType{};
+
+    const auto pattern = librarySearchPattern(searchText);
+    if (pattern.isEmpty()) {
+        return result;
+    }
+
+    d->mLibrarySearchQuery.bindValue(QStringLiteral(":pattern"), pattern);
+    d->mLibrarySearchQuery.bindValue(QStringLiteral(":maximumResults"), maximumCount);
+    d->mLibrarySearchQuery.bindValue(QStringLiteral(":offset"), offset);
+
+    if (!internalGenericPartialData(d->mLibrarySearchQuery)) {
+        return result;
+    }
+
+    while(d->mLibrarySearchQuery.next()) {
+        const auto &currentRecord = d->mLibrarySearchQuery.record();
+
+        auto newData = DataTypes::MusicDataType{};
+
+        switch (currentRecord.value(0).toInt())
+        {
+        case 0:
+            newData[DataTypes::ElementTypeRole] = ElisaUtils::Track;
+            newData[DataTypes::ArtistRole] = currentRecord.value(3);
+            newData[DataTypes::AlbumRole] = currentRecord.value(4);
+            break;
+        case 1:
+            newData[DataTypes::ElementTypeRole] = ElisaUtils::Album;
+            newData[DataTypes::ArtistRole] = currentRecord.value(3);
+            break;
+        case 2:
+            newData[DataTypes::ElementTypeRole] = ElisaUtils::Artist;
+            break;
+        case 3:
+            newData[DataTypes::ElementTypeRole] = ElisaUtils::Composer;
+            break;
+        case 4:
+            newData[DataTypes::ElementTypeRole] = ElisaUtils::Genre;
+            break;
+        default:
+            continue;
+        }
+
+        newData[DataTypes::DatabaseIdRole] = currentRecord.value(1);
+        newData[DataTypes::TitleRole] = currentRecord.value(2);
+
+        result.push_back(newData);
+    }
+
+    d->mLibrarySearchQuery.finish();
+
+    return result;
+}
+
+QString DatabaseInterface::librarySearchPattern(const QString &searchText)
+{
+    auto prefixes = QStringList{};
+
+    const auto words = searchText.simplified().split(QLatin1Char(' '), Qt::SkipEmptyParts);
+    for (auto oneWord : words) {
+        if (std::none_of(oneWord.cbegin(), oneWord.cend(), [](QChar oneCharacter) { return oneCharacter.isLetterOrNumber(); })) {
+            continue;
+        }
+
+        // each word becomes a quoted FTS5 string to keep its punctuation out of the query syntax
+        oneWord.replace(QLatin1Char('"'), QStringLiteral("\"\""));
+        prefixes.push_back(QLatin1Char('"') + oneWord + QStringLiteral("\"*"));
+    }
+
+    return prefixes.join(QLatin1Char(' '));
+}
+
 DataTypes::TrackDataType DatabaseInterface::internalOneTrackPartialData(qulonglong databaseId)
 {
     auto result = DataTypes::TrackDataType{};
@@ -8449,6 +10081,11 @@ DataTypes::ListGenreDataType DatabaseInterface::internalAllGenresPartialData()
     }
 
     while(d->mSelectAllGenresQuery.next()) {
+        if (internalIsLoadCancelled(result.size())) {
+            d->mSelectAllGenresQuery.finish();
+            return {};
+        }
+
         auto newData = DataTypes::GenreDataType{};
 
         const auto &currentRecord = d->mSelectAllGenresQuery.record();
@@ -8648,10 +10285,10 @@ void DatabaseInterface::updateTrackStartedStatistics(const QUrl &fileName, const
     d->mUpdateTrackStartedStatistics.finish();
 }
 
-void DatabaseInterface::updateTrackFinishedStatistics(const QUrl &fileName, const QDateTime &time)
+void DatabaseInterface::updateTrackFinishedStatistics(const QUrl &fileName, const QDateTime &time, int playCount)
 {
     d->mUpdateTrackFinishedStatistics.bindValue(QStringLiteral(":fileName"), fileName);
-    d->mUpdateTrackFinishedStatistics.bindValue(QStringLiteral(":playDate"), time.toMSecsSinceEpoch());
+    d->mUpdateTrackFinishedStatistics.bindValue(QStringLiteral(":playCount"), playCount);
 
     auto queryResult = execQuery(d->mUpdateTrackFinishedStatistics);
 
@@ -16,14 +16,19 @@
 #include <QQmlEngine>
 #include <QString>
 #include <QHash>
+#include <QSet>
 #include <QList>
 #include <QUrl>
 #include <QDateTime>
+#include <QAtomicInt>
 
 #include <memory>
 #include <optional>
 
 class DatabaseInterfacePrivate;
+class DatabaseInterfacePendingWrites;
+class DatabaseStatistics;
+class DatabaseStatement;
 class QSqlRecord;
 class QSqlQuery;
 
@@ -46,6 +51,10 @@ public:
         V15 = 15,
         V16 = 16,
         V17 = 17,
+        V18 = 18,
+        V19 = 19,
+        V20 = 20,
+        V21 = 21,
     };
 
     explicit DatabaseInterface(QObject *parent = nullptr);
@@ -54,6 +63,16 @@ public:
 
     Q_INVOKABLE void init(const QString &dbName, const QString &databaseFileName = {});
 
+    /**
+     * Open a read-only connection to a database already initialized by another instance with init
+     *
+     * Only the read methods can be used. The database being in write-ahead log mode, they run
+     * concurrently with the writer and each transaction sees a consistent snapshot.
+     */
+    Q_INVOKABLE void initReadOnly(const QString &dbName, const QString &databaseFileName);
+
+    [[nodiscard]] QString journalMode();
+
     qulonglong albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath);
 
     DataTypes::ListTrackDataType allTracksData();
@@ -102,6 +121,56 @@ public:
 
     qulonglong radioIdFromFileName(const QUrl &fileName);
 
+    /**
+     * One page of all the tracks sorted by sortRole, each track coming once even when found in several files
+     *
+     * The page starts after the track with the given sort value, as returned by trackSortValue, and
+     * database id. A null sort value starts from the first track. Only the roles for which
+     * isTracksPageSortRole is true can be used, each one being backed by an index.
+     */
+    DataTypes::ListTrackDataType tracksDataPage(DataTypes::ColumnsRoles sortRole, Qt::SortOrder sortOrder,
+                                                const QVariant &afterSortValue, qulonglong afterDatabaseId, int count);
+
+    [[nodiscard]] static bool isTracksPageSortRole(DataTypes::ColumnsRoles sortRole);
+
+    [[nodiscard]] static QVariant trackSortValue(const DataTypes::TrackDataType &track, DataTypes::ColumnsRoles sortRole);
+
+    /**
+     * Search the tracks, albums, artists, composers and genres matching all the words of a text
+     *
+     * Each word matches the beginning of a word in the titles and names, ignoring case and
+     * diacritics. The best matches come first: a match in a title ranks above one in an artist
+     * name, which ranks above one in an album title, a composer or a genre.
+     */
+    DataTypes::ListMusicDataType librarySearch(const QString &searchText, int maximumCount, int offset = 0);
+
+    /**
+     * Statistics of the executed statements, nullptr while the profiling is disabled
+     *
+     * The profiling is enabled by setStatementProfiling or by setting the ELISA_DATABASE_PROFILING
+     * environment variable to 1. The statistics can then be read from any thread and are logged
+     * when the application quits.
+     */
+    [[nodiscard]] std::shared_ptr<DatabaseStatistics> statementStatistics() const;
+
+    /**
+     * Record the statements of this connection in the statistics of another one, nullptr to stop
+     *
+     * The readers of a database share the statistics of its writer so that they are all logged
+     * together when the application quits.
+     */
+    void setStatementStatistics(std::shared_ptr<DatabaseStatistics> statistics);
+
+    /**
+     * Flag stopping the loads of the calling thread once set from any thread, nullptr for none
+     *
+     * The loads check it between two batches of rows and then drop the rows already read.
+     * It must stay valid until it is replaced.
+     */
+    void setLoadCancellation(const QAtomicInt *isCancelled);
+
+    [[nodiscard]] bool isLoadCancelled() const;
+
     void applicationAboutToQuit();
 
 Q_SIGNALS:
@@ -154,14 +223,88 @@ public Q_SLOTS:
 
     void askRestoredTracks();
 
+    /**
+     * The statistics, modified tracks and removed radios are queued from any thread, even before
+     * init or while the database is reset
+     *
+     * Repeated updates of the same track are merged and the queue is committed as one
+     * transaction at most 50 ms later, even in the middle of a large insertTracksList.
+     * A read from this instance commits the queue first.
+     */
     void trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time);
 
     void trackHasFinishedPlaying(const QUrl &fileName, const QDateTime &time);
 
+    /**
+     * Queue metadata edits, finishInsertingTracksList is emitted once they are committed
+     */
+    void saveModifiedTracks(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers);
+
     void clearData();
 
     void removeRadio(qulonglong radioId);
 
+    /**
+     * Regularly check if another process changed the database, 0 to stop
+     *
+     * Tracks, albums and artists inserted by another process, like elisaImport, are then
+     * notified as if they were inserted by this instance.
+     */
+    void setExternalChangesPollInterval(int interval);
+
+    void checkExternalChanges();
+
+    /**
+     * Allow the maintenance of the database while the indexer is idle and playback is not stalled
+     *
+     * After a minute without new or removed tracks, the statistics of the query planner are updated,
+     * free pages are reclaimed and the small tables are checked, in steps of a few milliseconds separated
+     * by the other requests. The tables not checked within a short budget are checked by the next
+     * maintenance. It only runs when tracks changed since the last maintenance.
+     */
+    void setMaintenanceAllowed(bool allowed);
+
+    /**
+     * Run now all the maintenance steps
+     *
+     * Unlike the maintenance run while idle, all the tables, even the large ones, are checked at once and
+     * a database created without the incremental vacuum is rebuilt if little data is left. clearData()
+     * also rebuilds such a database once it is empty.
+     */
+    void runMaintenance();
+
+    /**
+     * File of the LibrarySnapshot written at the end of the maintenance and when the application quits
+     */
+    void setLibrarySnapshotFileName(const QString &fileName);
+
+    /**
+     * Write the albums and artists to the snapshot file if they may have changed since it was written
+     */
+    void writeLibrarySnapshot();
+
+    /**
+     * Record the latency, rows and plan of each statement, in the thread of the database
+     *
+     * The rows of a select are all fetched by its execution to be counted.
+     */
+    void setStatementProfiling(bool enabled);
+
+    /**
+     * Prepare now all the statements instead of on their first use or in the background after startup
+     *
+     * @return false if one of them does not compile, databaseError is then emitted for each of them
+     */
+    bool prepareAllStatements();
+
+private Q_SLOTS:
+
+    void prepareNextStatements();
+
+    void runMaintenanceStep();
+
+    void commitPendingWrites();
+
 private:
 
     enum class DatabaseState {
@@ -169,9 +312,14 @@ private:
         BadState,
     };
 
+    enum class ConnectionMode {
+        ReadWrite,
+        ReadOnly,
+    };
+
     /********* Init and upgrade methods *********/
 
-    void initConnection(const QString &connectionName, const QString &databaseFileName);
+    void initConnection(const QString &connectionName, const QString &databaseFileName, ConnectionMode mode = ConnectionMode::ReadWrite);
 
     bool initDatabase();
 
@@ -193,6 +341,14 @@ private:
 
     void upgradeDatabaseV17();
 
+    void upgradeDatabaseV18();
+
+    void upgradeDatabaseV19();
+
+    void upgradeDatabaseV20();
+
+    void upgradeDatabaseV21();
+
     [[nodiscard]] DatabaseState checkDatabaseSchema() const;
 
     [[nodiscard]] DatabaseState checkTable(const QString &tableName, const QStringList &expectedColumns) const;
@@ -217,18 +373,32 @@ private:
 
     bool startTransaction();
 
+    bool startWriteTransaction();
+
     bool finishTransaction();
 
     bool rollBackTransaction();
 
-    bool prepareQuery(QSqlQuery &query, const QString &queryText) const;
+    void prepareQuery(DatabaseStatement &query, const QString &queryText, const QString &statementName) const;
+
+    bool prepareStatement(DatabaseStatement &statement);
 
-    bool execQuery(QSqlQuery &query);
+    bool execQuery(DatabaseStatement &query);
+
+    bool profiledExecQuery(QSqlQuery &query);
+
+    QStringList internalQueryPlan(const QSqlQuery &query);
+
+    void transactionFinished();
+
+    bool execAndFinishQuery(DatabaseStatement &query);
 
     void initDataQueries();
 
     void initChangesTrackers();
 
+    void notifyTrackedChanges();
+
     void recordModifiedTrack(qulonglong trackId);
 
     void recordModifiedAlbum(qulonglong albumId);
@@ -254,8 +424,6 @@ private:
 
     DataTypes::ListTrackDataType internalTracksFromGenre(const QString &genre);
 
-    QList<qulonglong> internalAlbumIdsFromAuthor(const QString &artistName);
-
     qulonglong insertAlbum(const QString &title, const QString &albumArtist,
                            const QString &trackPath, const QUrl &albumArtURI);
 
@@ -268,8 +436,6 @@ private:
 
     qulonglong insertGenre(const QString &name);
 
-    void removeTrackInDatabase(qulonglong trackId);
-
     void updateTrackInDatabase(const DataTypes::TrackDataType &oneTrack, const QString &albumPath);
 
     void removeAlbumInDatabase(qulonglong albumId);
@@ -278,7 +444,31 @@ private:
 
     void reloadExistingDatabase();
 
-    qulonglong genericInitialId(QSqlQuery &request);
+    void internalReloadInitialIds();
+
+    qulonglong internalGenericInitialId(DatabaseStatement &request);
+
+    void scheduleMaintenance();
+
+    void internalMaintenanceStep();
+
+    qlonglong internalPragmaValue(const QString &pragmaName);
+
+    void internalMaintenanceOptimize();
+
+    bool internalMaintenanceVacuum();
+
+    void internalMaintenanceEnableIncrementalVacuum();
+
+    bool internalMaintenanceIntegrityCheck();
+
+    QStringList internalMaintenanceCheckedTables();
+
+    QSet<QString> internalMaintenanceSmallTables();
+
+    qlonglong internalDataVersion();
+
+    void internalCollectExternalChanges();
 
     void insertTrackOrigin(const QUrl &fileNameURI, const QDateTime &fileModifiedTime, const QDateTime &importDate);
 
@@ -305,11 +495,13 @@ private:
 
     QHash<QUrl, QDateTime> internalAllFileName();
 
-    bool internalGenericPartialData(QSqlQuery &query);
+    bool internalGenericPartialData(DatabaseStatement &query);
+
+    [[nodiscard]] bool internalIsLoadCancelled(qsizetype loadedRowsCount) const;
 
-    DataTypes::ListArtistDataType internalAllArtistsPartialData(QSqlQuery &artistsQuery);
+    DataTypes::ListArtistDataType internalAllArtistsPartialData(DatabaseStatement &artistsQuery);
 
-    DataTypes::ListAlbumDataType internalAllAlbumsPartialData(QSqlQuery &query);
+    DataTypes::ListAlbumDataType internalAllAlbumsPartialData(DatabaseStatement &query);
 
     DataTypes::ListTrackDataType internalOneAlbumData(qulonglong databaseId);
 
@@ -317,6 +509,18 @@ private:
 
     DataTypes::ArtistDataType internalOneArtistPartialData(qulonglong databaseId);
 
+    [[nodiscard]] DataTypes::AlbumDataType buildAlbumDataFromDatabaseRecord(const QSqlRecord &albumRecord) const;
+
+    [[nodiscard]] DataTypes::ArtistDataType buildArtistDataFromDatabaseRecord(const QSqlRecord &artistRecord);
+
+    bool internalFillNotifiedIds(const QSet<qulonglong> &ids);
+
+    QHash<qulonglong, DataTypes::TrackDataType> internalNotifiedTracksPartialData(const QSet<qulonglong> &tracksIds);
+
+    QHash<qulonglong, DataTypes::AlbumDataType> internalNotifiedAlbumsPartialData(const QSet<qulonglong> &albumsIds);
+
+    QHash<qulonglong, DataTypes::ArtistDataType> internalNotifiedArtistsPartialData(const QSet<qulonglong> &artistsIds);
+
     DataTypes::ListTrackDataType internalAllTracksPartialData();
 
     DataTypes::ListRadioDataType internalAllRadiosPartialData();
@@ -325,6 +529,17 @@ private:
 
     DataTypes::ListTrackDataType internalFrequentlyPlayedTracksData(int count);
 
+    DataTypes::ListMusicDataType internalLibrarySearch(const QString &searchText, int maximumCount, int offset);
+
+    DataTypes::ListTrackDataType internalTracksDataPage(DataTypes::ColumnsRoles sortRole, Qt::SortOrder sortOrder,
+                                                        const QVariant &afterSortValue, qulonglong afterDatabaseId, int count);
+
+    [[nodiscard]] static int tracksPageQueryKey(DataTypes::ColumnsRoles sortRole, Qt::SortOrder sortOrder);
+
+    [[nodiscard]] static QString trackSortExpression(DataTypes::ColumnsRoles sortRole);
+
+    [[nodiscard]] static QString librarySearchPattern(const QString &searchText);
+
     DataTypes::TrackDataType internalOneTrackPartialData(qulonglong databaseId);
 
     DataTypes::TrackDataType internalOneTrackPartialDataByIdAndUrl(qulonglong databaseId, const QUrl &trackUrl);
@@ -346,7 +561,15 @@ private:
 
     void updateTrackStartedStatistics(const QUrl &fileName, const QDateTime &time);
 
-    void updateTrackFinishedStatistics(const QUrl &fileName, const QDateTime &time);
+    void updateTrackFinishedStatistics(const QUrl &fileName, const QDateTime &time, int playCount);
+
+    void pendingWriteQueued();
+
+    void schedulePendingWrites();
+
+    [[nodiscard]] bool hasPendingWritesDue();
+
+    bool internalRemoveRadio(qulonglong radioId);
 
     void internalInsertOneTrack(const DataTypes::TrackDataType &oneTrack, const QHash<QString, QUrl> &covers);
 
@@ -354,6 +577,9 @@ private:
 
     std::unique_ptr<DatabaseInterfacePrivate> d;
 
+    // written from any thread, it does not depend on the connection rebuilt by resetDatabase
+    std::unique_ptr<DatabaseInterfacePendingWrites> mPendingWrites;
+
 };
 
 #endif // DATABASEINTERFACE_H
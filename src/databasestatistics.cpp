@@ -0,0 +1,279 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "databasestatistics.h"
+
+#include "databaseStatisticsLogging.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QHash>
+#include <QJsonArray>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+double milliseconds(qint64 durationNs)
+{
+    return static_cast<double>(durationNs) / 1e6;
+}
+
+}
+
+class DatabaseStatisticsPrivate
+{
+public:
+
+    struct StatementRecord {
+        DatabaseStatistics::Statement mStatement;
+
+        // the latest durations, older ones are overwritten
+        QList<qint64> mRecentDurations;
+
+        qsizetype mNextDuration = 0;
+
+        // set even when the plan cannot be explained, it is captured only once
+        bool mIsQueryPlanKnown = false;
+    };
+
+    struct TransactionsRecord {
+        qint64 mCount = 0;
+
+        qint64 mTotalNs = 0;
+
+        qint64 mMaximumNs = 0;
+    };
+
+    static constexpr qsizetype RecentDurationsCount = 1024;
+
+    static qint64 percentile(const QList<qint64> &sortedValues, double percentile)
+    {
+        if (sortedValues.isEmpty()) {
+            return 0;
+        }
+
+        // nearest rank
+        const auto rank = static_cast<qsizetype>(std::ceil(percentile * static_cast<double>(sortedValues.size()) / 100.));
+
+        return sortedValues[std::clamp<qsizetype>(rank - 1, 0, sortedValues.size() - 1)];
+    }
+
+    static DatabaseStatistics::Statement statement(const StatementRecord &record)
+    {
+        auto result = record.mStatement;
+
+        auto sortedDurations = record.mRecentDurations;
+        std::sort(sortedDurations.begin(), sortedDurations.end());
+
+        result.mP50Ns = percentile(sortedDurations, 50);
+        result.mP90Ns = percentile(sortedDurations, 90);
+        result.mP99Ns = percentile(sortedDurations, 99);
+
+        return result;
+    }
+
+    static QJsonObject transactionsToJson(const TransactionsRecord &record)
+    {
+        return {
+            {QStringLiteral("count"), record.mCount},
+            {QStringLiteral("totalMs"), milliseconds(record.mTotalNs)},
+            {QStringLiteral("maxMs"), milliseconds(record.mMaximumNs)},
+        };
+    }
+
+    mutable QMutex mMutex;
+
+    QHash<QString, StatementRecord> mStatements;
+
+    TransactionsRecord mReadTransactions;
+
+    TransactionsRecord mWriteTransactions;
+
+};
+
+DatabaseStatistics::DatabaseStatistics() : d(std::make_unique<DatabaseStatisticsPrivate>())
+{
+}
+
+DatabaseStatistics::~DatabaseStatistics() = default;
+
+void DatabaseStatistics::addExecution(const QString &name, const QString &queryText, qint64 durationNs, qint64 rowsCount, bool isInTransaction)
+{
+    QMutexLocker locker(&d->mMutex);
+
+    auto &record = d->mStatements[name];
+    auto &statement = record.mStatement;
+
+    if (statement.mName.isEmpty()) {
+        statement.mName = name;
+        statement.mQueryText = queryText;
+        record.mRecentDurations.reserve(DatabaseStatisticsPrivate::RecentDurationsCount);
+    }
+
+    ++statement.mExecutionsCount;
+    statement.mTotalNs += durationNs;
+    statement.mMaximumNs = std::max(statement.mMaximumNs, durationNs);
+
+    if (rowsCount > 0) {
+        statement.mRowsCount += rowsCount;
+    }
+
+    if (isInTransaction) {
+        statement.mInTransactionNs += durationNs;
+    }
+
+    if (record.mRecentDurations.size() < DatabaseStatisticsPrivate::RecentDurationsCount) {
+        record.mRecentDurations.push_back(durationNs);
+    } else {
+        record.mRecentDurations[record.mNextDuration] = durationNs;
+        record.mNextDuration = (record.mNextDuration + 1) % DatabaseStatisticsPrivate::RecentDurationsCount;
+    }
+}
+
+void DatabaseStatistics::addTransaction(qint64 durationNs, bool isWriteTransaction)
+{
+    QMutexLocker locker(&d->mMutex);
+
+    auto &record = isWriteTransaction ? d->mWriteTransactions : d->mReadTransactions;
+
+    ++record.mCount;
+    record.mTotalNs += durationNs;
+    record.mMaximumNs = std::max(record.mMaximumNs, durationNs);
+}
+
+bool DatabaseStatistics::hasQueryPlan(const QString &name) const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    const auto itRecord = d->mStatements.constFind(name);
+
+    return itRecord != d->mStatements.cend() && itRecord->mIsQueryPlanKnown;
+}
+
+void DatabaseStatistics::setQueryPlan(const QString &name, const QStringList &queryPlan)
+{
+    QMutexLocker locker(&d->mMutex);
+
+    auto &record = d->mStatements[name];
+    auto &statement = record.mStatement;
+
+    record.mIsQueryPlanKnown = true;
+    statement.mQueryPlan = queryPlan;
+    statement.mHasFullScan = std::any_of(queryPlan.cbegin(), queryPlan.cend(), [](const auto &oneLine) {
+        return isFullScan(oneLine);
+    });
+}
+
+bool DatabaseStatistics::isFullScan(const QString &queryPlanLine)
+{
+    // "SCAN Tracks" or "SCAN TABLE Tracks" for older SQLite, an index scan names its index
+    const auto line = queryPlanLine.trimmed();
+
+    return line.startsWith(QLatin1String("SCAN ")) &&
+            !line.contains(QLatin1String(" INDEX")) &&
+            !line.contains(QLatin1String("SUBQUERY")) &&
+            !line.contains(QLatin1String("CONSTANT ROW"));
+}
+
+DatabaseStatistics::Statement DatabaseStatistics::statement(const QString &name) const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    const auto itRecord = d->mStatements.constFind(name);
+    if (itRecord == d->mStatements.cend()) {
+        return {};
+    }
+
+    return DatabaseStatisticsPrivate::statement(*itRecord);
+}
+
+QList<DatabaseStatistics::Statement> DatabaseStatistics::statements() const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    auto result = QList<Statement>{};
+    result.reserve(d->mStatements.size());
+
+    for (const auto &oneRecord : std::as_const(d->mStatements)) {
+        result.push_back(DatabaseStatisticsPrivate::statement(oneRecord));
+    }
+
+    std::sort(result.begin(), result.end(), [](const auto &left, const auto &right) {
+        return left.mTotalNs > right.mTotalNs;
+    });
+
+    return result;
+}
+
+QJsonObject DatabaseStatistics::toJson() const
+{
+    const auto allStatements = statements();
+
+    auto statementsArray = QJsonArray{};
+    for (const auto &oneStatement : allStatements) {
+        statementsArray.push_back(QJsonObject{
+            {QStringLiteral("name"), oneStatement.mName},
+            {QStringLiteral("executions"), oneStatement.mExecutionsCount},
+            {QStringLiteral("totalMs"), milliseconds(oneStatement.mTotalNs)},
+            {QStringLiteral("inTransactionMs"), milliseconds(oneStatement.mInTransactionNs)},
+            {QStringLiteral("p50Ms"), milliseconds(oneStatement.mP50Ns)},
+            {QStringLiteral("p90Ms"), milliseconds(oneStatement.mP90Ns)},
+            {QStringLiteral("p99Ms"), milliseconds(oneStatement.mP99Ns)},
+            {QStringLiteral("maxMs"), milliseconds(oneStatement.mMaximumNs)},
+            {QStringLiteral("rows"), oneStatement.mRowsCount},
+            {QStringLiteral("fullScan"), oneStatement.mHasFullScan},
+            {QStringLiteral("queryPlan"), QJsonArray::fromStringList(oneStatement.mQueryPlan)},
+        });
+    }
+
+    QMutexLocker locker(&d->mMutex);
+
+    return {
+        {QStringLiteral("statements"), statementsArray},
+        {QStringLiteral("readTransactions"), DatabaseStatisticsPrivate::transactionsToJson(d->mReadTransactions)},
+        {QStringLiteral("writeTransactions"), DatabaseStatisticsPrivate::transactionsToJson(d->mWriteTransactions)},
+    };
+}
+
+void DatabaseStatistics::dump() const
+{
+    const auto allStatements = statements();
+
+    for (const auto &oneStatement : allStatements) {
+        qCInfo(orgKdeElisaDatabaseStatistics) << oneStatement.mName
+                                              << "executions" << oneStatement.mExecutionsCount
+                                              << "total ms" << milliseconds(oneStatement.mTotalNs)
+                                              << "in transaction ms" << milliseconds(oneStatement.mInTransactionNs)
+                                              << "p50/p90/p99/max ms" << milliseconds(oneStatement.mP50Ns)
+                                              << milliseconds(oneStatement.mP90Ns) << milliseconds(oneStatement.mP99Ns)
+                                              << milliseconds(oneStatement.mMaximumNs)
+                                              << "rows" << oneStatement.mRowsCount;
+
+        if (oneStatement.mHasFullScan) {
+            qCInfo(orgKdeElisaDatabaseStatistics) << oneStatement.mName << "full scan" << oneStatement.mQueryPlan;
+        }
+    }
+
+    QMutexLocker locker(&d->mMutex);
+
+    qCInfo(orgKdeElisaDatabaseStatistics) << "read transactions" << d->mReadTransactions.mCount
+                                          << "total ms" << milliseconds(d->mReadTransactions.mTotalNs)
+                                          << "max ms" << milliseconds(d->mReadTransactions.mMaximumNs);
+    qCInfo(orgKdeElisaDatabaseStatistics) << "write transactions" << d->mWriteTransactions.mCount
+                                          << "total ms" << milliseconds(d->mWriteTransactions.mTotalNs)
+                                          << "max ms" << milliseconds(d->mWriteTransactions.mMaximumNs);
+}
+
+void DatabaseStatistics::clear()
+{
+    QMutexLocker locker(&d->mMutex);
+
+    d->mStatements.clear();
+    d->mReadTransactions = {};
+    d->mWriteTransactions = {};
+}
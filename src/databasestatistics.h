@@ -0,0 +1,98 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef DATABASESTATISTICS_H
+#define DATABASESTATISTICS_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QJsonObject>
+
+#include <memory>
+
+class DatabaseStatisticsPrivate;
+
+/**
+ * Execution statistics of the statements of a DatabaseInterface, keyed by statement name
+ *
+ * The statistics are written by the thread of the database and can be read from any thread.
+ */
+class ELISALIB_EXPORT DatabaseStatistics
+{
+public:
+
+    struct Statement {
+        QString mName;
+
+        QString mQueryText;
+
+        qint64 mExecutionsCount = 0;
+
+        qint64 mTotalNs = 0;
+
+        qint64 mInTransactionNs = 0;
+
+        qint64 mP50Ns = 0;
+
+        qint64 mP90Ns = 0;
+
+        qint64 mP99Ns = 0;
+
+        qint64 mMaximumNs = 0;
+
+        qint64 mRowsCount = 0;
+
+        QStringList mQueryPlan;
+
+        bool mHasFullScan = false;
+    };
+
+    DatabaseStatistics();
+
+    ~DatabaseStatistics();
+
+    void addExecution(const QString &name, const QString &queryText, qint64 durationNs, qint64 rowsCount, bool isInTransaction);
+
+    void addTransaction(qint64 durationNs, bool isWriteTransaction);
+
+    [[nodiscard]] bool hasQueryPlan(const QString &name) const;
+
+    /**
+     * Keep the lines of EXPLAIN QUERY PLAN, a line scanning a whole table flags a full scan
+     */
+    void setQueryPlan(const QString &name, const QStringList &queryPlan);
+
+    [[nodiscard]] static bool isFullScan(const QString &queryPlanLine);
+
+    /**
+     * Statistics of one statement, the percentiles are computed on its latest executions
+     */
+    [[nodiscard]] Statement statement(const QString &name) const;
+
+    /**
+     * All the statements, the ones with the largest total time first
+     */
+    [[nodiscard]] QList<Statement> statements() const;
+
+    [[nodiscard]] QJsonObject toJson() const;
+
+    /**
+     * Log the statistics of all statements in the org.kde.elisa.database.statistics category
+     */
+    void dump() const;
+
+    void clear();
+
+private:
+
+    std::unique_ptr<DatabaseStatisticsPrivate> d;
+
+};
+
+#endif // DATABASESTATISTICS_H
@@ -111,6 +111,8 @@ public:
         }
     };
 
+    using ListMusicDataType = QList<MusicDataType>;
+
     class TrackDataType : public MusicDataType
     {
     public:
@@ -440,6 +442,7 @@ Q_DECLARE_METATYPE(DataTypes::AlbumDataType)
 Q_DECLARE_METATYPE(DataTypes::ArtistDataType)
 Q_DECLARE_METATYPE(DataTypes::GenreDataType)
 
+Q_DECLARE_METATYPE(DataTypes::ListMusicDataType)
 Q_DECLARE_METATYPE(DataTypes::ListTrackDataType)
 Q_DECLARE_METATYPE(DataTypes::ListAlbumDataType)
 Q_DECLARE_METATYPE(DataTypes::ListArtistDataType)
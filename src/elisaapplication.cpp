@@ -427,11 +427,14 @@ void ElisaApplication::initializePlayer()
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::sourceInError, d->mMediaPlayListProxyModel.get(), &MediaPlayListProxyModel::trackInError);
 
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::sourceInError, d->mMusicManager.get(), &MusicListenersManager::playBackError);
+    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerStatusChanged, d->mMusicManager.get(), [this]() {
+        d->mMusicManager->playerMediaStatusChanged(d->mAudioControl->playerStatus());
+    });
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerSourceChanged, d->mAudioWrapper.get(), &AudioWrapper::setSource);
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::startedPlayingTrack,
-                     d->mMusicManager->viewDatabase(), &DatabaseInterface::trackHasStartedPlaying);
+                     d->mMusicManager->viewDatabase(), &DatabaseInterface::trackHasStartedPlaying, Qt::DirectConnection);
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::finishedPlayingTrack,
-                     d->mMusicManager->viewDatabase(), &DatabaseInterface::trackHasFinishedPlaying);
+                     d->mMusicManager->viewDatabase(), &DatabaseInterface::trackHasFinishedPlaying, Qt::DirectConnection);
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::updateData, d->mMediaPlayList.get(), &MediaPlayList::setData);
 
     QObject::connect(d->mMediaPlayListProxyModel.get(), &MediaPlayListProxyModel::ensurePlay, d->mAudioControl.get(), &ManageAudioPlayer::ensurePlay);
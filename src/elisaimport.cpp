@@ -6,13 +6,17 @@
 
 #include "config-upnp-qt.h"
 
-#include "musiclistenersmanager.h"
 #include "elisaimportapplication.h"
 #include "elisa_settings.h"
+#include "datatypes.h"
 
 #include <QCoreApplication>
 #include <QCommandLineParser>
 #include <QStandardPaths>
+#include <QFileInfo>
+#include <QDir>
+#include <QUrl>
+#include <QDebug>
 
 int main(int argc, char *argv[])
 {
@@ -27,8 +31,36 @@ int main(int argc, char *argv[])
     qRegisterMetaType<DataTypes::ListTrackDataType>("DataTypes::ListTrackDataType");
 
     QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Index music files into the Elisa database without user interface. "
+                                                    "Tracks outside of the music directories are removed from the database. "
+                                                    "Exit codes: 0 on success, 1 for invalid arguments, 2 for database errors "
+                                                    "and 3 when a music directory cannot be read."));
     parser.addHelpOption();
     parser.addVersionOption();
+
+    const QCommandLineOption databaseOption(QStringLiteral("database"),
+                                            QStringLiteral("Database file to create or update instead of the one of Elisa."),
+                                            QStringLiteral("file"));
+    parser.addOption(databaseOption);
+
+    const QCommandLineOption workersOption(QStringLiteral("workers"),
+                                           QStringLiteral("Number of threads extracting metadata, one per core when 0."),
+                                           QStringLiteral("count"));
+    parser.addOption(workersOption);
+
+    const QCommandLineOption batchSizeOption(QStringLiteral("batch-size"),
+                                             QStringLiteral("Maximum number of tracks inserted in the database at once."),
+                                             QStringLiteral("count"), QStringLiteral("50"));
+    parser.addOption(batchSizeOption);
+
+    const QCommandLineOption statsOption(QStringLiteral("stats"),
+                                         QStringLiteral("Print the throughput and timings of the indexing and of each database statement as JSON."));
+    parser.addOption(statsOption);
+
+    parser.addPositionalArgument(QStringLiteral("directories"),
+                                 QStringLiteral("Music directories to index instead of the configured ones."),
+                                 QStringLiteral("[directories...]"));
+
     parser.process(app);
 
     auto configurationFileName = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation);
@@ -37,12 +69,68 @@ int main(int argc, char *argv[])
     Elisa::ElisaConfiguration::self()->load();
     Elisa::ElisaConfiguration::self()->save();
 
-    MusicListenersManager myMusicManager;
-    ElisaImportApplication myApplication;
+    ElisaImportApplication::Options options;
+
+    const auto readCount = [&parser](const QCommandLineOption &option, int minimumValue, int &value) {
+        if (!parser.isSet(option)) {
+            return true;
+        }
+
+        auto isValid = false;
+        value = parser.value(option).toInt(&isValid);
+
+        if (!isValid || value < minimumValue) {
+            qCritical() << "invalid value for" << option.names().constFirst() << parser.value(option);
+            return false;
+        }
+
+        return true;
+    };
+
+    options.workerCount = Elisa::ElisaConfiguration::extractionWorkerCount();
 
-    QObject::connect(&myMusicManager, &MusicListenersManager::indexerBusyChanged,
-            &myApplication, &ElisaImportApplication::indexingChanged);
+    if (!readCount(workersOption, 0, options.workerCount) || !readCount(batchSizeOption, 1, options.batchSize)) {
+        return ElisaImportApplication::InvalidArguments;
+    }
+
+    // only for this run: the configuration file is not modified
+    Elisa::ElisaConfiguration::setExtractionWorkerCount(options.workerCount);
+
+    options.rootPaths = parser.positionalArguments();
+    if (options.rootPaths.isEmpty()) {
+        options.rootPaths = Elisa::ElisaConfiguration::rootPath();
+    }
+
+    for (auto &onePath : options.rootPaths) {
+        if (onePath.startsWith(QLatin1String("file:/"))) {
+            onePath = QUrl{onePath}.toLocalFile();
+        }
+    }
+
+    if (parser.isSet(databaseOption)) {
+        options.databaseFileName = QFileInfo(parser.value(databaseOption)).absoluteFilePath();
+    } else {
+        const auto &localDataPaths = QStandardPaths::standardLocations(QStandardPaths::AppDataLocation);
+        if (!localDataPaths.isEmpty()) {
+            QDir().mkpath(localDataPaths.first());
+            options.databaseFileName = localDataPaths.first() + QStringLiteral("/elisaDatabase.db");
+            options.directoryFingerprintsFileName = localDataPaths.first() + QStringLiteral("/elisaDirectoryFingerprints.cache");
+        }
+    }
+
+    if (options.databaseFileName.isEmpty()) {
+        qCritical() << "no database file to write";
+        return ElisaImportApplication::InvalidArguments;
+    }
+
+    options.printStatistics = parser.isSet(statsOption);
+
+    ElisaImportApplication myApplication(options);
+
+    QObject::connect(&myApplication, &ElisaImportApplication::finished,
+                     &app, &QCoreApplication::exit, Qt::QueuedConnection);
+
+    myApplication.start();
 
     return app.exec();
 }
-
@@ -6,20 +6,213 @@
 
 #include "elisaimportapplication.h"
 
+#include "databaseinterface.h"
+#include "databasestatistics.h"
+#include "file/localfilelisting.h"
+#include "abstractfile/indexerstatistics.h"
+#include "abstractfile/filescanpipeline.h"
+
 #include <QCoreApplication>
+#include <QThread>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QDebug>
+
+#include <cstdio>
+
+class ElisaImportApplicationPrivate
+{
+public:
+
+    explicit ElisaImportApplicationPrivate(const ElisaImportApplication::Options &options) : mOptions(options)
+    {
+    }
+
+    ElisaImportApplication::Options mOptions;
+
+    QThread mDatabaseThread;
+
+    QThread mListingThread;
+
+    DatabaseInterface mDatabaseInterface;
+
+    LocalFileListing mFileListing;
+
+    IndexerStatistics mStatistics;
+
+    QStringList mRootPaths;
+
+    bool mHasMissingRootPath = false;
+
+    bool mIsStarted = false;
+
+    bool mIsFinished = false;
+
+};
 
-ElisaImportApplication::ElisaImportApplication(QObject *parent) : QObject(parent)
+ElisaImportApplication::ElisaImportApplication(const Options &options, QObject *parent)
+    : QObject(parent), d(std::make_unique<ElisaImportApplicationPrivate>(options))
 {
+    auto *databaseInterface = &d->mDatabaseInterface;
+    auto *statistics = &d->mStatistics;
+
+    d->mFileListing.setStatistics(statistics);
+    d->mFileListing.setDirectoryFingerprintsFileName(d->mOptions.directoryFingerprintsFileName);
+    d->mFileListing.setMaximumNewFilesBatchSize(d->mOptions.batchSize);
+
+    connect(databaseInterface, &DatabaseInterface::requestsInitDone,
+            this, &ElisaImportApplication::databaseReady);
+    connect(databaseInterface, &DatabaseInterface::databaseError,
+            this, &ElisaImportApplication::databaseError);
+
+    // executed on the database thread to measure the insertion of each batch
+    const auto timedInsertion = [databaseInterface, statistics](const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers) {
+        QElapsedTimer insertionTimer;
+        insertionTimer.start();
+
+        databaseInterface->insertTracksList(tracks, covers);
+
+        statistics->addDatabaseBatch(static_cast<int>(tracks.size()), insertionTimer.nsecsElapsed());
+    };
+
+    connect(&d->mFileListing, &AbstractFileListing::tracksList, databaseInterface, timedInsertion);
+    connect(&d->mFileListing, &AbstractFileListing::modifyTracksList, databaseInterface, timedInsertion);
+    connect(&d->mFileListing, &AbstractFileListing::removedTracksList,
+            databaseInterface, &DatabaseInterface::removeTracksList);
+    connect(databaseInterface, &DatabaseInterface::restoredTracks,
+            &d->mFileListing, &AbstractFileListing::setIndexedTracks);
+    connect(databaseInterface, &DatabaseInterface::finishRemovingTracksList,
+            &d->mFileListing, &AbstractFileListing::databaseFinishedRemovingTracksList);
+    connect(databaseInterface, &DatabaseInterface::finishInsertingTracksList,
+            &d->mFileListing, &AbstractFileListing::databaseFinishedInsertingTracksList);
+    connect(&d->mFileListing, &AbstractFileListing::indexingFinished,
+            this, &ElisaImportApplication::indexingFinished);
+
+    d->mDatabaseThread.start();
+    d->mListingThread.start();
+
+    d->mDatabaseInterface.moveToThread(&d->mDatabaseThread);
+    d->mFileListing.moveToThread(&d->mListingThread);
 }
 
-void ElisaImportApplication::indexingChanged()
+ElisaImportApplication::~ElisaImportApplication()
 {
-    static bool firstCall = true;
+    d->mFileListing.applicationAboutToQuit();
+    d->mDatabaseInterface.applicationAboutToQuit();
+
+    d->mListingThread.quit();
+    d->mListingThread.wait();
+
+    d->mDatabaseThread.quit();
+    d->mDatabaseThread.wait();
+}
+
+void ElisaImportApplication::start()
+{
+    for (const auto &onePath : std::as_const(d->mOptions.rootPaths)) {
+        const auto pathInfo = QFileInfo(onePath);
+        auto directoryPath = pathInfo.canonicalFilePath();
+
+        if (directoryPath.isEmpty() || !pathInfo.isDir() || !pathInfo.isReadable()) {
+            qCritical() << "ElisaImportApplication::start" << onePath << "is not a readable directory";
+            d->mHasMissingRootPath = true;
+            continue;
+        }
+
+        if (!directoryPath.endsWith(QLatin1Char('/'))) {
+            directoryPath.append(QLatin1Char('/'));
+        }
+
+        d->mRootPaths.push_back(directoryPath);
+    }
+
+    if (d->mRootPaths.isEmpty()) {
+        qCritical() << "ElisaImportApplication::start" << "no music directory to index";
+        Q_EMIT finished(MissingRootPath);
+        return;
+    }
+
+    d->mStatistics.start();
+
+    QMetaObject::invokeMethod(&d->mDatabaseInterface, "init", Qt::QueuedConnection,
+                              Q_ARG(QString, QStringLiteral("listeners")), Q_ARG(QString, d->mOptions.databaseFileName));
+}
+
+void ElisaImportApplication::databaseReady()
+{
+    if (d->mIsStarted) {
+        return;
+    }
+
+    d->mIsStarted = true;
+
+    if (d->mStatistics.errorsCount() > 0) {
+        databaseFlushed();
+        return;
+    }
+
+    if (d->mOptions.printStatistics) {
+        QMetaObject::invokeMethod(&d->mDatabaseInterface, "setStatementProfiling", Qt::QueuedConnection,
+                                  Q_ARG(bool, true));
+    }
+
+    d->mFileListing.setAllRootPaths(d->mRootPaths);
+
+    QMetaObject::invokeMethod(&d->mFileListing, "init", Qt::QueuedConnection);
+
+    // the scan starts once the tracks already in the database are known, whatever the scan at startup setting
+    QMetaObject::invokeMethod(&d->mDatabaseInterface, "askRestoredTracks", Qt::QueuedConnection);
+}
+
+void ElisaImportApplication::databaseError()
+{
+    qCritical() << "ElisaImportApplication::databaseError" << d->mOptions.databaseFileName;
+
+    d->mStatistics.addError();
+}
+
+void ElisaImportApplication::indexingFinished()
+{
+    // the last batches of tracks may still wait in the queue of the database thread
+    QMetaObject::invokeMethod(&d->mDatabaseInterface, [this]() {
+        QMetaObject::invokeMethod(this, &ElisaImportApplication::databaseFlushed, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+void ElisaImportApplication::databaseFlushed()
+{
+    if (d->mIsFinished) {
+        return;
+    }
+
+    d->mIsFinished = true;
+    d->mStatistics.stop();
+
+    if (d->mOptions.printStatistics) {
+        auto allStatistics = d->mStatistics.toJson();
+
+        allStatistics.insert(QStringLiteral("databaseFileName"), d->mOptions.databaseFileName);
+        allStatistics.insert(QStringLiteral("rootPaths"), QJsonArray::fromStringList(d->mRootPaths));
+        allStatistics.insert(QStringLiteral("workers"), FileScanPipeline::effectiveWorkerCount(d->mOptions.workerCount));
+        allStatistics.insert(QStringLiteral("batchSize"), d->mOptions.batchSize);
+
+        if (const auto statementStatistics = d->mDatabaseInterface.statementStatistics()) {
+            allStatistics.insert(QStringLiteral("statements"), statementStatistics->toJson());
+        }
+
+        const auto output = QJsonDocument(allStatistics).toJson(QJsonDocument::Indented);
+        std::fwrite(output.constData(), 1, static_cast<size_t>(output.size()), stdout);
+        std::fflush(stdout);
+    }
 
-    if (firstCall) {
-        firstCall = false;
+    if (d->mStatistics.errorsCount() > 0) {
+        Q_EMIT finished(DatabaseError);
+    } else if (d->mHasMissingRootPath) {
+        Q_EMIT finished(MissingRootPath);
     } else {
-        QCoreApplication::quit();
+        Q_EMIT finished(Success);
     }
 }
 
@@ -8,18 +8,64 @@
 #define ELISAIMPORTAPPLICATION_H
 
 #include <QObject>
+#include <QString>
+#include <QStringList>
 
+#include <memory>
+
+class ElisaImportApplicationPrivate;
+
+/**
+ * Index music files into a database without user interface
+ *
+ * The indexing stops once the root paths were scanned and all the tracks are in the database.
+ */
 class ElisaImportApplication : public QObject
 {
     Q_OBJECT
 public:
-    explicit ElisaImportApplication(QObject *parent = nullptr);
+
+    enum ExitCode {
+        Success = 0,
+        InvalidArguments = 1,
+        DatabaseError = 2,
+        MissingRootPath = 3,
+    };
+
+    Q_ENUM(ExitCode)
+
+    struct Options {
+        QString databaseFileName;
+        QString directoryFingerprintsFileName;
+        QStringList rootPaths;
+        int workerCount = 0;
+        int batchSize = 50;
+        bool printStatistics = false;
+    };
+
+    explicit ElisaImportApplication(const Options &options, QObject *parent = nullptr);
+
+    ~ElisaImportApplication() override;
+
+    void start();
 
 Q_SIGNALS:
 
-public Q_SLOTS:
+    void finished(int exitCode);
+
+private Q_SLOTS:
+
+    void databaseReady();
+
+    void databaseError();
+
+    void indexingFinished();
+
+    void databaseFlushed();
+
+private:
 
-    void indexingChanged();
+    std::unique_ptr<ElisaImportApplicationPrivate> d;
 
 };
 
@@ -8,6 +8,7 @@
 
 #include "filescanner.h"
 #include "abstractfile/indexercommon.h"
+#include "elisa_settings.h"
 
 #include <QThread>
 #include <QHash>
@@ -55,11 +56,16 @@ void LocalFileListing::triggerRefreshOfContent()
 
     AbstractFileListing::triggerRefreshOfContent();
 
+    setExtractionWorkerCount(Elisa::ElisaConfiguration::extractionWorkerCount());
+    setFileSystemChangesQuietPeriod(Elisa::ElisaConfiguration::fileSystemChangesQuietPeriod());
+
     const auto &rootPaths = allRootPaths();
     for (const auto &onePath : rootPaths) {
         scanDirectoryTree(onePath);
     }
 
+    saveDirectoryFingerprints();
+
     setWaitEndTrackRemoval(false);
 
     if (!waitEndTrackRemoval()) {
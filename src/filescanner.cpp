@@ -9,6 +9,7 @@
 #include "config-upnp-qt.h"
 
 #include "abstractfile/indexercommon.h"
+#include "nativetagreader.h"
 
 #if KFFileMetaData_FOUND
 
@@ -50,6 +51,10 @@ public:
 
     QMimeDatabase mMimeDb;
 
+    NativeTagReader mNativeTagReader;
+
+    bool mUseNativeTagReader = true;
+
 #if KFFileMetaData_FOUND
     const QHash<KFileMetaData::Property::Property, DataTypes::ColumnsRoles> propertyTranslation = {
         {KFileMetaData::Property::Artist, DataTypes::ColumnsRoles::ArtistRole},
@@ -123,7 +128,6 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile, const QF
     newTrack[DataTypes::RatingRole] = 0;
     newTrack[DataTypes::ElementTypeRole] = ElisaUtils::Track;
 
-#if KFFileMetaData_FOUND
     const auto &localFileName = scanFile.toLocalFile();
 
     const auto &fileMimeType = d->mMimeDb.mimeTypeForFile(localFileName);
@@ -133,6 +137,20 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile, const QF
 
     const auto &mimetype = fileMimeType.name();
 
+    // known from the native tag reader even when the generic extractor has to read the tags
+    auto nativeHasEmbeddedCover = std::optional<bool>{};
+
+    if (d->mUseNativeTagReader) {
+        if (d->mNativeTagReader.readTrack(localFileName, mimetype, newTrack, nativeHasEmbeddedCover)) {
+            addFileProperties(localFileName, nativeHasEmbeddedCover.value_or(false), newTrack);
+
+            qCDebug(orgKdeElisaIndexer()) << "scanOneFile" << scanFile << "using native tag reader" << newTrack;
+
+            return newTrack;
+        }
+    }
+
+#if KFFileMetaData_FOUND
     const QList<KFileMetaData::Extractor*> &exList = d->mAllExtractors.fetchExtractors(mimetype);
 
     if (exList.isEmpty()) {
@@ -150,21 +168,25 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile, const QF
         return newTrack;
     }
 
+    // the pictures are only extracted when the native tag reader could not tell if there is one
+    auto extractionFlags = KFileMetaData::ExtractionResult::Flags{KFileMetaData::ExtractionResult::ExtractMetaData};
+    if (!nativeHasEmbeddedCover) {
+        extractionFlags |= KFileMetaData::ExtractionResult::ExtractImageData;
+    }
+
     KFileMetaData::Extractor* ex = exList.first();
-    KFileMetaData::SimpleExtractionResult result(localFileName, mimetype,
-                                                 KFileMetaData::ExtractionResult::ExtractMetaData);
+    KFileMetaData::SimpleExtractionResult result(localFileName, mimetype, extractionFlags);
 
     ex->extract(&result);
 
     d->mAllProperties = result.properties();
 
-    scanProperties(localFileName, newTrack);
+    const auto hasEmbeddedCover = nativeHasEmbeddedCover.value_or(!result.imageData().isEmpty());
+
+    scanProperties(localFileName, hasEmbeddedCover, newTrack);
 
     qCDebug(orgKdeElisaIndexer()) << "scanOneFile" << scanFile << "using KFileMetaData" << newTrack;
 #else
-    Q_UNUSED(scanFile)
-    Q_UNUSED(scanFileInfo)
-
     qCDebug(orgKdeElisaIndexer()) << "scanOneFile" << scanFile << "no metadata provider" << newTrack;
 #endif
 
@@ -181,7 +203,7 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile)
     }
 }
 
-void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackDataType &trackData)
+void FileScanner::scanProperties(const QString &localFileName, bool hasEmbeddedCover, DataTypes::TrackDataType &trackData)
 {
 #if KFFileMetaData_FOUND
     if (d->mAllProperties.isEmpty()) {
@@ -217,18 +239,28 @@ void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackD
         rangeBegin = rangeEnd;
     }
 
+    addFileProperties(localFileName, hasEmbeddedCover, trackData);
+#else
+    Q_UNUSED(localFileName)
+    Q_UNUSED(hasEmbeddedCover)
+    Q_UNUSED(trackData)
+#endif
+}
+
+void FileScanner::addFileProperties(const QString &localFileName, bool hasEmbeddedCover, DataTypes::TrackDataType &trackData)
+{
     if (!trackData.isValid()) {
         return;
     }
 
-    if (checkEmbeddedCoverImage(localFileName)) {
+    if (hasEmbeddedCover) {
         trackData[DataTypes::HasEmbeddedCover] = true;
         trackData[DataTypes::ImageUrlRole] = QUrl(QLatin1String("image://cover/") + localFileName);
     } else {
         trackData[DataTypes::HasEmbeddedCover] = false;
     }
 
-#if !defined Q_OS_ANDROID && !defined Q_OS_WIN
+#if KFFileMetaData_FOUND && !defined Q_OS_ANDROID && !defined Q_OS_WIN
     const auto fileData = KFileMetaData::UserMetaData(localFileName);
     const auto &comment = fileData.userComment();
     if (!comment.isEmpty()) {
@@ -240,11 +272,11 @@ void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackD
         trackData[DataTypes::RatingRole] = rating;
     }
 #endif
+}
 
-#else
-    Q_UNUSED(localFileName)
-    Q_UNUSED(trackData)
-#endif
+void FileScanner::setNativeTagReaderEnabled(bool enabled)
+{
+    d->mUseNativeTagReader = enabled;
 }
 
 QUrl FileScanner::searchForCoverFile(const QString &localFileName)
@@ -299,24 +331,3 @@ QUrl FileScanner::searchForCoverFile(const QString &localFileName)
 
     return url;
 }
-
-bool FileScanner::checkEmbeddedCoverImage(const QString &localFileName)
-{
-#if KFFileMetaData_FOUND
-    const auto &mimeType = QMimeDatabase().mimeTypeForFile(localFileName).name();
-    const auto extractors = d->mAllExtractors.fetchExtractors(mimeType);
-
-    for (const auto &extractor : extractors) {
-        KFileMetaData::SimpleExtractionResult result(localFileName, mimeType, KFileMetaData::ExtractionResult::ExtractImageData);
-        extractor->extract(&result);
-        if (!result.imageData().isEmpty()) {
-            return true;
-        }
-    }
-
-#else
-    Q_UNUSED(localFileName)
-#endif
-
-    return false;
-}
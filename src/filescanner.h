@@ -33,11 +33,18 @@ public:
 
     QUrl searchForCoverFile(const QString &localFileName);
 
+    /**
+     * Read FLAC, Ogg, MP3 and MP4 files with NativeTagReader before trying KFileMetaData
+     *
+     * Enabled by default.
+     */
+    void setNativeTagReaderEnabled(bool enabled);
+
 private:
 
-    void scanProperties(const QString &localFileName, DataTypes::TrackDataType &trackData);
+    void scanProperties(const QString &localFileName, bool hasEmbeddedCover, DataTypes::TrackDataType &trackData);
 
-    bool checkEmbeddedCoverImage(const QString &localFileName);
+    void addFileProperties(const QString &localFileName, bool hasEmbeddedCover, DataTypes::TrackDataType &trackData);
 
     std::unique_ptr<FileScannerPrivate> d;
 
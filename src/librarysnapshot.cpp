@@ -0,0 +1,244 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "librarysnapshot.h"
+
+#include "databaseLogging.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QByteArray>
+#include <QElapsedTimer>
+
+namespace {
+
+constexpr quint32 SnapshotFileMagic = 0x454c5353;
+
+constexpr quint32 SnapshotFileVersion = 2;
+
+// the serialization of QVariant values changes with the versions of Qt
+constexpr auto SnapshotStreamVersion = QDataStream::Qt_6_5;
+
+// magic, version, stream version and the offsets of the albums and of the artists
+constexpr qint64 SnapshotHeaderSize = 2 * sizeof(quint32) + sizeof(qint32) + 2 * sizeof(qint64);
+
+template <typename DataListType>
+QByteArray serializeList(const DataListType &data)
+{
+    auto result = QByteArray{};
+    QDataStream outputStream(&result, QIODevice::WriteOnly);
+    outputStream.setVersion(SnapshotStreamVersion);
+
+    outputStream << static_cast<quint32>(data.size());
+
+    for (const auto &oneData : data) {
+        outputStream << static_cast<quint32>(oneData.size());
+
+        for (const auto &oneValue : oneData.asKeyValueRange()) {
+            outputStream << static_cast<qint32>(oneValue.first) << oneValue.second;
+        }
+    }
+
+    return result;
+}
+
+template <typename DataListType>
+DataListType deserializeList(const uchar *data, qint64 size)
+{
+    auto result = DataListType{};
+
+    const auto rawData = QByteArray::fromRawData(reinterpret_cast<const char*>(data), static_cast<qsizetype>(size));
+    QDataStream inputStream(rawData);
+    inputStream.setVersion(SnapshotStreamVersion);
+
+    quint32 dataCount = 0;
+    inputStream >> dataCount;
+
+    // each entry takes at least its count of values
+    if (inputStream.status() != QDataStream::Ok || static_cast<qint64>(dataCount) > size / static_cast<qint64>(sizeof(quint32))) {
+        return {};
+    }
+
+    result.reserve(dataCount);
+
+    for (quint32 i = 0; i < dataCount; ++i) {
+        quint32 valuesCount = 0;
+        inputStream >> valuesCount;
+
+        auto oneData = typename DataListType::value_type{};
+
+        for (quint32 j = 0; j < valuesCount && inputStream.status() == QDataStream::Ok; ++j) {
+            qint32 role = 0;
+            QVariant value;
+
+            inputStream >> role >> value;
+            oneData[static_cast<DataTypes::ColumnsRoles>(role)] = value;
+        }
+
+        if (inputStream.status() != QDataStream::Ok) {
+            return {};
+        }
+
+        result.push_back(oneData);
+    }
+
+    return result;
+}
+
+}
+
+class LibrarySnapshotPrivate
+{
+public:
+
+    QFile mFile;
+
+    const uchar *mData = nullptr;
+
+    qint64 mSize = 0;
+
+    qint64 mAlbumsOffset = 0;
+
+    qint64 mArtistsOffset = 0;
+
+    bool mAreAlbumsTaken = false;
+
+    bool mAreArtistsTaken = false;
+
+};
+
+LibrarySnapshot::LibrarySnapshot() : d(std::make_unique<LibrarySnapshotPrivate>())
+{
+}
+
+LibrarySnapshot::~LibrarySnapshot() = default;
+
+bool LibrarySnapshot::open(const QString &fileName)
+{
+    d->mFile.setFileName(fileName);
+
+    if (!d->mFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    d->mSize = d->mFile.size();
+    d->mData = d->mSize >= SnapshotHeaderSize ? d->mFile.map(0, d->mSize) : nullptr;
+
+    if (!d->mData) {
+        d->mFile.close();
+        return false;
+    }
+
+    const auto header = QByteArray::fromRawData(reinterpret_cast<const char*>(d->mData), SnapshotHeaderSize);
+    QDataStream inputStream(header);
+    inputStream.setVersion(SnapshotStreamVersion);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 streamVersion = 0;
+
+    inputStream >> magic >> version >> streamVersion >> d->mAlbumsOffset >> d->mArtistsOffset;
+
+    if (magic != SnapshotFileMagic || version != SnapshotFileVersion || streamVersion != SnapshotStreamVersion ||
+            d->mAlbumsOffset < SnapshotHeaderSize || d->mArtistsOffset < d->mAlbumsOffset || d->mArtistsOffset > d->mSize) {
+        qCDebug(orgKdeElisaDatabase) << "LibrarySnapshot::open" << fileName << "has an unknown format";
+
+        d->mAreAlbumsTaken = true;
+        d->mAreArtistsTaken = true;
+        closeWhenTaken();
+
+        return false;
+    }
+
+    return true;
+}
+
+bool LibrarySnapshot::isOpen() const
+{
+    return d->mData != nullptr;
+}
+
+DataTypes::ListAlbumDataType LibrarySnapshot::takeAlbums()
+{
+    if (!d->mData || d->mAreAlbumsTaken) {
+        return {};
+    }
+
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    auto result = deserializeList<DataTypes::ListAlbumDataType>(d->mData + d->mAlbumsOffset, d->mArtistsOffset - d->mAlbumsOffset);
+
+    qCDebug(orgKdeElisaDatabase) << "LibrarySnapshot::takeAlbums" << result.size() << "albums read in" << timer.elapsed() << "ms";
+
+    d->mAreAlbumsTaken = true;
+    closeWhenTaken();
+
+    return result;
+}
+
+DataTypes::ListArtistDataType LibrarySnapshot::takeArtists()
+{
+    if (!d->mData || d->mAreArtistsTaken) {
+        return {};
+    }
+
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    auto result = deserializeList<DataTypes::ListArtistDataType>(d->mData + d->mArtistsOffset, d->mSize - d->mArtistsOffset);
+
+    qCDebug(orgKdeElisaDatabase) << "LibrarySnapshot::takeArtists" << result.size() << "artists read in" << timer.elapsed() << "ms";
+
+    d->mAreArtistsTaken = true;
+    closeWhenTaken();
+
+    return result;
+}
+
+bool LibrarySnapshot::write(const QString &fileName, const DataTypes::ListAlbumDataType &albums,
+                            const DataTypes::ListArtistDataType &artists)
+{
+    const auto albumsData = serializeList(albums);
+    const auto artistsData = serializeList(artists);
+
+    QSaveFile snapshotFile(fileName);
+    if (!snapshotFile.open(QIODevice::WriteOnly)) {
+        qCDebug(orgKdeElisaDatabase) << "LibrarySnapshot::write" << "cannot open" << fileName;
+        return false;
+    }
+
+    QDataStream outputStream(&snapshotFile);
+    outputStream.setVersion(SnapshotStreamVersion);
+
+    outputStream << SnapshotFileMagic << SnapshotFileVersion << static_cast<qint32>(SnapshotStreamVersion)
+                 << SnapshotHeaderSize << static_cast<qint64>(SnapshotHeaderSize + albumsData.size());
+
+    outputStream.writeRawData(albumsData.constData(), static_cast<int>(albumsData.size()));
+    outputStream.writeRawData(artistsData.constData(), static_cast<int>(artistsData.size()));
+
+    if (!snapshotFile.commit()) {
+        qCDebug(orgKdeElisaDatabase) << "LibrarySnapshot::write" << "cannot write" << fileName;
+        return false;
+    }
+
+    return true;
+}
+
+void LibrarySnapshot::closeWhenTaken()
+{
+    if (!d->mAreAlbumsTaken || !d->mAreArtistsTaken) {
+        return;
+    }
+
+    if (d->mData) {
+        d->mFile.unmap(const_cast<uchar*>(d->mData));
+        d->mData = nullptr;
+    }
+
+    d->mFile.close();
+}
@@ -0,0 +1,62 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef LIBRARYSNAPSHOT_H
+#define LIBRARYSNAPSHOT_H
+
+#include "elisaLib_export.h"
+
+#include "datatypes.h"
+
+#include <QString>
+
+#include <memory>
+
+class LibrarySnapshotPrivate;
+
+/**
+ * List level data of the albums and artists views saved by the previous run
+ *
+ * The views show it while the database is opened and the real data are read, they then
+ * only apply the differences. The file is memory mapped and each list is read on demand.
+ */
+class ELISALIB_EXPORT LibrarySnapshot
+{
+public:
+
+    LibrarySnapshot();
+
+    ~LibrarySnapshot();
+
+    /**
+     * Map the snapshot file, false if it does not exist or has an unknown format
+     */
+    bool open(const QString &fileName);
+
+    [[nodiscard]] bool isOpen() const;
+
+    /**
+     * The albums of the snapshot, only given once: a view opened later reads the database
+     */
+    [[nodiscard]] DataTypes::ListAlbumDataType takeAlbums();
+
+    /**
+     * The artists of the snapshot, only given once: a view opened later reads the database
+     */
+    [[nodiscard]] DataTypes::ListArtistDataType takeArtists();
+
+    static bool write(const QString &fileName, const DataTypes::ListAlbumDataType &albums,
+                      const DataTypes::ListArtistDataType &artists);
+
+private:
+
+    void closeWhenTaken();
+
+    std::unique_ptr<LibrarySnapshotPrivate> d;
+
+};
+
+#endif // LIBRARYSNAPSHOT_H
@@ -10,6 +10,36 @@
 #include "filewriter.h"
 
 #include <QFileInfo>
+#include <QAtomicInt>
+
+namespace {
+
+// gives the cancellation of a loader to its database for the duration of one load
+class LoadCancellationScope
+{
+public:
+
+    LoadCancellationScope(DatabaseInterface *database, const QAtomicInt &isCancelled) : mDatabase(database)
+    {
+        mDatabase->setLoadCancellation(&isCancelled);
+    }
+
+    ~LoadCancellationScope()
+    {
+        mDatabase->setLoadCancellation(nullptr);
+    }
+
+    LoadCancellationScope(const LoadCancellationScope &) = delete;
+
+    LoadCancellationScope &operator=(const LoadCancellationScope &) = delete;
+
+private:
+
+    DatabaseInterface *mDatabase = nullptr;
+
+};
+
+}
 
 class ModelDataLoaderPrivate
 {
@@ -17,6 +47,8 @@ public:
 
     DatabaseInterface *mDatabase = nullptr;
 
+    DatabaseInterface *mReadDatabase = nullptr;
+
     ElisaUtils::PlayListEntryType mModelType = ElisaUtils::Unknown;
 
     ModelDataLoader::FilterType mFilterType = ModelDataLoader::FilterType::UnknownFilter;
@@ -31,6 +63,20 @@ public:
 
     qulonglong mDatabaseId = 0;
 
+    // set from the thread of the view, the loads run in the thread of this loader
+    QAtomicInt mIsCancelled = 0;
+
+    int mSearchGeneration = 0;
+
+    int mSearchResultsCount = 0;
+
+    // small first batch to show the best matches at once
+    int mSearchFirstBatchSize = 20;
+
+    int mSearchBatchSize = 100;
+
+    int mSearchMaximumResults = 500;
+
     FileScanner mFileScanner;
 
     FileWriter mFileWriter;
@@ -65,9 +111,9 @@ void ModelDataLoader::setDatabase(DatabaseInterface *database)
     connect(database, &DatabaseInterface::artistRemoved,
             this, &ModelDataLoader::artistRemoved);
     connect(this, &ModelDataLoader::saveTrackModified,
-            database, &DatabaseInterface::insertTracksList);
+            database, &DatabaseInterface::saveModifiedTracks, Qt::DirectConnection);
     connect(this, &ModelDataLoader::removeRadio,
-            database, &DatabaseInterface::removeRadio);
+            database, &DatabaseInterface::removeRadio, Qt::DirectConnection);
     connect(database, &DatabaseInterface::radioAdded,
             this, &ModelDataLoader::radioAdded);
     connect(database, &DatabaseInterface::radioModified,
@@ -78,31 +124,48 @@ void ModelDataLoader::setDatabase(DatabaseInterface *database)
             this, &ModelDataLoader::clearedDatabase);
 }
 
+void ModelDataLoader::setReadDatabase(DatabaseInterface *database)
+{
+    d->mReadDatabase = database;
+}
+
+void ModelDataLoader::cancelLoads()
+{
+    d->mIsCancelled.storeRelaxed(1);
+}
+
+bool ModelDataLoader::isLoadCancelled() const
+{
+    return d->mIsCancelled.loadRelaxed() == 1;
+}
+
 void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
 {
-    if (!d->mDatabase) {
+    if (!d->mDatabase || isLoadCancelled()) {
         return;
     }
 
+    const LoadCancellationScope loadCancellation{readDatabase(), d->mIsCancelled};
+
     d->mFilterType = ModelDataLoader::FilterType::NoFilter;
 
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsData());
+        emitLoadedData(&ModelDataLoader::allAlbumsData, readDatabase()->allAlbumsData());
         break;
     case ElisaUtils::Artist:
-        Q_EMIT allArtistsData(d->mDatabase->allArtistsData());
+        emitLoadedData(&ModelDataLoader::allArtistsData, readDatabase()->allArtistsData());
         break;
     case ElisaUtils::Composer:
         break;
     case ElisaUtils::Genre:
-        Q_EMIT allGenresData(d->mDatabase->allGenresData());
+        emitLoadedData(&ModelDataLoader::allGenresData, readDatabase()->allGenresData());
         break;
     case ElisaUtils::Lyricist:
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->allTracksData());
+        emitLoadedData(&ModelDataLoader::allTracksData, readDatabase()->allTracksData());
         break;
     case ElisaUtils::FileName:
     case ElisaUtils::Unknown:
@@ -110,17 +173,19 @@ void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
     case ElisaUtils::PlayList:
         break;
     case ElisaUtils::Radio:
-        Q_EMIT allRadiosData(d->mDatabase->allRadiosData());
+        emitLoadedData(&ModelDataLoader::allRadiosData, readDatabase()->allRadiosData());
         break;
     }
 }
 
 void ModelDataLoader::loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType, qulonglong databaseId)
 {
-    if (!d->mDatabase) {
+    if (!d->mDatabase || isLoadCancelled()) {
         return;
     }
 
+    const LoadCancellationScope loadCancellation{readDatabase(), d->mIsCancelled};
+
     d->mFilterType = ModelDataLoader::FilterType::FilterById;
     d->mDatabaseId = databaseId;
 
@@ -137,7 +202,7 @@ void ModelDataLoader::loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType,
     case ElisaUtils::Lyricist:
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->albumData(databaseId));
+        emitLoadedData(&ModelDataLoader::allTracksData, readDatabase()->albumData(databaseId));
         break;
     case ElisaUtils::FileName:
     case ElisaUtils::Unknown:
@@ -150,17 +215,19 @@ void ModelDataLoader::loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType,
 
 void ModelDataLoader::loadDataByGenre(ElisaUtils::PlayListEntryType dataType, const QString &genre)
 {
-    if (!d->mDatabase) {
+    if (!d->mDatabase || isLoadCancelled()) {
         return;
     }
 
+    const LoadCancellationScope loadCancellation{readDatabase(), d->mIsCancelled};
+
     d->mFilterType = ModelDataLoader::FilterType::FilterByGenre;
     d->mGenre = genre;
 
     switch (dataType)
     {
     case ElisaUtils::Artist:
-        Q_EMIT allArtistsData(d->mDatabase->allArtistsDataByGenre(genre));
+        emitLoadedData(&ModelDataLoader::allArtistsData, readDatabase()->allArtistsDataByGenre(genre));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Composer:
@@ -178,17 +245,19 @@ void ModelDataLoader::loadDataByGenre(ElisaUtils::PlayListEntryType dataType, co
 
 void ModelDataLoader::loadDataByArtist(ElisaUtils::PlayListEntryType dataType, const QString &artist)
 {
-    if (!d->mDatabase) {
+    if (!d->mDatabase || isLoadCancelled()) {
         return;
     }
 
+    const LoadCancellationScope loadCancellation{readDatabase(), d->mIsCancelled};
+
     d->mFilterType = ModelDataLoader::FilterType::FilterByArtist;
     d->mArtist = artist;
 
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsDataByArtist(artist));
+        emitLoadedData(&ModelDataLoader::allAlbumsData, readDatabase()->allAlbumsDataByArtist(artist));
         break;
     case ElisaUtils::Artist:
     case ElisaUtils::Composer:
@@ -206,10 +275,12 @@ void ModelDataLoader::loadDataByArtist(ElisaUtils::PlayListEntryType dataType, c
 
 void ModelDataLoader::loadDataByGenreAndArtist(ElisaUtils::PlayListEntryType dataType, const QString &genre, const QString &artist)
 {
-    if (!d->mDatabase) {
+    if (!d->mDatabase || isLoadCancelled()) {
         return;
     }
 
+    const LoadCancellationScope loadCancellation{readDatabase(), d->mIsCancelled};
+
     d->mFilterType = ModelDataLoader::FilterType::FilterByGenreAndArtist;
     d->mArtist = artist;
     d->mGenre = genre;
@@ -217,7 +288,7 @@ void ModelDataLoader::loadDataByGenreAndArtist(ElisaUtils::PlayListEntryType dat
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsDataByGenreAndArtist(genre, artist));
+        emitLoadedData(&ModelDataLoader::allAlbumsData, readDatabase()->allAlbumsDataByGenreAndArtist(genre, artist));
         break;
     case ElisaUtils::Artist:
     case ElisaUtils::Composer:
@@ -236,10 +307,12 @@ void ModelDataLoader::loadDataByGenreAndArtist(ElisaUtils::PlayListEntryType dat
 void ModelDataLoader::loadDataByDatabaseIdAndUrl(ElisaUtils::PlayListEntryType dataType,
                                                  qulonglong databaseId, const QUrl &url)
 {
-    if (!d->mDatabase) {
+    if (!d->mDatabase || isLoadCancelled()) {
         return;
     }
 
+    const LoadCancellationScope loadCancellation{readDatabase(), d->mIsCancelled};
+
     d->mFilterType = ModelDataLoader::FilterType::FilterById;
     d->mDatabaseId = databaseId;
 
@@ -247,10 +320,10 @@ void ModelDataLoader::loadDataByDatabaseIdAndUrl(ElisaUtils::PlayListEntryType d
     {
     case ElisaUtils::FileName:
     case ElisaUtils::Track:
-        Q_EMIT allTrackData(d->mDatabase->trackDataFromDatabaseIdAndUrl(databaseId, url));
+        emitLoadedData(&ModelDataLoader::allTrackData, readDatabase()->trackDataFromDatabaseIdAndUrl(databaseId, url));
         break;
     case ElisaUtils::Radio:
-        Q_EMIT allRadioData(d->mDatabase->radioDataFromDatabaseId(databaseId));
+        emitLoadedData(&ModelDataLoader::allRadioData, readDatabase()->radioDataFromDatabaseId(databaseId));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -266,10 +339,12 @@ void ModelDataLoader::loadDataByDatabaseIdAndUrl(ElisaUtils::PlayListEntryType d
 
 void ModelDataLoader::loadDataByUrl(ElisaUtils::PlayListEntryType dataType, const QUrl &url)
 {
-    if (!d->mDatabase) {
+    if (!d->mDatabase || isLoadCancelled()) {
         return;
     }
 
+    const LoadCancellationScope loadCancellation{readDatabase(), d->mIsCancelled};
+
     d->mFilterType = ModelDataLoader::FilterType::UnknownFilter;
 
     switch (dataType)
@@ -277,23 +352,23 @@ void ModelDataLoader::loadDataByUrl(ElisaUtils::PlayListEntryType dataType, cons
     case ElisaUtils::FileName:
     case ElisaUtils::Track:
     {
-        auto databaseId = d->mDatabase->trackIdFromFileName(url);
+        auto databaseId = readDatabase()->trackIdFromFileName(url);
         if (databaseId != 0) {
-            Q_EMIT allTrackData(d->mDatabase->trackDataFromDatabaseIdAndUrl(databaseId, url));
+            emitLoadedData(&ModelDataLoader::allTrackData, readDatabase()->trackDataFromDatabaseIdAndUrl(databaseId, url));
         } else {
             auto result = d->mFileScanner.scanOneFile(url);
-            Q_EMIT allTrackData(result);
+            emitLoadedData(&ModelDataLoader::allTrackData, result);
         }
         break;
     }
     case ElisaUtils::Radio:
     {
-        auto databaseId = d->mDatabase->radioIdFromFileName(url);
+        auto databaseId = readDatabase()->radioIdFromFileName(url);
         if (databaseId != 0) {
-            Q_EMIT allRadioData(d->mDatabase->radioDataFromDatabaseId(databaseId));
+            emitLoadedData(&ModelDataLoader::allRadioData, readDatabase()->radioDataFromDatabaseId(databaseId));
         } else {
             auto result = d->mFileScanner.scanOneFile(url);
-            Q_EMIT allRadioData(result);
+            emitLoadedData(&ModelDataLoader::allRadioData, result);
         }
         break;
     }
@@ -311,16 +386,18 @@ void ModelDataLoader::loadDataByUrl(ElisaUtils::PlayListEntryType dataType, cons
 
 void ModelDataLoader::loadRecentlyPlayedData(ElisaUtils::PlayListEntryType dataType)
 {
-    if (!d->mDatabase) {
+    if (!d->mDatabase || isLoadCancelled()) {
         return;
     }
 
+    const LoadCancellationScope loadCancellation{readDatabase(), d->mIsCancelled};
+
     d->mFilterType = ModelDataLoader::FilterType::FilterByRecentlyPlayed;
 
     switch (dataType)
     {
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->recentlyPlayedTracksData(50));
+        emitLoadedData(&ModelDataLoader::allTracksData, readDatabase()->recentlyPlayedTracksData(50));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -338,16 +415,18 @@ void ModelDataLoader::loadRecentlyPlayedData(ElisaUtils::PlayListEntryType dataT
 
 void ModelDataLoader::loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType)
 {
-    if (!d->mDatabase) {
+    if (!d->mDatabase || isLoadCancelled()) {
         return;
     }
 
+    const LoadCancellationScope loadCancellation{readDatabase(), d->mIsCancelled};
+
     d->mFilterType = ModelDataLoader::FilterType::FilterByFrequentlyPlayed;
 
     switch (dataType)
     {
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->frequentlyPlayedTracksData(50));
+        emitLoadedData(&ModelDataLoader::allTracksData, readDatabase()->frequentlyPlayedTracksData(50));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -363,8 +442,38 @@ void ModelDataLoader::loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dat
     }
 }
 
+void ModelDataLoader::loadSearchResults(const QString &searchText)
+{
+    if (!d->mDatabase || isLoadCancelled()) {
+        return;
+    }
+
+    ++d->mSearchGeneration;
+    d->mSearchResultsCount = 0;
+
+    loadNextSearchResults(searchText, d->mSearchGeneration);
+}
+
+void ModelDataLoader::loadTracksPage(int requestId, DataTypes::ColumnsRoles sortRole, Qt::SortOrder sortOrder,
+                                     const QVariant &afterSortValue, qulonglong afterDatabaseId, int count)
+{
+    if (!d->mDatabase || isLoadCancelled()) {
+        return;
+    }
+
+    const LoadCancellationScope loadCancellation{readDatabase(), d->mIsCancelled};
+
+    d->mFilterType = ModelDataLoader::FilterType::NoFilter;
+
+    emitLoadedData(&ModelDataLoader::tracksPage, requestId, readDatabase()->tracksDataPage(sortRole, sortOrder, afterSortValue, afterDatabaseId, count));
+}
+
 void ModelDataLoader::databaseTracksAdded(const ListTrackDataType &newData)
 {
+    if (isLoadCancelled()) {
+        return;
+    }
+
     switch(d->mFilterType) {
     case ModelDataLoader::FilterType::NoFilter:
         Q_EMIT tracksAdded(newData);
@@ -393,12 +502,16 @@ void ModelDataLoader::databaseTracksAdded(const ListTrackDataType &newData)
 
 void ModelDataLoader::databaseArtistsAdded(const ListArtistDataType &newData)
 {
+    if (isLoadCancelled()) {
+        return;
+    }
+
     switch(d->mFilterType) {
     case ModelDataLoader::FilterType::FilterByGenre:
     {
         auto filteredData = newData;
         auto new_end = std::remove_if(filteredData.begin(), filteredData.end(),
-                                      [&](const auto &oneArtist){return !d->mDatabase->internalArtistMatchGenre(oneArtist.databaseId(), d->mGenre);});
+                                      [&](const auto &oneArtist){return !readDatabase()->internalArtistMatchGenre(oneArtist.databaseId(), d->mGenre);});
         filteredData.erase(new_end, filteredData.end());
 
         Q_EMIT artistsAdded(filteredData);
@@ -421,6 +534,10 @@ void ModelDataLoader::databaseArtistsAdded(const ListArtistDataType &newData)
 
 void ModelDataLoader::databaseAlbumsAdded(const ListAlbumDataType &newData)
 {
+    if (isLoadCancelled()) {
+        return;
+    }
+
     switch(d->mFilterType) {
     case ModelDataLoader::FilterType::FilterByArtist:
     {
@@ -487,4 +604,34 @@ void ModelDataLoader::updateSingleFileMetaData(const QUrl &url, DataTypes::Colum
     d->mFileWriter.writeSingleMetaDataToFile(url, role, data);
 }
 
+DatabaseInterface *ModelDataLoader::readDatabase() const
+{
+    return d->mReadDatabase ? d->mReadDatabase : d->mDatabase;
+}
+
+void ModelDataLoader::loadNextSearchResults(const QString &searchText, int searchGeneration)
+{
+    // a newer search was asked meanwhile
+    if (searchGeneration != d->mSearchGeneration || isLoadCancelled()) {
+        return;
+    }
+
+    const auto batchSize = (d->mSearchResultsCount == 0 ? d->mSearchFirstBatchSize : d->mSearchBatchSize);
+    const auto offset = d->mSearchResultsCount;
+    const auto results = readDatabase()->librarySearch(searchText, batchSize, offset);
+
+    d->mSearchResultsCount += results.size();
+
+    emitLoadedData(&ModelDataLoader::searchResults, searchText, offset, results);
+
+    if (results.size() < batchSize || d->mSearchResultsCount >= d->mSearchMaximumResults) {
+        return;
+    }
+
+    // the next batch is queued to let a newer search stop this one
+    QMetaObject::invokeMethod(this, [this, searchText, searchGeneration]() {
+        loadNextSearchResults(searchText, searchGeneration);
+    }, Qt::QueuedConnection);
+}
+
 #include "moc_modeldataloader.cpp"
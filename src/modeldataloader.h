@@ -31,6 +31,7 @@ public:
     using ListArtistDataType = DataTypes::ListArtistDataType;
     using ListGenreDataType = DataTypes::ListGenreDataType;
     using ListTrackDataType = DataTypes::ListTrackDataType;
+    using ListMusicDataType = DataTypes::ListMusicDataType;
     using ListRadioDataType = DataTypes::ListRadioDataType;
     using TrackDataType = DataTypes::TrackDataType;
     using AlbumDataType = DataTypes::AlbumDataType;
@@ -43,6 +44,25 @@ public:
 
     void setDatabase(DatabaseInterface *database);
 
+    /**
+     * Connection used to load the data, the one set with setDatabase when not set
+     *
+     * It must live in the thread of this loader. Changes are still notified by the
+     * database set with setDatabase.
+     */
+    void setReadDatabase(DatabaseInterface *database);
+
+    /**
+     * Stop the loads of this loader, can be called from any thread
+     *
+     * The loads still queued are dropped before being run and a running one stops between
+     * two batches of rows. Nothing is emitted for them: the loader of a closed view is
+     * cancelled to let the loads of the views still shown run first.
+     */
+    void cancelLoads();
+
+    [[nodiscard]] bool isLoadCancelled() const;
+
 Q_SIGNALS:
 
     void allAlbumsData(const ModelDataLoader::ListAlbumDataType &allData);
@@ -89,6 +109,16 @@ Q_SIGNALS:
 
     void clearedDatabase();
 
+    /**
+     * One batch of results of a library search, offset being the rank of its first result
+     */
+    void searchResults(const QString &searchText, int offset, const ModelDataLoader::ListMusicDataType &results);
+
+    /**
+     * One page of sorted tracks, requestId being the one given to loadTracksPage
+     */
+    void tracksPage(int requestId, const ModelDataLoader::ListTrackDataType &tracks);
+
 public Q_SLOTS:
 
     void loadData(ElisaUtils::PlayListEntryType dataType);
@@ -114,6 +144,16 @@ public Q_SLOTS:
 
     void loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType);
 
+    /**
+     * Search the library and emit the results in batches with searchResults
+     *
+     * A search requested before the previous one is complete stops the previous one.
+     */
+    void loadSearchResults(const QString &searchText);
+
+    void loadTracksPage(int requestId, DataTypes::ColumnsRoles sortRole, Qt::SortOrder sortOrder,
+                        const QVariant &afterSortValue, qulonglong afterDatabaseId, int count);
+
     void updateFileMetaData(const DataTypes::TrackDataType &trackDataType, const QUrl &url);
 
     void updateSingleFileMetaData(const QUrl &url, DataTypes::ColumnsRoles role, const QVariant &data);
@@ -130,6 +170,20 @@ private Q_SLOTS:
 
 private:
 
+    [[nodiscard]] DatabaseInterface *readDatabase() const;
+
+    template <typename Signal, typename... Data>
+    void emitLoadedData(Signal loadedSignal, const Data&... loadedData)
+    {
+        if (isLoadCancelled()) {
+            return;
+        }
+
+        Q_EMIT (this->*loadedSignal)(loadedData...);
+    }
+
+    void loadNextSearchResults(const QString &searchText, int searchGeneration);
+
     std::unique_ptr<ModelDataLoaderPrivate> d;
 
 };
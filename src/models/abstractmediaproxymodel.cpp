@@ -8,6 +8,7 @@
 #include "abstractmediaproxymodel.h"
 
 #include "mediaplaylistproxymodel.h"
+#include "datamodel.h"
 
 #include <QWriteLocker>
 #include <QReadLocker>
@@ -19,6 +20,19 @@ AbstractMediaProxyModel::AbstractMediaProxyModel(QObject *parent) : QSortFilterP
     mThreadPool.setMaxThreadCount(1);
 
     connect(&mEnqueueWatcher, &QFutureWatcher<void>::finished, this, &AbstractMediaProxyModel::afterPlaylistEnqueue);
+
+    connect(this, &QSortFilterProxyModel::sortRoleChanged, this, &AbstractMediaProxyModel::updatePagedSort);
+    connect(this, &QAbstractProxyModel::sourceModelChanged, this, [this]() {
+        if (auto pagedModel = qobject_cast<DataModel*>(sourceModel())) {
+            connect(pagedModel, &DataModel::isPagedChanged,
+                    this, &AbstractMediaProxyModel::updatePagedSort, Qt::UniqueConnection);
+            connect(pagedModel, &DataModel::isPagedChanged,
+                    this, &AbstractMediaProxyModel::updatePagedFilter, Qt::UniqueConnection);
+            connect(pagedModel, &DataModel::allPagedTracksLoaded,
+                    this, &AbstractMediaProxyModel::enqueueAllPagedTracks, Qt::UniqueConnection);
+        }
+        updatePagedFilter();
+    });
 }
 
 AbstractMediaProxyModel::~AbstractMediaProxyModel()
@@ -51,6 +65,8 @@ void AbstractMediaProxyModel::setFilterText(const QString &filterText)
 
     invalidate();
 
+    updatePagedFilter();
+
     Q_EMIT filterTextChanged(mFilterText);
 }
 
@@ -66,6 +82,8 @@ void AbstractMediaProxyModel::setFilterRating(int filterRating)
 
     invalidate();
 
+    updatePagedFilter();
+
     Q_EMIT filterRatingChanged(filterRating);
 }
 
@@ -81,10 +99,60 @@ MediaPlayListProxyModel *AbstractMediaProxyModel::playList() const
 
 void AbstractMediaProxyModel::sortModel(Qt::SortOrder order)
 {
-    sort(0, order);
+    // a paged model already gives its rows in the order of the database
+    if (auto pagedModel = qobject_cast<DataModel*>(sourceModel()); pagedModel && pagedModel->isPaged()) {
+        pagedModel->setPagedSort(sortRole(), order);
+        sort(-1, order);
+    } else {
+        sort(0, order);
+    }
     Q_EMIT sortedAscendingChanged();
 }
 
+void AbstractMediaProxyModel::updatePagedSort()
+{
+    auto pagedModel = qobject_cast<DataModel*>(sourceModel());
+    if (!pagedModel || !pagedModel->isPaged()) {
+        return;
+    }
+
+    pagedModel->setPagedSort(sortRole(), sortOrder());
+    if (sortColumn() != -1) {
+        sort(-1, sortOrder());
+    }
+}
+
+void AbstractMediaProxyModel::updatePagedFilter()
+{
+    auto pagedModel = pagedSourceModel();
+    if (!pagedModel) {
+        return;
+    }
+
+    // the filter needs to see all the rows, not only the pages already loaded
+    pagedModel->setKeepAllTracksPages(!mFilterText.isEmpty() || mFilterRating > 0);
+}
+
+void AbstractMediaProxyModel::useRows(int firstRow, int lastRow)
+{
+    auto pagedModel = pagedSourceModel();
+    if (!pagedModel || firstRow < 0 || lastRow < firstRow || lastRow >= rowCount()) {
+        return;
+    }
+
+    pagedModel->useTracksRows(mapToSource(index(firstRow, 0)).row(), mapToSource(index(lastRow, 0)).row());
+}
+
+DataModel *AbstractMediaProxyModel::pagedSourceModel() const
+{
+    auto pagedModel = qobject_cast<DataModel*>(sourceModel());
+    if (!pagedModel || !pagedModel->isPaged()) {
+        return nullptr;
+    }
+
+    return pagedModel;
+}
+
 void AbstractMediaProxyModel::setPlayList(MediaPlayListProxyModel *playList)
 {
     if (mPlayList == playList) {
@@ -137,13 +205,59 @@ QFuture<void> AbstractMediaProxyModel::genericEnqueueToPlayList(const QModelInde
     });
 }
 
+void AbstractMediaProxyModel::enqueueFromPagedModel(ElisaUtils::PlayListEnqueueMode enqueueMode,
+                                                    ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay)
+{
+    mIsWaitingAllPagedTracks = true;
+    mPagedEnqueueMode = enqueueMode;
+    mPagedTriggerPlay = triggerPlay;
+
+    pagedSourceModel()->loadAllPagedTracks();
+}
+
+void AbstractMediaProxyModel::enqueueAllPagedTracks(const DataTypes::ListTrackDataType &tracks)
+{
+    if (!mIsWaitingAllPagedTracks) {
+        return;
+    }
+
+    mIsWaitingAllPagedTracks = false;
+
+    auto allData = DataTypes::EntryDataList{};
+    allData.reserve(tracks.size());
+    for (const auto &oneTrack : tracks) {
+        auto title = oneTrack.title();
+        if (title.isEmpty()) {
+            title = oneTrack.resourceURI().fileName();
+        }
+
+        allData.push_back(DataTypes::EntryData{oneTrack, title, {}});
+    }
+
+    Q_EMIT entriesToEnqueue(allData, mPagedEnqueueMode, mPagedTriggerPlay);
+
+    afterPlaylistEnqueue();
+}
+
 void AbstractMediaProxyModel::enqueueAll(ElisaUtils::PlayListEnqueueMode enqueueMode, ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay)
 {
+    // without a filter, all the tracks of a paged model are read from the database instead of the loaded rows
+    if (pagedSourceModel() && mFilterText.isEmpty() && mFilterRating == 0) {
+        enqueueFromPagedModel(enqueueMode, triggerPlay);
+        return;
+    }
+
     genericEnqueueToPlayList(QModelIndex(), enqueueMode, triggerPlay);
 }
 
 void AbstractMediaProxyModel::replaceAndPlayOfPlayListFromTrackUrl(const QModelIndex &rootIndex, const QUrl &switchTrackUrl)
 {
+    if (!rootIndex.isValid() && pagedSourceModel() && mFilterText.isEmpty() && mFilterRating == 0) {
+        mEnqueueWatcherTrackUrl = switchTrackUrl;
+        enqueueFromPagedModel(ElisaUtils::ReplacePlayList, ElisaUtils::DoNotTriggerPlay);
+        return;
+    }
+
     auto future = genericEnqueueToPlayList(rootIndex, ElisaUtils::ReplacePlayList, ElisaUtils::DoNotTriggerPlay);
 
     // Wait until the future is finished before switching tracks
@@ -21,6 +21,7 @@
 #include <QFutureWatcher>
 
 class MediaPlayListProxyModel;
+class DataModel;
 
 class ELISALIB_EXPORT AbstractMediaProxyModel : public QSortFilterProxyModel
 {
@@ -78,6 +79,8 @@ public Q_SLOTS:
 
     void afterPlaylistEnqueue();
 
+    void useRows(int firstRow, int lastRow);
+
 Q_SIGNALS:
 
     void filterTextChanged(const QString &filterText);
@@ -118,9 +121,28 @@ protected:
 
     QUrl mEnqueueWatcherTrackUrl;
 
+    // enqueue waiting for all the tracks of a paged model
+    bool mIsWaitingAllPagedTracks = false;
+
+    ElisaUtils::PlayListEnqueueMode mPagedEnqueueMode = ElisaUtils::AppendPlayList;
+
+    ElisaUtils::PlayListEnqueueTriggerPlay mPagedTriggerPlay = ElisaUtils::DoNotTriggerPlay;
+
+private Q_SLOTS:
+
+    void updatePagedSort();
+
+    void updatePagedFilter();
+
+    void enqueueAllPagedTracks(const DataTypes::ListTrackDataType &tracks);
 
 private:
 
+    [[nodiscard]] DataModel* pagedSourceModel() const;
+
+    void enqueueFromPagedModel(ElisaUtils::PlayListEnqueueMode enqueueMode,
+                               ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
+
     QFuture<void> genericEnqueueToPlayList(const QModelIndex &rootIndex,
                                   ElisaUtils::PlayListEnqueueMode enqueueMode,
                                   ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
@@ -8,10 +8,44 @@
 
 #include "modeldataloader.h"
 #include "musiclistenersmanager.h"
+#include "databaseinterface.h"
+#include "librarysnapshot.h"
 
 #include "models/modelLogging.h"
 
+#include <QHash>
+#include <QTimer>
+
 #include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace {
+
+// same order as COLLATE NOCASE: only ASCII letters are folded, the other characters keep the order of their code points
+int compareNoCase(const QString &left, const QString &right)
+{
+    const auto leftCodePoints = left.toUcs4();
+    const auto rightCodePoints = right.toUcs4();
+
+    const auto foldAscii = [](uint codePoint) -> uint {
+        return (codePoint >= 'A' && codePoint <= 'Z') ? codePoint + ('a' - 'A') : codePoint;
+    };
+
+    const auto commonSize = std::min(leftCodePoints.size(), rightCodePoints.size());
+    for (auto i = qsizetype{0}; i < commonSize; ++i) {
+        const auto leftCodePoint = foldAscii(leftCodePoints[i]);
+        const auto rightCodePoint = foldAscii(rightCodePoints[i]);
+
+        if (leftCodePoint != rightCodePoint) {
+            return leftCodePoint < rightCodePoint ? -1 : 1;
+        }
+    }
+
+    return leftCodePoints.size() < rightCodePoints.size() ? -1 : (leftCodePoints.size() > rightCodePoints.size() ? 1 : 0);
+}
+
+}
 
 class DataModelPrivate
 {
@@ -29,6 +63,11 @@ public:
 
     ModelDataLoader *mDataLoader = nullptr;
 
+    LibrarySnapshot *mLibrarySnapshot = nullptr;
+
+    // rows come from the snapshot of the previous run until the data of the database are loaded
+    bool mIsShowingSnapshot = false;
+
     ElisaUtils::PlayListEntryType mModelType = ElisaUtils::Unknown;
 
     ElisaUtils::FilterType mFilterType = ElisaUtils::UnknownFilter;
@@ -45,16 +84,78 @@ public:
 
     bool mIsBusy = false;
 
+    bool mIsPaged = false;
+
+    DataTypes::ColumnsRoles mPagedSortRole = DataTypes::TitleRole;
+
+    Qt::SortOrder mPagedSortOrder = Qt::AscendingOrder;
+
+    bool mHasMoreTracksPages = false;
+
+    int mNextTracksPageRequestId = 0;
+
+    // request of the page appended at the end of the rows, -1 when none is running
+    int mFetchMoreRequestId = -1;
+
+    int mFetchMoreCount = 0;
+
+    // request of all the tracks asked by loadAllPagedTracks, -1 when none is running
+    int mAllTracksRequestId = -1;
+
+    // the rows of a page are the tracks sorted after the end of the previous page up to its own end,
+    // only the pages used last keep their tracks
+    struct TracksPage
+    {
+        int firstRow = 0;
+
+        int rowsCount = 0;
+
+        QVariant lastSortValue;
+
+        qulonglong lastDatabaseId = 0;
+
+        DataModel::ListTrackDataType tracks;
+    };
+
+    QList<TracksPage> mTracksPages;
+
+    int mTracksCount = 0;
+
+    // evicted page being loaded again, by request
+    QHash<int, int> mReloadingTracksPages;
+
+    // pages keeping their tracks, the most recently used last
+    QList<int> mLoadedTracksPages;
+
+    // evicted pages a view asked for since the last reload
+    QList<int> mWantedTracksPages;
+
+    QTimer mWantedTracksPagesTimer;
+
+    int mTracksPageSize = 200;
+
+    int mMaximumLoadedTracksPages = 10;
+
+    bool mKeepAllTracksPages = false;
+
 };
 
 DataModel::DataModel(QObject *parent) : QAbstractListModel(parent), d(std::make_unique<DataModelPrivate>())
 {
     d->mDataLoader = new ModelDataLoader;
     connect(this, &DataModel::destroyed, d->mDataLoader, &ModelDataLoader::deleteLater);
+
+    d->mWantedTracksPagesTimer.setSingleShot(true);
+    d->mWantedTracksPagesTimer.setInterval(0);
+    connect(&d->mWantedTracksPagesTimer, &QTimer::timeout,
+            this, &DataModel::loadWantedTracksPages);
 }
 
 DataModel::~DataModel()
-= default;
+{
+    // the loader is deleted later, its queued loads are useless
+    d->mDataLoader->cancelLoads();
+}
 
 int DataModel::rowCount(const QModelIndex &parent) const
 {
@@ -64,7 +165,7 @@ int DataModel::rowCount(const QModelIndex &parent) const
         return dataCount;
     }
 
-    dataCount = d->mAllTrackData.size() + d->mAllAlbumData.size() + d->mAllArtistData.size() + d->mAllGenreData.size();
+    dataCount = (d->mIsPaged ? d->mTracksCount : d->mAllTrackData.size()) + d->mAllAlbumData.size() + d->mAllArtistData.size() + d->mAllGenreData.size();
 
     return dataCount;
 }
@@ -117,7 +218,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         return result;
     }
 
-    const auto dataCount = d->mModelType == ElisaUtils::Radio ? d->mAllRadiosData.size() : d->mAllTrackData.size() + d->mAllAlbumData.size() + d->mAllArtistData.size() + d->mAllGenreData.size();
+    const auto dataCount = d->mModelType == ElisaUtils::Radio ? d->mAllRadiosData.size() : (d->mIsPaged ? d->mTracksCount : d->mAllTrackData.size()) + d->mAllAlbumData.size() + d->mAllArtistData.size() + d->mAllGenreData.size();
 
     Q_ASSERT(index.isValid());
     Q_ASSERT(index.column() == 0);
@@ -132,9 +233,9 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         switch(d->mModelType)
         {
         case ElisaUtils::Track:
-            result = d->mAllTrackData[index.row()][TrackDataType::key_type::TitleRole];
+            result = trackDataAt(index.row()).value(TrackDataType::key_type::TitleRole);
             if (result.toString().isEmpty()) {
-                result = d->mAllTrackData[index.row()][TrackDataType::key_type::ResourceRole].toUrl().fileName();
+                result = trackDataAt(index.row()).value(TrackDataType::key_type::ResourceRole).toUrl().fileName();
             }
             break;
         case ElisaUtils::Album:
@@ -164,7 +265,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         {
         case ElisaUtils::Track:
         {
-            auto trackDuration = d->mAllTrackData[index.row()][TrackDataType::key_type::DurationRole].toTime();
+            auto trackDuration = trackDataAt(index.row()).value(TrackDataType::key_type::DurationRole).toTime();
             if (trackDuration.hour() == 0) {
                 result = trackDuration.toString(QStringLiteral("mm:ss"));
             } else {
@@ -191,7 +292,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         switch (d->mModelType)
         {
         case ElisaUtils::Track:
-            result = d->mAllTrackData[index.row()][TrackDataType::key_type::IsSingleDiscAlbumRole];
+            result = trackDataAt(index.row()).value(TrackDataType::key_type::IsSingleDiscAlbumRole);
             break;
         case ElisaUtils::Radio:
             result = false;
@@ -217,11 +318,12 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         {
         case ElisaUtils::Track:
         {
-            auto itArtist = d->mAllTrackData[index.row()].find(TrackDataType::key_type::ArtistRole);
-            if (itArtist != d->mAllTrackData[index.row()].end()) {
-                result = d->mAllTrackData[index.row()][TrackDataType::key_type::ArtistRole];
+            const auto &trackData = trackDataAt(index.row());
+            auto itArtist = trackData.find(TrackDataType::key_type::ArtistRole);
+            if (itArtist != trackData.end()) {
+                result = itArtist.value();
             } else {
-                result = d->mAllTrackData[index.row()][TrackDataType::key_type::AlbumArtistRole];
+                result = trackData.value(TrackDataType::key_type::AlbumArtistRole);
             }
             break;
         }
@@ -251,7 +353,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         switch (d->mModelType)
         {
         case ElisaUtils::Track:
-            result = QVariant::fromValue(static_cast<DataTypes::MusicDataType>(d->mAllTrackData[index.row()]));
+            result = QVariant::fromValue(static_cast<DataTypes::MusicDataType>(trackDataAt(index.row())));
             break;
         case ElisaUtils::Radio:
             result = QVariant::fromValue(static_cast<DataTypes::MusicDataType>(d->mAllRadiosData[index.row()]));
@@ -280,7 +382,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         {
         case ElisaUtils::Track:
         case ElisaUtils::FileName:
-            result = d->mAllTrackData[index.row()][TrackDataType::key_type::ResourceRole];
+            result = trackDataAt(index.row()).value(TrackDataType::key_type::ResourceRole);
             break;
         case ElisaUtils::Radio:
             result = d->mAllRadiosData[index.row()][TrackDataType::key_type::ResourceRole];
@@ -324,7 +426,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         switch(d->mModelType)
         {
         case ElisaUtils::Track:
-            result = d->mAllTrackData[index.row()][static_cast<TrackDataType::key_type>(role)];
+            result = trackDataAt(index.row()).value(static_cast<TrackDataType::key_type>(role));
             break;
         case ElisaUtils::Album:
             result = d->mAllAlbumData[index.row()][static_cast<AlbumDataType::key_type>(role)];
@@ -392,6 +494,38 @@ bool DataModel::isBusy() const
     return d->mIsBusy;
 }
 
+bool DataModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return false;
+    }
+
+    return d->mIsPaged && d->mHasMoreTracksPages && d->mFetchMoreRequestId == -1;
+}
+
+void DataModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) {
+        return;
+    }
+
+    // a view needing all the rows gets them at once
+    d->mFetchMoreCount = d->mKeepAllTracksPages ? std::numeric_limits<int>::max() : d->mTracksPageSize;
+    d->mFetchMoreRequestId = d->mNextTracksPageRequestId++;
+    requestTracksPage(d->mFetchMoreRequestId, static_cast<int>(d->mTracksPages.size()) - 1, d->mFetchMoreCount);
+}
+
+bool DataModel::isPaged() const
+{
+    return d->mIsPaged;
+}
+
+void DataModel::setTracksPaging(int pageSize, int maximumLoadedPages)
+{
+    d->mTracksPageSize = std::max(pageSize, 1);
+    d->mMaximumLoadedTracksPages = std::max(maximumLoadedPages, 1);
+}
+
 void DataModel::initializeByData(MusicListenersManager *manager, DatabaseInterface *database,
                                  ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                                  const DataTypes::DataType &dataFilter)
@@ -421,8 +555,13 @@ void DataModel::initializeModel(MusicListenersManager *manager, DatabaseInterfac
     d->mModelType = modelType;
     d->mFilterType = type;
 
+    const auto isPaged = d->mModelType == ElisaUtils::Track && d->mFilterType == ElisaUtils::NoFilter;
+    const auto isPagedModified = d->mIsPaged != isPaged;
+    d->mIsPaged = isPaged;
+
     if (manager) {
         manager->connectModel(d->mDataLoader);
+        d->mLibrarySnapshot = manager->librarySnapshot();
     }
 
     if (manager) {
@@ -436,8 +575,15 @@ void DataModel::initializeModel(MusicListenersManager *manager, DatabaseInterfac
     switch(d->mFilterType)
     {
     case ElisaUtils::NoFilter:
-        connect(this, &DataModel::needData,
-                d->mDataLoader, &ModelDataLoader::loadData);
+        if (d->mIsPaged) {
+            connect(this, &DataModel::needTracksPage,
+                    d->mDataLoader, &ModelDataLoader::loadTracksPage);
+            connect(d->mDataLoader, &ModelDataLoader::tracksPage,
+                    this, &DataModel::tracksPageLoaded);
+        } else {
+            connect(this, &DataModel::needData,
+                    d->mDataLoader, &ModelDataLoader::loadData);
+        }
         break;
     case ElisaUtils::FilterById:
         connect(this, &DataModel::needDataById,
@@ -470,6 +616,10 @@ void DataModel::initializeModel(MusicListenersManager *manager, DatabaseInterfac
 
     setBusy(true);
 
+    if (isPagedModified) {
+        Q_EMIT isPagedChanged();
+    }
+
     askModelData();
 }
 
@@ -478,7 +628,13 @@ void DataModel::askModelData()
     switch(d->mFilterType)
     {
     case ElisaUtils::NoFilter:
-        Q_EMIT needData(d->mModelType);
+        if (d->mIsPaged) {
+            d->mHasMoreTracksPages = true;
+            fetchMore({});
+        } else {
+            showLibrarySnapshot();
+            Q_EMIT needData(d->mModelType);
+        }
         break;
     case ElisaUtils::FilterById:
         Q_EMIT needDataById(d->mModelType, d->mDatabaseId);
@@ -529,9 +685,9 @@ void DataModel::connectModel(DatabaseInterface *database)
     connect(d->mDataLoader, &ModelDataLoader::allRadiosData,
             this, &DataModel::radiosAdded);
     connect(d->mDataLoader, &ModelDataLoader::allAlbumsData,
-            this, &DataModel::albumsAdded);
+            this, &DataModel::allAlbumsLoaded);
     connect(d->mDataLoader, &ModelDataLoader::allArtistsData,
-            this, &DataModel::artistsAdded);
+            this, &DataModel::allArtistsLoaded);
     connect(d->mDataLoader, &ModelDataLoader::allGenresData,
             this, &DataModel::genresAdded);
     connect(d->mDataLoader, &ModelDataLoader::genresAdded,
@@ -572,6 +728,11 @@ void DataModel::tracksAdded(ListTrackDataType newData)
         return;
     }
 
+    if (d->mIsPaged) {
+        insertPagedTracks(newData);
+        return;
+    }
+
     if (d->mFilterType == ElisaUtils::FilterById && !d->mAllTrackData.isEmpty()) {
         for (const auto &newTrack : newData) {
             auto trackIndex = indexFromId(newTrack.databaseId());
@@ -690,6 +851,11 @@ void DataModel::trackModified(const TrackDataType &modifiedTrack)
         return;
     }
 
+    if (d->mIsPaged) {
+        modifyPagedTrack(modifiedTrack);
+        return;
+    }
+
     if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty()) {
         if (modifiedTrack.album() != d->mAlbumTitle) {
             return;
@@ -743,6 +909,11 @@ void DataModel::trackRemoved(qulonglong removedTrackId)
         return;
     }
 
+    if (d->mIsPaged) {
+        removePagedTrack(removedTrackId);
+        return;
+    }
+
     if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty()) {
         auto trackIndex = indexFromId(removedTrackId);
 
@@ -947,6 +1118,145 @@ void DataModel::albumModified(const DataModel::AlbumDataType &modifiedAlbum)
     Q_EMIT dataChanged(index(albumIndex, 0), index(albumIndex, 0));
 }
 
+void DataModel::albumsSnapshotLoaded(DataModel::ListAlbumDataType snapshotData)
+{
+    if (snapshotData.isEmpty() || d->mModelType != ElisaUtils::Album || !d->mAllAlbumData.isEmpty()) {
+        return;
+    }
+
+    d->mIsShowingSnapshot = true;
+
+    albumsAdded(std::move(snapshotData));
+}
+
+void DataModel::artistsSnapshotLoaded(DataModel::ListArtistDataType snapshotData)
+{
+    if (snapshotData.isEmpty() || d->mModelType != ElisaUtils::Artist || !d->mAllArtistData.isEmpty()) {
+        return;
+    }
+
+    d->mIsShowingSnapshot = true;
+
+    artistsAdded(std::move(snapshotData));
+}
+
+void DataModel::allAlbumsLoaded(DataModel::ListAlbumDataType newData)
+{
+    if (!d->mIsShowingSnapshot) {
+        albumsAdded(std::move(newData));
+        return;
+    }
+
+    d->mIsShowingSnapshot = false;
+
+    if (d->mModelType == ElisaUtils::Album) {
+        applyDataDifferences(d->mAllAlbumData, newData);
+    }
+}
+
+void DataModel::allArtistsLoaded(DataModel::ListArtistDataType newData)
+{
+    if (!d->mIsShowingSnapshot) {
+        artistsAdded(std::move(newData));
+        return;
+    }
+
+    d->mIsShowingSnapshot = false;
+
+    if (d->mModelType == ElisaUtils::Artist) {
+        applyDataDifferences(d->mAllArtistData, newData);
+    }
+}
+
+void DataModel::showLibrarySnapshot()
+{
+    if (!d->mLibrarySnapshot || !d->mLibrarySnapshot->isOpen()) {
+        return;
+    }
+
+    switch (d->mModelType)
+    {
+    case ElisaUtils::Album:
+        albumsSnapshotLoaded(d->mLibrarySnapshot->takeAlbums());
+        break;
+    case ElisaUtils::Artist:
+        artistsSnapshotLoaded(d->mLibrarySnapshot->takeArtists());
+        break;
+    case ElisaUtils::Composer:
+    case ElisaUtils::Genre:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::Track:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Unknown:
+    case ElisaUtils::Radio:
+    case ElisaUtils::Container:
+    case ElisaUtils::PlayList:
+        break;
+    }
+}
+
+template <typename DataListType>
+void DataModel::applyDataDifferences(DataListType &currentData, const DataListType &newData)
+{
+    auto newRows = QHash<qulonglong, qsizetype>{};
+    newRows.reserve(newData.size());
+    for (qsizetype row = 0; row < newData.size(); ++row) {
+        newRows.insert(newData[row].databaseId(), row);
+    }
+
+    // the rows kept must be in the order of the new data, the ones gone or moved are removed
+    auto lastKeptRow = qsizetype{-1};
+    for (qsizetype row = 0; row < currentData.size();) {
+        auto removedRowsCount = qsizetype{0};
+
+        while (row + removedRowsCount < currentData.size()) {
+            const auto itNewRow = newRows.constFind(currentData[row + removedRowsCount].databaseId());
+            if (itNewRow != newRows.cend() && *itNewRow > lastKeptRow) {
+                break;
+            }
+            ++removedRowsCount;
+        }
+
+        if (removedRowsCount > 0) {
+            beginRemoveRows({}, static_cast<int>(row), static_cast<int>(row + removedRowsCount - 1));
+            currentData.remove(row, removedRowsCount);
+            endRemoveRows();
+        }
+
+        if (row < currentData.size()) {
+            lastKeptRow = newRows.value(currentData[row].databaseId());
+            ++row;
+        }
+    }
+
+    // the rows are now a subsequence of the new data: the missing ones are inserted and the others updated
+    for (qsizetype row = 0; row < newData.size();) {
+        if (row < currentData.size() && currentData[row].databaseId() == newData[row].databaseId()) {
+            if (currentData[row] != newData[row]) {
+                currentData[row] = newData[row];
+                Q_EMIT dataChanged(index(static_cast<int>(row), 0), index(static_cast<int>(row), 0));
+            }
+
+            ++row;
+            continue;
+        }
+
+        auto insertedRowsCount = qsizetype{1};
+        while (row + insertedRowsCount < newData.size() &&
+               (row >= currentData.size() || currentData[row].databaseId() != newData[row + insertedRowsCount].databaseId())) {
+            ++insertedRowsCount;
+        }
+
+        beginInsertRows({}, static_cast<int>(row), static_cast<int>(row + insertedRowsCount - 1));
+        for (qsizetype i = 0; i < insertedRowsCount; ++i) {
+            currentData.insert(row + i, newData[row + i]);
+        }
+        endInsertRows();
+
+        row += insertedRowsCount;
+    }
+}
+
 void DataModel::initialize(MusicListenersManager *manager, DatabaseInterface *database,
                            ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                            const QString &genre, const QString &artist, qulonglong databaseId,
@@ -970,7 +1280,459 @@ void DataModel::cleanedDatabase()
     d->mAllGenreData.clear();
     d->mAllTrackData.clear();
     d->mAllArtistData.clear();
+    d->mTracksPages.clear();
+    d->mTracksCount = 0;
+    d->mReloadingTracksPages.clear();
+    d->mLoadedTracksPages.clear();
+    d->mWantedTracksPages.clear();
+    d->mIsShowingSnapshot = false;
+    endResetModel();
+}
+
+void DataModel::setPagedSort(int sortRole, Qt::SortOrder sortOrder)
+{
+    auto pagedSortRole = static_cast<DataTypes::ColumnsRoles>(sortRole);
+    if (!DatabaseInterface::isTracksPageSortRole(pagedSortRole)) {
+        pagedSortRole = DataTypes::TitleRole;
+    }
+
+    if (d->mPagedSortRole == pagedSortRole && d->mPagedSortOrder == sortOrder) {
+        return;
+    }
+
+    d->mPagedSortRole = pagedSortRole;
+    d->mPagedSortOrder = sortOrder;
+
+    if (d->mIsPaged) {
+        resetTracksPages();
+    }
+}
+
+void DataModel::tracksPageLoaded(int requestId, const DataModel::ListTrackDataType &tracks)
+{
+    if (requestId == d->mFetchMoreRequestId) {
+        d->mFetchMoreRequestId = -1;
+        d->mHasMoreTracksPages = tracks.size() == d->mFetchMoreCount;
+
+        if (!tracks.isEmpty()) {
+            appendTracksPages(tracks);
+        }
+
+        setBusy(false);
+
+        // a view needing all the rows gets the remaining ones at once
+        if (d->mKeepAllTracksPages) {
+            fetchMore({});
+        }
+
+        return;
+    }
+
+    if (requestId == d->mAllTracksRequestId) {
+        d->mAllTracksRequestId = -1;
+
+        Q_EMIT allPagedTracksLoaded(tracks);
+
+        return;
+    }
+
+    const auto itReloadingPage = d->mReloadingTracksPages.constFind(requestId);
+    if (itReloadingPage == d->mReloadingTracksPages.cend()) {
+        return;
+    }
+
+    const auto page = itReloadingPage.value();
+    d->mReloadingTracksPages.erase(itReloadingPage);
+
+    reloadTracksPage(page, tracks);
+}
+
+void DataModel::useTracksRows(int firstRow, int lastRow)
+{
+    if (!d->mIsPaged || firstRow > lastRow || firstRow < 0 || lastRow >= d->mTracksCount) {
+        return;
+    }
+
+    for (auto page = tracksPageFromRow(firstRow), lastPage = tracksPageFromRow(lastRow); page <= lastPage; ++page) {
+        if (d->mLoadedTracksPages.contains(page)) {
+            touchTracksPage(page);
+            continue;
+        }
+
+        if (d->mTracksPages[page].rowsCount == 0 || d->mWantedTracksPages.contains(page) ||
+                std::find(d->mReloadingTracksPages.cbegin(), d->mReloadingTracksPages.cend(), page) != d->mReloadingTracksPages.cend()) {
+            continue;
+        }
+
+        // only the pages that were asked last are still likely to be visible
+        d->mWantedTracksPages.push_back(page);
+        if (d->mWantedTracksPages.size() > d->mMaximumLoadedTracksPages) {
+            d->mWantedTracksPages.removeFirst();
+        }
+    }
+
+    if (!d->mWantedTracksPages.isEmpty()) {
+        d->mWantedTracksPagesTimer.start();
+    }
+}
+
+void DataModel::setKeepAllTracksPages(bool keepAllPages)
+{
+    if (d->mKeepAllTracksPages == keepAllPages) {
+        return;
+    }
+
+    d->mKeepAllTracksPages = keepAllPages;
+
+    if (!d->mIsPaged) {
+        return;
+    }
+
+    if (!keepAllPages) {
+        evictTracksPages();
+        return;
+    }
+
+    for (int page = 0; page < d->mTracksPages.size(); ++page) {
+        if (!d->mLoadedTracksPages.contains(page) && !d->mWantedTracksPages.contains(page) &&
+                std::find(d->mReloadingTracksPages.cbegin(), d->mReloadingTracksPages.cend(), page) == d->mReloadingTracksPages.cend()) {
+            d->mWantedTracksPages.push_back(page);
+        }
+    }
+
+    loadWantedTracksPages();
+
+    fetchMore({});
+}
+
+void DataModel::loadAllPagedTracks()
+{
+    if (!d->mIsPaged) {
+        return;
+    }
+
+    d->mAllTracksRequestId = d->mNextTracksPageRequestId++;
+    requestTracksPage(d->mAllTracksRequestId, -1, std::numeric_limits<int>::max());
+}
+
+void DataModel::cancelLoads()
+{
+    d->mWantedTracksPagesTimer.stop();
+    d->mWantedTracksPages.clear();
+
+    d->mDataLoader->cancelLoads();
+
+    setBusy(false);
+}
+
+void DataModel::loadWantedTracksPages()
+{
+    const auto wantedPages = std::exchange(d->mWantedTracksPages, {});
+
+    for (const auto page : wantedPages) {
+        if (page >= d->mTracksPages.size() || d->mLoadedTracksPages.contains(page)) {
+            continue;
+        }
+
+        const auto requestId = d->mNextTracksPageRequestId++;
+        d->mReloadingTracksPages[requestId] = page;
+
+        // leave room for the tracks moved into the page by a modification while it was evicted
+        requestTracksPage(requestId, page - 1, d->mTracksPages[page].rowsCount + d->mTracksPageSize);
+    }
+}
+
+void DataModel::resetTracksPages()
+{
+    beginResetModel();
+    d->mTracksPages.clear();
+    d->mTracksCount = 0;
+    d->mReloadingTracksPages.clear();
+    d->mLoadedTracksPages.clear();
+    d->mWantedTracksPages.clear();
+    d->mFetchMoreRequestId = -1;
+    d->mHasMoreTracksPages = true;
     endResetModel();
+
+    setBusy(true);
+
+    fetchMore({});
+}
+
+const DataModel::TrackDataType &DataModel::trackDataAt(int row) const
+{
+    if (!d->mIsPaged) {
+        return d->mAllTrackData.at(row);
+    }
+
+    static const auto evictedTrack = TrackDataType{};
+
+    const auto &tracksPage = d->mTracksPages.at(tracksPageFromRow(row));
+    const auto pageRow = row - tracksPage.firstRow;
+
+    // the tracks of an evicted page are only known once a view asked for them with useTracksRows
+    if (pageRow >= tracksPage.tracks.size()) {
+        return evictedTrack;
+    }
+
+    return tracksPage.tracks.at(pageRow);
+}
+
+int DataModel::tracksPageFromRow(int row) const
+{
+    // an empty page has the same first row as the following one and is never the page of a row
+    const auto itPage = std::upper_bound(d->mTracksPages.cbegin(), d->mTracksPages.cend(), row,
+                                         [](int oneRow, const auto &onePage) {return oneRow < onePage.firstRow;});
+
+    return static_cast<int>(itPage - d->mTracksPages.cbegin()) - 1;
+}
+
+std::pair<int, int> DataModel::findLoadedPagedTrack(qulonglong databaseId) const
+{
+    for (const auto page : std::as_const(d->mLoadedTracksPages)) {
+        const auto &pageTracks = d->mTracksPages.at(page).tracks;
+        const auto itTrack = std::find_if(pageTracks.cbegin(), pageTracks.cend(),
+                                          [databaseId](const auto &oneTrack) {return oneTrack.databaseId() == databaseId;});
+
+        if (itTrack != pageTracks.cend()) {
+            return {page, static_cast<int>(itTrack - pageTracks.cbegin())};
+        }
+    }
+
+    return {-1, -1};
+}
+
+bool DataModel::isTrackSortedBefore(const QVariant &leftValue, qulonglong leftId,
+                                    const QVariant &rightValue, qulonglong rightId) const
+{
+    auto comparison = 0;
+
+    if (leftValue.typeId() == QMetaType::QDateTime && rightValue.typeId() == QMetaType::QDateTime) {
+        const auto leftTime = leftValue.toDateTime();
+        const auto rightTime = rightValue.toDateTime();
+        comparison = leftTime < rightTime ? -1 : (rightTime < leftTime ? 1 : 0);
+    } else if (leftValue.typeId() == QMetaType::QString || rightValue.typeId() == QMetaType::QString) {
+        comparison = compareNoCase(leftValue.toString(), rightValue.toString());
+    } else if (leftValue.toLongLong() != rightValue.toLongLong()) {
+        comparison = leftValue.toLongLong() < rightValue.toLongLong() ? -1 : 1;
+    }
+
+    if (comparison == 0) {
+        comparison = leftId < rightId ? -1 : (leftId > rightId ? 1 : 0);
+    }
+
+    return d->mPagedSortOrder == Qt::AscendingOrder ? comparison < 0 : comparison > 0;
+}
+
+void DataModel::requestTracksPage(int requestId, int previousPage, int count)
+{
+    auto afterSortValue = QVariant{};
+    auto afterDatabaseId = qulonglong{0};
+
+    if (previousPage >= 0 && previousPage < d->mTracksPages.size()) {
+        const auto &tracksPage = d->mTracksPages[previousPage];
+        afterSortValue = tracksPage.lastSortValue;
+        afterDatabaseId = tracksPage.lastDatabaseId;
+    }
+
+    Q_EMIT needTracksPage(requestId, d->mPagedSortRole, d->mPagedSortOrder,
+                          afterSortValue, afterDatabaseId, count);
+}
+
+void DataModel::appendTracksPages(const ListTrackDataType &tracks)
+{
+    const auto firstRow = d->mTracksCount;
+
+    beginInsertRows({}, firstRow, firstRow + tracks.size() - 1);
+    for (qsizetype pageStart = 0; pageStart < tracks.size(); pageStart += d->mTracksPageSize) {
+        auto tracksPage = DataModelPrivate::TracksPage{};
+        tracksPage.firstRow = d->mTracksCount;
+        tracksPage.tracks = tracks.mid(pageStart, d->mTracksPageSize);
+        tracksPage.rowsCount = tracksPage.tracks.size();
+        tracksPage.lastSortValue = DatabaseInterface::trackSortValue(tracksPage.tracks.constLast(), d->mPagedSortRole);
+        tracksPage.lastDatabaseId = tracksPage.tracks.constLast().databaseId();
+
+        d->mTracksCount += tracksPage.rowsCount;
+        d->mTracksPages.push_back(std::move(tracksPage));
+        d->mLoadedTracksPages.push_back(static_cast<int>(d->mTracksPages.size()) - 1);
+    }
+    endInsertRows();
+
+    evictTracksPages();
+}
+
+void DataModel::reloadTracksPage(int page, const ListTrackDataType &tracks)
+{
+    if (page >= d->mTracksPages.size()) {
+        return;
+    }
+
+    // the tracks removed or modified while the page was evicted change its rows: they are the
+    // tracks up to its end, the rows added or removed being the last ones of the page
+    const auto &tracksPage = d->mTracksPages[page];
+    const auto itPageEnd = std::find_if(tracks.cbegin(), tracks.cend(), [this, &tracksPage](const auto &oneTrack) {
+        return isTrackSortedBefore(tracksPage.lastSortValue, tracksPage.lastDatabaseId,
+                                   DatabaseInterface::trackSortValue(oneTrack, d->mPagedSortRole), oneTrack.databaseId());
+    });
+
+    const auto firstRow = tracksPage.firstRow;
+    const auto previousRowsCount = tracksPage.rowsCount;
+    const auto rowsCount = static_cast<int>(itPageEnd - tracks.cbegin());
+
+    d->mTracksPages[page].tracks = ListTrackDataType{tracks.cbegin(), itPageEnd};
+    touchTracksPage(page);
+
+    if (rowsCount > previousRowsCount) {
+        beginInsertRows({}, firstRow + previousRowsCount, firstRow + rowsCount - 1);
+        shiftTracksPages(page, rowsCount - previousRowsCount);
+        endInsertRows();
+    } else if (rowsCount < previousRowsCount) {
+        beginRemoveRows({}, firstRow + rowsCount, firstRow + previousRowsCount - 1);
+        shiftTracksPages(page, rowsCount - previousRowsCount);
+        endRemoveRows();
+    }
+
+    if (const auto changedRowsCount = std::min(rowsCount, previousRowsCount); changedRowsCount > 0) {
+        Q_EMIT dataChanged(index(firstRow, 0), index(firstRow + changedRowsCount - 1, 0));
+    }
+
+    evictTracksPages();
+}
+
+void DataModel::shiftTracksPages(int page, int rowsDifference)
+{
+    d->mTracksPages[page].rowsCount += rowsDifference;
+
+    for (auto nextPage = page + 1; nextPage < d->mTracksPages.size(); ++nextPage) {
+        d->mTracksPages[nextPage].firstRow += rowsDifference;
+    }
+
+    d->mTracksCount += rowsDifference;
+}
+
+void DataModel::touchTracksPage(int page)
+{
+    if (!d->mLoadedTracksPages.isEmpty() && d->mLoadedTracksPages.constLast() == page) {
+        return;
+    }
+
+    d->mLoadedTracksPages.removeOne(page);
+    d->mLoadedTracksPages.push_back(page);
+}
+
+void DataModel::evictTracksPages()
+{
+    if (d->mKeepAllTracksPages) {
+        return;
+    }
+
+    // the rows keep their place and the views still showing them keep what they read
+    while (d->mLoadedTracksPages.size() > d->mMaximumLoadedTracksPages) {
+        const auto page = d->mLoadedTracksPages.takeFirst();
+        d->mTracksPages[page].tracks = {};
+    }
+}
+
+void DataModel::insertPagedTracks(const ListTrackDataType &newData)
+{
+    const auto sortValue = [this](const auto &oneTrack) {
+        return DatabaseInterface::trackSortValue(oneTrack, d->mPagedSortRole);
+    };
+
+    if (d->mTracksPages.isEmpty()) {
+        // the first page being fetched will bring them
+        if (d->mHasMoreTracksPages) {
+            return;
+        }
+
+        auto sortedTracks = newData;
+        std::sort(sortedTracks.begin(), sortedTracks.end(), [this, &sortValue](const auto &leftTrack, const auto &rightTrack) {
+            return isTrackSortedBefore(sortValue(leftTrack), leftTrack.databaseId(), sortValue(rightTrack), rightTrack.databaseId());
+        });
+
+        appendTracksPages(sortedTracks);
+
+        return;
+    }
+
+    for (const auto &newTrack : newData) {
+        const auto newTrackId = newTrack.databaseId();
+        if (findLoadedPagedTrack(newTrackId).first != -1) {
+            continue;
+        }
+
+        const auto newSortValue = sortValue(newTrack);
+        const auto itPage = std::partition_point(d->mTracksPages.cbegin(), d->mTracksPages.cend(),
+                                                 [this, &newSortValue, newTrackId](const auto &onePage) {
+            return isTrackSortedBefore(onePage.lastSortValue, onePage.lastDatabaseId, newSortValue, newTrackId);
+        });
+
+        auto page = static_cast<int>(itPage - d->mTracksPages.cbegin());
+        if (page == d->mTracksPages.size()) {
+            // a track sorted after all fetched rows will come with a later page
+            if (d->mHasMoreTracksPages) {
+                continue;
+            }
+
+            page = static_cast<int>(d->mTracksPages.size()) - 1;
+            d->mTracksPages[page].lastSortValue = newSortValue;
+            d->mTracksPages[page].lastDatabaseId = newTrackId;
+        }
+
+        auto &tracksPage = d->mTracksPages[page];
+        const auto isPageLoaded = d->mLoadedTracksPages.contains(page);
+
+        // the place of the track in an evicted page is only known once it is loaded again
+        auto pageRow = 0;
+        if (isPageLoaded) {
+            const auto itPosition = std::partition_point(tracksPage.tracks.cbegin(), tracksPage.tracks.cend(),
+                                                         [this, &sortValue, &newSortValue, newTrackId](const auto &oneTrack) {
+                return isTrackSortedBefore(sortValue(oneTrack), oneTrack.databaseId(), newSortValue, newTrackId);
+            });
+            pageRow = static_cast<int>(itPosition - tracksPage.tracks.cbegin());
+        }
+
+        const auto row = tracksPage.firstRow + pageRow;
+
+        beginInsertRows({}, row, row);
+        if (isPageLoaded) {
+            tracksPage.tracks.insert(pageRow, newTrack);
+        }
+        shiftTracksPages(page, 1);
+        endInsertRows();
+    }
+}
+
+void DataModel::modifyPagedTrack(const TrackDataType &modifiedTrack)
+{
+    const auto [page, pageRow] = findLoadedPagedTrack(modifiedTrack.databaseId());
+
+    // an evicted page gets the modified track when it is loaded again
+    if (page == -1) {
+        return;
+    }
+
+    d->mTracksPages[page].tracks[pageRow] = modifiedTrack;
+
+    const auto row = d->mTracksPages[page].firstRow + pageRow;
+    Q_EMIT dataChanged(index(row, 0), index(row, 0));
+}
+
+void DataModel::removePagedTrack(qulonglong removedTrackId)
+{
+    const auto [page, pageRow] = findLoadedPagedTrack(removedTrackId);
+
+    // an evicted page drops the removed track when it is loaded again
+    if (page == -1) {
+        return;
+    }
+
+    const auto row = d->mTracksPages[page].firstRow + pageRow;
+
+    beginRemoveRows({}, row, row);
+    d->mTracksPages[page].tracks.removeAt(pageRow);
+    shiftTracksPages(page, -1);
+    endRemoveRows();
 }
 
 #include "moc_datamodel.cpp"
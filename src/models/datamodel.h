@@ -18,10 +18,12 @@
 #include <QString>
 
 #include <memory>
+#include <utility>
 
 class DataModelPrivate;
 class MusicListenersManager;
 class DatabaseInterface;
+class LibrarySnapshot;
 
 class ELISALIB_EXPORT DataModel : public QAbstractListModel
 {
@@ -83,6 +85,25 @@ public:
 
     [[nodiscard]] bool isBusy() const;
 
+    [[nodiscard]] bool canFetchMore(const QModelIndex &parent) const override;
+
+    void fetchMore(const QModelIndex &parent) override;
+
+    /**
+     * @brief isPaged is true when the tracks are fetched page by page in the order given by setPagedSort
+     *
+     * Only the view of all tracks is paged. Only the pages used last keep their tracks, the views call
+     * useTracksRows for the rows they show so that their pages are loaded again.
+     */
+    [[nodiscard]] bool isPaged() const;
+
+    /**
+     * Number of tracks of a page and number of pages keeping their tracks, 200 and 10 by default
+     *
+     * Only used before the model is initialized.
+     */
+    void setTracksPaging(int pageSize, int maximumLoadedPages);
+
 Q_SIGNALS:
 
     void titleChanged();
@@ -106,6 +127,16 @@ Q_SIGNALS:
 
     void isBusyChanged();
 
+    void isPagedChanged();
+
+    void needTracksPage(int requestId, DataTypes::ColumnsRoles sortRole, Qt::SortOrder sortOrder,
+                        const QVariant &afterSortValue, qulonglong afterDatabaseId, int count);
+
+    /**
+     * All the tracks of a paged model in its order, as asked by loadAllPagedTracks
+     */
+    void allPagedTracksLoaded(const DataModel::ListTrackDataType &tracks);
+
 public Q_SLOTS:
 
     void tracksAdded(DataModel::ListTrackDataType newData);
@@ -130,6 +161,20 @@ public Q_SLOTS:
 
     void albumModified(const DataModel::AlbumDataType &modifiedAlbum);
 
+    /**
+     * Show the albums saved by the previous run until allAlbumsLoaded gives the ones of the database
+     */
+    void albumsSnapshotLoaded(DataModel::ListAlbumDataType snapshotData);
+
+    void artistsSnapshotLoaded(DataModel::ListArtistDataType snapshotData);
+
+    /**
+     * All the albums of the database: only the differences with a snapshot shown meanwhile are applied
+     */
+    void allAlbumsLoaded(DataModel::ListAlbumDataType newData);
+
+    void allArtistsLoaded(DataModel::ListArtistDataType newData);
+
     void initialize(MusicListenersManager *manager, DatabaseInterface *database,
                     ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                     const QString &genre, const QString &artist, qulonglong databaseId,
@@ -139,10 +184,36 @@ public Q_SLOTS:
                           ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                           const DataTypes::DataType &dataFilter);
 
+    void setPagedSort(int sortRole, Qt::SortOrder sortOrder);
+
+    void tracksPageLoaded(int requestId, const DataModel::ListTrackDataType &tracks);
+
+    /**
+     * Load the pages holding these rows if they were evicted, the rows being shown by a view
+     */
+    void useTracksRows(int firstRow, int lastRow);
+
+    /**
+     * Load all the pages and keep them while a view needs every row, for example to filter them
+     */
+    void setKeepAllTracksPages(bool keepAllPages);
+
+    /**
+     * Read all the tracks of a paged model at once, without keeping them, see allPagedTracksLoaded
+     */
+    void loadAllPagedTracks();
+
+    /**
+     * Drop the loads still waiting for this model and stop the running one, the view being closed
+     */
+    void cancelLoads();
+
 private Q_SLOTS:
 
     void cleanedDatabase();
 
+    void loadWantedTracksPages();
+
 private:
 
     void radioAdded(const TrackDataType &radiosData);
@@ -160,8 +231,42 @@ private:
 
     void askModelData();
 
+    void showLibrarySnapshot();
+
+    template <typename DataListType>
+    void applyDataDifferences(DataListType &currentData, const DataListType &newData);
+
     void removeRadios();
 
+    [[nodiscard]] const TrackDataType &trackDataAt(int row) const;
+
+    [[nodiscard]] int tracksPageFromRow(int row) const;
+
+    [[nodiscard]] std::pair<int, int> findLoadedPagedTrack(qulonglong databaseId) const;
+
+    [[nodiscard]] bool isTrackSortedBefore(const QVariant &leftValue, qulonglong leftId,
+                                           const QVariant &rightValue, qulonglong rightId) const;
+
+    void resetTracksPages();
+
+    void requestTracksPage(int requestId, int previousPage, int count);
+
+    void appendTracksPages(const ListTrackDataType &tracks);
+
+    void reloadTracksPage(int page, const ListTrackDataType &tracks);
+
+    void shiftTracksPages(int page, int rowsDifference);
+
+    void touchTracksPage(int page);
+
+    void evictTracksPages();
+
+    void insertPagedTracks(const ListTrackDataType &newData);
+
+    void modifyPagedTrack(const TrackDataType &modifiedTrack);
+
+    void removePagedTrack(qulonglong removedTrackId);
+
     std::unique_ptr<DataModelPrivate> d;
 
 };
@@ -0,0 +1,157 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "searchmodel.h"
+
+#include "modeldataloader.h"
+#include "musiclistenersmanager.h"
+
+#include "models/modelLogging.h"
+
+class SearchModelPrivate
+{
+public:
+
+    SearchModel::ListMusicDataType mResults;
+
+    QString mSearchText;
+
+    ModelDataLoader *mDataLoader = nullptr;
+
+};
+
+SearchModel::SearchModel(QObject *parent) : QAbstractListModel(parent), d(std::make_unique<SearchModelPrivate>())
+{
+    d->mDataLoader = new ModelDataLoader;
+    connect(this, &SearchModel::destroyed, d->mDataLoader, &ModelDataLoader::deleteLater);
+}
+
+SearchModel::~SearchModel()
+= default;
+
+int SearchModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return d->mResults.size();
+}
+
+QHash<int, QByteArray> SearchModel::roleNames() const
+{
+    auto roles = QAbstractListModel::roleNames();
+
+    roles[static_cast<int>(DataTypes::ColumnsRoles::TitleRole)] = "title";
+    roles[static_cast<int>(DataTypes::ColumnsRoles::SecondaryTextRole)] = "secondaryText";
+    roles[static_cast<int>(DataTypes::ColumnsRoles::DatabaseIdRole)] = "databaseId";
+    roles[static_cast<int>(DataTypes::ColumnsRoles::ElementTypeRole)] = "dataType";
+    roles[static_cast<int>(DataTypes::ColumnsRoles::ArtistRole)] = "artist";
+    roles[static_cast<int>(DataTypes::ColumnsRoles::AlbumRole)] = "album";
+
+    return roles;
+}
+
+QVariant SearchModel::data(const QModelIndex &index, int role) const
+{
+    auto result = QVariant();
+
+    if (!index.isValid() || index.row() < 0 || index.row() >= d->mResults.size()) {
+        return result;
+    }
+
+    const auto &oneResult = d->mResults[index.row()];
+
+    switch(role)
+    {
+    case Qt::DisplayRole:
+        result = oneResult[DataTypes::TitleRole];
+        break;
+    case DataTypes::SecondaryTextRole:
+        switch(oneResult.elementType())
+        {
+        case ElisaUtils::Track:
+        case ElisaUtils::Album:
+            result = oneResult[DataTypes::ArtistRole];
+            break;
+        case ElisaUtils::Artist:
+        case ElisaUtils::Composer:
+        case ElisaUtils::Genre:
+        case ElisaUtils::Lyricist:
+        case ElisaUtils::Radio:
+        case ElisaUtils::FileName:
+        case ElisaUtils::Container:
+        case ElisaUtils::PlayList:
+        case ElisaUtils::Unknown:
+            break;
+        }
+        break;
+    default:
+        result = oneResult[static_cast<DataTypes::ColumnsRoles>(role)];
+    }
+
+    return result;
+}
+
+QString SearchModel::searchText() const
+{
+    return d->mSearchText;
+}
+
+void SearchModel::setSearchText(const QString &searchText)
+{
+    if (d->mSearchText == searchText) {
+        return;
+    }
+
+    d->mSearchText = searchText;
+    Q_EMIT searchTextChanged();
+
+    beginResetModel();
+    d->mResults.clear();
+    endResetModel();
+
+    Q_EMIT needSearchResults(d->mSearchText);
+}
+
+void SearchModel::initialize(MusicListenersManager *manager, DatabaseInterface *database)
+{
+    qCDebug(orgKdeElisaModel()) << "SearchModel::initialize";
+
+    if (manager) {
+        manager->connectModel(d->mDataLoader);
+        database = manager->viewDatabase();
+    }
+
+    if (!database) {
+        return;
+    }
+
+    d->mDataLoader->setDatabase(database);
+
+    connect(this, &SearchModel::needSearchResults,
+            d->mDataLoader, &ModelDataLoader::loadSearchResults);
+    connect(d->mDataLoader, &ModelDataLoader::searchResults,
+            this, &SearchModel::searchResults);
+
+    if (!d->mSearchText.isEmpty()) {
+        Q_EMIT needSearchResults(d->mSearchText);
+    }
+}
+
+void SearchModel::searchResults(const QString &searchText, int offset, const SearchModel::ListMusicDataType &results)
+{
+    // batches of an older search or already received ones are dropped
+    if (searchText != d->mSearchText || offset != d->mResults.size() || results.isEmpty()) {
+        return;
+    }
+
+    beginInsertRows({}, d->mResults.size(), d->mResults.size() + results.size() - 1);
+    d->mResults.append(results);
+    endInsertRows();
+}
+
+#include "moc_searchmodel.cpp"
@@ -0,0 +1,77 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SEARCHMODEL_H
+#define SEARCHMODEL_H
+
+#include "elisaLib_export.h"
+
+#include "datatypes.h"
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QQmlEngine>
+#include <QString>
+
+#include <memory>
+
+class SearchModelPrivate;
+class MusicListenersManager;
+class DatabaseInterface;
+
+/**
+ * Results of a search in the whole library: tracks, albums, artists, composers and genres
+ *
+ * The best matches are shown first and the other ones are appended as they are loaded.
+ */
+class ELISALIB_EXPORT SearchModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    QML_ELEMENT
+
+    Q_PROPERTY(QString searchText
+               READ searchText
+               WRITE setSearchText
+               NOTIFY searchTextChanged)
+
+public:
+
+    using ListMusicDataType = DataTypes::ListMusicDataType;
+
+    explicit SearchModel(QObject *parent = nullptr);
+
+    ~SearchModel() override;
+
+    [[nodiscard]] int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
+
+    [[nodiscard]] QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    [[nodiscard]] QString searchText() const;
+
+Q_SIGNALS:
+
+    void searchTextChanged();
+
+    void needSearchResults(const QString &searchText);
+
+public Q_SLOTS:
+
+    void setSearchText(const QString &searchText);
+
+    void initialize(MusicListenersManager *manager, DatabaseInterface *database);
+
+    void searchResults(const QString &searchText, int offset, const SearchModel::ListMusicDataType &results);
+
+private:
+
+    std::unique_ptr<SearchModelPrivate> d;
+
+};
+
+#endif // SEARCHMODEL_H
@@ -26,15 +26,20 @@
 #include "elisaapplication.h"
 #include "elisa_settings.h"
 #include "modeldataloader.h"
+#include "librarysnapshot.h"
 
 #include <KLocalizedString>
 
 #include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
 #include <QStandardPaths>
 #include <QDir>
 #include <QCoreApplication>
 #include <QFileSystemWatcher>
 
+#include <array>
 #include <list>
 
 class MusicListenersManagerPrivate
@@ -57,6 +62,58 @@ public:
 
     DatabaseInterface mDatabaseInterface;
 
+    LibrarySnapshot mLibrarySnapshot;
+
+    struct DatabaseReader {
+        QThread mThread;
+
+        DatabaseInterface mDatabase;
+    };
+
+    static constexpr int DatabaseReadersCount = 2;
+
+    static constexpr int ExternalChangesPollInterval = 2000;
+
+    [[nodiscard]] bool waitForDatabaseReady()
+    {
+        QMutexLocker locker(&mDatabaseReadyMutex);
+
+        while (!mIsDatabaseReady && !mIsStopping) {
+            mDatabaseReadyCondition.wait(&mDatabaseReadyMutex);
+        }
+
+        return !mIsStopping;
+    }
+
+    void releaseDatabaseReaders(bool isStopping)
+    {
+        QMutexLocker locker(&mDatabaseReadyMutex);
+
+        if (isStopping) {
+            mIsStopping = true;
+        } else {
+            mIsDatabaseReady = true;
+        }
+
+        mDatabaseReadyCondition.wakeAll();
+    }
+
+    void stopDatabaseReaders()
+    {
+        releaseDatabaseReaders(true);
+
+        for (auto &oneReader : mDatabaseReaders) {
+            oneReader.mThread.exit();
+            oneReader.mThread.wait();
+        }
+    }
+
+    std::array<DatabaseReader, DatabaseReadersCount> mDatabaseReaders;
+
+    QMutex mDatabaseReadyMutex;
+
+    QWaitCondition mDatabaseReadyCondition;
+
     std::unique_ptr<TracksListener> mTracksListener;
 
     QFileSystemWatcher mConfigFileWatcher;
@@ -67,8 +124,18 @@ public:
 
     int mImportedTracksCount = 0;
 
+    int mNextDatabaseReader = 0;
+
     bool mIndexerBusy = false;
 
+    bool mIsPlaybackStalled = false;
+
+    bool mHasDatabaseReaders = false;
+
+    bool mIsDatabaseReady = false;
+
+    bool mIsStopping = false;
+
     bool mFileSystemIndexerActive = false;
 
     bool mAndroidIndexerActive = false;
@@ -101,6 +168,9 @@ MusicListenersManager::MusicListenersManager(QObject *parent)
     connect(this, &MusicListenersManager::refreshDatabase,
             &d->mDatabaseInterface, &DatabaseInterface::askRestoredTracks);
 
+    connect(this, &MusicListenersManager::indexerBusyChanged,
+            this, &MusicListenersManager::updateDatabaseMaintenance);
+
     d->mListenerThread.start();
     d->mDatabaseThread.start();
 
@@ -112,16 +182,55 @@ MusicListenersManager::MusicListenersManager(QObject *parent)
         QDir myDataDirectory;
         myDataDirectory.mkpath(localDataPaths.first());
         databaseFileName = localDataPaths.first() + QStringLiteral("/elisaDatabase.db");
+        d->mFileListener.setDirectoryFingerprintsFileName(localDataPaths.first() + QStringLiteral("/elisaDirectoryFingerprints.cache"));
     }
 
     QMetaObject::invokeMethod(&d->mDatabaseInterface, "init", Qt::QueuedConnection,
                               Q_ARG(QString, QStringLiteral("listeners")), Q_ARG(QString, databaseFileName));
 
+    // an in-memory database cannot be shared: the views then read with the writer connection
+    if (!databaseFileName.isEmpty()) {
+        d->mHasDatabaseReaders = true;
+
+        const auto librarySnapshotFileName = localDataPaths.first() + QStringLiteral("/elisaLibrary.snapshot");
+
+        d->mLibrarySnapshot.open(librarySnapshotFileName);
+
+        QMetaObject::invokeMethod(&d->mDatabaseInterface, "setLibrarySnapshotFileName", Qt::QueuedConnection,
+                                  Q_ARG(QString, librarySnapshotFileName));
+
+        // elisaImport may index tracks into the same database while Elisa is running
+        QMetaObject::invokeMethod(&d->mDatabaseInterface, "setExternalChangesPollInterval", Qt::QueuedConnection,
+                                  Q_ARG(int, MusicListenersManagerPrivate::ExternalChangesPollInterval));
+
+        connect(&d->mDatabaseInterface, &DatabaseInterface::requestsInitDone,
+                this, [this]() { d->releaseDatabaseReaders(false); }, Qt::DirectConnection);
+
+        for (int i = 0; i < MusicListenersManagerPrivate::DatabaseReadersCount; ++i) {
+            auto &oneReader = d->mDatabaseReaders[i];
+
+            oneReader.mThread.start();
+            oneReader.mDatabase.moveToThread(&oneReader.mThread);
+
+            // first event of the reader thread: requests from the views wait until the schema is ready
+            QMetaObject::invokeMethod(&oneReader.mDatabase, [this, reader = &oneReader.mDatabase, i, databaseFileName]() {
+                if (d->waitForDatabaseReady()) {
+                    reader->initReadOnly(QStringLiteral("listenersReader%1").arg(i), databaseFileName);
+
+                    // the statistics of the writer are the ones logged when Elisa quits
+                    reader->setStatementStatistics(d->mDatabaseInterface.statementStatistics());
+                }
+            }, Qt::QueuedConnection);
+        }
+    }
+
     qCInfo(orgKdeElisaIndexersManager) << "Local file system indexer is inactive";
 }
 
 MusicListenersManager::~MusicListenersManager()
 {
+    d->stopDatabaseReaders();
+
     d->mListenerThread.quit();
     d->mListenerThread.wait();
 
@@ -160,6 +269,11 @@ TracksListener *MusicListenersManager::tracksListener() const
     return d->mTracksListener.get();
 }
 
+LibrarySnapshot *MusicListenersManager::librarySnapshot() const
+{
+    return &d->mLibrarySnapshot;
+}
+
 bool MusicListenersManager::indexerBusy() const
 {
     return d->mIndexerBusy;
@@ -204,6 +318,8 @@ void MusicListenersManager::databaseReady()
     d->mConfigFileWatcher.addPath(Elisa::ElisaConfiguration::self()->config()->name());
 
     configChanged();
+
+    updateDatabaseMaintenance();
 }
 
 void MusicListenersManager::applicationAboutToQuit()
@@ -212,6 +328,8 @@ void MusicListenersManager::applicationAboutToQuit()
 
     Q_EMIT applicationIsTerminating();
 
+    d->stopDatabaseReaders();
+
     d->mDatabaseThread.exit();
     d->mDatabaseThread.wait();
 
@@ -244,13 +362,27 @@ void MusicListenersManager::playBackError(const QUrl &sourceInError, QMediaPlaye
     }
 }
 
+void MusicListenersManager::playerMediaStatusChanged(QMediaPlayer::MediaStatus playerStatus)
+{
+    const auto isPlaybackStalled = playerStatus == QMediaPlayer::LoadingMedia ||
+            playerStatus == QMediaPlayer::StalledMedia ||
+            playerStatus == QMediaPlayer::BufferingMedia;
+
+    if (isPlaybackStalled == d->mIsPlaybackStalled) {
+        return;
+    }
+
+    d->mIsPlaybackStalled = isPlaybackStalled;
+
+    updateDatabaseMaintenance();
+}
+
 void MusicListenersManager::deleteElementById(ElisaUtils::PlayListEntryType entryType, qulonglong databaseId)
 {
     switch(entryType)
     {
     case ElisaUtils::Radio:
-        QMetaObject::invokeMethod(&d->mDatabaseInterface, "removeRadio", Qt::QueuedConnection,
-                                  Q_ARG(qulonglong, databaseId));
+        d->mDatabaseInterface.removeRadio(databaseId);
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -268,7 +400,17 @@ void MusicListenersManager::deleteElementById(ElisaUtils::PlayListEntryType entr
 
 void MusicListenersManager::connectModel(ModelDataLoader *dataLoader)
 {
-    dataLoader->moveToThread(&d->mDatabaseThread);
+    if (!d->mHasDatabaseReaders) {
+        dataLoader->moveToThread(&d->mDatabaseThread);
+        return;
+    }
+
+    // the views load their data concurrently with the indexing
+    auto &oneReader = d->mDatabaseReaders[d->mNextDatabaseReader];
+    d->mNextDatabaseReader = (d->mNextDatabaseReader + 1) % MusicListenersManagerPrivate::DatabaseReadersCount;
+
+    dataLoader->setReadDatabase(&oneReader.mDatabase);
+    dataLoader->moveToThread(&oneReader.mThread);
 }
 
 void MusicListenersManager::scanCollection(CollectionScan scantype)
@@ -378,6 +520,15 @@ void MusicListenersManager::monitorEndingListeners()
     Q_EMIT indexerBusyChanged();
 }
 
+void MusicListenersManager::updateDatabaseMaintenance()
+{
+    // the maintenance reads the whole database: it waits for the indexer and for a smooth playback
+    const auto isMaintenanceAllowed = !d->mIndexerBusy && !d->mIsPlaybackStalled;
+
+    QMetaObject::invokeMethod(&d->mDatabaseInterface, "setMaintenanceAllowed", Qt::QueuedConnection,
+                              Q_ARG(bool, isMaintenanceAllowed));
+}
+
 void MusicListenersManager::cleanedDatabase()
 {
     d->mImportedTracksCount = 0;
@@ -24,6 +24,7 @@ class MediaPlayList;
 class ElisaApplication;
 class ModelDataLoader;
 class TracksListener;
+class LibrarySnapshot;
 
 class ELISALIB_EXPORT MusicListenersManager : public QObject
 {
@@ -87,6 +88,11 @@ public:
 
     [[nodiscard]] TracksListener* tracksListener() const;
 
+    /**
+     * Albums and artists saved by the previous run, shown by the views until the database gives its data
+     */
+    [[nodiscard]] LibrarySnapshot* librarySnapshot() const;
+
     [[nodiscard]] bool indexerBusy() const;
 
     [[nodiscard]] bool fileSystemIndexerActive() const;
@@ -135,6 +141,8 @@ public Q_SLOTS:
 
     void playBackError(const QUrl &sourceInError, QMediaPlayer::Error playerError);
 
+    void playerMediaStatusChanged(QMediaPlayer::MediaStatus playerStatus);
+
     void deleteElementById(ElisaUtils::PlayListEntryType entryType, qulonglong databaseId);
 
     void connectModel(ModelDataLoader *dataLoader);
@@ -157,6 +165,8 @@ private Q_SLOTS:
 
     void cleanedDatabase();
 
+    void updateDatabaseMaintenance();
+
 private:
 
     void startLocalFileSystemIndexing();
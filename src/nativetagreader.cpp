@@ -0,0 +1,1361 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "nativetagreader.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include <QFile>
+#include <QByteArray>
+#include <QStringList>
+#include <QStringDecoder>
+#include <QLocale>
+#include <QTime>
+#include <QList>
+#include <QMap>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+quint16 readBE16(const uchar *data)
+{
+    return static_cast<quint16>((data[0] << 8) | data[1]);
+}
+
+quint32 readBE24(const uchar *data)
+{
+    return (quint32{data[0]} << 16) | (quint32{data[1]} << 8) | quint32{data[2]};
+}
+
+quint32 readBE32(const uchar *data)
+{
+    return (quint32{data[0]} << 24) | (quint32{data[1]} << 16) | (quint32{data[2]} << 8) | quint32{data[3]};
+}
+
+quint64 readBE64(const uchar *data)
+{
+    return (quint64{readBE32(data)} << 32) | quint64{readBE32(data + 4)};
+}
+
+quint16 readLE16(const uchar *data)
+{
+    return static_cast<quint16>(data[0] | (data[1] << 8));
+}
+
+quint32 readLE32(const uchar *data)
+{
+    return quint32{data[0]} | (quint32{data[1]} << 8) | (quint32{data[2]} << 16) | (quint32{data[3]} << 24);
+}
+
+quint64 readLE64(const uchar *data)
+{
+    return quint64{readLE32(data)} | (quint64{readLE32(data + 4)} << 32);
+}
+
+quint32 readSyncSafe32(const uchar *data)
+{
+    return (quint32{data[0] & 0x7fu} << 21) | (quint32{data[1] & 0x7fu} << 14) | (quint32{data[2] & 0x7fu} << 7) | quint32{data[3] & 0x7fu};
+}
+
+constexpr quint32 makeBoxType(quint8 a, quint8 b, quint8 c, quint8 d)
+{
+    return (quint32{a} << 24) | (quint32{b} << 16) | (quint32{c} << 8) | quint32{d};
+}
+
+/**
+ * Tags and audio properties collected while parsing one file
+ */
+struct ParsedTrack
+{
+    QMap<DataTypes::ColumnsRoles, QStringList> mTags;
+
+    QStringList mDescriptions;
+
+    qint64 mDurationMs = 0;
+
+    int mChannels = 0;
+
+    int mSampleRate = 0;
+
+    int mBitRate = 0;
+
+    int mRating = -1;
+
+    bool mHasEmbeddedCover = false;
+
+    void addTag(DataTypes::ColumnsRoles role, const QString &value)
+    {
+        if (!value.isEmpty()) {
+            mTags[role].push_back(value);
+        }
+    }
+};
+
+/**
+ * Sequential reader over a packet split in several chunks of the mapped file
+ *
+ * Ogg packets span pages: the chunks point directly into the mapping so that
+ * skipping a field never copies it.
+ */
+class ChunkReader
+{
+public:
+
+    void append(const uchar *data, qint64 length)
+    {
+        if (length > 0) {
+            mChunks.push_back({data, length});
+            mRemaining += length;
+        }
+    }
+
+    [[nodiscard]] qint64 remaining() const
+    {
+        return mRemaining;
+    }
+
+    bool skip(qint64 length)
+    {
+        if (length < 0 || length > mRemaining) {
+            return false;
+        }
+
+        mRemaining -= length;
+
+        while (length > 0) {
+            const auto &currentChunk = mChunks[mCurrentChunk];
+            const auto available = currentChunk.second - mPositionInChunk;
+
+            if (length < available) {
+                mPositionInChunk += length;
+                return true;
+            }
+
+            length -= available;
+            ++mCurrentChunk;
+            mPositionInChunk = 0;
+        }
+
+        return true;
+    }
+
+    bool read(qint64 length, QByteArray &result)
+    {
+        if (length < 0 || length > mRemaining) {
+            return false;
+        }
+
+        result.resize(length);
+        auto *destination = result.data();
+
+        mRemaining -= length;
+
+        while (length > 0) {
+            const auto &currentChunk = mChunks[mCurrentChunk];
+            const auto available = currentChunk.second - mPositionInChunk;
+            const auto copied = std::min(length, available);
+
+            std::memcpy(destination, currentChunk.first + mPositionInChunk, copied);
+            destination += copied;
+            length -= copied;
+
+            if (copied == available) {
+                ++mCurrentChunk;
+                mPositionInChunk = 0;
+            } else {
+                mPositionInChunk += copied;
+            }
+        }
+
+        return true;
+    }
+
+    bool readLE32(quint32 &value)
+    {
+        QByteArray buffer;
+        if (!read(4, buffer)) {
+            return false;
+        }
+
+        value = ::readLE32(reinterpret_cast<const uchar*>(buffer.constData()));
+        return true;
+    }
+
+private:
+
+    QList<std::pair<const uchar*, qint64>> mChunks;
+
+    qsizetype mCurrentChunk = 0;
+
+    qint64 mPositionInChunk = 0;
+
+    qint64 mRemaining = 0;
+
+};
+
+int leadingNumber(const QString &value)
+{
+    const auto trimmedValue = value.trimmed();
+
+    qsizetype digitsCount = 0;
+    while (digitsCount < trimmedValue.size() && trimmedValue.at(digitsCount).isDigit()) {
+        ++digitsCount;
+    }
+
+    if (digitsCount == 0) {
+        return -1;
+    }
+
+    bool conversionOk = false;
+    const auto number = trimmedValue.left(digitsCount).toInt(&conversionOk);
+
+    return conversionOk ? number : -1;
+}
+
+bool parseVorbisComment(ChunkReader &reader, ParsedTrack &track)
+{
+    static const QMap<QByteArray, DataTypes::ColumnsRoles> vorbisKeys = {
+        {QByteArrayLiteral("TITLE"), DataTypes::TitleRole},
+        {QByteArrayLiteral("ARTIST"), DataTypes::ArtistRole},
+        {QByteArrayLiteral("ALBUMARTIST"), DataTypes::AlbumArtistRole},
+        {QByteArrayLiteral("ALBUM ARTIST"), DataTypes::AlbumArtistRole},
+        {QByteArrayLiteral("ALBUM"), DataTypes::AlbumRole},
+        {QByteArrayLiteral("GENRE"), DataTypes::GenreRole},
+        {QByteArrayLiteral("COMPOSER"), DataTypes::ComposerRole},
+        {QByteArrayLiteral("LYRICIST"), DataTypes::LyricistRole},
+        {QByteArrayLiteral("TRACKNUMBER"), DataTypes::TrackNumberRole},
+        {QByteArrayLiteral("DISCNUMBER"), DataTypes::DiscNumberRole},
+        {QByteArrayLiteral("DATE"), DataTypes::YearRole},
+        {QByteArrayLiteral("COMMENT"), DataTypes::CommentRole},
+        {QByteArrayLiteral("LYRICS"), DataTypes::LyricsRole},
+        {QByteArrayLiteral("UNSYNCEDLYRICS"), DataTypes::LyricsRole},
+    };
+
+    // keys longer than that are not interesting and the field is skipped
+    constexpr qint64 maximumKeyPrefix = 64;
+
+    quint32 vendorLength = 0;
+    if (!reader.readLE32(vendorLength) || !reader.skip(vendorLength)) {
+        return false;
+    }
+
+    quint32 fieldsCount = 0;
+    if (!reader.readLE32(fieldsCount)) {
+        return false;
+    }
+
+    for (quint32 fieldIndex = 0; fieldIndex < fieldsCount; ++fieldIndex) {
+        quint32 fieldLength = 0;
+        if (!reader.readLE32(fieldLength) || fieldLength > reader.remaining()) {
+            return false;
+        }
+
+        QByteArray prefix;
+        const auto prefixLength = std::min<qint64>(fieldLength, maximumKeyPrefix);
+        if (!reader.read(prefixLength, prefix)) {
+            return false;
+        }
+
+        const auto separatorIndex = prefix.indexOf('=');
+        if (separatorIndex <= 0) {
+            if (!reader.skip(fieldLength - prefixLength)) {
+                return false;
+            }
+            continue;
+        }
+
+        const auto key = prefix.left(separatorIndex).toUpper();
+
+        if (key == "METADATA_BLOCK_PICTURE" || key == "COVERART") {
+            track.mHasEmbeddedCover = true;
+            if (!reader.skip(fieldLength - prefixLength)) {
+                return false;
+            }
+            continue;
+        }
+
+        const auto itKey = vorbisKeys.constFind(key);
+        const auto isDescription = key == "DESCRIPTION";
+        const auto isRating = key == "RATING";
+
+        if (itKey == vorbisKeys.constEnd() && !isDescription && !isRating) {
+            if (!reader.skip(fieldLength - prefixLength)) {
+                return false;
+            }
+            continue;
+        }
+
+        QByteArray valueEnd;
+        if (!reader.read(fieldLength - prefixLength, valueEnd)) {
+            return false;
+        }
+
+        const auto value = QString::fromUtf8(prefix.mid(separatorIndex + 1) + valueEnd);
+
+        if (isDescription) {
+            track.mDescriptions.push_back(value);
+        } else if (isRating) {
+            // ratings are stored out of 100
+            const auto rating = leadingNumber(value);
+            if (rating >= 0) {
+                track.mRating = (rating + 5) / 10;
+            }
+        } else {
+            track.addTag(itKey.value(), value);
+        }
+    }
+
+    return true;
+}
+
+bool readFlac(const uchar *data, qint64 size, ParsedTrack &track)
+{
+    qint64 offset = 0;
+
+    // some tools prepend an ID3v2 tag to FLAC files
+    if (size >= 10 && std::memcmp(data, "ID3", 3) == 0) {
+        offset = 10 + readSyncSafe32(data + 6);
+    }
+
+    if (offset + 4 > size || std::memcmp(data + offset, "fLaC", 4) != 0) {
+        return false;
+    }
+    offset += 4;
+
+    quint64 totalSamples = 0;
+    auto streamInfoFound = false;
+    auto lastBlock = false;
+
+    while (!lastBlock) {
+        if (offset + 4 > size) {
+            return false;
+        }
+
+        const auto blockHeader = data[offset];
+        const auto blockLength = qint64{readBE24(data + offset + 1)};
+        lastBlock = (blockHeader & 0x80) != 0;
+        offset += 4;
+
+        if (offset + blockLength > size) {
+            return false;
+        }
+
+        switch (blockHeader & 0x7f)
+        {
+        case 0:
+        {
+            if (blockLength < 18) {
+                return false;
+            }
+
+            const auto streamInfo = readBE64(data + offset + 10);
+            track.mSampleRate = static_cast<int>(streamInfo >> 44);
+            track.mChannels = static_cast<int>((streamInfo >> 41) & 0x7) + 1;
+            totalSamples = streamInfo & Q_UINT64_C(0xfffffffff);
+            streamInfoFound = true;
+            break;
+        }
+        case 4:
+        {
+            ChunkReader reader;
+            reader.append(data + offset, blockLength);
+            if (!parseVorbisComment(reader, track)) {
+                return false;
+            }
+            break;
+        }
+        case 6:
+            track.mHasEmbeddedCover = true;
+            break;
+        default:
+            break;
+        }
+
+        offset += blockLength;
+    }
+
+    if (!streamInfoFound || track.mSampleRate == 0 || totalSamples == 0) {
+        return false;
+    }
+
+    track.mDurationMs = static_cast<qint64>(totalSamples * 1000 / static_cast<quint64>(track.mSampleRate));
+    if (track.mDurationMs > 0) {
+        track.mBitRate = static_cast<int>((size - offset) * 8000 / track.mDurationMs);
+    }
+
+    return true;
+}
+
+bool readOgg(const uchar *data, qint64 size, ParsedTrack &track)
+{
+    constexpr qint64 pageHeaderLength = 27;
+
+    std::array<ChunkReader, 2> headerPackets;
+    qsizetype currentPacket = 0;
+    qint64 offset = 0;
+    quint32 streamSerial = 0;
+
+    while (currentPacket < static_cast<qsizetype>(headerPackets.size())) {
+        if (offset + pageHeaderLength > size || std::memcmp(data + offset, "OggS", 4) != 0) {
+            return false;
+        }
+
+        const auto pageSerial = readLE32(data + offset + 14);
+        const auto segmentsCount = qint64{data[offset + 26]};
+        const auto *segmentsTable = data + offset + pageHeaderLength;
+        auto payloadOffset = offset + pageHeaderLength + segmentsCount;
+
+        if (payloadOffset > size) {
+            return false;
+        }
+
+        if (offset == 0) {
+            streamSerial = pageSerial;
+        }
+
+        qint64 payloadLength = 0;
+        for (qint64 segmentIndex = 0; segmentIndex < segmentsCount; ++segmentIndex) {
+            payloadLength += segmentsTable[segmentIndex];
+        }
+
+        if (payloadOffset + payloadLength > size) {
+            return false;
+        }
+
+        if (pageSerial == streamSerial) {
+            for (qint64 segmentIndex = 0; segmentIndex < segmentsCount && currentPacket < static_cast<qsizetype>(headerPackets.size()); ++segmentIndex) {
+                const auto segmentLength = qint64{segmentsTable[segmentIndex]};
+
+                headerPackets[currentPacket].append(data + payloadOffset, segmentLength);
+                payloadOffset += segmentLength;
+
+                if (segmentLength < 255) {
+                    ++currentPacket;
+                }
+            }
+        }
+
+        offset += pageHeaderLength + segmentsCount + payloadLength;
+    }
+
+    auto &identificationPacket = headerPackets[0];
+    auto &commentPacket = headerPackets[1];
+
+    QByteArray identification;
+    if (!identificationPacket.read(std::min<qint64>(identificationPacket.remaining(), 30), identification)) {
+        return false;
+    }
+
+    const auto *identificationData = reinterpret_cast<const uchar*>(identification.constData());
+    quint64 preSkip = 0;
+    auto nominalBitRate = qint64{0};
+
+    QByteArray commentMagic;
+    if (identification.size() >= 30 && identification.startsWith("\x01vorbis")) {
+        track.mChannels = identificationData[11];
+        track.mSampleRate = static_cast<int>(readLE32(identificationData + 12));
+        nominalBitRate = static_cast<qint32>(readLE32(identificationData + 20));
+
+        if (!commentPacket.read(7, commentMagic) || commentMagic != "\x03vorbis") {
+            return false;
+        }
+    } else if (identification.size() >= 19 && identification.startsWith("OpusHead")) {
+        track.mChannels = identificationData[9];
+        // Opus is always decoded at 48 kHz, the header only stores the original rate
+        track.mSampleRate = 48000;
+        preSkip = readLE16(identificationData + 10);
+
+        if (!commentPacket.read(8, commentMagic) || commentMagic != "OpusTags") {
+            return false;
+        }
+    } else {
+        return false;
+    }
+
+    if (track.mSampleRate <= 0 || !parseVorbisComment(commentPacket, track)) {
+        return false;
+    }
+
+    // the duration is the granule position of the last page of the stream
+    auto lastGranulePosition = qint64{-1};
+    const auto searchLimit = std::max<qint64>(offset, size - 2 * 65536);
+    for (auto pageOffset = size - pageHeaderLength; pageOffset >= searchLimit; --pageOffset) {
+        if (data[pageOffset] != 'O' || std::memcmp(data + pageOffset, "OggS", 4) != 0) {
+            continue;
+        }
+
+        if (readLE32(data + pageOffset + 14) != streamSerial) {
+            continue;
+        }
+
+        const auto granulePosition = static_cast<qint64>(readLE64(data + pageOffset + 6));
+        if (granulePosition >= 0) {
+            lastGranulePosition = granulePosition;
+            break;
+        }
+    }
+
+    if (lastGranulePosition <= static_cast<qint64>(preSkip)) {
+        return false;
+    }
+
+    track.mDurationMs = (lastGranulePosition - static_cast<qint64>(preSkip)) * 1000 / track.mSampleRate;
+
+    if (nominalBitRate > 0) {
+        track.mBitRate = static_cast<int>(nominalBitRate);
+    } else if (track.mDurationMs > 0) {
+        track.mBitRate = static_cast<int>(size * 8000 / track.mDurationMs);
+    }
+
+    return true;
+}
+
+QStringList decodeId3Strings(quint8 encoding, const uchar *data, qint64 length)
+{
+    QStringList result;
+
+    const auto isWide = encoding == 1 || encoding == 2;
+    const auto characterSize = isWide ? 2 : 1;
+
+    qint64 stringStart = 0;
+    while (stringStart < length) {
+        auto stringEnd = stringStart;
+        while (stringEnd + characterSize <= length) {
+            if (data[stringEnd] == 0 && (!isWide || data[stringEnd + 1] == 0)) {
+                break;
+            }
+            stringEnd += characterSize;
+        }
+        stringEnd = std::min(stringEnd, length);
+
+        const auto oneString = QByteArrayView{data + stringStart, stringEnd - stringStart};
+
+        switch (encoding)
+        {
+        case 0:
+            result.push_back(QString::fromLatin1(oneString));
+            break;
+        case 1:
+        {
+            auto decoder = QStringDecoder{QStringDecoder::Utf16};
+            result.push_back(QString{decoder.decode(oneString)});
+            break;
+        }
+        case 2:
+        {
+            auto decoder = QStringDecoder{QStringDecoder::Utf16BE};
+            result.push_back(QString{decoder.decode(oneString)});
+            break;
+        }
+        default:
+            result.push_back(QString::fromUtf8(oneString));
+            break;
+        }
+
+        stringStart = stringEnd + characterSize;
+    }
+
+    while (!result.isEmpty() && result.last().isEmpty()) {
+        result.removeLast();
+    }
+
+    return result;
+}
+
+/**
+ * Skip the NUL terminated description of COMM, USLT and APIC frames
+ */
+qint64 skipId3Description(quint8 encoding, const uchar *data, qint64 length, qint64 offset)
+{
+    const auto isWide = encoding == 1 || encoding == 2;
+
+    while (offset < length) {
+        if (isWide) {
+            if (offset + 1 < length && data[offset] == 0 && data[offset + 1] == 0) {
+                return offset + 2;
+            }
+            offset += 2;
+        } else {
+            if (data[offset] == 0) {
+                return offset + 1;
+            }
+            ++offset;
+        }
+    }
+
+    return length;
+}
+
+bool readId3v2Frame(const QByteArray &frameId, const uchar *frameData, qint64 frameLength, ParsedTrack &track, bool &commentFound)
+{
+    static const QMap<QByteArray, DataTypes::ColumnsRoles> id3TextFrames = {
+        {QByteArrayLiteral("TIT2"), DataTypes::TitleRole},
+        {QByteArrayLiteral("TPE1"), DataTypes::ArtistRole},
+        {QByteArrayLiteral("TPE2"), DataTypes::AlbumArtistRole},
+        {QByteArrayLiteral("TALB"), DataTypes::AlbumRole},
+        {QByteArrayLiteral("TCON"), DataTypes::GenreRole},
+        {QByteArrayLiteral("TCOM"), DataTypes::ComposerRole},
+        {QByteArrayLiteral("TEXT"), DataTypes::LyricistRole},
+        {QByteArrayLiteral("TRCK"), DataTypes::TrackNumberRole},
+        {QByteArrayLiteral("TPOS"), DataTypes::DiscNumberRole},
+        {QByteArrayLiteral("TDRC"), DataTypes::YearRole},
+        {QByteArrayLiteral("TYER"), DataTypes::YearRole},
+    };
+
+    if (frameId == "APIC") {
+        track.mHasEmbeddedCover = true;
+        return true;
+    }
+
+    if (frameLength < 1) {
+        return true;
+    }
+
+    const auto encoding = frameData[0];
+    if (encoding > 3) {
+        return false;
+    }
+
+    const auto itTextFrame = id3TextFrames.constFind(frameId);
+    if (itTextFrame != id3TextFrames.constEnd()) {
+        const auto values = decodeId3Strings(encoding, frameData + 1, frameLength - 1);
+
+        for (const auto &oneValue : values) {
+            // references to the ID3v1 genres list need the generic extractor
+            if (itTextFrame.value() == DataTypes::GenreRole && !oneValue.isEmpty() &&
+                    (oneValue.at(0) == QLatin1Char('(') || std::all_of(oneValue.cbegin(), oneValue.cend(), [](QChar oneChar) {return oneChar.isDigit();}))) {
+                return false;
+            }
+
+            track.addTag(itTextFrame.value(), oneValue);
+        }
+
+        return true;
+    }
+
+    if (frameId == "COMM" || frameId == "USLT") {
+        if (frameLength < 4) {
+            return true;
+        }
+
+        const auto descriptionStart = qint64{4};
+        const auto textStart = skipId3Description(encoding, frameData, frameLength, descriptionStart);
+        const auto isEmptyDescription = textStart - descriptionStart <= ((encoding == 1 || encoding == 2) ? 4 : 1);
+        const auto values = decodeId3Strings(encoding, frameData + textStart, frameLength - textStart);
+
+        if (values.isEmpty()) {
+            return true;
+        }
+
+        if (frameId == "USLT") {
+            track.addTag(DataTypes::LyricsRole, values.first());
+        } else if (isEmptyDescription && !commentFound) {
+            track.mTags[DataTypes::CommentRole] = {values.first()};
+            commentFound = true;
+        } else if (!track.mTags.contains(DataTypes::CommentRole)) {
+            track.addTag(DataTypes::CommentRole, values.first());
+        }
+
+        return true;
+    }
+
+    if (frameId == "POPM") {
+        const auto ratingOffset = skipId3Description(0, frameData, frameLength, 0);
+        if (ratingOffset < frameLength) {
+            // POPM ratings go from 1 to 255, Elisa uses 0 to 10
+            const auto popularity = frameData[ratingOffset];
+            if (popularity == 0) {
+                track.mRating = 0;
+            } else if (popularity < 32) {
+                track.mRating = 2;
+            } else if (popularity < 96) {
+                track.mRating = 4;
+            } else if (popularity < 160) {
+                track.mRating = 6;
+            } else if (popularity < 224) {
+                track.mRating = 8;
+            } else {
+                track.mRating = 10;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool readMpegAudioProperties(const uchar *data, qint64 size, qint64 audioStart, ParsedTrack &track)
+{
+    static constexpr int bitRates[5][16] = {
+        {0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 0},
+        {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 0},
+        {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0},
+        {0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256, 0},
+        {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0},
+    };
+
+    static constexpr int sampleRates[3][3] = {
+        {44100, 48000, 32000},
+        {22050, 24000, 16000},
+        {11025, 12000, 8000},
+    };
+
+    // the first frame is expected right after the tag, allow some garbage or padding
+    const auto searchEnd = std::min(size - 4, audioStart + 65536);
+
+    for (auto frameStart = audioStart; frameStart < searchEnd; ++frameStart) {
+        if (data[frameStart] != 0xff || (data[frameStart + 1] & 0xe0) != 0xe0) {
+            continue;
+        }
+
+        const auto versionBits = (data[frameStart + 1] >> 3) & 0x3;
+        const auto layerBits = (data[frameStart + 1] >> 1) & 0x3;
+        const auto bitRateIndex = data[frameStart + 2] >> 4;
+        const auto sampleRateIndex = (data[frameStart + 2] >> 2) & 0x3;
+        const auto channelMode = data[frameStart + 3] >> 6;
+
+        if (versionBits == 1 || layerBits == 0 || bitRateIndex == 0 || bitRateIndex == 15 || sampleRateIndex == 3) {
+            continue;
+        }
+
+        const auto isVersion1 = versionBits == 3;
+        const auto layer = 4 - layerBits;
+        const auto versionIndex = isVersion1 ? 0 : (versionBits == 2 ? 1 : 2);
+
+        const auto bitRateTable = isVersion1 ? layer - 1 : (layer == 1 ? 3 : 4);
+        const auto frameBitRate = bitRates[bitRateTable][bitRateIndex];
+        const auto sampleRate = sampleRates[versionIndex][sampleRateIndex];
+        const auto samplesPerFrame = layer == 1 ? 384 : ((layer == 3 && !isVersion1) ? 576 : 1152);
+
+        track.mSampleRate = sampleRate;
+        track.mChannels = channelMode == 3 ? 1 : 2;
+
+        auto streamLength = size - frameStart;
+        if (size >= 128 && std::memcmp(data + size - 128, "TAG", 3) == 0) {
+            streamLength -= 128;
+        }
+
+        quint64 framesCount = 0;
+        quint64 bytesCount = 0;
+
+        if (layer == 3) {
+            const auto sideInformationLength = isVersion1 ? (channelMode == 3 ? 17 : 32) : (channelMode == 3 ? 9 : 17);
+            const auto xingOffset = frameStart + 4 + sideInformationLength;
+            const auto vbriOffset = frameStart + 4 + 32;
+
+            if (xingOffset + 16 <= size &&
+                    (std::memcmp(data + xingOffset, "Xing", 4) == 0 || std::memcmp(data + xingOffset, "Info", 4) == 0)) {
+                const auto xingFlags = readBE32(data + xingOffset + 4);
+                auto fieldOffset = xingOffset + 8;
+
+                if (xingFlags & 0x1) {
+                    framesCount = readBE32(data + fieldOffset);
+                    fieldOffset += 4;
+                }
+                if (xingFlags & 0x2) {
+                    bytesCount = readBE32(data + fieldOffset);
+                }
+            } else if (vbriOffset + 18 <= size && std::memcmp(data + vbriOffset, "VBRI", 4) == 0) {
+                bytesCount = readBE32(data + vbriOffset + 10);
+                framesCount = readBE32(data + vbriOffset + 14);
+            }
+        }
+
+        if (framesCount > 0) {
+            track.mDurationMs = static_cast<qint64>(framesCount * samplesPerFrame * 1000 / static_cast<quint64>(sampleRate));
+            if (track.mDurationMs > 0) {
+                const auto audioBytes = bytesCount > 0 ? static_cast<qint64>(bytesCount) : streamLength;
+                track.mBitRate = static_cast<int>(audioBytes * 8000 / track.mDurationMs);
+            }
+        } else {
+            track.mDurationMs = streamLength * 8 / frameBitRate;
+            track.mBitRate = frameBitRate * 1000;
+        }
+
+        return track.mDurationMs > 0;
+    }
+
+    return false;
+}
+
+bool readMpeg(const uchar *data, qint64 size, ParsedTrack &track)
+{
+    // files without ID3v2 tag (ID3v1 only or APE tags) are left to the generic extractor
+    if (size < 10 || std::memcmp(data, "ID3", 3) != 0) {
+        return false;
+    }
+
+    const auto majorVersion = data[3];
+    const auto tagFlags = data[5];
+
+    if (majorVersion < 2 || majorVersion > 4 || (tagFlags & 0x80)) {
+        return false;
+    }
+
+    const auto tagEnd = qint64{10} + readSyncSafe32(data + 6);
+    const auto audioStart = tagEnd + ((majorVersion == 4 && (tagFlags & 0x10)) ? 10 : 0);
+
+    if (audioStart > size) {
+        return false;
+    }
+
+    auto offset = qint64{10};
+
+    if (majorVersion > 2 && (tagFlags & 0x40)) {
+        if (offset + 4 > tagEnd) {
+            return false;
+        }
+
+        if (majorVersion == 3) {
+            offset += 4 + readBE32(data + offset);
+        } else {
+            offset += readSyncSafe32(data + offset);
+        }
+    }
+
+    static const QMap<QByteArray, QByteArray> id3v22FrameIds = {
+        {QByteArrayLiteral("TT2"), QByteArrayLiteral("TIT2")},
+        {QByteArrayLiteral("TP1"), QByteArrayLiteral("TPE1")},
+        {QByteArrayLiteral("TP2"), QByteArrayLiteral("TPE2")},
+        {QByteArrayLiteral("TAL"), QByteArrayLiteral("TALB")},
+        {QByteArrayLiteral("TCO"), QByteArrayLiteral("TCON")},
+        {QByteArrayLiteral("TCM"), QByteArrayLiteral("TCOM")},
+        {QByteArrayLiteral("TXT"), QByteArrayLiteral("TEXT")},
+        {QByteArrayLiteral("TRK"), QByteArrayLiteral("TRCK")},
+        {QByteArrayLiteral("TPA"), QByteArrayLiteral("TPOS")},
+        {QByteArrayLiteral("TYE"), QByteArrayLiteral("TYER")},
+        {QByteArrayLiteral("COM"), QByteArrayLiteral("COMM")},
+        {QByteArrayLiteral("ULT"), QByteArrayLiteral("USLT")},
+        {QByteArrayLiteral("PIC"), QByteArrayLiteral("APIC")},
+        {QByteArrayLiteral("POP"), QByteArrayLiteral("POPM")},
+    };
+
+    const auto frameHeaderLength = majorVersion == 2 ? 6 : 10;
+    const auto frameIdLength = majorVersion == 2 ? 3 : 4;
+    auto commentFound = false;
+
+    while (offset + frameHeaderLength <= tagEnd) {
+        if (data[offset] == 0) {
+            break;
+        }
+
+        auto frameId = QByteArray{reinterpret_cast<const char*>(data + offset), frameIdLength};
+        qint64 frameLength = 0;
+        quint16 frameFlags = 0;
+
+        if (majorVersion == 2) {
+            frameLength = readBE24(data + offset + 3);
+            frameId = id3v22FrameIds.value(frameId);
+        } else if (majorVersion == 3) {
+            frameLength = readBE32(data + offset + 4);
+            frameFlags = readBE16(data + offset + 8);
+        } else {
+            frameLength = readSyncSafe32(data + offset + 4);
+            frameFlags = readBE16(data + offset + 8);
+        }
+
+        offset += frameHeaderLength;
+
+        if (frameLength > tagEnd - offset) {
+            return false;
+        }
+
+        // compressed, encrypted, grouped or unsynchronised frames need the generic extractor
+        const auto unsupportedFlags = majorVersion == 3 ? 0x00e0 : 0x004f;
+        if (frameFlags & unsupportedFlags) {
+            return false;
+        }
+
+        if (!frameId.isEmpty() && !readId3v2Frame(frameId, data + offset, frameLength, track, commentFound)) {
+            return false;
+        }
+
+        offset += frameLength;
+    }
+
+    return readMpegAudioProperties(data, size, audioStart, track);
+}
+
+struct Mp4Box
+{
+    quint32 mType = 0;
+
+    qint64 mPayloadOffset = 0;
+
+    qint64 mEnd = 0;
+};
+
+bool readMp4Box(const uchar *data, qint64 offset, qint64 end, Mp4Box &box)
+{
+    if (offset + 8 > end) {
+        return false;
+    }
+
+    auto boxSize = qint64{readBE32(data + offset)};
+    auto headerLength = qint64{8};
+
+    box.mType = readBE32(data + offset + 4);
+
+    if (boxSize == 1) {
+        if (offset + 16 > end) {
+            return false;
+        }
+        boxSize = static_cast<qint64>(readBE64(data + offset + 8));
+        headerLength = 16;
+    } else if (boxSize == 0) {
+        boxSize = end - offset;
+    }
+
+    if (boxSize < headerLength || boxSize > end - offset) {
+        return false;
+    }
+
+    box.mPayloadOffset = offset + headerLength;
+    box.mEnd = offset + boxSize;
+
+    return true;
+}
+
+bool findMp4Box(const uchar *data, qint64 offset, qint64 end, quint32 type, Mp4Box &box)
+{
+    while (readMp4Box(data, offset, end, box)) {
+        if (box.mType == type) {
+            return true;
+        }
+        offset = box.mEnd;
+    }
+
+    return false;
+}
+
+/**
+ * Read one length of an MPEG-4 descriptor, coded on up to four bytes of seven bits
+ */
+bool readDescriptorLength(const uchar *data, qint64 &offset, qint64 end, qint64 &length)
+{
+    length = 0;
+
+    for (int byteIndex = 0; byteIndex < 4; ++byteIndex) {
+        if (offset >= end) {
+            return false;
+        }
+
+        const auto oneByte = data[offset++];
+        length = (length << 7) | (oneByte & 0x7f);
+
+        if (!(oneByte & 0x80)) {
+            return true;
+        }
+    }
+
+    return true;
+}
+
+int readEsdsAverageBitRate(const uchar *data, const Mp4Box &esdsBox)
+{
+    auto offset = esdsBox.mPayloadOffset + 4;
+    const auto end = esdsBox.mEnd;
+    qint64 descriptorLength = 0;
+
+    if (offset >= end || data[offset++] != 0x03 || !readDescriptorLength(data, offset, end, descriptorLength)) {
+        return 0;
+    }
+
+    if (offset + 3 > end) {
+        return 0;
+    }
+
+    const auto streamFlags = data[offset + 2];
+    offset += 3;
+
+    if (streamFlags & 0x80) {
+        offset += 2;
+    }
+    if (streamFlags & 0x40) {
+        if (offset >= end) {
+            return 0;
+        }
+        offset += 1 + data[offset];
+    }
+    if (streamFlags & 0x20) {
+        offset += 2;
+    }
+
+    if (offset >= end || data[offset++] != 0x04 || !readDescriptorLength(data, offset, end, descriptorLength)) {
+        return 0;
+    }
+
+    if (offset + 13 > end) {
+        return 0;
+    }
+
+    return static_cast<int>(readBE32(data + offset + 9));
+}
+
+bool readMp4SampleEntry(const uchar *data, const Mp4Box &stsdBox, ParsedTrack &track, int &averageBitRate)
+{
+    Mp4Box sampleEntry;
+    if (!readMp4Box(data, stsdBox.mPayloadOffset + 8, stsdBox.mEnd, sampleEntry)) {
+        return false;
+    }
+
+    const auto entryOffset = sampleEntry.mPayloadOffset;
+    if (entryOffset + 28 > sampleEntry.mEnd) {
+        return false;
+    }
+
+    track.mChannels = readBE16(data + entryOffset + 16);
+    track.mSampleRate = static_cast<int>(readBE32(data + entryOffset + 24) >> 16);
+
+    const auto soundVersion = readBE16(data + entryOffset + 8);
+    const auto childrenOffset = entryOffset + 28 + (soundVersion == 1 ? 16 : (soundVersion == 2 ? 36 : 0));
+
+    Mp4Box esdsBox;
+    if (findMp4Box(data, childrenOffset, sampleEntry.mEnd, makeBoxType('e', 's', 'd', 's'), esdsBox)) {
+        averageBitRate = readEsdsAverageBitRate(data, esdsBox);
+    }
+
+    return true;
+}
+
+bool readMp4AudioTrack(const uchar *data, const Mp4Box &moovBox, ParsedTrack &track, int &averageBitRate)
+{
+    auto offset = moovBox.mPayloadOffset;
+    Mp4Box trakBox;
+
+    while (findMp4Box(data, offset, moovBox.mEnd, makeBoxType('t', 'r', 'a', 'k'), trakBox)) {
+        offset = trakBox.mEnd;
+
+        Mp4Box mdiaBox;
+        Mp4Box hdlrBox;
+        Mp4Box minfBox;
+        Mp4Box stblBox;
+        Mp4Box stsdBox;
+
+        if (!findMp4Box(data, trakBox.mPayloadOffset, trakBox.mEnd, makeBoxType('m', 'd', 'i', 'a'), mdiaBox) ||
+                !findMp4Box(data, mdiaBox.mPayloadOffset, mdiaBox.mEnd, makeBoxType('h', 'd', 'l', 'r'), hdlrBox) ||
+                hdlrBox.mPayloadOffset + 12 > hdlrBox.mEnd ||
+                readBE32(data + hdlrBox.mPayloadOffset + 8) != makeBoxType('s', 'o', 'u', 'n')) {
+            continue;
+        }
+
+        if (!findMp4Box(data, mdiaBox.mPayloadOffset, mdiaBox.mEnd, makeBoxType('m', 'i', 'n', 'f'), minfBox) ||
+                !findMp4Box(data, minfBox.mPayloadOffset, minfBox.mEnd, makeBoxType('s', 't', 'b', 'l'), stblBox) ||
+                !findMp4Box(data, stblBox.mPayloadOffset, stblBox.mEnd, makeBoxType('s', 't', 's', 'd'), stsdBox)) {
+            continue;
+        }
+
+        return readMp4SampleEntry(data, stsdBox, track, averageBitRate);
+    }
+
+    return false;
+}
+
+bool readMp4Items(const uchar *data, const Mp4Box &ilstBox, ParsedTrack &track)
+{
+    static const QMap<quint32, DataTypes::ColumnsRoles> mp4TextItems = {
+        {makeBoxType(0xa9, 'n', 'a', 'm'), DataTypes::TitleRole},
+        {makeBoxType(0xa9, 'A', 'R', 'T'), DataTypes::ArtistRole},
+        {makeBoxType('a', 'A', 'R', 'T'), DataTypes::AlbumArtistRole},
+        {makeBoxType(0xa9, 'a', 'l', 'b'), DataTypes::AlbumRole},
+        {makeBoxType(0xa9, 'g', 'e', 'n'), DataTypes::GenreRole},
+        {makeBoxType(0xa9, 'w', 'r', 't'), DataTypes::ComposerRole},
+        {makeBoxType(0xa9, 'd', 'a', 'y'), DataTypes::YearRole},
+        {makeBoxType(0xa9, 'c', 'm', 't'), DataTypes::CommentRole},
+        {makeBoxType(0xa9, 'l', 'y', 'r'), DataTypes::LyricsRole},
+    };
+
+    auto offset = ilstBox.mPayloadOffset;
+    Mp4Box itemBox;
+
+    while (readMp4Box(data, offset, ilstBox.mEnd, itemBox)) {
+        offset = itemBox.mEnd;
+
+        if (itemBox.mType == makeBoxType('c', 'o', 'v', 'r')) {
+            track.mHasEmbeddedCover = true;
+            continue;
+        }
+
+        // genres stored as an index in the ID3v1 list need the generic extractor
+        if (itemBox.mType == makeBoxType('g', 'n', 'r', 'e')) {
+            return false;
+        }
+
+        const auto isTrackNumber = itemBox.mType == makeBoxType('t', 'r', 'k', 'n');
+        const auto isDiscNumber = itemBox.mType == makeBoxType('d', 'i', 's', 'k');
+        const auto itTextItem = mp4TextItems.constFind(itemBox.mType);
+
+        if (!isTrackNumber && !isDiscNumber && itTextItem == mp4TextItems.constEnd()) {
+            continue;
+        }
+
+        auto dataOffset = itemBox.mPayloadOffset;
+        Mp4Box dataBox;
+
+        while (findMp4Box(data, dataOffset, itemBox.mEnd, makeBoxType('d', 'a', 't', 'a'), dataBox)) {
+            dataOffset = dataBox.mEnd;
+
+            const auto valueOffset = dataBox.mPayloadOffset + 8;
+            if (valueOffset > dataBox.mEnd) {
+                return false;
+            }
+
+            const auto valueLength = dataBox.mEnd - valueOffset;
+
+            if (isTrackNumber || isDiscNumber) {
+                if (valueLength >= 4) {
+                    const auto number = readBE16(data + valueOffset + 2);
+                    if (number > 0) {
+                        track.addTag(isTrackNumber ? DataTypes::TrackNumberRole : DataTypes::DiscNumberRole, QString::number(number));
+                    }
+                }
+                continue;
+            }
+
+            const auto valueType = readBE32(data + dataBox.mPayloadOffset) & 0xffffff;
+            const auto rawValue = QByteArrayView{data + valueOffset, valueLength};
+
+            if (valueType == 1) {
+                track.addTag(itTextItem.value(), QString::fromUtf8(rawValue));
+            } else if (valueType == 2) {
+                auto decoder = QStringDecoder{QStringDecoder::Utf16BE};
+                track.addTag(itTextItem.value(), QString{decoder.decode(rawValue)});
+            }
+        }
+    }
+
+    return true;
+}
+
+bool readMp4(const uchar *data, qint64 size, ParsedTrack &track)
+{
+    Mp4Box ftypBox;
+    if (!readMp4Box(data, 0, size, ftypBox) || ftypBox.mType != makeBoxType('f', 't', 'y', 'p')) {
+        return false;
+    }
+
+    Mp4Box moovBox;
+    if (!findMp4Box(data, 0, size, makeBoxType('m', 'o', 'o', 'v'), moovBox)) {
+        return false;
+    }
+
+    Mp4Box mvhdBox;
+    if (!findMp4Box(data, moovBox.mPayloadOffset, moovBox.mEnd, makeBoxType('m', 'v', 'h', 'd'), mvhdBox)) {
+        return false;
+    }
+
+    const auto mvhdOffset = mvhdBox.mPayloadOffset;
+    quint64 timeScale = 0;
+    quint64 duration = 0;
+
+    if (mvhdOffset + 32 <= mvhdBox.mEnd && data[mvhdOffset] == 1) {
+        timeScale = readBE32(data + mvhdOffset + 20);
+        duration = readBE64(data + mvhdOffset + 24);
+    } else if (mvhdOffset + 20 <= mvhdBox.mEnd) {
+        timeScale = readBE32(data + mvhdOffset + 12);
+        duration = readBE32(data + mvhdOffset + 16);
+    }
+
+    if (timeScale == 0 || duration == 0) {
+        return false;
+    }
+
+    track.mDurationMs = static_cast<qint64>(duration * 1000 / timeScale);
+
+    auto averageBitRate = 0;
+    if (!readMp4AudioTrack(data, moovBox, track, averageBitRate)) {
+        return false;
+    }
+
+    if (averageBitRate > 0) {
+        track.mBitRate = averageBitRate;
+    } else if (track.mDurationMs > 0) {
+        track.mBitRate = static_cast<int>(size * 8000 / track.mDurationMs);
+    }
+
+    Mp4Box udtaBox;
+    Mp4Box metaBox;
+    Mp4Box ilstBox;
+
+    auto metaFound = findMp4Box(data, moovBox.mPayloadOffset, moovBox.mEnd, makeBoxType('m', 'e', 't', 'a'), metaBox);
+    if (!metaFound && findMp4Box(data, moovBox.mPayloadOffset, moovBox.mEnd, makeBoxType('u', 'd', 't', 'a'), udtaBox)) {
+        metaFound = findMp4Box(data, udtaBox.mPayloadOffset, udtaBox.mEnd, makeBoxType('m', 'e', 't', 'a'), metaBox);
+    }
+
+    // meta is a full box: its children start after the version and flags
+    if (metaFound && findMp4Box(data, metaBox.mPayloadOffset + 4, metaBox.mEnd, makeBoxType('i', 'l', 's', 't'), ilstBox)) {
+        return readMp4Items(data, ilstBox, track);
+    }
+
+    return true;
+}
+
+bool parseTrackFile(const QString &localFileName, NativeTagReader::Format format, ParsedTrack &parsedTrack)
+{
+    if (format == NativeTagReader::Format::Unknown) {
+        return false;
+    }
+
+    QFile audioFile(localFileName);
+    if (!audioFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const auto fileSize = audioFile.size();
+    if (fileSize <= 0) {
+        return false;
+    }
+
+    auto *fileData = audioFile.map(0, fileSize);
+    if (!fileData) {
+        qCDebug(orgKdeElisaIndexer()) << "NativeTagReader" << localFileName << "cannot be mapped" << audioFile.errorString();
+        return false;
+    }
+
+    auto result = false;
+
+    switch (format)
+    {
+    case NativeTagReader::Format::Flac:
+        result = readFlac(fileData, fileSize, parsedTrack);
+        break;
+    case NativeTagReader::Format::Ogg:
+        result = readOgg(fileData, fileSize, parsedTrack);
+        break;
+    case NativeTagReader::Format::Mpeg:
+        result = readMpeg(fileData, fileSize, parsedTrack);
+        break;
+    case NativeTagReader::Format::Mp4:
+        result = readMp4(fileData, fileSize, parsedTrack);
+        break;
+    case NativeTagReader::Format::Unknown:
+        break;
+    }
+
+    audioFile.unmap(fileData);
+
+    return result;
+}
+
+}
+
+class NativeTagReaderPrivate
+{
+public:
+
+    void fillTrackData(const ParsedTrack &parsedTrack, DataTypes::TrackDataType &trackData) const;
+
+    QLocale mLocale;
+
+};
+
+void NativeTagReaderPrivate::fillTrackData(const ParsedTrack &parsedTrack, DataTypes::TrackDataType &trackData) const
+{
+    for (const auto &oneTag : parsedTrack.mTags.asKeyValueRange()) {
+        const auto role = oneTag.first;
+        const auto &values = oneTag.second;
+
+        switch (role)
+        {
+        case DataTypes::TrackNumberRole:
+        case DataTypes::DiscNumberRole:
+        case DataTypes::YearRole:
+        {
+            const auto number = leadingNumber(values.first());
+            if (number > 0) {
+                trackData.insert(role, number);
+            }
+            break;
+        }
+        default:
+            if (values.size() > 1) {
+                trackData.insert(role, mLocale.createSeparatedList(values));
+            } else {
+                trackData.insert(role, values.first());
+            }
+            break;
+        }
+    }
+
+    if (!parsedTrack.mTags.contains(DataTypes::CommentRole) && !parsedTrack.mDescriptions.isEmpty()) {
+        trackData.insert(DataTypes::CommentRole, parsedTrack.mDescriptions.first());
+    }
+
+    if (parsedTrack.mRating >= 0) {
+        trackData.insert(DataTypes::RatingRole, parsedTrack.mRating);
+    }
+
+    if (parsedTrack.mChannels > 0) {
+        trackData.insert(DataTypes::ChannelsRole, parsedTrack.mChannels);
+    }
+
+    if (parsedTrack.mSampleRate > 0) {
+        trackData.insert(DataTypes::SampleRateRole, parsedTrack.mSampleRate);
+    }
+
+    if (parsedTrack.mBitRate > 0) {
+        trackData.insert(DataTypes::BitRateRole, parsedTrack.mBitRate);
+    }
+
+    trackData.insert(DataTypes::DurationRole, QTime::fromMSecsSinceStartOfDay(static_cast<int>(parsedTrack.mDurationMs)));
+}
+
+NativeTagReader::NativeTagReader() : d(std::make_unique<NativeTagReaderPrivate>())
+{
+}
+
+NativeTagReader::~NativeTagReader() = default;
+
+NativeTagReader::Format NativeTagReader::formatForMimeType(const QString &mimeType)
+{
+    if (mimeType == QLatin1String("audio/flac") || mimeType == QLatin1String("audio/x-flac")) {
+        return Format::Flac;
+    }
+
+    if (mimeType == QLatin1String("audio/x-vorbis+ogg") || mimeType == QLatin1String("audio/x-opus+ogg") ||
+            mimeType == QLatin1String("audio/ogg") || mimeType == QLatin1String("audio/vorbis") ||
+            mimeType == QLatin1String("audio/opus")) {
+        return Format::Ogg;
+    }
+
+    if (mimeType == QLatin1String("audio/mpeg")) {
+        return Format::Mpeg;
+    }
+
+    if (mimeType == QLatin1String("audio/mp4") || mimeType == QLatin1String("audio/x-m4a") ||
+            mimeType == QLatin1String("audio/m4a")) {
+        return Format::Mp4;
+    }
+
+    return Format::Unknown;
+}
+
+bool NativeTagReader::readTrack(const QString &localFileName, const QString &mimeType,
+                                DataTypes::TrackDataType &trackData, std::optional<bool> &hasEmbeddedCover)
+{
+    ParsedTrack parsedTrack;
+
+    const auto isParsed = parseTrackFile(localFileName, formatForMimeType(mimeType), parsedTrack);
+
+    // a picture seen before an unsupported part of the tags is still a cover
+    if (isParsed || parsedTrack.mHasEmbeddedCover) {
+        hasEmbeddedCover = parsedTrack.mHasEmbeddedCover;
+    } else {
+        hasEmbeddedCover.reset();
+    }
+
+    if (!isParsed || parsedTrack.mDurationMs <= 0) {
+        qCDebug(orgKdeElisaIndexer()) << "NativeTagReader::readTrack" << localFileName << "not handled";
+        return false;
+    }
+
+    d->fillTrackData(parsedTrack, trackData);
+
+    return true;
+}
@@ -0,0 +1,69 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef NATIVETAGREADER_H
+#define NATIVETAGREADER_H
+
+#include "elisaLib_export.h"
+
+#include "datatypes.h"
+
+#include <QString>
+
+#include <memory>
+#include <optional>
+
+class NativeTagReaderPrivate;
+
+/**
+ * Read tags and audio properties of the most common formats without KFileMetaData
+ *
+ * FLAC, Ogg Vorbis, Ogg Opus, MP3 with an ID3v2 tag and MP4 audio are parsed directly
+ * from a memory mapping of the whole file, the parsers need the end of some files like
+ * the last Ogg page or a trailing MP4 movie box. Only the accessed pages, plus the read
+ * ahead of the system around them, are read from the disk: embedded pictures and audio
+ * data are skipped over, never copied, but the mapping takes the address space of the
+ * whole file for the duration of the parsing.
+ *
+ * readTrack() returns false for anything it does not fully understand (unknown format,
+ * compressed ID3v2 frames, numeric genres, missing duration, ...) so that the caller
+ * can fall back to a generic extractor.
+ */
+class ELISALIB_EXPORT NativeTagReader
+{
+public:
+
+    enum class Format {
+        Unknown,
+        Flac,
+        Ogg,
+        Mpeg,
+        Mp4,
+    };
+
+    NativeTagReader();
+
+    ~NativeTagReader();
+
+    [[nodiscard]] static Format formatForMimeType(const QString &mimeType);
+
+    /**
+     * Fill @p trackData with the tags and audio properties of @p localFileName
+     *
+     * @p hasEmbeddedCover tells whether the file contains at least one picture.
+     * Returns false and leaves @p trackData untouched when the file cannot be read: @p hasEmbeddedCover
+     * is still set when the pictures could be found, it has no value otherwise.
+     */
+    bool readTrack(const QString &localFileName, const QString &mimeType,
+                   DataTypes::TrackDataType &trackData, std::optional<bool> &hasEmbeddedCover);
+
+private:
+
+    std::unique_ptr<NativeTagReaderPrivate> d;
+
+};
+
+#endif // NATIVETAGREADER_H
@@ -84,6 +84,10 @@ AbstractDataView {
         isAlternateColor: (index % 2) === 1
         detailedView: !listView.displaySingleAlbum
 
+        // a paged model only keeps the tracks of the rows being shown
+        Component.onCompleted: listView.contentModel.useRows(index, index)
+        ListView.onReused: listView.contentModel.useRows(index, index)
+
         onTrackRatingChanged: (url, rating) => {
             ElisaApplication.musicManager.updateSingleFileMetaData(url, DataTypes.RatingRole, rating)
         }
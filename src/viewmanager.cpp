@@ -23,6 +23,7 @@
 
 #include <QQmlEngine>
 #include <QMetaEnum>
+#include <QPointer>
 
 class ViewManagerPrivate
 {
@@ -95,6 +96,9 @@ public:
     QString mInitialFilesViewPath = QDir::rootPath();
 
     QList<ViewParameters> mViewParametersStack = (mViewsListData ? QList<ViewParameters>{mViewsListData->viewParameters(0)} : QList<ViewParameters>{});
+
+    // model of each view of the stack, null for the views not using a data model
+    QList<QPointer<DataModel>> mViewModelsStack;
 };
 
 ViewManager::ViewManager(QObject *parent)
@@ -232,6 +236,10 @@ void ViewManager::openViewFromData(const ViewParameters &viewParamaters)
 
     QAbstractItemModel *newModel = nullptr;
     QAbstractProxyModel *proxyModel = nullptr;
+    DataModel *dataModel = nullptr;
+
+    // the new view replaces the ones at its depth and deeper: their loads must not delay its own
+    cancelViewsLoads(viewParamaters.mDepth);
 
     switch (viewParamaters.mModelType)
     {
@@ -248,7 +256,8 @@ void ViewManager::openViewFromData(const ViewParameters &viewParamaters)
         break;
     }
     case GenericDataModel:
-        newModel = new DataModel;
+        dataModel = new DataModel;
+        newModel = dataModel;
         proxyModel = new GridViewProxyModel;
         break;
     case UnknownModelType:
@@ -260,6 +269,7 @@ void ViewManager::openViewFromData(const ViewParameters &viewParamaters)
     QQmlEngine::setObjectOwnership(proxyModel, QQmlEngine::JavaScriptOwnership);
 
     d->mViewParametersStack.push_back(viewParamaters);
+    d->mViewModelsStack.push_back(dataModel);
     switch (viewParamaters.mViewPresentationType)
     {
     case ViewPresentationType::GridView:
@@ -484,12 +494,24 @@ void ViewManager::goBack()
     Q_EMIT popOneView();
 
     if (d->mViewParametersStack.size() > 1) {
+        cancelViewsLoads(d->mViewParametersStack.size());
         d->mViewParametersStack.pop_back();
     }
 
     qCDebug(orgKdeElisaViews()) << "ViewManager::goBack" << d->mViewParametersStack.size();
 }
 
+void ViewManager::cancelViewsLoads(int fromDepth)
+{
+    while (!d->mViewModelsStack.isEmpty() && d->mViewModelsStack.size() >= fromDepth) {
+        const auto viewModel = d->mViewModelsStack.takeLast();
+
+        if (viewModel) {
+            viewModel->cancelLoads();
+        }
+    }
+}
+
 void ViewManager::setViewsData(ViewsListData *viewsData)
 {
     if (d->mViewsListData == viewsData) {
@@ -166,6 +166,11 @@ private:
 
     void openViewFromData(const ViewParameters &viewParamaters);
 
+    /**
+     * Cancel the loads of the models of the views at fromDepth and deeper, these views being closed
+     */
+    void cancelViewsLoads(int fromDepth);
+
     void applyFilter(ViewParameters &nextViewParameters,
                      QString title, const ViewParameters &lastView) const;
 